@@ -0,0 +1,497 @@
+#pragma once
+
+#include <Arduino.h>
+#include <mutex>
+#include <type_traits>
+#include "JsonWriter.h"
+
+// 延遲格式化的二進位日誌（BINARY_DEBUG_LOG 模式下由 DEBUG_*_PRINT 使用）
+// 記錄時只存格式字串的位置與原始參數，不呼叫 printf；
+// 有人讀取時（/api/binlog、遠端調試 WebSocket、USB 串口連線中）才格式化。
+// 格式字串以相對於 ANCHOR 的位移記錄：韌體內直接還原成指標，
+// 離線時 scripts/decode_binlog.py 在韌體 ELF 中找到錨點字串即可查回所有格式字串。
+//
+// 記錄格式（小端序，變動長度）：
+//   u16 size | u8 level | u8 argc | u32 seq | u32 timestamp | i32 formatOffset
+//   | argc 個型別標記 | 參數（i/u/F 4 bytes，I/U/f 8 bytes，s 為 u8 長度 + 內容）
+// size 為 0 表示緩衝尾端未使用，下一筆記錄從頭開始。
+class BinaryLog {
+public:
+    static constexpr size_t BUFFER_SIZE = 2048;
+    static constexpr size_t MAX_RECORD_SIZE = 128;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t MAX_STRING_ARG = 48;
+    static constexpr size_t MAX_ARGS = 12;
+    static constexpr size_t MAX_MESSAGE_SIZE = 256;
+    static constexpr uint8_t DUMP_VERSION = 1;
+    static constexpr char ANCHOR[] = "DaiSpan-BinaryLog-Anchor";
+
+    enum ArgType : uint8_t {
+        ARG_INT32 = 'i',
+        ARG_UINT32 = 'u',
+        ARG_INT64 = 'I',
+        ARG_UINT64 = 'U',
+        ARG_FLOAT = 'F',        // 能無損轉成 float 的浮點數
+        ARG_DOUBLE = 'f',
+        ARG_STRING = 's'
+    };
+
+    // 讀取端拿到的一筆記錄（從環形緩衝複製到堆疊上）
+    struct Entry {
+        uint8_t raw[MAX_RECORD_SIZE];
+        size_t size;
+        uint32_t seq;
+        uint32_t timestamp;
+        uint8_t level;
+        const char* format;
+    };
+
+    struct Stats {
+        uint32_t written;       // 累計記錄數
+        uint32_t evicted;       // 為新記錄讓出空間而丟棄的記錄
+        uint32_t truncated;     // 字串參數被截短的記錄
+        uint32_t stored;        // 目前緩衝中的記錄數
+        uint32_t bytesUsed;
+    };
+
+    static BinaryLog& getInstance() {
+        static BinaryLog instance;
+        return instance;
+    }
+
+    // 開啟後每筆記錄立即格式化輸出到串口（USB CDC 未連線時 Serial 為 false，仍然略過）
+    void setSerialEcho(bool enabled) { serialEcho = enabled; }
+
+    template <typename... Args>
+    void write(uint8_t level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+        uint8_t record[MAX_RECORD_SIZE];
+        Encoder encoder(record, sizeof...(Args));
+        int expand[] = {0, (encoder.add(args), 0)...};
+        (void)expand;
+
+        record[2] = level;
+        record[3] = (uint8_t)sizeof...(Args);
+        uint32_t timestamp = millis();
+        int32_t offset = (int32_t)((intptr_t)format - (intptr_t)ANCHOR);
+        memcpy(record + 8, &timestamp, 4);
+        memcpy(record + 12, &offset, 4);
+        uint16_t size = (uint16_t)encoder.pos;
+        memcpy(record, &size, 2);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            uint32_t seq = nextSeq++;
+            memcpy(record + 4, &seq, 4);
+            store(record, size);
+            stats.written++;
+            if (encoder.truncated) stats.truncated++;
+        }
+
+        if (serialEcho && Serial) {
+            char text[MAX_MESSAGE_SIZE];
+            formatRecord(format, record, size, text, sizeof(text));
+            Serial.print(text);
+        }
+    }
+
+    // 依序號走訪：since = 0 時從最新的 limit 筆開始，否則從序號大於 since 的最舊記錄開始。
+    // 每次只在鎖內複製一筆記錄，fn 執行時不持有鎖（fn 內再寫日誌也不會死結）。
+    // 回傳最後處理的序號，作為下一次的 since
+    template <typename Fn>
+    uint32_t forEach(uint32_t since, size_t limit, Fn fn) {
+        uint32_t cursor;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (since >= nextSeq) since = 0;    // 游標超前（設備已重啟）
+            uint32_t stored = nextSeq - tailSeq;
+            cursor = since == 0 ? (stored > limit ? nextSeq - (uint32_t)limit - 1 : tailSeq - 1) : since;
+        }
+
+        Entry entry;
+        Hint hint = {0, 0};
+        for (size_t n = 0; n < limit && read(cursor, hint, entry); n++) {
+            cursor = entry.seq;
+            fn(entry);
+        }
+        return cursor;
+    }
+
+    // 把一筆記錄格式化成文字，回傳長度
+    size_t format(const Entry& entry, char* out, size_t size) const {
+        return formatRecord(entry.format, entry.raw, entry.size, out, size);
+    }
+
+    // 以 JSON 輸出格式化後的日誌，欄位與 /api/logs 相同
+    template <typename Sink>
+    void writeJSON(JsonWriter<Sink>& json, uint32_t since = 0, size_t limit = 100) {
+        uint32_t first = getFirstSeq();
+        json.beginObject();
+        json.beginArray("logs");
+        uint32_t next = forEach(since, limit, [this, &json](const Entry& entry) {
+            char text[MAX_MESSAGE_SIZE];
+            size_t length = format(entry, text, sizeof(text));
+            while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) text[--length] = '\0';
+            json.beginObject()
+                .field("seq", entry.seq)
+                .field("timestamp", entry.timestamp)
+                .field("level", levelName(entry.level))
+                .field("message", text)
+                .endObject();
+        });
+        json.endArray();
+        json.field("first", first)
+            .field("next", next)
+            .field("more", next < getLastSeq())
+            .field("dropped", since > 0 && since + 1 < first);
+        json.endObject();
+    }
+
+    // 原始傾印：6 bytes 檔頭（"DSBL"、版本、記錄檔頭長度）後接各筆記錄原樣，供離線解碼
+    template <typename Sink>
+    void writeRaw(Sink& out) {
+        const uint8_t header[6] = {'D', 'S', 'B', 'L', DUMP_VERSION, HEADER_SIZE};
+        out.append((const char*)header, sizeof(header));
+        forEach(0, BUFFER_SIZE / HEADER_SIZE, [&out](const Entry& entry) {
+            out.append((const char*)entry.raw, entry.size);
+        });
+    }
+
+    uint32_t getFirstSeq() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tailSeq;
+    }
+
+    // 最新記錄的序號（尚無記錄時為 0）
+    uint32_t getLastSeq() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return nextSeq - 1;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        Stats s = stats;
+        s.stored = count;
+        s.bytesUsed = count == 0 ? 0 : (head > tail ? head - tail : BUFFER_SIZE - tail + head);
+        return s;
+    }
+
+    static const char* levelName(uint8_t level) {
+        switch (level) {
+            case 1: return "ERROR";
+            case 2: return "WARN";
+            case 3: return "INFO";
+            case 4: return "VERBOSE";
+            default: return "UNKNOWN";
+        }
+    }
+
+private:
+    struct Hint {
+        uint32_t seq;
+        size_t offset;
+    };
+
+    // 參數編碼：依 C++ 型別決定標記，字串截短到剩餘空間（保留後面數值參數所需）
+    struct Encoder {
+        uint8_t* record;
+        uint8_t* tags;
+        size_t pos;
+        size_t remainingArgs;
+        bool truncated = false;
+
+        Encoder(uint8_t* r, size_t argc) : record(r), tags(r + HEADER_SIZE), pos(HEADER_SIZE + argc), remainingArgs(argc) {}
+
+        void put(ArgType type, const void* value, size_t length) {
+            *tags++ = type;
+            memcpy(record + pos, value, length);
+            pos += length;
+            remainingArgs--;
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+        add(const T& value) {
+            if (sizeof(T) <= 4) {
+                if (std::is_signed<T>::value) {
+                    int32_t v = (int32_t)value;
+                    put(ARG_INT32, &v, 4);
+                } else {
+                    uint32_t v = (uint32_t)value;
+                    put(ARG_UINT32, &v, 4);
+                }
+            } else if (std::is_signed<T>::value) {
+                int64_t v = (int64_t)value;
+                put(ARG_INT64, &v, 8);
+            } else {
+                uint64_t v = (uint64_t)value;
+                put(ARG_UINT64, &v, 8);
+            }
+        }
+
+        void add(float value) { put(ARG_FLOAT, &value, 4); }
+
+        void add(double value) {
+            float narrow = (float)value;
+            if ((double)narrow == value) put(ARG_FLOAT, &narrow, 4);
+            else put(ARG_DOUBLE, &value, 8);
+        }
+
+        void add(const char* value) {
+            if (!value) value = "(null)";
+            size_t reserve = (remainingArgs - 1) * 8;
+            size_t space = MAX_RECORD_SIZE - pos - 1 - reserve;
+            size_t length = strlen(value);
+            size_t limit = space < MAX_STRING_ARG ? space : MAX_STRING_ARG;
+            if (length > limit) {
+                length = limit;
+                while (length > 0 && ((uint8_t)value[length] & 0xC0) == 0x80) length--;   // 不切斷 UTF-8 字元
+                truncated = true;
+            }
+            *tags++ = ARG_STRING;
+            record[pos++] = (uint8_t)length;
+            memcpy(record + pos, value, length);
+            pos += length;
+            remainingArgs--;
+        }
+        void add(char* value) { add((const char*)value); }
+
+        template <typename T>
+        void add(T* value) {
+            uint64_t v = (uint64_t)(uintptr_t)value;
+            put(ARG_UINT64, &v, 8);
+        }
+    };
+
+    std::mutex mutex;
+    uint8_t buffer[BUFFER_SIZE];
+    size_t head = 0;            // 下一筆記錄寫入位置
+    size_t tail = 0;            // 最舊記錄位置
+    uint32_t count = 0;
+    uint32_t tailSeq = 1;       // 最舊記錄的序號
+    uint32_t nextSeq = 1;
+    bool serialEcho = false;    // 預設不輸出串口，需要時以 setSerialEcho(true) 開啟
+    Stats stats = {};
+
+    BinaryLog() {}
+
+    static uint16_t sizeAt(const uint8_t* p) {
+        uint16_t size;
+        memcpy(&size, p, 2);
+        return size;
+    }
+
+    // 尾端放不下記錄或標記為未使用時回到開頭
+    size_t normalize(size_t offset) const {
+        if (BUFFER_SIZE - offset < HEADER_SIZE || sizeAt(buffer + offset) == 0) return 0;
+        return offset;
+    }
+
+    size_t contiguousFree() const {
+        if (count == 0) return BUFFER_SIZE - head;
+        if (tail > head) return tail - head;
+        if (tail == head) return 0;
+        return BUFFER_SIZE - head;
+    }
+
+    void evictOldest() {
+        tail = normalize(tail);
+        tail += sizeAt(buffer + tail);
+        tailSeq++;
+        count--;
+        stats.evicted++;
+        if (count == 0) head = tail = 0;
+    }
+
+    // 呼叫者持有鎖
+    void store(const uint8_t* record, size_t size) {
+        if (count == 0) head = tail = 0;
+        while (contiguousFree() < size) {
+            if (count > 0 && tail < head) {
+                if (BUFFER_SIZE - head >= 2) memset(buffer + head, 0, 2);
+                head = 0;
+                continue;
+            }
+            evictOldest();
+        }
+        memcpy(buffer + head, record, size);
+        head += size;
+        count++;
+    }
+
+    // 複製序號大於 after 的第一筆記錄；hint 記住上一筆的位置，連續讀取時不必從頭走訪
+    bool read(uint32_t after, Hint& hint, Entry& entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint32_t wanted = after + 1 > tailSeq ? after + 1 : tailSeq;
+        if (count == 0 || wanted >= nextSeq) return false;
+
+        uint32_t seq = tailSeq;
+        size_t offset = tail;
+        if (hint.seq >= tailSeq && hint.seq <= wanted) {
+            seq = hint.seq;
+            offset = hint.offset;
+        }
+        offset = normalize(offset);
+        while (seq < wanted) {
+            offset = normalize(offset + sizeAt(buffer + offset));
+            seq++;
+        }
+        hint = {seq, offset};
+
+        entry.size = sizeAt(buffer + offset);
+        memcpy(entry.raw, buffer + offset, entry.size);
+        memcpy(&entry.seq, entry.raw + 4, 4);
+        memcpy(&entry.timestamp, entry.raw + 8, 4);
+        entry.level = entry.raw[2];
+        int32_t formatOffset;
+        memcpy(&formatOffset, entry.raw + 12, 4);
+        entry.format = (const char*)((intptr_t)ANCHOR + formatOffset);
+        return true;
+    }
+
+    // 參數解碼
+    struct Reader {
+        const uint8_t* tags;
+        const uint8_t* p;
+        const uint8_t* end;
+        uint8_t remaining;
+
+        bool next(uint8_t& type, int64_t& i, uint64_t& u, double& d, const char*& s, size_t& length) {
+            if (remaining == 0) return false;
+            remaining--;
+            type = *tags++;
+            switch (type) {
+                case ARG_INT32: { int32_t v; memcpy(&v, p, 4); p += 4; i = v; u = (uint32_t)v; d = v; return true; }
+                case ARG_UINT32: { uint32_t v; memcpy(&v, p, 4); p += 4; i = v; u = v; d = v; return true; }
+                case ARG_INT64: { memcpy(&i, p, 8); p += 8; u = (uint64_t)i; d = (double)i; return true; }
+                case ARG_UINT64: { memcpy(&u, p, 8); p += 8; i = (int64_t)u; d = (double)u; return true; }
+                case ARG_FLOAT: { float v; memcpy(&v, p, 4); p += 4; d = v; i = (int64_t)v; u = (uint64_t)i; return true; }
+                case ARG_DOUBLE: { memcpy(&d, p, 8); p += 8; i = (int64_t)d; u = (uint64_t)i; return true; }
+                case ARG_STRING: { length = *p++; s = (const char*)p; p += length; return true; }
+                default: remaining = 0; return false;
+            }
+        }
+    };
+
+    // 逐一解析轉換規格，每個規格配一個參數呼叫一次 snprintf（長度修飾詞依記錄的型別重建）
+    static size_t formatRecord(const char* fmt, const uint8_t* record, size_t size, char* out, size_t outSize) {
+        if (outSize == 0) return 0;
+        uint8_t argc = record[3];
+        Reader args = {record + HEADER_SIZE, record + HEADER_SIZE + argc, record + size, argc};
+        size_t pos = 0;
+        out[0] = '\0';
+
+        auto emit = [&](const char* text, size_t length) {
+            size_t n = length < outSize - 1 - pos ? length : outSize - 1 - pos;
+            memcpy(out + pos, text, n);
+            pos += n;
+            out[pos] = '\0';
+        };
+
+        while (*fmt && pos < outSize - 1) {
+            if (*fmt != '%') {
+                const char* run = fmt;
+                while (*fmt && *fmt != '%') fmt++;
+                emit(run, fmt - run);
+                continue;
+            }
+            if (fmt[1] == '%') {
+                emit("%", 1);
+                fmt += 2;
+                continue;
+            }
+
+            char spec[32] = "%";
+            size_t specLength = 1;
+            const char* start = fmt++;
+            auto appendSpec = [&](const char* text) {
+                size_t n = strlen(text);
+                if (specLength + n < sizeof(spec) - 4) {
+                    memcpy(spec + specLength, text, n + 1);
+                    specLength += n;
+                }
+            };
+            auto starArgument = [&]() {
+                uint8_t type; int64_t i = 0; uint64_t u; double d; const char* s; size_t l;
+                args.next(type, i, u, d, s, l);
+                char number[16];
+                snprintf(number, sizeof(number), "%d", (int)i);
+                appendSpec(number);
+            };
+
+            while (*fmt && strchr("-+ #0", *fmt)) { char c[2] = {*fmt++, 0}; appendSpec(c); }
+            if (*fmt == '*') { fmt++; starArgument(); }
+            while (*fmt >= '0' && *fmt <= '9') { char c[2] = {*fmt++, 0}; appendSpec(c); }
+            if (*fmt == '.') {
+                appendSpec(".");
+                fmt++;
+                if (*fmt == '*') { fmt++; starArgument(); }
+                while (*fmt >= '0' && *fmt <= '9') { char c[2] = {*fmt++, 0}; appendSpec(c); }
+            }
+            while (*fmt && strchr("hlLqjzt", *fmt)) fmt++;
+            char conversion = *fmt;
+            if (!conversion) {
+                emit(start, strlen(start));
+                break;
+            }
+            fmt++;
+
+            uint8_t type;
+            int64_t i = 0;
+            uint64_t u = 0;
+            double d = 0;
+            const char* s = nullptr;
+            size_t length = 0;
+            if (!args.next(type, i, u, d, s, length)) {
+                emit("?", 1);
+                continue;
+            }
+
+            char text[MAX_MESSAGE_SIZE];
+            int n = -1;
+            switch (conversion) {
+                case 'd': case 'i':
+                    appendSpec("lld");
+                    n = snprintf(text, sizeof(text), spec, (long long)i);
+                    break;
+                case 'u': case 'x': case 'X': case 'o': {
+                    char tail[4] = {'l', 'l', conversion, 0};
+                    appendSpec(tail);
+                    n = snprintf(text, sizeof(text), spec, (unsigned long long)u);
+                    break;
+                }
+                case 'c':
+                    appendSpec("c");
+                    n = snprintf(text, sizeof(text), spec, (int)i);
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                    char tail[2] = {conversion, 0};
+                    appendSpec(tail);
+                    n = snprintf(text, sizeof(text), spec, d);
+                    break;
+                }
+                case 's':
+                    if (type == ARG_STRING) {
+                        char value[MAX_STRING_ARG + 1];
+                        memcpy(value, s, length);
+                        value[length] = '\0';
+                        appendSpec("s");
+                        n = snprintf(text, sizeof(text), spec, value);
+                    } else {
+                        n = snprintf(text, sizeof(text), "?");
+                    }
+                    break;
+                case 'p':
+                    n = snprintf(text, sizeof(text), "0x%llx", (unsigned long long)u);
+                    break;
+                default:
+                    n = snprintf(text, sizeof(text), "%.*s", (int)(fmt - start), start);
+                    break;
+            }
+            if (n > 0) emit(text, (size_t)n < sizeof(text) ? n : sizeof(text) - 1);
+        }
+        return pos;
+    }
+};
+
+#define BINARY_LOG BinaryLog::getInstance()
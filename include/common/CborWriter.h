@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+#include <string.h>
+#include <type_traits>
+
+// 串流式 CBOR（RFC 8949）寫入器
+// 介面與 JsonWriter 相同，同一份欄位描述（模板函式）可同時輸出 JSON 與 CBOR。
+// 物件與陣列使用不定長度編碼（0xBF / 0x9F ... 0xFF），不需預先計算元素數，
+// 因此和 JsonWriter 一樣直接寫進 Sink、不配置堆積。
+//
+//   CborWriter<StreamingResponse> cbor(stream);
+//   cbor.beginObject().field("freeHeap", ESP.getFreeHeap()).endObject();
+template <typename Sink>
+class CborWriter {
+public:
+    explicit CborWriter(Sink& sink) : sink(sink) {}
+
+    CborWriter& beginObject() { put(0xBF); return *this; }
+    CborWriter& beginObject(const char* name) { key(name); return beginObject(); }
+    CborWriter& endObject() { put(0xFF); return *this; }
+
+    CborWriter& beginArray() { put(0x9F); return *this; }
+    CborWriter& beginArray(const char* name) { key(name); return beginArray(); }
+    CborWriter& endArray() { put(0xFF); return *this; }
+
+    CborWriter& key(const char* name) { writeString(name); return *this; }
+
+    CborWriter& value(bool v) { put(v ? 0xF5 : 0xF4); return *this; }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, CborWriter&>::type
+    value(T v) {
+        if (std::is_signed<T>::value && v < 0) {
+            writeHead(MAJOR_NEGATIVE, (uint64_t)(-1 - (long long)v));
+        } else {
+            writeHead(MAJOR_UNSIGNED, (uint64_t)v);
+        }
+        return *this;
+    }
+
+    // 與 JsonWriter 相同先捨入到固定小數位，再以能無損表示的最短格式（half / single）輸出；
+    // NaN/Inf 輸出 null，與 JSON 輸出一致
+    CborWriter& value(double v, uint8_t decimals = 1) {
+        if (isnan(v) || isinf(v)) {
+            put(0xF6);
+            return *this;
+        }
+        double scale = 1;
+        for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+        float rounded = (float)(round(v * scale) / scale);
+
+        uint16_t half;
+        if (toHalf(rounded, half)) {
+            uint8_t bytes[3] = {0xF9, (uint8_t)(half >> 8), (uint8_t)half};
+            sink.append((const char*)bytes, sizeof(bytes));
+        } else {
+            uint32_t bits;
+            memcpy(&bits, &rounded, sizeof(bits));
+            uint8_t bytes[5] = {0xFA, (uint8_t)(bits >> 24), (uint8_t)(bits >> 16), (uint8_t)(bits >> 8), (uint8_t)bits};
+            sink.append((const char*)bytes, sizeof(bytes));
+        }
+        return *this;
+    }
+    CborWriter& value(float v, uint8_t decimals = 1) { return value((double)v, decimals); }
+
+    CborWriter& value(const char* v) {
+        if (v) writeString(v);
+        else put(0xF6);
+        return *this;
+    }
+    CborWriter& value(const String& v) { return value(v.c_str()); }
+    CborWriter& value(std::nullptr_t) { put(0xF6); return *this; }
+
+    template <typename T>
+    CborWriter& field(const char* name, const T& v) { key(name); return value(v); }
+    CborWriter& field(const char* name, const char* v) { key(name); return value(v); }
+    CborWriter& field(const char* name, float v, uint8_t decimals) { key(name); return value(v, decimals); }
+    CborWriter& field(const char* name, double v, uint8_t decimals) { key(name); return value(v, decimals); }
+
+private:
+    static constexpr uint8_t MAJOR_UNSIGNED = 0;
+    static constexpr uint8_t MAJOR_NEGATIVE = 1;
+    static constexpr uint8_t MAJOR_TEXT = 3;
+
+    Sink& sink;
+
+    void put(uint8_t b) { sink.append((const char*)&b, 1); }
+
+    // 型別標頭：小於 24 的值直接放進首位元組，其餘依大小接 1/2/4/8 位元組大端序
+    void writeHead(uint8_t major, uint64_t v) {
+        uint8_t bytes[9];
+        size_t length;
+        bytes[0] = major << 5;
+        if (v < 24) {
+            bytes[0] |= (uint8_t)v;
+            length = 1;
+        } else if (v <= 0xFF) {
+            bytes[0] |= 24;
+            bytes[1] = (uint8_t)v;
+            length = 2;
+        } else if (v <= 0xFFFF) {
+            bytes[0] |= 25;
+            bytes[1] = (uint8_t)(v >> 8);
+            bytes[2] = (uint8_t)v;
+            length = 3;
+        } else if (v <= 0xFFFFFFFFULL) {
+            bytes[0] |= 26;
+            for (uint8_t i = 0; i < 4; i++) bytes[1 + i] = (uint8_t)(v >> (24 - 8 * i));
+            length = 5;
+        } else {
+            bytes[0] |= 27;
+            for (uint8_t i = 0; i < 8; i++) bytes[1 + i] = (uint8_t)(v >> (56 - 8 * i));
+            length = 9;
+        }
+        sink.append((const char*)bytes, length);
+    }
+
+    // UTF-8 原樣寫出，不需轉義
+    void writeString(const char* s) {
+        size_t length = strlen(s);
+        writeHead(MAJOR_TEXT, length);
+        if (length) sink.append(s, length);
+    }
+
+    // 只在無損時轉成 half（不處理次正規數）；溫度、百分比等 0.5 步進的值都能以 3 bytes 表示
+    static bool toHalf(float f, uint16_t& half) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        uint16_t sign = (bits >> 16) & 0x8000;
+        if ((bits & 0x7FFFFFFF) == 0) {
+            half = sign;
+            return true;
+        }
+        int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 127;
+        uint32_t mantissa = bits & 0x7FFFFF;
+        if (exponent < -14 || exponent > 15 || (mantissa & 0x1FFF)) return false;
+        half = sign | (uint16_t)((exponent + 15) << 10) | (uint16_t)(mantissa >> 13);
+        return true;
+    }
+};
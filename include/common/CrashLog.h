@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 跨重啟保留的崩潰日誌（RTC 記憶體，實作於 src/CrashLog.cpp）
+// 看門狗、掉電（brownout）、panic 或 safeRestart() 重置後，一般 RAM 中的 LogManager 與
+// RemoteDebugger 歷史都會遺失；RTC_NOINIT_ATTR 的資料在這些重置中保留，只有上電時是隨機值。
+// 保留兩部分：
+//   - 最近 RECORD_COUNT 行調試日誌（src/DebugLog.cpp 每行寫入一筆）；
+//   - 最後已知的控制器快照（AccessorySync 在狀態變化與心跳時更新）。
+// 每筆記錄與快照各帶 CRC32，寫入只是一次 memcpy 加一次只涵蓋實際文字的 CRC，不需要鎖；
+// 寫到一半就重置的記錄 CRC 不符，開機時個別丟棄。標頭 CRC 不符（上電、韌體佈局改變）時整份視為空白。
+// 開機後第一次存取時把上一輪的內容複製到一般 RAM 供 /api/crashlog 讀取，再重新初始化 RTC 區塊。
+
+struct CrashLogRecord {
+    static constexpr size_t TEXT_SIZE = 84;
+
+    uint32_t seq;                   // 本輪開機的序號，從 1 開始；0 表示空槽位
+    uint32_t uptimeMs;
+    char text[TEXT_SIZE];           // 不含結尾換行，以 '\0' 結尾
+    uint32_t crc;
+};  // 96 bytes
+
+struct CrashLogSnapshot {
+    uint32_t uptimeMs;
+    uint32_t freeHeap;
+    uint32_t minFreeHeap;
+    float targetTemperature;
+    float currentTemperature;
+    uint8_t power;
+    uint8_t targetMode;
+    uint8_t fanSpeed;
+    uint8_t valid;
+    uint32_t crc;
+};
+
+struct CrashLogStore {
+    static constexpr size_t RECORD_COUNT = 16;
+
+    uint32_t magic;
+    uint32_t layout;                // 版本與大小，韌體改變佈局後舊內容不會被誤讀
+    uint32_t bootCount;
+    uint32_t headerCrc;
+    CrashLogRecord records[RECORD_COUNT];
+    CrashLogSnapshot snapshot;
+};
+
+// RTC 記憶體中的資料（src/CrashLog.cpp）
+extern CrashLogStore crashLogStore;
+
+class CrashLog {
+public:
+    static constexpr size_t RECORD_COUNT = CrashLogStore::RECORD_COUNT;
+
+    // 上一輪開機留下的內容（開機時從 RTC 複製）
+    struct Recovered {
+        uint8_t recordCount;        // 依序號排列的有效記錄數
+        bool hasSnapshot;
+        CrashLogRecord records[RECORD_COUNT];
+        CrashLogSnapshot snapshot;
+    };
+
+    static CrashLog& getInstance() {
+        static CrashLog instance;
+        return instance;
+    }
+
+    // 寫入一行日誌（可在任何任務中呼叫）；超過 TEXT_SIZE 的部分在 UTF-8 字元邊界截斷
+    void record(const char* text, size_t length);
+    void record(const char* text) { record(text, strlen(text)); }
+
+    // 更新最後已知的控制器狀態；剩餘堆積與運行時間在這裡一併記下
+    void updateSnapshot(bool power, uint8_t targetMode, float targetTemperature,
+                        float currentTemperature, uint8_t fanSpeed);
+
+    // 讀取 RTC 內容並重新初始化；建構時呼叫一次（主機端測試可再次呼叫以模擬重啟）
+    void recover();
+
+    const Recovered& getRecovered() const { return recovered; }
+    esp_reset_reason_t getResetReason() const { return resetReason; }
+    uint32_t getBootCount() const { return crashLogStore.bootCount; }
+    uint32_t getRecorded() const { return nextSeq.load(std::memory_order_relaxed) - 1; }
+
+    // 非預期的重置（panic、看門狗、掉電）
+    bool isCrashReset() const;
+
+    static const char* resetReasonName(esp_reset_reason_t reason);
+    static uint32_t crc32(const void* data, size_t length);
+
+private:
+    Recovered recovered;
+    esp_reset_reason_t resetReason;
+    std::atomic<uint32_t> nextSeq{1};
+
+    CrashLog();
+    CrashLog(const CrashLog&) = delete;
+    CrashLog& operator=(const CrashLog&) = delete;
+};
+
+#define CRASH_LOG CrashLog::getInstance()
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "HomeSpan.h"
+#include <atomic>
+#include <type_traits>
 
 // 前向聲明遠端調試功能
 void remoteWebLog(const String& message);
@@ -17,7 +19,10 @@ void remoteWebLog(const String& message);
 #define DEBUG_INFO      3  // 顯示重要狀態更新
 #define DEBUG_VERBOSE   4  // 顯示詳細通訊過程
 
+// 編譯期上限：高於 DEBUG_LEVEL 的日誌完全不編入韌體（可用 -DDEBUG_LEVEL=4 覆寫，
+// 見 platformio.ini 的 esp32-c3-supermini-verbose）
 // 性能優化：生產環境使用較低的調試級別
+#ifndef DEBUG_LEVEL
 #ifdef PRODUCTION_BUILD
     #ifdef MINIMAL_DEBUG_OUTPUT
     #define DEBUG_LEVEL DEBUG_NONE   // 最小調試輸出
@@ -25,54 +30,157 @@ void remoteWebLog(const String& message);
     #define DEBUG_LEVEL DEBUG_ERROR  // 生產環境只顯示錯誤
     #endif
 #else
-#define DEBUG_LEVEL DEBUG_INFO   // 開發環境顯示資訊
+#define DEBUG_LEVEL DEBUG_INFO       // 開發環境顯示資訊；VERBOSE 另以 -DDEBUG_LEVEL=4 編入
 #endif
+#endif
+
+// 各元件開機時的執行期級別（不超過 DEBUG_LEVEL），可經 /api/debug/levels 調整
+#ifndef DEBUG_RUNTIME_LEVEL
+#if DEBUG_LEVEL > DEBUG_INFO
+#define DEBUG_RUNTIME_LEVEL DEBUG_INFO
+#else
+#define DEBUG_RUNTIME_LEVEL DEBUG_LEVEL
+#endif
+#endif
+
+// 日誌元件：由格式字串開頭的 [標籤] 在編譯期判斷，呼叫點不需修改
+enum class DebugComponent : uint8_t {
+    S21,
+    Controller,
+    Device,
+    Web,
+    WiFi,
+    System,
+    Count
+};
+
+struct DebugTag {
+    const char* prefix;
+    DebugComponent component;
+};
+
+inline constexpr DebugTag DEBUG_TAGS[] = {
+    {"[S21", DebugComponent::S21},              // [S21]、[S21Adapter]
+    {"[ACFactory]", DebugComponent::S21},
+    {"[Controller]", DebugComponent::Controller},
+    {"[MockController]", DebugComponent::Controller},
+    {"[Device]", DebugComponent::Device},
+    {"[FanDevice]", DebugComponent::Device},
+    {"[SwingSwitch]", DebugComponent::Device},
+    {"[Notifier]", DebugComponent::Device},
+    {"[AccessorySync]", DebugComponent::Device},
+    {"[Web]", DebugComponent::Web},
+    {"[Events]", DebugComponent::Web},
+    {"[RemoteDebug]", DebugComponent::Web},
+    {"[WiFi", DebugComponent::WiFi},            // [WiFi]、[WiFiManager]
+};
+
+constexpr bool debugPrefixMatches(const char* format, const char* prefix) {
+    while (*prefix) {
+        if (*format++ != *prefix++) return false;
+    }
+    return true;
+}
+
+// 沒有標籤的行（多行輸出的延續行、[Main]、[OTA] 等）歸入 System
+constexpr DebugComponent debugComponentOf(const char* format) {
+    while (*format == '\n') format++;
+    for (const DebugTag& tag : DEBUG_TAGS) {
+        if (debugPrefixMatches(format, tag.prefix)) return tag.component;
+    }
+    return DebugComponent::System;
+}
+
+// 級別遮罩：每個元件 4 bits，bit (元件 * 4 + 級別 - 1) 為 1 表示該級別開啟
+constexpr uint32_t debugLevelBit(DebugComponent component, int level) {
+    return 1u << ((uint8_t)component * 4 + level - 1);
+}
 
-// 優化的緩衝區大小和內存管理
+extern std::atomic<uint32_t> debugLevelMask;
+
+// 格式化之前的檢查：位元在編譯期算好，執行期只有一次載入與比較
+#define DEBUG_LEVEL_ENABLED(level, fmt) \
+    (debugLevelMask.load(std::memory_order_relaxed) & \
+     std::integral_constant<uint32_t, debugLevelBit(debugComponentOf(fmt), level)>::value)
+
+// 執行期級別調整（src/DebugLog.cpp），level 會限制在 DEBUG_LEVEL 以內，回傳實際生效的級別
+int setDebugLevel(DebugComponent component, int level);
+int getDebugLevel(DebugComponent component);
+const char* debugComponentName(DebugComponent component);
+const char* debugLevelName(int level);
+int parseDebugLevel(const char* text);     // "none"/"error"/"warn"/"info"/"verbose" 或 0-4，無效時回傳 -1
+
+// 優化的緩衝區大小和內存管理（單行日誌上限，超過部分截斷）
 #define DEBUG_BUFFER_SIZE 256
 #define DEBUG_MAX_REMOTE_LOGS 10  // 遠端日誌最大緩存數量
 
-// 優化的日誌宏 - 避免重複的內存分配
+#ifdef BINARY_DEBUG_LOG
+// 二進位日誌模式：只記錄格式字串位置與原始參數，讀取時才格式化（見 BinaryLog.h）
+// "" fmt 讓非字面常數的格式字串在編譯時報錯，確保格式字串位於韌體唯讀區
+#include "BinaryLog.h"
+#define DEBUG_LOG_WRITE(level, fmt, ...) do { \
+    if (DEBUG_LEVEL_ENABLED(level, "" fmt)) BINARY_LOG.write(level, "" fmt, ##__VA_ARGS__); \
+} while(0)
+
 #if DEBUG_LEVEL >= DEBUG_ERROR
-#define DEBUG_ERROR_PRINT(...) do { \
-    Serial.printf(__VA_ARGS__); \
-    static char buffer[DEBUG_BUFFER_SIZE]; \
-    snprintf(buffer, DEBUG_BUFFER_SIZE, __VA_ARGS__); \
-    remoteWebLog(buffer); \
+#define DEBUG_ERROR_PRINT(fmt, ...) DEBUG_LOG_WRITE(DEBUG_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define DEBUG_ERROR_PRINT(...) do {} while(0)
+#endif
+
+#if DEBUG_LEVEL >= DEBUG_WARN
+#define DEBUG_WARN_PRINT(fmt, ...) DEBUG_LOG_WRITE(DEBUG_WARN, fmt, ##__VA_ARGS__)
+#else
+#define DEBUG_WARN_PRINT(...) do {} while(0)
+#endif
+
+#if DEBUG_LEVEL >= DEBUG_INFO
+#define DEBUG_INFO_PRINT(fmt, ...) DEBUG_LOG_WRITE(DEBUG_INFO, fmt, ##__VA_ARGS__)
+#else
+#define DEBUG_INFO_PRINT(...) do {} while(0)
+#endif
+
+#if DEBUG_LEVEL >= DEBUG_VERBOSE
+#define DEBUG_VERBOSE_PRINT(fmt, ...) DEBUG_LOG_WRITE(DEBUG_VERBOSE, fmt, ##__VA_ARGS__)
+#else
+#define DEBUG_VERBOSE_PRINT(...) do {} while(0)
+#endif
+
+#else
+
+// 集中的日誌後端（src/DebugLog.cpp）：共用一個格式化緩衝，格式化一次後同時送往串口與遠端調試
+void debugLog(uint8_t level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+#if DEBUG_LEVEL >= DEBUG_ERROR
+#define DEBUG_ERROR_PRINT(fmt, ...) do { \
+    if (DEBUG_LEVEL_ENABLED(DEBUG_ERROR, fmt)) debugLog(DEBUG_ERROR, fmt, ##__VA_ARGS__); \
 } while(0)
 #else
 #define DEBUG_ERROR_PRINT(...) do {} while(0)
 #endif
 
 #if DEBUG_LEVEL >= DEBUG_WARN
-#define DEBUG_WARN_PRINT(...) do { \
-    Serial.printf(__VA_ARGS__); \
-    static char buffer[DEBUG_BUFFER_SIZE]; \
-    snprintf(buffer, DEBUG_BUFFER_SIZE, __VA_ARGS__); \
-    remoteWebLog(buffer); \
+#define DEBUG_WARN_PRINT(fmt, ...) do { \
+    if (DEBUG_LEVEL_ENABLED(DEBUG_WARN, fmt)) debugLog(DEBUG_WARN, fmt, ##__VA_ARGS__); \
 } while(0)
 #else
 #define DEBUG_WARN_PRINT(...) do {} while(0)
 #endif
 
 #if DEBUG_LEVEL >= DEBUG_INFO
-#define DEBUG_INFO_PRINT(...) do { \
-    Serial.printf(__VA_ARGS__); \
-    static char buffer[DEBUG_BUFFER_SIZE]; \
-    snprintf(buffer, DEBUG_BUFFER_SIZE, __VA_ARGS__); \
-    remoteWebLog(buffer); \
+#define DEBUG_INFO_PRINT(fmt, ...) do { \
+    if (DEBUG_LEVEL_ENABLED(DEBUG_INFO, fmt)) debugLog(DEBUG_INFO, fmt, ##__VA_ARGS__); \
 } while(0)
 #else
 #define DEBUG_INFO_PRINT(...) do {} while(0)
 #endif
 
 #if DEBUG_LEVEL >= DEBUG_VERBOSE
-#define DEBUG_VERBOSE_PRINT(...) do { \
-    Serial.printf(__VA_ARGS__); \
-    static char buffer[DEBUG_BUFFER_SIZE]; \
-    snprintf(buffer, DEBUG_BUFFER_SIZE, __VA_ARGS__); \
-    remoteWebLog(buffer); \
+#define DEBUG_VERBOSE_PRINT(fmt, ...) do { \
+    if (DEBUG_LEVEL_ENABLED(DEBUG_VERBOSE, fmt)) debugLog(DEBUG_VERBOSE, fmt, ##__VA_ARGS__); \
 } while(0)
 #else
 #define DEBUG_VERBOSE_PRINT(...) do {} while(0)
-#endif
\ No newline at end of file
+#endif
+
+#endif // BINARY_DEBUG_LOG
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include "CborWriter.h"
+#include "Debug.h"
+#include "DebugTopics.h"
+#include "JsonWriter.h"
+#include "Metrics.h"
+
+// 長度前綴的訊息環形緩衝
+// 每筆訊息在緩衝中連續存放（尾端放不下時留下繞回標記，從開頭繼續），
+// 空間不足時丟棄最舊的訊息，寫入端永不失敗。只在單一任務中使用（RemoteDebugger 的主迴圈）。
+template <size_t CAPACITY>
+class MessageRing {
+    static constexpr size_t HEADER = 2;
+    static constexpr uint16_t WRAP = 0xFFFF;
+
+public:
+    static_assert(CAPACITY >= 64 && CAPACITY < 0xFFFF, "MessageRing capacity");
+    static constexpr size_t MAX_MESSAGE = CAPACITY / 2 - HEADER;
+
+    // 寫入一筆訊息（超過 MAX_MESSAGE 的部分截斷）；回傳為騰出空間而丟棄的舊訊息數
+    uint32_t push(const char* data, size_t length) {
+        if (length > MAX_MESSAGE) length = MAX_MESSAGE;
+        size_t need = HEADER + length;
+        uint32_t evicted = 0;
+        size_t at;
+        for (;;) {
+            if (count == 0) head = tail = 0;
+            if (count == 0 || tail > head) {
+                if (CAPACITY - tail >= need) { at = tail; break; }
+                if (head >= need) {
+                    if (CAPACITY - tail >= HEADER) writeLength(tail, WRAP);
+                    at = 0;
+                    break;
+                }
+            } else if (tail < head && head - tail >= need) {
+                at = tail;
+                break;
+            }
+            pop();
+            evicted++;
+        }
+        writeLength(at, (uint16_t)length);
+        memcpy(buffer + at + HEADER, data, length);
+        tail = at + need;
+        count++;
+        payload += length;
+        return evicted;
+    }
+
+    // 最舊的訊息
+    const char* front(size_t& length) const {
+        size_t at = align(head);
+        length = readLength(at);
+        return buffer + at + HEADER;
+    }
+
+    void pop() {
+        if (count == 0) return;
+        size_t at = align(head);
+        uint16_t length = readLength(at);
+        head = at + HEADER + length;
+        payload -= length;
+        if (--count == 0) head = tail = 0;
+    }
+
+    // 由舊到新走訪：fn(const char* data, size_t length)
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        size_t position = head;
+        for (uint16_t i = 0; i < count; i++) {
+            size_t at = align(position);
+            uint16_t length = readLength(at);
+            fn(buffer + at + HEADER, (size_t)length);
+            position = at + HEADER + length;
+        }
+    }
+
+    void clear() { head = tail = payload = count = 0; }
+    bool empty() const { return count == 0; }
+    uint16_t size() const { return count; }
+    size_t bytes() const { return payload; }        // 佇列中訊息內容的總長度
+
+private:
+    char buffer[CAPACITY];
+    size_t head = 0;        // 最舊訊息（或繞回標記）的位置
+    size_t tail = 0;        // 下一筆寫入的位置
+    size_t payload = 0;
+    uint16_t count = 0;
+
+    size_t align(size_t position) const {
+        if (CAPACITY - position < HEADER || readLength(position) == WRAP) return 0;
+        return position;
+    }
+    uint16_t readLength(size_t at) const {
+        uint16_t length;
+        memcpy(&length, buffer + at, HEADER);
+        return length;
+    }
+    void writeLength(size_t at, uint16_t length) { memcpy(buffer + at, &length, HEADER); }
+};
+
+// 固定大小的 JSON 事件緩衝（JsonWriter 的 Sink）；超出容量時標記 overflow，內容不再增加
+template <size_t SIZE>
+struct EventBuffer {
+    char data[SIZE];
+    size_t length = 0;
+    bool overflow = false;
+
+    void append(const char* content, size_t n) {
+        if (length + n > SIZE) {
+            overflow = true;
+            return;
+        }
+        memcpy(data + length, content, n);
+        length += n;
+    }
+};
+
+// 遠端調試 WebSocket 的批次廣播
+// 每個客戶端訂閱一組主題（DebugTopics.h）、日誌級別下限與編碼（JSON 文字或 CBOR 二進位）。
+// publish() 先比對訂閱，沒有客戶端要的事件不呼叫 describe、不序列化；有人要時每種編碼只序列化一次，
+// 複製進每個訂閱者固定容量的佇列（連線時配置一次，之後每個事件都不配置堆積）。
+// 主迴圈呼叫 flush()：佇列累積到 BATCH_BYTES 或最舊事件等待超過 BATCH_INTERVAL_MS 時，
+// 把多個事件合併成一個 {"type":"batch","dropped":n,"events":[...]} 訊框送出（CBOR 客戶端為相同結構的二進位訊框）。
+// socket 寫不進去（慢速客戶端）時不送、不等待，事件留在佇列中；佇列滿時丟棄最舊的事件並計數，
+// 丟棄數在下一個訊框的 dropped 欄位告知客戶端。
+class DebugFanout {
+public:
+    static constexpr uint8_t MAX_CLIENTS = 4;
+    static constexpr size_t QUEUE_BYTES = 2048;                 // 每個客戶端
+    static constexpr size_t EVENT_MAX = 384;
+    static constexpr size_t FRAME_MAX = 1400;                   // 約一個 TCP 分段
+    static constexpr size_t BATCH_BYTES = 768;
+    static constexpr unsigned long BATCH_INTERVAL_MS = 100;
+    static constexpr uint8_t MAX_FRAMES_PER_TICK = 2;           // 每個客戶端每輪最多送出幾個訊框
+
+    using Queue = MessageRing<QUEUE_BYTES>;
+    using Event = EventBuffer<EVENT_MAX>;
+
+    // formatsFor() 的回傳值
+    static constexpr uint8_t FORMAT_JSON = 0x01;
+    static constexpr uint8_t FORMAT_CBOR = 0x02;
+
+    struct Stats {
+        uint32_t published;     // 至少有一個訂閱者、已序列化的事件
+        uint32_t skipped;       // 沒有訂閱者、未序列化的事件
+        uint32_t sent;          // 送出的事件（每個客戶端各算一次）
+        uint32_t dropped;       // 佇列滿（或切換編碼）時丟棄的事件
+        uint32_t frames;        // 送出的訊框
+        uint32_t deferred;      // 到期但 socket 不可寫而延後的次數
+        uint32_t bytesSent;
+    };
+
+    // 客戶端連線時配置佇列，訂閱預設主題與級別（JSON 編碼）；回傳 false 表示已滿
+    bool attach(uint8_t id, unsigned long now, uint8_t topics = DEBUG_TOPICS_DEFAULT,
+                uint8_t logLevel = DEBUG_VERBOSE) {
+        if (find(id)) return true;
+        for (Client& client : clients) {
+            if (client.queue) continue;
+            client.queue.reset(new Queue());
+            client.id = id;
+            client.topics = topics;
+            client.logLevel = logLevel;
+            client.binary = false;
+            client.oldestAt = now;
+            client.unreported = 0;
+            return true;
+        }
+        return false;
+    }
+
+    void detach(uint8_t id) {
+        Client* client = find(id);
+        if (client) client->queue.reset();
+    }
+
+    // 更新訂閱；切換編碼時佇列中舊編碼的事件無法放進新訊框，清空並計入丟棄
+    bool subscribe(uint8_t id, uint8_t topics, uint8_t logLevel, bool binary) {
+        Client* client = find(id);
+        if (!client) return false;
+        if (client->binary != binary && !client->queue->empty()) {
+            uint32_t discarded = client->queue->size();
+            client->queue->clear();
+            client->unreported += discarded;
+            stats.dropped += discarded;
+            Metrics::remoteDebugEventsDropped.inc(discarded);
+        }
+        client->topics = topics & DEBUG_TOPICS_ALL;
+        client->logLevel = logLevel;
+        client->binary = binary;
+        return true;
+    }
+
+    // 只調整日誌級別（保留主題與編碼）
+    bool setLogLevel(uint8_t id, uint8_t logLevel) {
+        Client* client = find(id);
+        if (!client) return false;
+        client->logLevel = logLevel;
+        return true;
+    }
+
+    uint8_t getClientCount() const {
+        uint8_t n = 0;
+        for (const Client& client : clients) n += client.queue ? 1 : 0;
+        return n;
+    }
+
+    // 所有客戶端訂閱主題的聯集（寫入 debugTopicMask）
+    uint8_t getTopicMask() const {
+        uint8_t mask = 0;
+        for (const Client& client : clients) {
+            if (client.queue) mask |= client.topics;
+        }
+        return mask;
+    }
+
+    // 這個事件需要哪些編碼（FORMAT_* 的組合）；0 表示沒有客戶端訂閱。level 只對 Logs 主題有意義
+    uint8_t formatsFor(DebugTopic topic, uint8_t level = DEBUG_NONE) const {
+        uint8_t formats = 0;
+        for (const Client& client : clients) {
+            if (client.queue && client.wants(topic, level)) formats |= client.binary ? FORMAT_CBOR : FORMAT_JSON;
+        }
+        return formats;
+    }
+
+    // describe(writer)：以 JsonWriter 或 CborWriter 寫出一個完整的事件物件（同一份欄位描述，見 Telemetry.h）；
+    // 只在有訂閱者時呼叫，每種編碼各一次。序列化後超過 EVENT_MAX 的事件不會送出，計入丟棄
+    template <typename Describe>
+    void publish(DebugTopic topic, uint8_t level, unsigned long now, Describe describe) {
+        uint8_t formats = formatsFor(topic, level);
+        if (!formats) {
+            stats.skipped++;
+            return;
+        }
+        stats.published++;
+        Event event;
+        if (formats & FORMAT_JSON) {
+            JsonWriter<Event> json(event);
+            describe(json);
+            enqueue(topic, level, event, false, now);
+        }
+        if (formats & FORMAT_CBOR) {
+            event.length = 0;
+            event.overflow = false;
+            CborWriter<Event> cbor(event);
+            describe(cbor);
+            enqueue(topic, level, event, true, now);
+        }
+    }
+
+    // writable(uint8_t id) -> bool：socket 是否可寫（不得阻塞）
+    // send(uint8_t id, const char* data, size_t length, bool binary)：送出一個文字或二進位訊框
+    template <typename Writable, typename Send>
+    void flush(unsigned long now, Writable writable, Send send) {
+        for (Client& client : clients) {
+            for (uint8_t n = 0; n < MAX_FRAMES_PER_TICK && client.queue && !client.queue->empty(); n++) {
+                bool due = client.queue->bytes() >= BATCH_BYTES || now - client.oldestAt >= BATCH_INTERVAL_MS;
+                if (!due) break;
+                if (!writable(client.id)) {
+                    stats.deferred++;
+                    break;
+                }
+                uint16_t events = 0;
+                size_t length = client.binary ? buildCborFrame(client, events) : buildJsonFrame(client, events);
+                send(client.id, frame.data, length, client.binary);
+                client.oldestAt = now;
+                stats.frames++;
+                stats.sent += events;
+                stats.bytesSent += length;
+                Metrics::remoteDebugEventsSent.inc(events);
+            }
+        }
+    }
+
+    Stats getStats() const { return stats; }
+
+private:
+    struct Client {
+        std::unique_ptr<Queue> queue;       // nullptr 表示空位
+        uint8_t id = 0;
+        uint8_t topics = 0;                 // debugTopicBit() 的組合
+        uint8_t logLevel = DEBUG_NONE;      // Logs 主題只收這個級別以下（含）的日誌
+        bool binary = false;                // CBOR 訊框
+        unsigned long oldestAt = 0;         // 佇列中最舊事件的時間（近似）
+        uint32_t unreported = 0;            // 尚未告知客戶端的丟棄數
+
+        bool wants(DebugTopic topic, uint8_t level) const {
+            return (topics & debugTopicBit(topic)) && (topic != DebugTopic::Logs || level <= logLevel);
+        }
+    };
+
+    Client clients[MAX_CLIENTS];
+    EventBuffer<FRAME_MAX> frame;
+    Stats stats = {};
+
+    Client* find(uint8_t id) {
+        for (Client& client : clients) {
+            if (client.queue && client.id == id) return &client;
+        }
+        return nullptr;
+    }
+
+    void enqueue(DebugTopic topic, uint8_t level, const Event& event, bool binary, unsigned long now) {
+        if (event.overflow || event.length == 0) {
+            stats.dropped++;
+            Metrics::remoteDebugEventsDropped.inc();
+            return;
+        }
+        for (Client& client : clients) {
+            if (!client.queue || client.binary != binary || !client.wants(topic, level)) continue;
+            if (client.queue->empty()) client.oldestAt = now;
+            uint32_t evicted = client.queue->push(event.data, event.length);
+            if (evicted) {
+                client.unreported += evicted;
+                stats.dropped += evicted;
+                Metrics::remoteDebugEventsDropped.inc(evicted);
+            }
+        }
+    }
+
+    // 從佇列取出放得下的事件組成一個訊框（至少一個事件），回傳訊框長度
+    size_t buildJsonFrame(Client& client, uint16_t& events) {
+        int length = snprintf(frame.data, FRAME_MAX, "{\"type\":\"batch\",\"dropped\":%u,\"events\":[",
+                              (unsigned)client.unreported);
+        client.unreported = 0;
+        size_t position = (size_t)length;
+        while (!client.queue->empty()) {
+            size_t size;
+            const char* event = client.queue->front(size);
+            if (position + (events ? 1 : 0) + size + 2 > FRAME_MAX) break;
+            if (events) frame.data[position++] = ',';
+            memcpy(frame.data + position, event, size);
+            position += size;
+            client.queue->pop();
+            events++;
+        }
+        frame.data[position++] = ']';
+        frame.data[position++] = '}';
+        return position;
+    }
+
+    // CBOR 的不定長度陣列不需要分隔符號，佇列中已編碼的事件直接接在標頭之後
+    size_t buildCborFrame(Client& client, uint16_t& events) {
+        frame.length = 0;
+        CborWriter<EventBuffer<FRAME_MAX>> cbor(frame);
+        cbor.beginObject()
+            .field("type", "batch")
+            .field("dropped", client.unreported)
+            .beginArray("events");
+        client.unreported = 0;
+        while (!client.queue->empty()) {
+            size_t size;
+            const char* event = client.queue->front(size);
+            if (frame.length + size + 2 > FRAME_MAX) break;
+            frame.append(event, size);
+            client.queue->pop();
+            events++;
+        }
+        cbor.endArray().endObject();
+        return frame.length;
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 遠端調試的訂閱主題
+// 客戶端以 {"command":"subscribe","topics":[...],"level":"warn","binary":true} 選擇要接收的事件；
+// 發布端先以 DEBUG_TOPIC_ENABLED 檢查，沒有任何客戶端訂閱的主題不組裝、不序列化。
+enum class DebugTopic : uint8_t {
+    S21Frames,          // "s21"：S21 收發的原始訊框
+    ControllerState,    // "controller"：控制器狀態變化（AccessorySync 偵測到欄位變化時）
+    HomeKitOps,         // "homekit"：HomeKit 操作
+    Logs,               // "logs"：遠端日誌與轉發的調試日誌，另依客戶端的級別過濾
+    Count
+};
+
+constexpr uint8_t debugTopicBit(DebugTopic topic) {
+    return 1u << (uint8_t)topic;
+}
+
+constexpr uint8_t DEBUG_TOPICS_ALL = (1u << (uint8_t)DebugTopic::Count) - 1;
+
+// 連線時的預設訂閱：原本會收到的事件（S21 訊框量大，需明確訂閱）
+constexpr uint8_t DEBUG_TOPICS_DEFAULT = DEBUG_TOPICS_ALL & ~debugTopicBit(DebugTopic::S21Frames);
+
+inline constexpr const char* DEBUG_TOPIC_NAMES[] = {"s21", "controller", "homekit", "logs"};
+
+inline int parseDebugTopic(const char* name) {
+    for (uint8_t i = 0; i < (uint8_t)DebugTopic::Count; i++) {
+        if (strcmp(name, DEBUG_TOPIC_NAMES[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// 所有客戶端訂閱的聯集（RemoteDebugger 在連線、斷線與訂閱改變時更新）
+extern std::atomic<uint8_t> debugTopicMask;
+
+#define DEBUG_TOPIC_ENABLED(topic) \
+    (debugTopicMask.load(std::memory_order_relaxed) & debugTopicBit(topic))
+
+// 發布到遠端調試（src/RemoteDebugger.cpp），只在主迴圈任務中呼叫，呼叫前先以 DEBUG_TOPIC_ENABLED 檢查
+void debugPublishS21Frame(bool transmit, const uint8_t* frame, size_t length);
+void debugPublishControllerState(bool power, uint8_t targetMode, float targetTemperature,
+                                 float currentTemperature, uint8_t fanSpeed);
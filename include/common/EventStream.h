@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <memory>
+#include "../controller/IThermostatControl.h"
+#include "../device/AccessorySync.h"
+#include "Debug.h"
+
+class ThermostatController;
+
+// Server-Sent Events 即時狀態推送（/api/events）
+// 連線建立時送一次完整快照，之後只在欄位變化時推送差異。
+// 每個客戶端有固定深度的佇列，寫不出去時丟棄最舊的事件並在佇列清空後補送快照，
+// 因此慢速客戶端不會阻塞主迴圈，也不會無限累積記憶體。
+// 寫入前以零逾時 select() 確認 socket 可寫，主迴圈不會卡在 TCP 送出緩衝區。
+class EventStream {
+public:
+    static constexpr uint8_t MAX_CLIENTS = 3;
+    static constexpr uint8_t QUEUE_DEPTH = 6;
+    static constexpr size_t EVENT_MAX = 256;
+    static constexpr uint8_t MAX_WRITES_PER_TICK = 2;          // 每個客戶端每輪最多送出幾個事件
+    static constexpr unsigned long SAMPLE_INTERVAL_MS = 500;
+    static constexpr unsigned long HEARTBEAT_INTERVAL_MS = 15000;
+    static constexpr unsigned long HEALTH_INTERVAL_MS = 30000;  // 記憶體等數值的最長回報間隔
+    static constexpr uint32_t HEAP_DELTA = 2048;                // 記憶體變化超過此值立即回報
+
+    struct Stats {
+        uint32_t accepted;          // 接受的連線
+        uint32_t rejected;          // 客戶端已滿被拒絕的連線
+        uint32_t published;         // 產生的差異事件
+        uint32_t sent;              // 實際寫出的事件（含快照）
+        uint32_t dropped;           // 佇列滿時丟棄的事件
+        uint32_t resyncs;           // 丟棄後補送的快照
+        uint32_t bytesSent;
+    };
+
+    static EventStream& getInstance();
+
+    // health 可為 nullptr（模擬模式沒有協議健康資訊）
+    void begin(IThermostatControl* ctrl, ThermostatController* health);
+
+    // 在 WebServer 處理器中呼叫：接管連線並送出 SSE 標頭，回傳 false 表示已滿
+    bool accept(WiFiClient& client);
+
+    // 主迴圈呼叫：取樣、產生差異事件並送出佇列
+    void tick(unsigned long currentTime);
+
+    uint8_t getClientCount() const;
+    Stats getStats() const { return stats; }
+
+private:
+    struct Sample {
+        AccessorySnapshot state;
+        uint32_t freeHeap;
+        uint32_t errors;
+        bool healthy;
+    };
+
+    struct Event {
+        uint16_t length;
+        char data[EVENT_MAX];
+    };
+
+    struct Client {
+        WiFiClient connection;
+        std::unique_ptr<Event[]> queue;
+        uint8_t head;
+        uint8_t count;
+        bool resync;
+        unsigned long lastWrite;
+    };
+
+    IThermostatControl* controller;
+    ThermostatController* healthSource;
+    Client clients[MAX_CLIENTS];
+    Sample published;           // 最近一次推送給客戶端的狀態
+    bool hasPublished;
+    uint32_t nextEventId;
+    unsigned long lastSampleTime;
+    unsigned long lastHealthTime;
+    Stats stats;
+
+    EventStream() : controller(nullptr), healthSource(nullptr), published{}, hasPublished(false),
+                    nextEventId(1), lastSampleTime(0), lastHealthTime(0), stats{} {}
+
+    Sample takeSample() const;
+    int formatSnapshot(char* buffer, size_t size, const Sample& sample);
+    int formatDelta(char* buffer, size_t size, const Sample& sample, unsigned long currentTime);
+    void enqueue(Client& client, const char* data, int length);
+    void enqueueSnapshot(Client& client, const Sample& sample);
+    void drain(Client& client, unsigned long currentTime);
+    bool isWritable(WiFiClient& connection) const;
+    void release(Client& client);
+};
+
+#define EVENT_STREAM EventStream::getInstance()
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 扁平 JSON 物件的欄位查詢（/api/control、/api/debug/levels 的請求本體）
+// 只接受單一頂層物件；字串支援跳脫字元（含 \uXXXX，解碼為 UTF-8），巢狀物件與陣列的內容略過，
+// 不會匹配到其中的同名鍵。每次查詢都掃描整個本體，不配置記憶體。
+
+namespace FlatJson {
+
+namespace detail {
+
+struct Scanner {
+    const char* p;
+
+    void skipSpace() {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    }
+
+    static int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool readHex4(uint32_t& code) {
+        code = 0;
+        for (int i = 0; i < 4; i++) {
+            int d = hexDigit(p[i]);
+            if (d < 0) return false;
+            code = code << 4 | d;
+        }
+        p += 4;
+        return true;
+    }
+
+    // 讀取字串（p 指向開頭的引號）；out 為 nullptr 時只驗證。
+    // 解碼後長度存入 length；超過 size - 1 時不再寫入但仍繼續驗證
+    bool readString(char* out, size_t size, size_t& length) {
+        length = 0;
+        if (*p++ != '"') return false;
+        while (true) {
+            unsigned char c = *p++;
+            if (c == '"') break;
+            if (c < 0x20) return false;         // 含字串結尾的 '\0'
+            char decoded[4];
+            size_t n = 1;
+            decoded[0] = c;
+            if (c == '\\') {
+                char e = *p++;
+                switch (e) {
+                    case '"': case '\\': case '/': decoded[0] = e; break;
+                    case 'b': decoded[0] = '\b'; break;
+                    case 'f': decoded[0] = '\f'; break;
+                    case 'n': decoded[0] = '\n'; break;
+                    case 'r': decoded[0] = '\r'; break;
+                    case 't': decoded[0] = '\t'; break;
+                    case 'u': {
+                        uint32_t code;
+                        if (!readHex4(code)) return false;
+                        if (code >= 0xDC00 && code <= 0xDFFF) return false;
+                        if (code >= 0xD800 && code <= 0xDBFF) {
+                            uint32_t low;
+                            if (p[0] != '\\' || p[1] != 'u') return false;
+                            p += 2;
+                            if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF) return false;
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        if (code == 0) return false;    // 不接受內嵌的 NUL
+                        n = encodeUtf8(code, decoded);
+                        break;
+                    }
+                    default: return false;
+                }
+            }
+            if (out && length + n < size) memcpy(out + length, decoded, n);
+            length += n;
+        }
+        if (out && length < size) out[length] = '\0';
+        return true;
+    }
+
+    static size_t encodeUtf8(uint32_t code, char* out) {
+        if (code < 0x80) { out[0] = code; return 1; }
+        if (code < 0x800) {
+            out[0] = 0xC0 | code >> 6;
+            out[1] = 0x80 | (code & 0x3F);
+            return 2;
+        }
+        if (code < 0x10000) {
+            out[0] = 0xE0 | code >> 12;
+            out[1] = 0x80 | (code >> 6 & 0x3F);
+            out[2] = 0x80 | (code & 0x3F);
+            return 3;
+        }
+        out[0] = 0xF0 | code >> 18;
+        out[1] = 0x80 | (code >> 12 & 0x3F);
+        out[2] = 0x80 | (code >> 6 & 0x3F);
+        out[3] = 0x80 | (code & 0x3F);
+        return 4;
+    }
+
+    // 數字（RFC 8259 語法）或 true / false / null；回傳原文長度，0 = 無效
+    size_t readLiteral() {
+        const char* start = p;
+        static const char* const WORDS[] = {"true", "false", "null"};
+        for (const char* word : WORDS) {
+            size_t n = strlen(word);
+            if (strncmp(p, word, n) == 0) {
+                p += n;
+                return n;
+            }
+        }
+        if (*p == '-') p++;
+        if (*p == '0') p++;
+        else if (*p >= '1' && *p <= '9') while (isdigit((unsigned char)*p)) p++;
+        else return 0;
+        if (*p == '.') {
+            p++;
+            if (!isdigit((unsigned char)*p)) return 0;
+            while (isdigit((unsigned char)*p)) p++;
+        }
+        if (*p == 'e' || *p == 'E') {
+            p++;
+            if (*p == '+' || *p == '-') p++;
+            if (!isdigit((unsigned char)*p)) return 0;
+            while (isdigit((unsigned char)*p)) p++;
+        }
+        return p - start;
+    }
+
+    // 略過任意值（含巢狀物件與陣列）
+    bool skipValue(int depth = 0) {
+        if (depth > 8) return false;
+        skipSpace();
+        size_t length;
+        if (*p == '"') return readString(nullptr, 0, length);
+        if (*p != '{' && *p != '[') return readLiteral() > 0;
+        char close = *p++ == '{' ? '}' : ']';
+        skipSpace();
+        if (*p == close) {
+            p++;
+            return true;
+        }
+        while (true) {
+            if (close == '}') {
+                skipSpace();
+                if (!readString(nullptr, 0, length)) return false;
+                skipSpace();
+                if (*p++ != ':') return false;
+            }
+            if (!skipValue(depth + 1)) return false;
+            skipSpace();
+            if (*p == close) {
+                p++;
+                return true;
+            }
+            if (*p++ != ',') return false;
+        }
+    }
+};
+
+} // namespace detail
+
+// 查詢頂層欄位 name（nullptr = 只驗證本體）。字串值去掉引號並解碼，其他純量值保留原文。
+// 回傳 1 = 取得欄位值，0 = 本體有效但沒有此欄位，
+// -1 = 本體不是有效的 JSON 物件，或此欄位重複、不是純量、放不進 value（size - 1 個位元組）
+inline int getField(const char* json, const char* name, char* value, size_t size) {
+    detail::Scanner s{json};
+    bool found = false;
+    bool invalid = false;
+    s.skipSpace();
+    if (*s.p++ != '{') return -1;
+    s.skipSpace();
+    if (*s.p == '}') {
+        s.p++;
+    } else {
+        char key[24];
+        while (true) {
+            s.skipSpace();
+            size_t keyLength;
+            if (!s.readString(key, sizeof(key), keyLength)) return -1;
+            bool match = name && keyLength < sizeof(key) && strcmp(key, name) == 0;
+            s.skipSpace();
+            if (*s.p++ != ':') return -1;
+            s.skipSpace();
+            if (!match) {
+                if (!s.skipValue()) return -1;
+            } else if (found) {
+                invalid = true;                 // 重複的鍵：無法判斷以哪個為準
+                if (!s.skipValue()) return -1;
+            } else if (*s.p == '"') {
+                size_t length;
+                if (!s.readString(value, size, length)) return -1;
+                found = true;
+                if (length >= size) invalid = true;
+            } else if (*s.p == '{' || *s.p == '[') {
+                if (!s.skipValue()) return -1;
+                found = true;
+                invalid = true;
+            } else {
+                const char* start = s.p;
+                size_t length = s.readLiteral();
+                if (length == 0) return -1;
+                found = true;
+                if (length >= size) invalid = true;
+                else {
+                    memcpy(value, start, length);
+                    value[length] = '\0';
+                }
+            }
+            s.skipSpace();
+            if (*s.p == '}') {
+                s.p++;
+                break;
+            }
+            if (*s.p++ != ',') return -1;
+        }
+    }
+    s.skipSpace();
+    if (*s.p != '\0') return -1;                // 物件之後不能有其他內容
+    if (invalid) return -1;
+    return found ? 1 : 0;
+}
+
+inline bool isValidObject(const char* json) {
+    return getField(json, nullptr, nullptr, 0) == 0;
+}
+
+} // namespace FlatJson
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+#include <type_traits>
+
+// 串流式 JSON 寫入器
+// 直接把輸出寫進 Sink（需提供 append(const char*, size_t)），不建立文件樹、不配置堆積，
+// 也沒有總長度上限；字串值一律正確轉義。逗號由寫入器依巢狀層級自動補上。
+//
+//   JsonWriter<StreamingResponse> json(stream);
+//   json.beginObject().field("freeHeap", ESP.getFreeHeap())
+//       .beginArray("items").value(1).value(2).endArray()
+//       .endObject();
+template <typename Sink>
+class JsonWriter {
+public:
+    static constexpr uint8_t MAX_DEPTH = 31;
+
+    explicit JsonWriter(Sink& sink) : sink(sink), depth(0), hasItems(0), afterKey(false) {}
+
+    JsonWriter& beginObject() { separate(); put('{'); push(); return *this; }
+    JsonWriter& beginObject(const char* name) { key(name); return beginObject(); }
+    JsonWriter& endObject() { pop(); put('}'); return *this; }
+
+    JsonWriter& beginArray() { separate(); put('['); push(); return *this; }
+    JsonWriter& beginArray(const char* name) { key(name); return beginArray(); }
+    JsonWriter& endArray() { pop(); put(']'); return *this; }
+
+    JsonWriter& key(const char* name) {
+        separate();
+        writeString(name);
+        put(':');
+        afterKey = true;
+        return *this;
+    }
+
+    JsonWriter& value(bool v) {
+        separate();
+        if (v) sink.append("true", 4);
+        else sink.append("false", 5);
+        return *this;
+    }
+
+    // 所有整數型別（不含 bool），手寫轉換避免 printf 格式與寬度問題
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, JsonWriter&>::type
+    value(T v) {
+        separate();
+        char buffer[21];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        bool negative = std::is_signed<T>::value && v < 0;
+        unsigned long long magnitude = negative ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+        do {
+            *--p = '0' + (magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (negative) *--p = '-';
+        sink.append(p, end - p);
+        return *this;
+    }
+
+    // 浮點數以固定小數位輸出；NaN/Inf 在 JSON 中不合法，輸出 null
+    JsonWriter& value(double v, uint8_t decimals = 1) {
+        separate();
+        if (isnan(v) || isinf(v)) {
+            sink.append("null", 4);
+            return *this;
+        }
+        char buffer[32];
+        int n = snprintf(buffer, sizeof(buffer), "%.*f", decimals, v);
+        if (n > 0) sink.append(buffer, (size_t)n < sizeof(buffer) ? n : sizeof(buffer) - 1);
+        return *this;
+    }
+    JsonWriter& value(float v, uint8_t decimals = 1) { return value((double)v, decimals); }
+
+    JsonWriter& value(const char* v) {
+        separate();
+        if (v) writeString(v);
+        else sink.append("null", 4);
+        return *this;
+    }
+    JsonWriter& value(const String& v) { return value(v.c_str()); }
+    JsonWriter& value(std::nullptr_t) { separate(); sink.append("null", 4); return *this; }
+
+    template <typename T>
+    JsonWriter& field(const char* name, const T& v) { key(name); return value(v); }
+    JsonWriter& field(const char* name, const char* v) { key(name); return value(v); }
+    JsonWriter& field(const char* name, float v, uint8_t decimals) { key(name); return value(v, decimals); }
+    JsonWriter& field(const char* name, double v, uint8_t decimals) { key(name); return value(v, decimals); }
+
+private:
+    Sink& sink;
+    uint8_t depth;
+    uint32_t hasItems;      // 每層一個位元：該層是否已有元素（決定是否補逗號）
+    bool afterKey;
+
+    void put(char c) { sink.append(&c, 1); }
+
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        uint32_t bit = 1UL << depth;
+        if (hasItems & bit) put(',');
+        hasItems |= bit;
+    }
+
+    void push() {
+        if (depth < MAX_DEPTH) depth++;
+        hasItems &= ~(1UL << depth);
+    }
+
+    void pop() {
+        if (depth > 0) depth--;
+    }
+
+    // 連續的安全字元整段寫出，只有需要轉義的字元才逐一處理
+    void writeString(const char* s) {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        put('"');
+        const char* run = s;
+        for (const char* p = s; *p; p++) {
+            unsigned char c = (unsigned char)*p;
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            if (p > run) sink.append(run, p - run);
+            run = p + 1;
+            switch (c) {
+                case '"':  sink.append("\\\"", 2); break;
+                case '\\': sink.append("\\\\", 2); break;
+                case '\n': sink.append("\\n", 2); break;
+                case '\r': sink.append("\\r", 2); break;
+                case '\t': sink.append("\\t", 2); break;
+                case '\b': sink.append("\\b", 2); break;
+                case '\f': sink.append("\\f", 2); break;
+                default: {
+                    char escaped[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+                    sink.append(escaped, sizeof(escaped));
+                }
+            }
+        }
+        const char* end = run + strlen(run);
+        if (end > run) sink.append(run, end - run);
+        put('"');
+    }
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 調試日誌的非同步輸出佇列（src/DebugLog.cpp 寫入）
+// 呼叫端只把格式化好的文字複製進環形槽位就返回，不碰串口：
+//   - 串口由低優先級任務以 drain() 排空，UART/USB-CDC 寫入阻塞只發生在該任務；
+//   - 遠端調試由主迴圈以 forEachMessage() 依游標讀取（WebSocket 不能跨任務操作）。
+// 佇列滿時丟棄整筆訊息並計數，呼叫端永不等待。
+// 長訊息佔用連續多個槽位：生產者以 CAS 一次保留所需的槽位數，多個任務同時寫入也不會交錯。
+class LogDrain {
+public:
+    static constexpr size_t SLOT_COUNT = 64;            // 必須是 2 的冪
+    static constexpr size_t SLOT_PAYLOAD = 57;          // 每個槽位 64 bytes
+    static constexpr size_t MAX_MESSAGE_SIZE = 256;
+
+    static LogDrain& getInstance() {
+        static LogDrain instance;
+        return instance;
+    }
+
+    // 寫入一筆訊息（level 為 DEBUG_* 級別，供遠端調試依訂閱過濾）；佇列空間不足時丟棄並回傳 false
+    bool push(const char* text, size_t length, uint8_t level = 0) {
+        if (length == 0) return true;
+        if (length > MAX_MESSAGE_SIZE - 1) length = MAX_MESSAGE_SIZE - 1;
+        uint32_t slots = (uint32_t)((length + SLOT_PAYLOAD - 1) / SLOT_PAYLOAD);
+
+        uint32_t start = head.load(std::memory_order_relaxed);
+        do {
+            if (start + slots - tail.load(std::memory_order_acquire) > SLOT_COUNT) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!head.compare_exchange_weak(start, start + slots, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        for (uint32_t i = 0; i < slots; i++) {
+            Slot& slot = ring[(start + i) & (SLOT_COUNT - 1)];
+            size_t n = length > SLOT_PAYLOAD ? SLOT_PAYLOAD : length;
+            slot.seq.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.length = (uint8_t)n;
+            slot.level = level;
+            slot.last = i + 1 == slots;
+            memcpy(slot.data, text, n);
+            slot.seq.store(start + i + 1, std::memory_order_release);
+            text += n;
+            length -= n;
+        }
+        queued.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 串口排空（單一消費者）：依序把已發布的槽位交給 write(const char*, size_t)，
+    // 寫完才釋放槽位；遇到尚未發布的槽位即停止。回傳處理的槽位數
+    template <typename Write>
+    size_t drain(Write write, size_t maxSlots = SLOT_COUNT) {
+        uint32_t position = tail.load(std::memory_order_relaxed);
+        size_t n = 0;
+        while (n < maxSlots) {
+            Slot& slot = ring[position & (SLOT_COUNT - 1)];
+            if (slot.seq.load(std::memory_order_acquire) != position + 1) break;
+            write(slot.data, slot.length);
+            position++;
+            n++;
+            tail.store(position, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // 依游標讀取完整訊息（可與 drain() 及生產者同時進行）：
+    // 每個槽位先複製再確認序號未變；游標落後到已被覆蓋時跳到下一筆完整訊息開頭。
+    // fn(const char* text, size_t length, uint8_t level) 收到以 '\0' 結尾的訊息。回傳新的游標
+    template <typename Fn>
+    uint32_t forEachMessage(uint32_t cursor, size_t maxMessages, Fn fn) {
+        char message[MAX_MESSAGE_SIZE];
+        size_t length = 0;
+        bool skipping = false;
+        uint32_t messageStart = cursor;
+        uint32_t end = head.load(std::memory_order_acquire);
+        if (end - cursor > SLOT_COUNT) {
+            cursor = end - SLOT_COUNT;
+            skipping = true;
+        }
+
+        while (maxMessages > 0 && cursor != end) {
+            Slot& slot = ring[cursor & (SLOT_COUNT - 1)];
+            uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            uint8_t chunk = slot.length;
+            uint8_t level = slot.level;
+            bool last = slot.last;
+            if (chunk > SLOT_PAYLOAD) chunk = SLOT_PAYLOAD;
+            if (!skipping) memcpy(message + length, slot.data, chunk);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq != cursor + 1 || slot.seq.load(std::memory_order_relaxed) != seq) {
+                if (seq == 0 || (int32_t)(seq - (cursor + 1)) < 0) break;  // 尚未發布，下次再讀
+                // 已被新訊息覆蓋：丟棄未完成的訊息，重新對齊
+                cursor = head.load(std::memory_order_acquire) - SLOT_COUNT;
+                end = head.load(std::memory_order_acquire);
+                messageStart = cursor;
+                length = 0;
+                skipping = true;
+                continue;
+            }
+            cursor++;
+            if (skipping) {
+                if (last) {
+                    skipping = false;
+                    messageStart = cursor;
+                }
+                continue;
+            }
+            length += chunk;
+            if (last) {
+                message[length] = '\0';
+                fn(message, length, level);
+                length = 0;
+                messageStart = cursor;
+                maxMessages--;
+            }
+        }
+        return messageStart;
+    }
+
+    uint32_t getHead() const { return head.load(std::memory_order_acquire); }
+    uint32_t getQueued() const { return queued.load(std::memory_order_relaxed); }
+    uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{0};   // 已發布時為槽位位置 + 1；0 表示寫入中
+        uint8_t length = 0;
+        uint8_t level = 0;
+        bool last = false;              // 訊息的最後一個槽位
+        char data[SLOT_PAYLOAD];
+    };
+
+    Slot ring[SLOT_COUNT];
+    std::atomic<uint32_t> head{0};      // 下一個保留的位置
+    std::atomic<uint32_t> tail{0};      // 串口尚未寫出的最舊位置
+    std::atomic<uint32_t> queued{0};
+    std::atomic<uint32_t> dropped{0};
+
+    LogDrain() {}
+};
+
+#define LOG_DRAIN LogDrain::getInstance()
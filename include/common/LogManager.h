@@ -1,9 +1,11 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include "Debug.h"
+#include "JsonWriter.h"
 
 // 日誌級別定義
 enum class LogLevel {
@@ -15,31 +17,54 @@ enum class LogLevel {
     CRITICAL = 5
 };
 
-// 日誌條目結構
+// 日誌環形緩衝：固定筆數、固定大小的記錄，訊息直接存在記錄內，元件名稱轉成編號
+static constexpr size_t LOG_CAPACITY = 32;              // 必須為 2 的次方
+static constexpr size_t LOG_MESSAGE_SIZE = 116;         // 含結尾 NUL，整筆記錄 128 bytes
+static constexpr size_t LOG_MAX_COMPONENTS = 16;
+static constexpr size_t LOG_COMPONENT_SIZE = 16;
+
+// 讀取端看到的日誌條目（從環形緩衝複製出的一筆快照，元件名稱指向轉換表）
 struct LogEntry {
+    uint32_t seq;               // 單調遞增序號，客戶端以此為游標增量取得新日誌
     unsigned long timestamp;
     LogLevel level;
-    String component;
-    String message;
-    
-    LogEntry(LogLevel lvl, const String& comp, const String& msg) :
-        timestamp(millis()),
-        level(lvl),
-        component(comp),
-        message(msg) {}
+    const char* component;
+    uint16_t length;
+    char message[LOG_MESSAGE_SIZE];
 };
 
 class LogManager {
 private:
+    // 環形緩衝中的一筆記錄；seq 同時是發布旗標：0 為空，帶 WRITING 位元表示寫入中
+    struct LogRecord {
+        std::atomic<uint32_t> seq{0};
+        uint32_t timestamp = 0;
+        uint8_t level = 0;
+        uint8_t component = 0;
+        uint16_t length = 0;
+        char message[LOG_MESSAGE_SIZE];
+    };
+
+    static constexpr uint32_t WRITING = 0x80000000UL;
+    static constexpr uint8_t UNKNOWN_COMPONENT = 0xFF;   // 轉換表已滿
+
     static LogManager* instance;
-    std::vector<LogEntry> logBuffer;
-    std::mutex logMutex;
-    size_t maxLogEntries;
+    LogRecord records[LOG_CAPACITY];
+    std::atomic<uint32_t> head;         // 下一個要分配的序號
+    std::atomic<uint32_t> floor;        // clearLogs() 之後，小於此序號的記錄不再輸出
+
+    // 元件名稱轉換表：只增不減，發布後內容不再改變，查找不需加鎖
+    char componentNames[LOG_MAX_COMPONENTS][LOG_COMPONENT_SIZE];
+    std::atomic<uint8_t> componentCount;
+    std::mutex componentMutex;          // 只在新增元件時使用
+
     LogLevel currentLogLevel;
     bool enableSerial;
     bool enableWebLog;
     
 public:
+    static constexpr size_t MAX_RESPONSE_ENTRIES = 100;   // 單次回應最多輸出的條目
+
     // 日誌級別字符串 (移到 public)
     const char* getLevelString(LogLevel level) {
         switch (level) {
@@ -69,13 +94,68 @@ private:
     }
     
     LogManager() :
-        maxLogEntries(30),
+        head(1),
+        floor(1),
+        componentCount(0),
         currentLogLevel(LogLevel::INFO),
         enableSerial(true),
-        enableWebLog(true) {
-        logBuffer.reserve(maxLogEntries);
+        enableWebLog(true) {}
+
+    static const char* cstr(const char* s) { return s ? s : ""; }
+    static const char* cstr(const String& s) { return s.c_str(); }
+
+    // 截斷後不留下不完整的 UTF-8 字元（中文訊息常見）
+    static size_t utf8Length(const char* s, size_t length) {
+        if (length < LOG_MESSAGE_SIZE) return length;
+        length = LOG_MESSAGE_SIZE - 1;
+        size_t cut = length;
+        while (cut > 0 && ((uint8_t)s[cut] & 0xC0) == 0x80) cut--;
+        return cut;
     }
-    
+
+    uint8_t internComponent(const char* name) {
+        uint8_t count = componentCount.load(std::memory_order_acquire);
+        for (uint8_t i = 0; i < count; i++) {
+            if (strncmp(componentNames[i], name, LOG_COMPONENT_SIZE - 1) == 0) return i;
+        }
+        std::lock_guard<std::mutex> lock(componentMutex);
+        count = componentCount.load(std::memory_order_relaxed);
+        for (uint8_t i = 0; i < count; i++) {
+            if (strncmp(componentNames[i], name, LOG_COMPONENT_SIZE - 1) == 0) return i;
+        }
+        if (count >= LOG_MAX_COMPONENTS) return UNKNOWN_COMPONENT;
+        strncpy(componentNames[count], name, LOG_COMPONENT_SIZE - 1);
+        componentNames[count][LOG_COMPONENT_SIZE - 1] = '\0';
+        componentCount.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    const char* componentName(uint8_t id) const {
+        return id < componentCount.load(std::memory_order_acquire) ? componentNames[id] : "other";
+    }
+
+    // 多生產者保留：fetch_add 取得序號即擁有對應槽位，先標記寫入中再填內容
+    LogRecord& reserve(uint32_t& seq, LogLevel level, uint8_t component) {
+        seq = head.fetch_add(1, std::memory_order_relaxed);
+        LogRecord& record = records[seq & (LOG_CAPACITY - 1)];
+        record.seq.store(seq | WRITING, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        record.timestamp = millis();
+        record.level = (uint8_t)level;
+        record.component = component;
+        return record;
+    }
+
+    // 發布：只有槽位仍是自己的寫入中標記才發布（繞了一圈的較新寫入者優先）
+    void commit(LogRecord& record, uint32_t seq) {
+        uint32_t expected = seq | WRITING;
+        record.seq.compare_exchange_strong(expected, seq, std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    void printSerial(LogLevel level, const char* component, const char* message) {
+        Serial.printf("[%lu][%s][%s] %s\n", millis(), getLevelString(level), component, message);
+    }
+
 public:
     // 單例模式
     static LogManager& getInstance() {
@@ -85,101 +165,139 @@ public:
         return *instance;
     }
     
-    // 配置日誌系統
-    void configure(LogLevel level = LogLevel::INFO, size_t maxEntries = 50, 
-                   bool serial = true, bool web = true) {
-        std::lock_guard<std::mutex> lock(logMutex);
+    // 配置日誌系統（緩衝筆數固定為 LOG_CAPACITY）
+    void configure(LogLevel level = LogLevel::INFO, bool serial = true, bool web = true) {
         currentLogLevel = level;
-        maxLogEntries = maxEntries;
         enableSerial = serial;
         enableWebLog = web;
-        
-        // 調整緩衝區大小
-        if (logBuffer.capacity() != maxLogEntries) {
-            logBuffer.clear();
-            logBuffer.reserve(maxLogEntries);
-        }
     }
     
-    // 記錄日誌
-    void log(LogLevel level, const String& component, const String& message) {
+    // 記錄日誌：不配置堆積、不加鎖（僅第一次出現的元件名稱需要登記）
+    void log(LogLevel level, const char* component, const char* message) {
         // 檢查日誌級別
         if (level < currentLogLevel) {
             return;
         }
-        
-        // 創建日誌條目
-        LogEntry entry(level, component, message);
+        component = cstr(component);
+        message = cstr(message);
         
         // 輸出到串口
         if (enableSerial) {
-            Serial.printf("[%lu][%s][%s] %s\n", 
-                         entry.timestamp, 
-                         getLevelString(level), 
-                         component.c_str(), 
-                         message.c_str());
+            printSerial(level, component, message);
         }
         
-        // 添加到緩衝區
+        // 寫入環形緩衝，最舊的記錄直接被覆蓋
         if (enableWebLog) {
-            std::lock_guard<std::mutex> lock(logMutex);
-            
-            // 如果緩衝區滿了，移除最舊的條目
-            if (logBuffer.size() >= maxLogEntries) {
-                logBuffer.erase(logBuffer.begin());
-            }
-            
-            logBuffer.push_back(entry);
+            uint32_t seq;
+            LogRecord& record = reserve(seq, level, internComponent(component));
+            size_t length = utf8Length(message, strlen(message));
+            memcpy(record.message, message, length);
+            record.message[length] = '\0';
+            record.length = length;
+            commit(record, seq);
         }
     }
+
+    void log(LogLevel level, const String& component, const String& message) {
+        log(level, component.c_str(), message.c_str());
+    }
     
-    // 便捷的日誌記錄方法
-    void verbose(const String& component, const String& message) {
-        log(LogLevel::VERBOSE, component, message);
+    // 便捷的日誌記錄方法（接受 const char* 或 String）
+    template <typename C, typename M>
+    void verbose(const C& component, const M& message) {
+        log(LogLevel::VERBOSE, cstr(component), cstr(message));
     }
     
-    void debug(const String& component, const String& message) {
-        log(LogLevel::DEBUG, component, message);
+    template <typename C, typename M>
+    void debug(const C& component, const M& message) {
+        log(LogLevel::DEBUG, cstr(component), cstr(message));
     }
     
-    void info(const String& component, const String& message) {
-        log(LogLevel::INFO, component, message);
+    template <typename C, typename M>
+    void info(const C& component, const M& message) {
+        log(LogLevel::INFO, cstr(component), cstr(message));
     }
     
-    void warning(const String& component, const String& message) {
-        log(LogLevel::WARNING, component, message);
+    template <typename C, typename M>
+    void warning(const C& component, const M& message) {
+        log(LogLevel::WARNING, cstr(component), cstr(message));
     }
     
-    void error(const String& component, const String& message) {
-        log(LogLevel::ERROR, component, message);
+    template <typename C, typename M>
+    void error(const C& component, const M& message) {
+        log(LogLevel::ERROR, cstr(component), cstr(message));
     }
     
-    void critical(const String& component, const String& message) {
-        log(LogLevel::CRITICAL, component, message);
+    template <typename C, typename M>
+    void critical(const C& component, const M& message) {
+        log(LogLevel::CRITICAL, cstr(component), cstr(message));
     }
     
-    // 格式化日誌記錄
-    void logf(LogLevel level, const String& component, const char* format, ...) {
+    // 格式化日誌記錄：直接格式化到保留的記錄中
+    template <typename C>
+    __attribute__((format(printf, 4, 5)))
+    void logf(LogLevel level, const C& component, const char* format, ...) {
+        if (level < currentLogLevel || (!enableWebLog && !enableSerial)) {
+            return;
+        }
+        const char* name = cstr(component);
         va_list args;
         va_start(args, format);
-        
-        char buffer[512];
-        vsnprintf(buffer, sizeof(buffer), format, args);
+        if (enableWebLog) {
+            uint32_t seq;
+            LogRecord& record = reserve(seq, level, internComponent(name));
+            int n = vsnprintf(record.message, LOG_MESSAGE_SIZE, format, args);
+            size_t length = n > 0 ? utf8Length(record.message, n) : 0;
+            record.message[length] = '\0';
+            record.length = length;
+            if (enableSerial) printSerial(level, name, record.message);
+            commit(record, seq);
+        } else {
+            char message[LOG_MESSAGE_SIZE];
+            vsnprintf(message, sizeof(message), format, args);
+            printSerial(level, name, message);
+        }
         va_end(args);
-        
-        log(level, component, String(buffer));
     }
     
-    // 獲取日誌條目
-    std::vector<LogEntry> getLogs() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        return logBuffer;
+    // 依序號走訪日誌，不複製整個緩衝：每筆記錄複製成堆疊上的快照並確認未被覆寫後才交給 fn
+    // since = 0 時從最新的 limit 筆開始；否則從序號大於 since 的最舊條目開始。
+    // 遇到尚在寫入中的記錄即停止（下次再從該處接續），已被覆寫的記錄略過。
+    // 回傳已處理到的序號，作為下一次的 since
+    template <typename Fn>
+    uint32_t forEach(uint32_t since, size_t limit, Fn fn) {
+        uint32_t end = head.load(std::memory_order_acquire);
+        uint32_t first = getFirstSeq();
+        if (since >= end) since = first - 1;     // 游標超前（設備已重啟），從頭開始
+        uint32_t seq = since == 0 ? (end - first > limit ? end - (uint32_t)limit : first)
+                                  : std::max(since + 1, first);
+        if (end - seq > limit) end = seq + (uint32_t)limit;
+
+        LogEntry entry;
+        for (; seq < end; seq++) {
+            LogRecord& record = records[seq & (LOG_CAPACITY - 1)];
+            uint32_t published = record.seq.load(std::memory_order_acquire);
+            if (published != seq) {
+                if ((published & ~WRITING) > seq) continue;   // 已被較新的記錄覆寫
+                break;                                        // 尚未發布
+            }
+            entry.seq = seq;
+            entry.timestamp = record.timestamp;
+            entry.level = (LogLevel)record.level;
+            entry.component = componentName(record.component);
+            entry.length = std::min<uint16_t>(record.length, LOG_MESSAGE_SIZE - 1);
+            memcpy(entry.message, record.message, entry.length);
+            entry.message[entry.length] = '\0';
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (record.seq.load(std::memory_order_relaxed) != seq) continue;   // 複製期間被覆寫
+            fn(entry);
+        }
+        return seq > 0 ? seq - 1 : 0;
     }
     
-    // 清除日誌
+    // 清除日誌（只移動下限，不觸碰正在寫入的記錄）
     void clearLogs() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        logBuffer.clear();
+        floor.store(head.load(std::memory_order_acquire), std::memory_order_release);
     }
     
     // 獲取日誌統計
@@ -194,11 +312,9 @@ public:
     };
     
     LogStats getStats() {
-        std::lock_guard<std::mutex> lock(logMutex);
         LogStats stats = {0};
-        stats.totalEntries = logBuffer.size();
-        
-        for (const auto& entry : logBuffer) {
+        forEach(0, LOG_CAPACITY, [&stats](const LogEntry& entry) {
+            stats.totalEntries++;
             switch (entry.level) {
                 case LogLevel::VERBOSE: stats.verboseCount++; break;
                 case LogLevel::DEBUG: stats.debugCount++; break;
@@ -207,116 +323,77 @@ public:
                 case LogLevel::ERROR: stats.errorCount++; break;
                 case LogLevel::CRITICAL: stats.criticalCount++; break;
             }
-        }
-        
+        });
         return stats;
     }
     
-    // 生成 HTML 日誌頁面 (記憶體優化版本)
-    String generateLogHTML() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        LogStats stats = getStats();
-
-        const size_t MAX_DISPLAY_ENTRIES = 20;
-        size_t displayCount = std::min(logBuffer.size(), MAX_DISPLAY_ENTRIES);
+    // 以串流方式輸出 JSON 格式的日誌（訊息內容會正確轉義）
+    // since = 0 時輸出最新的 limit 筆；否則輸出序號大於 since 的最舊 limit 筆，
+    // 客戶端把回應中的 next 當作下一次的 since 即可只取得新日誌
+    template <typename Sink>
+    void writeLogJSON(JsonWriter<Sink>& json, uint32_t since = 0, size_t limit = MAX_RESPONSE_ENTRIES) {
+        uint32_t first = getFirstSeq();
+        json.beginObject();
+        json.beginArray("logs");
+        uint32_t next = forEach(since, limit, [this, &json](const LogEntry& entry) {
+            json.beginObject()
+                .field("seq", entry.seq)
+                .field("timestamp", entry.timestamp)
+                .field("level", getLevelString(entry.level))
+                .field("component", entry.component)
+                .field("message", entry.message)
+                .endObject();
+        });
+        json.endArray();
+        json.field("first", first)
+            .field("next", next)
+            .field("more", next + 1 < head.load(std::memory_order_acquire))
+            .field("dropped", since > 0 && since + 1 < first);   // 游標之後的條目已被覆蓋
+        json.endObject();
+    }
 
-        // 分配一個足夠大的緩衝區來構建HTML，避免String串接造成的記憶體碎片。
-        const size_t bufferSize = 3072;
-        auto buffer = std::make_unique<char[]>(bufferSize);
-        if (!buffer) {
-            log(LogLevel::CRITICAL, "LogManager", "Failed to allocate memory for HTML log page.");
-            return "<!DOCTYPE html><html><body><h1>Error: Not enough memory to display logs.</h1></body></html>";
-        }
+    // 以串流方式輸出 HTML 日誌列（每筆一行，已做 HTML 轉義，放在 <pre> 中顯示）
+    template <typename Sink>
+    void writeLogHTML(Sink& out, uint32_t since = 0, size_t limit = MAX_RESPONSE_ENTRIES) {
+        forEach(since, limit, [this, &out](const LogEntry& entry) {
+            char prefix[64];
+            int n = snprintf(prefix, sizeof(prefix), "[%lus] [%s] ", entry.timestamp / 1000, getLevelString(entry.level));
+            if (n > 0) out.append(prefix, std::min((size_t)n, sizeof(prefix) - 1));
+            appendEscapedHTML(out, entry.message);
+            out.append("\n", 1);
+        });
+    }
 
-        char* p = buffer.get();
-        int remaining = bufferSize;
-        int written;
+    // 緩衝中最舊可讀條目的序號（尚無日誌時為下一個序號）
+    uint32_t getFirstSeq() {
+        uint32_t end = head.load(std::memory_order_acquire);
+        uint32_t oldest = end > LOG_CAPACITY ? end - (uint32_t)LOG_CAPACITY : 1;
+        return std::max(oldest, floor.load(std::memory_order_acquire));
+    }
 
-        // 安全地附加內容到緩衝區的輔助 Lambda
-        auto append = [&](const char* format, ...) {
-            if (remaining <= 1) return;
-            va_list args;
-            va_start(args, format);
-            written = vsnprintf(p, remaining, format, args);
-            va_end(args);
-            if (written > 0) {
-                p += written;
-                remaining -= written;
-            }
-        };
+    // 最新條目的序號（尚無日誌時為 0）
+    uint32_t getLastSeq() {
+        return head.load(std::memory_order_acquire) - 1;
+    }
 
-        append("<!DOCTYPE html><html><head><meta charset=\"UTF-8\">");
-        append("<title>DaiSpan Logs</title>");
-        append("<style>body{font-family:monospace;margin:10px;background:#f0f0f0;}");
-        append(".container{max-width:800px;margin:0 auto;background:white;padding:15px;border-radius:5px;}");
-        append("h1{color:#333;text-align:center;margin:10px;}");
-        append(".button{padding:5px 10px;margin:3px;background:#007cba;color:white;text-decoration:none;border-radius:3px;}");
-        append(".stats{background:#e8f4f8;padding:10px;border-radius:3px;margin:10px 0;}");
-        append(".log-container{background:#000;color:#0f0;padding:10px;border-radius:3px;max-height:300px;overflow-y:auto;font-size:11px;}");
-        append("</style></head><body><div class=\"container\">");
-        append("<h1>DaiSpan System Logs</h1>");
-        
-        append("<div style=\"text-align:center;\">");
-        append("<button onclick=\"location.reload()\" class=\"button\">Refresh</button>");
-        append("<button onclick=\"clearLogs()\" class=\"button\">Clear</button>");
-        append("<a href=\"/\" class=\"button\">Back</a></div>");
-        
-        append("<div class=\"stats\"><h3>Stats</h3><p>Total: %d", stats.totalEntries);
-        if (displayCount < stats.totalEntries) {
-            append(" (latest %d)", displayCount);
-        }
-        append(" | INFO: %d", stats.infoCount);
-        append(" | WARN: %d", stats.warningCount);
-        append(" | ERR: %d</p></div>", stats.errorCount);
-        
-        append("<div class=\"log-container\">");
-        if (logBuffer.size() > 0) {
-            size_t startIndex = logBuffer.size() > displayCount ? logBuffer.size() - displayCount : 0;
-            for (size_t i = startIndex; i < logBuffer.size(); i++) {
-                if (remaining < 256) { // 為最後的日誌條目保留足夠空間，避免溢出
-                    append("...<br>");
-                    break;
-                }
-                const auto& entry = logBuffer[i];
-                // 注意：此處未對 entry.message 進行HTML轉義，假設日誌內容是安全的
-                append("[%lu][%s][%s] %s<br>", entry.timestamp, getLevelString(entry.level), entry.component.c_str(), entry.message.c_str());
+private:
+    template <typename Sink>
+    static void appendEscapedHTML(Sink& out, const char* s) {
+        const char* run = s;
+        for (const char* p = s; *p; p++) {
+            const char* escaped;
+            switch (*p) {
+                case '<': escaped = "&lt;"; break;
+                case '>': escaped = "&gt;"; break;
+                case '&': escaped = "&amp;"; break;
+                default: continue;
             }
-        } else {
-            append("No logs");
+            if (p > run) out.append(run, p - run);
+            out.append(escaped, strlen(escaped));
+            run = p + 1;
         }
-        append("</div>");
-        
-        append("<script>function clearLogs(){if(confirm('Clear?')){fetch('/logs-clear',{method:'POST'}).then(()=>location.reload());}}</script>");
-        append("</div></body></html>");
-        
-        return String(buffer.get());
-    }
-    
-    // 生成 JSON 格式的日誌
-    String generateLogJSON() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        
-        // 限制 JSON 返回的條目數量
-        const size_t MAX_JSON_ENTRIES = 100;
-        size_t startIndex = logBuffer.size() > MAX_JSON_ENTRIES ? logBuffer.size() - MAX_JSON_ENTRIES : 0;
-        
-        String json = "{\"logs\":[";
-        bool first = true;
-        for (size_t i = startIndex; i < logBuffer.size(); i++) {
-            if (!first) json += ",";
-            first = false;
-            
-            const auto& entry = logBuffer[i];
-            json += "{";
-            json += "\"timestamp\":" + String(entry.timestamp) + ",";
-            json += "\"level\":\"" + String(getLevelString(entry.level)) + "\",";
-            json += "\"component\":\"" + entry.component + "\",";
-            json += "\"message\":\"" + entry.message + "\"";
-            json += "}";
-        }
-        json += "]}";
-        
-        return json;
+        size_t rest = strlen(run);
+        if (rest) out.append(run, rest);
     }
 };
 
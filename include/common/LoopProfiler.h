@@ -0,0 +1,260 @@
+#pragma once
+
+#include <Arduino.h>
+#include "JsonWriter.h"
+#include "Debug.h"
+#include "Metrics.h"
+
+// 主迴圈階段分析（常駐啟用）
+// SystemManager 以 LoopProfiler::Scope 包住各階段，離開時以 CPU 週期計數器累計該階段耗時；
+// 每輪開始時（beginLoop）計算與上一輪的間隔，扣掉已計時的階段後剩下的算在 other
+// （遠端調試、配對檢測、main.cpp 中的其他處理）。間隔超過 SLO 時記錄耗時最多的階段。
+// 每個階段每次只有兩次讀取週期計數器與幾次整數運算；只在主迴圈任務中更新與讀取，不需要鎖。
+// 週期計數器為 32 位元（240 MHz 約 17 秒繞回），超過此長度的單次間隔無法正確量測。
+
+enum class LoopPhase : uint8_t {
+    HomeSpan,       // homeSpan.poll()
+    OTA,            // ArduinoOTA.handle()
+    WiFi,           // WiFi 監控與功率管理
+    Web,            // 監控 WebServer 與 SSE
+    Controller,     // 配件同步（控制器 update）
+    Heartbeat,      // 系統心跳
+    Other,          // 未計時的部分（由間隔推算）
+    Count
+};
+
+inline constexpr const char* LOOP_PHASE_NAMES[] = {
+    "homespan", "ota", "wifi", "web", "controller", "heartbeat", "other"
+};
+
+class LoopProfiler {
+public:
+    static constexpr uint8_t PHASE_COUNT = (uint8_t)LoopPhase::Count;
+    static constexpr uint32_t SLO_GAP_US = 50000;           // 主迴圈間隔上限
+    static constexpr unsigned long BREACH_LOG_INTERVAL = 1000;
+
+    // 以 2 的冪次分桶的週期數直方圖：桶 0 為 < 2^BASE_SHIFT，桶 i 為 [2^(BASE_SHIFT+i-1), 2^(BASE_SHIFT+i))，
+    // 最後一桶不設上限
+    struct CycleHistogram {
+        static constexpr uint8_t BASE_SHIFT = 10;           // 1024 週期（160 MHz 約 6.4 µs）
+        static constexpr uint8_t BUCKETS = 18;
+
+        uint32_t buckets[BUCKETS];
+        uint32_t count;
+        uint64_t total;
+        uint32_t max;
+
+        static uint8_t bucketOf(uint32_t cycles) {
+            if (cycles < (1u << BASE_SHIFT)) return 0;
+            uint8_t bits = 32 - __builtin_clz(cycles);      // cycles < 2^bits
+            uint8_t i = bits - BASE_SHIFT;
+            return i < BUCKETS ? i : BUCKETS - 1;
+        }
+
+        // 桶 i 的上界（不含）；最後一桶回傳 0 表示無上限
+        static uint32_t upperBound(uint8_t i) {
+            return i + 1 < BUCKETS ? 1u << (BASE_SHIFT + i) : 0;
+        }
+
+        void observe(uint32_t cycles) {
+            buckets[bucketOf(cycles)]++;
+            count++;
+            total += cycles;
+            if (cycles > max) max = cycles;
+        }
+
+        // 分位數的上界估計（所在桶的上界，不超過最大值）
+        uint32_t quantile(float q) const {
+            if (count == 0) return 0;
+            uint32_t rank = (uint32_t)ceilf(q * count);
+            if (rank == 0) rank = 1;
+            uint32_t seen = 0;
+            for (uint8_t i = 0; i < BUCKETS; i++) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    uint32_t bound = upperBound(i);
+                    return bound && bound < max ? bound : max;
+                }
+            }
+            return max;
+        }
+    };
+
+    struct PhaseStats {
+        CycleHistogram histogram;   // 每次執行的週期數（other 為每輪推算值）
+        uint32_t breaches;          // 間隔超過 SLO 時由此階段負責的次數
+    };
+
+    // 離開作用域時把耗時計入目前這一輪的階段
+    class Scope {
+    public:
+        Scope(LoopProfiler& profiler, LoopPhase phase)
+            : profiler(profiler), phase(phase), start(ESP.getCycleCount()) {}
+        ~Scope() { profiler.record(phase, ESP.getCycleCount() - start); }
+
+    private:
+        LoopProfiler& profiler;
+        LoopPhase phase;
+        uint32_t start;
+    };
+
+    LoopProfiler() { reset(); }
+
+    // 每輪主迴圈開始時呼叫：結算上一輪
+    void beginLoop() {
+        uint32_t now = ESP.getCycleCount();
+        if (started) finishLoop(now - loopStart);
+        started = true;
+        loopStart = now;
+        memset(loopCycles, 0, sizeof(loopCycles));
+    }
+
+    void record(LoopPhase phase, uint32_t cycles) {
+        phases[(uint8_t)phase].histogram.observe(cycles);
+        loopCycles[(uint8_t)phase] += cycles;
+    }
+
+    void reset() {
+        memset(phases, 0, sizeof(phases));
+        memset(&period, 0, sizeof(period));
+        memset(loopCycles, 0, sizeof(loopCycles));
+        started = false;
+        avgPeriod = 0;
+        jitter = 0;
+        breaches = 0;
+        suppressedLogs = 0;
+        lastBreachLog = 0;
+        worstGap = 0;
+        worstGapPhase = LoopPhase::Other;
+    }
+
+    // 有 SLO 違規時為違規次數最多的階段，否則為單次耗時最長的已計時階段
+    LoopPhase worstOffender() const {
+        uint8_t worst = 0;
+        for (uint8_t i = 1; i < PHASE_COUNT; i++) {
+            if (breaches ? phases[i].breaches > phases[worst].breaches
+                         : i != (uint8_t)LoopPhase::Other &&
+                           phases[i].histogram.max > phases[worst].histogram.max) worst = i;
+        }
+        return (LoopPhase)worst;
+    }
+
+    const PhaseStats& getPhase(LoopPhase phase) const { return phases[(uint8_t)phase]; }
+    const CycleHistogram& getPeriod() const { return period; }
+    uint32_t getJitterCycles() const { return jitter >> EWMA_SHIFT; }
+    uint32_t getBreaches() const { return breaches; }
+    uint32_t getWorstGapCycles() const { return worstGap; }
+    LoopPhase getWorstGapPhase() const { return worstGapPhase; }
+
+    template <typename Sink>
+    void writeJSON(JsonWriter<Sink>& json) const {
+        float mhz = ESP.getCpuFreqMHz();
+        LoopPhase offender = worstOffender();
+        json.beginObject()
+            .field("cpuMHz", ESP.getCpuFreqMHz())
+            .field("loops", period.count)
+            .field("worstOffender", LOOP_PHASE_NAMES[(uint8_t)offender]);
+
+        json.beginObject("period");
+        writeSummary(json, period, mhz);
+        json.field("jitterUs", getJitterCycles() / mhz, 1);
+        json.endObject();
+
+        json.beginObject("slo")
+            .field("gapUs", SLO_GAP_US)
+            .field("breaches", breaches)
+            .field("worstGapUs", worstGap / mhz, 1)
+            .field("worstGapPhase", worstGap ? LOOP_PHASE_NAMES[(uint8_t)worstGapPhase] : nullptr)
+            .endObject();
+
+        json.beginArray("phases");
+        for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+            const PhaseStats& phase = phases[i];
+            json.beginObject().field("name", LOOP_PHASE_NAMES[i]);
+            writeSummary(json, phase.histogram, mhz);
+            json.field("share", period.total ? 100.0 * phase.histogram.total / period.total : 0.0, 2)
+                .field("breaches", phase.breaches)
+                .endObject();
+        }
+        json.endArray();
+
+        // 直方圖的桶上界（週期數），最後一桶無上限
+        json.beginArray("bucketBounds");
+        for (uint8_t i = 0; i + 1 < CycleHistogram::BUCKETS; i++) json.value(CycleHistogram::upperBound(i));
+        json.endArray();
+        json.endObject();
+    }
+
+private:
+    static constexpr uint8_t EWMA_SHIFT = 4;                // 平滑係數 1/16
+
+    PhaseStats phases[PHASE_COUNT];
+    CycleHistogram period;                  // 相鄰兩輪開始之間的週期數
+    uint32_t loopCycles[PHASE_COUNT];       // 目前這一輪各階段的累計週期數
+    uint32_t loopStart;
+    bool started;
+    uint32_t avgPeriod;                     // 週期數 << EWMA_SHIFT
+    uint32_t jitter;                        // 與平均間隔的平均絕對偏差，週期數 << EWMA_SHIFT
+    uint32_t breaches;
+    uint32_t suppressedLogs;
+    unsigned long lastBreachLog;
+    uint32_t worstGap;
+    LoopPhase worstGapPhase;
+
+    void finishLoop(uint32_t gap) {
+        uint32_t timed = 0;
+        for (uint8_t i = 0; i < (uint8_t)LoopPhase::Other; i++) timed += loopCycles[i];
+        uint32_t other = gap > timed ? gap - timed : 0;
+        record(LoopPhase::Other, other);
+        period.observe(gap);
+
+        // 平均間隔與抖動：整數指數移動平均
+        if (period.count == 1) {
+            avgPeriod = gap << EWMA_SHIFT;
+        } else {
+            uint32_t avg = avgPeriod >> EWMA_SHIFT;
+            uint32_t deviation = gap > avg ? gap - avg : avg - gap;
+            avgPeriod += gap - avg;
+            jitter += deviation - (jitter >> EWMA_SHIFT);
+        }
+
+        uint8_t worst = 0;
+        for (uint8_t i = 1; i < PHASE_COUNT; i++) {
+            if (loopCycles[i] > loopCycles[worst]) worst = i;
+        }
+        if (gap > worstGap) {
+            worstGap = gap;
+            worstGapPhase = (LoopPhase)worst;
+        }
+
+        uint32_t mhz = ESP.getCpuFreqMHz();
+        if (gap / mhz <= SLO_GAP_US) return;
+        breaches++;
+        phases[worst].breaches++;
+        Metrics::loopSloBreaches.inc();
+
+        unsigned long nowMs = millis();
+        if (lastBreachLog && nowMs - lastBreachLog < BREACH_LOG_INTERVAL) {
+            suppressedLogs++;
+            return;
+        }
+        lastBreachLog = nowMs;
+        DEBUG_WARN_PRINT("[Perf] 主迴圈間隔 %lu ms 超過 %lu ms，主要耗時：%s %lu ms（略過 %lu 筆同類警告）\n",
+                         (unsigned long)(gap / mhz / 1000), (unsigned long)(SLO_GAP_US / 1000),
+                         LOOP_PHASE_NAMES[worst], (unsigned long)(loopCycles[worst] / mhz / 1000),
+                         (unsigned long)suppressedLogs);
+        suppressedLogs = 0;
+    }
+
+    template <typename Sink>
+    static void writeSummary(JsonWriter<Sink>& json, const CycleHistogram& h, float mhz) {
+        json.field("count", h.count)
+            .field("avgUs", h.count ? h.total / mhz / h.count : 0.0f, 1)
+            .field("p50Us", h.quantile(0.5f) / mhz, 1)
+            .field("p99Us", h.quantile(0.99f) / mhz, 1)
+            .field("maxUs", h.max / mhz, 1);
+        json.beginArray("histogram");
+        for (uint8_t i = 0; i < CycleHistogram::BUCKETS; i++) json.value(h.buckets[i]);
+        json.endArray();
+    }
+};
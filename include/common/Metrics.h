@@ -0,0 +1,238 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <math.h>
+
+// 指標註冊表（OpenMetrics / Prometheus）
+// 所有指標都是常數初始化的全域物件，註冊表是編譯期決定的靜態陣列（src/Metrics.cpp），
+// 執行期沒有註冊、查找或配置；更新只是一次 relaxed 原子操作，可在任何任務中呼叫。
+// /metrics 以 renderOpenMetrics() 串流輸出整份註冊表。
+
+enum class MetricType : uint8_t { Counter, Gauge, Histogram };
+
+// 單調遞增計數器
+class Counter {
+public:
+    constexpr Counter() : value(0) {}
+    void inc(uint32_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    uint32_t get() const { return value.load(std::memory_order_relaxed); }
+private:
+    std::atomic<uint32_t> value;
+};
+
+// 可任意設定的量測值
+class Gauge {
+public:
+    constexpr Gauge() : value(0.0f) {}
+    void set(float v) { value.store(v, std::memory_order_relaxed); }
+    float get() const { return value.load(std::memory_order_relaxed); }
+private:
+    std::atomic<float> value;
+};
+
+// 固定桶直方圖（上界遞增，另有隱含的 +Inf 桶）；觀測值為整數（ms 或 us）
+class Histogram {
+public:
+    static constexpr uint8_t MAX_BUCKETS = 12;
+
+    template <size_t N>
+    constexpr explicit Histogram(const uint32_t (&upperBounds)[N])
+        : bounds(upperBounds), bucketCount(N), buckets{}, sum(0), count(0) {
+        static_assert(N <= MAX_BUCKETS, "too many histogram buckets");
+    }
+
+    void observe(uint32_t v) {
+        uint8_t i = 0;
+        while (i < bucketCount && v > bounds[i]) i++;
+        buckets[i].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(v, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint8_t getBucketCount() const { return bucketCount; }
+    uint32_t getBound(uint8_t i) const { return bounds[i]; }
+    uint32_t getBucket(uint8_t i) const { return buckets[i].load(std::memory_order_relaxed); }  // 非累積
+    uint32_t getSum() const { return sum.load(std::memory_order_relaxed); }
+    uint32_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+private:
+    const uint32_t* bounds;
+    uint8_t bucketCount;
+    std::atomic<uint32_t> buckets[MAX_BUCKETS + 1];
+    std::atomic<uint32_t> sum;
+    std::atomic<uint32_t> count;
+};
+
+// 註冊表項目：同名項目必須相鄰（同一個 family，以 labels 區分）
+struct MetricEntry {
+    const char* name;
+    const char* labels;     // 例如 reason="timeout"；無標籤時為 nullptr
+    const char* help;
+    MetricType type;
+    const void* metric;
+};
+
+namespace Metrics {
+
+    // S21 通訊
+    extern Counter s21Commands;
+    extern Counter s21Errors;
+    extern Counter s21RetriesTimeout;
+    extern Counter s21RetriesChecksum;
+    extern Counter s21RetriesOther;
+    extern Histogram s21ResponseMs;
+    extern Gauge s21QualityScore;
+
+    // 控制器
+    extern Gauge power;
+    extern Gauge targetTemperature;
+    extern Gauge currentTemperature;
+    extern Gauge fanSpeed;
+    extern Gauge consecutiveErrors;
+    extern Counter optionalQueries;
+    extern Counter optionalSkipped;
+    extern Histogram controlLatencyMs;
+
+    // HomeKit
+    extern Counter notificationsSent;
+    extern Counter notificationsSuppressed;
+    extern Counter syncTicks;
+    extern Histogram syncTickUs;
+
+    // Web
+    extern Counter httpRequests;
+    extern Histogram httpHandleMs;
+    extern Gauge sseClients;
+    extern Counter sseEventsSent;
+    extern Counter sseEventsDropped;
+    extern Counter remoteDebugEventsSent;
+    extern Counter remoteDebugEventsDropped;
+
+    // 系統
+    extern Counter debugLogQueued;
+    extern Counter debugLogDropped;
+    extern Counter loopSloBreaches;
+    extern Gauge uptimeSeconds;
+    extern Gauge freeHeap;
+    extern Gauge minFreeHeap;
+    extern Gauge maxAllocHeap;
+    extern Gauge avgFreeHeap;
+    extern Gauge wifiRssi;
+
+    const MetricEntry* getEntries();
+    size_t getEntryCount();
+
+} // namespace Metrics
+
+namespace MetricsDetail {
+
+    template <typename Sink>
+    inline void writeText(Sink& sink, const char* s) { sink.append(s, strlen(s)); }
+
+    template <typename Sink>
+    inline void writeUnsigned(Sink& sink, uint32_t v) {
+        char buffer[11];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        do {
+            *--p = '0' + (v % 10);
+            v /= 10;
+        } while (v > 0);
+        sink.append(p, end - p);
+    }
+
+    template <typename Sink>
+    inline void writeFloat(Sink& sink, float v) {
+        if (isnan(v)) { writeText(sink, "NaN"); return; }
+        if (isinf(v)) { writeText(sink, v > 0 ? "+Inf" : "-Inf"); return; }
+        char buffer[24];
+        int n = snprintf(buffer, sizeof(buffer), "%.7g", v);
+        if (n > 0) sink.append(buffer, n);
+    }
+
+    // name{labels,extra}
+    template <typename Sink>
+    inline void writeSeries(Sink& sink, const char* name, const char* suffix,
+                            const char* labels, const char* extraKey, uint32_t extraValue, bool extraInf) {
+        writeText(sink, name);
+        if (suffix) writeText(sink, suffix);
+        bool hasLabels = labels && *labels;
+        if (!hasLabels && !extraKey) {
+            sink.append(" ", 1);
+            return;
+        }
+        sink.append("{", 1);
+        if (hasLabels) writeText(sink, labels);
+        if (extraKey) {
+            if (hasLabels) sink.append(",", 1);
+            writeText(sink, extraKey);
+            sink.append("=\"", 2);
+            if (extraInf) writeText(sink, "+Inf");
+            else writeUnsigned(sink, extraValue);
+            sink.append("\"", 1);
+        }
+        sink.append("} ", 2);
+    }
+
+} // namespace MetricsDetail
+
+// 以 OpenMetrics 文字格式輸出註冊表（Content-Type: application/openmetrics-text; version=1.0.0）
+template <typename Sink>
+void renderOpenMetrics(Sink& sink, const MetricEntry* entries, size_t count) {
+    using namespace MetricsDetail;
+    static const char* TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+
+    const char* family = nullptr;
+    for (size_t i = 0; i < count; i++) {
+        const MetricEntry& e = entries[i];
+        if (!family || strcmp(family, e.name) != 0) {
+            family = e.name;
+            writeText(sink, "# TYPE ");
+            writeText(sink, e.name);
+            sink.append(" ", 1);
+            writeText(sink, TYPE_NAMES[(uint8_t)e.type]);
+            writeText(sink, "\n# HELP ");
+            writeText(sink, e.name);
+            sink.append(" ", 1);
+            writeText(sink, e.help);
+            sink.append("\n", 1);
+        }
+
+        switch (e.type) {
+            case MetricType::Counter:
+                writeSeries(sink, e.name, "_total", e.labels, nullptr, 0, false);
+                writeUnsigned(sink, static_cast<const Counter*>(e.metric)->get());
+                sink.append("\n", 1);
+                break;
+            case MetricType::Gauge:
+                writeSeries(sink, e.name, nullptr, e.labels, nullptr, 0, false);
+                writeFloat(sink, static_cast<const Gauge*>(e.metric)->get());
+                sink.append("\n", 1);
+                break;
+            case MetricType::Histogram: {
+                const Histogram* h = static_cast<const Histogram*>(e.metric);
+                // 先讀總數再累加各桶：並行更新時各桶總和可能略大於 count，輸出時以 count 封頂
+                uint32_t total = h->getCount();
+                uint32_t cumulative = 0;
+                for (uint8_t b = 0; b < h->getBucketCount(); b++) {
+                    cumulative += h->getBucket(b);
+                    writeSeries(sink, e.name, "_bucket", e.labels, "le", h->getBound(b), false);
+                    writeUnsigned(sink, cumulative < total ? cumulative : total);
+                    sink.append("\n", 1);
+                }
+                writeSeries(sink, e.name, "_bucket", e.labels, "le", 0, true);
+                writeUnsigned(sink, total);
+                sink.append("\n", 1);
+                writeSeries(sink, e.name, "_sum", e.labels, nullptr, 0, false);
+                writeUnsigned(sink, h->getSum());
+                sink.append("\n", 1);
+                writeSeries(sink, e.name, "_count", e.labels, nullptr, 0, false);
+                writeUnsigned(sink, total);
+                sink.append("\n", 1);
+                break;
+            }
+        }
+    }
+    writeText(sink, "# EOF\n");
+}
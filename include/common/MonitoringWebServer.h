@@ -0,0 +1,197 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WebServer.h>
+#include <functional>
+
+// 非阻塞的監控 WebServer（HTTP/1.1 keep-alive）
+// Arduino WebServer 一次只服務一個連線、每個回應都 Connection: close，讀寫皆阻塞，
+// 一個慢速客戶端（弱訊號手機下載日誌）就會卡住所有人。這裡改為：
+//   - 固定大小的連線表，每個連線有自己的讀寫緩衝與期限
+//   - 請求在 socket 上非阻塞累積，收齊才分派；回應先進連線的送出緩衝
+//     （放不下時暫存到有上限的堆積溢出區），之後每次 service() 只寫 socket 當下收得下的部分
+//   - 連線表滿且有人在等待時，優先踢掉閒置最久的 keep-alive 連線
+// 路由處理器仍在主迴圈任務中執行（與 HomeSpan、S21 串口同一執行緒），
+// 對處理器提供與 WebServer 相同的 on()/arg()/send()/sendContent() 介面。
+class MonitoringWebServer {
+public:
+    typedef std::function<void()> Handler;
+
+    static constexpr uint8_t MAX_CONNECTIONS = 4;
+    static constexpr size_t RX_BUFFER_SIZE = 1024;          // 請求行 + 標頭 + 表單內容
+    static constexpr size_t TX_BUFFER_SIZE = 1536;
+    static constexpr size_t MAX_OVERFLOW_PER_CONNECTION = 8192; // 客戶端收得慢時暫存在堆積的回應
+    static constexpr size_t MAX_OVERFLOW_TOTAL = 16384;
+    static constexpr uint8_t MAX_ROUTES = 40;
+    static constexpr uint8_t MAX_ARGS = 10;
+    static constexpr uint8_t MAX_HEADERS = 12;
+    static constexpr size_t RESPONSE_HEADER_SIZE = 256;     // sendHeader() 累積的自訂標頭
+    static constexpr uint8_t MAX_DISPATCH_PER_SERVICE = 2;  // 每次 service() 最多執行的處理器數
+    static constexpr uint8_t MAX_REQUESTS_PER_CONNECTION = 100;
+
+    static constexpr unsigned long REQUEST_TIMEOUT = 3000;  // 收到第一個位元組後收齊請求的期限
+    static constexpr unsigned long IDLE_TIMEOUT = 10000;    // keep-alive 閒置上限
+    static constexpr unsigned long WRITE_TIMEOUT = 5000;    // 回應送出無進度的上限
+    static constexpr unsigned long HANDLER_STALL_LIMIT = 250; // 溢出區也滿時，處理器最多等待客戶端的累計時間
+
+    struct Stats {
+        uint32_t dispatches;        // 執行的路由處理器次數
+        uint32_t idleChecks;        // 沒有任何 I/O 的 service() 次數
+        uint32_t lastHandleMicros;
+        uint32_t maxHandleMicros;
+        uint64_t totalHandleMicros;
+        uint32_t accepted;          // 接受的 TCP 連線
+        uint32_t reused;            // 在既有 keep-alive 連線上的請求
+        uint32_t evicted;           // 為新連線讓出的閒置連線
+        uint32_t timeouts;          // 讀取、閒置或送出逾時而關閉的連線
+        uint32_t badRequests;       // 無法解析或過大的請求
+        uint32_t partialWrites;     // socket 只收下部分資料的寫入
+        uint32_t overflows;         // 回應超出固定送出緩衝、改用溢出區的次數
+        uint32_t handlerStalls;     // 處理器因溢出區也滿而等待客戶端的次數
+        uint32_t bytesSent;
+        uint8_t maxConcurrent;      // 同時開啟的最大連線數
+    };
+
+    explicit MonitoringWebServer(int port);
+
+    void begin();
+    void close();
+
+    // 主迴圈呼叫：接受新連線、推進所有連線的讀寫，回傳是否有任何進度
+    bool service();
+
+    void on(const char* uri, Handler handler) { on(uri, HTTP_ANY, handler); }
+    void on(const char* uri, HTTPMethod method, Handler handler);
+    void onNotFound(Handler handler) { notFoundHandler = handler; }
+    // 所有請求標頭都會保留到處理器結束，這裡只為與 WebServer 介面相容
+    void collectHeaders(const char* headerKeys[], size_t count) {}
+
+    // 目前請求
+    const char* uri() const { return request.path; }
+    HTTPMethod method() const { return request.method; }
+    String arg(const char* name) const;
+    bool hasArg(const char* name) const;
+    String header(const char* name) const;
+    WiFiClient& client();
+    // 連線交給其他模組（例如 SSE 推送）接管：不再讀寫也不關閉 socket
+    void detachClient();
+
+    // 回應（僅能在處理器中呼叫）
+    void sendHeader(const char* name, const char* value);
+    void sendHeader(const char* name, const String& value) { sendHeader(name, value.c_str()); }
+    void setContentLength(size_t length) { response.contentLength = length; }
+    void send(int code, const char* contentType, const char* content, size_t length);
+    void send(int code, const char* contentType = "text/plain", const char* content = "") {
+        send(code, contentType, content, strlen(content));
+    }
+    void send(int code, const char* contentType, const String& content) {
+        send(code, contentType, content.c_str(), content.length());
+    }
+    // 內容留在原處（PROGMEM），由 service() 直接從來源分段送出，不複製
+    void send_P(int code, const char* contentType, PGM_P content, size_t length);
+    // setContentLength(CONTENT_LENGTH_UNKNOWN) 之後以 chunked 編碼送出；長度 0 表示結束
+    void sendContent(const char* content, size_t length);
+    void sendContent(const char* content) { sendContent(content, strlen(content)); }
+
+    Stats getStats() const { return stats; }
+    uint8_t getConnectionCount() const;
+
+private:
+    enum class ConnState : uint8_t { Free, Reading, Writing };
+
+    struct Connection {
+        WiFiClient socket;
+        ConnState state = ConnState::Free;
+        char rx[RX_BUFFER_SIZE + 1];
+        size_t rxLength = 0;
+        char tx[TX_BUFFER_SIZE];
+        size_t txStart = 0;
+        size_t txEnd = 0;
+        char* overflow = nullptr;       // 堆積溢出區，回應送完即釋放
+        size_t overflowCapacity = 0;
+        size_t overflowLength = 0;
+        size_t overflowSent = 0;
+        const uint8_t* body = nullptr;  // send_P 的待送內容
+        size_t bodyRemaining = 0;
+        bool keepAlive = false;
+        bool aborted = false;
+        uint8_t requests = 0;
+        unsigned long deadline = 0;     // 依狀態而定的期限
+        unsigned long lastActivity = 0;
+    };
+
+    struct Route {
+        const char* uri;
+        HTTPMethod method;
+        Handler handler;
+    };
+
+    struct KeyValue {
+        const char* key;
+        const char* value;
+    };
+
+    // 目前分派中的請求，字串都指向連線的 rx 緩衝
+    struct Request {
+        Connection* connection = nullptr;
+        HTTPMethod method = HTTP_GET;
+        const char* path = "";
+        bool http11 = false;
+        size_t length = 0;              // 請求總長（標頭 + 內容），用於保留管線化的後續請求
+        KeyValue headers[MAX_HEADERS];
+        uint8_t headerCount = 0;
+        KeyValue args[MAX_ARGS];
+        uint8_t argCount = 0;
+    };
+
+    struct Response {
+        char headers[RESPONSE_HEADER_SIZE];
+        size_t headersLength = 0;
+        size_t contentLength = CONTENT_LENGTH_NOT_SET;
+        bool started = false;
+        bool chunked = false;
+        bool finished = false;
+        bool headOnly = false;
+        bool detached = false;
+        unsigned long stalledMs = 0;    // 處理器等待客戶端接收的累計時間
+    };
+
+    WiFiServer server;
+    Connection connections[MAX_CONNECTIONS];
+    Route routes[MAX_ROUTES];
+    uint8_t routeCount = 0;
+    Handler notFoundHandler;
+    uint8_t nextConnection = 0;         // 輪流起點，避免固定由第一個連線優先
+    size_t overflowBytes = 0;           // 所有連線溢出區的總配置量
+    Request request;
+    Response response;
+    Stats stats;
+
+    bool acceptConnections(unsigned long currentTime);
+    bool evictIdleConnection();
+    bool serviceConnection(Connection& conn, unsigned long currentTime, uint8_t& dispatches);
+    bool readRequest(Connection& conn, unsigned long currentTime);
+    bool flushConnection(Connection& conn, unsigned long currentTime);
+    bool pumpOutput(Connection& conn);
+    size_t appendOverflow(Connection& conn, const char* data, size_t length);
+    void freeOverflow(Connection& conn);
+    void finishResponse(Connection& conn, unsigned long currentTime);
+    void release(Connection& conn);
+
+    // 回傳請求總長；0 = 尚未收齊，-1 = 無法處理（已送出錯誤回應）
+    int findCompleteRequest(Connection& conn);
+    static bool parseContentLength(const char* value, size_t& length);
+    bool parseRequest(Connection& conn, size_t headerLength, size_t totalLength);
+    void parseArgs(char* query);
+    void dispatch(Connection& conn, unsigned long currentTime);
+    void rejectRequest(Connection& conn, int code, const char* message);
+
+    void writeStatus(int code, const char* contentType, size_t contentLength);
+    void writeBody(const char* data, size_t length);
+    void write(Connection& conn, const char* data, size_t length);
+    size_t sendNow(Connection& conn, const char* data, size_t length);
+
+    static void urlDecode(char* s);
+    static const char* statusText(int code);
+};
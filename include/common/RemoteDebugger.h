@@ -2,19 +2,37 @@
 
 #include <WebSocketsServer.h>
 #include <ArduinoJson.h>
+#include <memory>
 #include <vector>
 #include <string>
+#include "DebugFanout.h"
+
+// WebSocketsServer 沒有公開底層連線；批次廣播送出前需要確認 socket 可寫，避免慢速客戶端阻塞主迴圈。
+// isWritable() 直接讀取受保護的 _clients[num].tcp，這是函式庫的內部結構，只對照過 2.4.1
+// （platformio.ini 固定此版本）；升級時須確認 WSclient_t 仍以 tcp 指向 WiFiClient 再調整此檢查。
+static_assert(WEBSOCKETS_VERSION_INT == 2004001,
+              "DebugSocketServer::isWritable() 依賴 WebSockets 2.4.1 的 _clients[].tcp");
+class DebugSocketServer : public WebSocketsServer {
+public:
+    using WebSocketsServer::WebSocketsServer;
+    bool isWritable(uint8_t num);
+};
 
 // 遠端調試系統
 class RemoteDebugger {
 private:
-    WebSocketsServer* wsServer;
+    DebugSocketServer* wsServer;
     std::vector<uint8_t> connectedClients;
     bool debugEnabled;
     
-    // 日誌緩存
-    std::vector<String> logBuffer;
-    static const size_t MAX_LOG_BUFFER = 30;
+    // 事件批次廣播（每個客戶端有固定容量的佇列與各自的訂閱），begin() 時配置
+    std::unique_ptr<DebugFanout> fanout;
+    void updateTopicMask();
+    void handleSubscribe(uint8_t num, const JsonDocument& doc);
+    
+    // 日誌緩存（固定容量，滿時丟棄最舊的行；每行以 '\0' 結尾存放），begin() 時配置
+    static const size_t LOG_HISTORY_BYTES = 2048;
+    std::unique_ptr<MessageRing<LOG_HISTORY_BYTES>> logHistory;
     
     // HomeKit 狀態追蹤
     struct HomeKitOperation {
@@ -32,9 +50,11 @@ private:
     
     // 串口日誌轉發
     bool serialLogEnabled;
-    int serialLogLevel;
-    std::vector<String> serialLogBuffer;
-    static const size_t MAX_SERIAL_LOG_BUFFER = 50;
+    int serialLogLevel;             // 新連線客戶端預設訂閱的日誌級別
+    static const size_t SERIAL_LOG_HISTORY_BYTES = 4096;
+    std::unique_ptr<MessageRing<SERIAL_LOG_HISTORY_BYTES>> serialLogHistory;
+    uint32_t debugLogCursor = 0;    // 調試日誌轉發游標（LogDrain 位置或二進位日誌序號）
+    void forwardDebugLogs();
     
 public:
     // 單例模式
@@ -65,16 +85,22 @@ public:
     
     // 即時串口日誌轉發
     void logSerial(const String& message);
+    void logSerial(const char* message, uint8_t level = DEBUG_INFO);
     void setSerialLogLevel(int level);
     
+    // 訂閱主題的事件（DebugTopics.h 的發布函數），沒有訂閱者時不序列化
+    void publishS21Frame(bool transmit, const uint8_t* frame, size_t length);
+    void publishControllerState(bool power, uint8_t targetMode, float targetTemperature,
+                                float currentTemperature, uint8_t fanSpeed);
+    
     // WebSocket 事件處理
     void onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
     
 private:
-    RemoteDebugger() : wsServer(nullptr), debugEnabled(false), serialLogEnabled(true), serialLogLevel(2) {}
+    RemoteDebugger() : wsServer(nullptr), debugEnabled(false), serialLogEnabled(true), serialLogLevel(DEBUG_VERBOSE) {}
     void broadcastMessage(const String& message);
     void sendToClient(uint8_t clientId, const String& message);
-    String createJsonMessage(const String& type, const String& data);
+    void publishLog(const char* type, uint8_t level, const char* text);
 };
 
 // 便利宏定義
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <lwip/sockets.h>
+
+// 以 select() 檢查 socket 是否可寫（送出緩衝還有空間）。
+// waitMs 為 0 時立即回傳，主迴圈據此決定這次要不要寫，不會卡在 TCP 送出緩衝區；
+// 大於 0 時最多等待這麼久。fd < 0（連線已關閉）視為不可寫。
+inline bool socketWritable(int fd, unsigned long waitMs = 0) {
+    if (fd < 0) return false;
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(fd, &writeSet);
+    struct timeval timeout = {(long)(waitMs / 1000), (long)(waitMs % 1000 * 1000)};
+    return select(fd + 1, nullptr, &writeSet, nullptr, &timeout) > 0;
+}
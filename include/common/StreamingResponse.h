@@ -2,57 +2,159 @@
 
 #include <Arduino.h>
 #include <WebServer.h>
+#include "JsonWriter.h"
+#include "MonitoringWebServer.h"
 
 // 流式 HTTP 響應構建器，避免大型 String 分配
+// - appendf 直接格式化到分塊的剩餘空間；放不下時先送出補滿的分塊，再接續格式化尾段，不會截斷
+// - 大段內容（PROGMEM 頁面片段）在分塊為空時直接從來源分段送出，不先複製到緩衝
+// - 分塊大小在 begin() 時依剩餘堆積與送出視窗決定
 class StreamingResponse {
-    static constexpr size_t CHUNK_SIZE = 512;
-    char buffer[CHUNK_SIZE + 1];
+public:
+    static constexpr size_t MAX_CHUNK_SIZE = 1024;          // 緩衝放在處理器堆疊上，上限 1 KB
+    static constexpr size_t MIN_CHUNK_SIZE = 256;
+    static constexpr size_t CHUNK_OVERHEAD = 8;             // chunked 編碼的長度行與結尾 CRLF
+    static constexpr uint32_t LOW_HEAP_THRESHOLD = 32768;
+#ifdef CONFIG_LWIP_TCP_MSS
+    static constexpr size_t TCP_SEGMENT_SIZE = CONFIG_LWIP_TCP_MSS;
+#else
+    static constexpr size_t TCP_SEGMENT_SIZE = 1436;
+#endif
+
+    // 一個分塊（含 chunked 標頭）不超過送出視窗；剩餘堆積偏低時改用小分塊，
+    // 讓 lwIP（或監控伺服器的溢出區）每次只需配置較小的緩衝
+    static size_t chooseChunkSize(uint32_t freeHeap, size_t window) {
+        size_t size = window > CHUNK_OVERHEAD + MIN_CHUNK_SIZE ? window - CHUNK_OVERHEAD : MIN_CHUNK_SIZE;
+        size = min(size, MAX_CHUNK_SIZE);
+        if (freeHeap < LOW_HEAP_THRESHOLD) size = MIN_CHUNK_SIZE;
+        return size;
+    }
+
+private:
+    char buffer[MAX_CHUNK_SIZE + 1];                        // +1 給 vsnprintf 的結尾 NUL
+    size_t chunkSize = MAX_CHUNK_SIZE;
     size_t pos = 0;
     WebServer* server = nullptr;
+    MonitoringWebServer* monitor = nullptr;
     bool active = false;
 
+    void sendChunk(const char* content, size_t len) {
+        if (monitor) monitor->sendContent(content, len);
+        else server->sendContent(content, len);
+    }
+
 public:
     void begin(WebServer* srv, const char* contentType = "text/html") {
         server = srv;
+        monitor = nullptr;
+        chunkSize = chooseChunkSize(ESP.getFreeHeap(), TCP_SEGMENT_SIZE);
         server->setContentLength(CONTENT_LENGTH_UNKNOWN);
         server->send(200, contentType, "");
         active = true;
         pos = 0;
     }
 
+    void begin(MonitoringWebServer* srv, const char* contentType = "text/html", int code = 200) {
+        server = nullptr;
+        monitor = srv;
+        chunkSize = chooseChunkSize(ESP.getFreeHeap(), min(TCP_SEGMENT_SIZE, MonitoringWebServer::TX_BUFFER_SIZE));
+        monitor->setContentLength(CONTENT_LENGTH_UNKNOWN);
+        monitor->send(code, contentType, "");
+        active = true;
+        pos = 0;
+    }
+
+    size_t getChunkSize() const { return chunkSize; }
+
+    // 字串常值的 strlen 在內聯後由編譯器求值；已知長度時直接呼叫 append(content, len)
     void append(const char* content) {
+        append(content, strlen(content));
+    }
+
+    void append(const String& content) {
+        append(content.c_str(), content.length());
+    }
+
+    void append(const char* content, size_t len) {
         if (!active) return;
-        size_t len = strlen(content);
-        size_t i = 0;
-        while (i < len) {
-            size_t n = min(len - i, CHUNK_SIZE - pos);
-            memcpy(buffer + pos, content + i, n);
+        while (len > 0) {
+            if (pos == 0 && len >= chunkSize) {
+                sendChunk(content, chunkSize);
+                content += chunkSize;
+                len -= chunkSize;
+                continue;
+            }
+            size_t n = min(len, chunkSize - pos);
+            memcpy(buffer + pos, content, n);
             pos += n;
-            i += n;
-            if (pos >= CHUNK_SIZE) flush();
+            content += n;
+            len -= n;
+            if (pos >= chunkSize) flush();
         }
     }
 
+    // ESP32 的 flash 映射在資料位址空間，PROGMEM 內容可直接以指標讀取並送出
+    void append_P(PGM_P content) {
+        append(content, strlen_P(content));
+    }
+
+    void append_P(PGM_P content, size_t len) {
+        append(content, len);
+    }
+
     void appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
-        char tmp[256];
+        if (!active) return;
         va_list args;
         va_start(args, fmt);
-        int n = vsnprintf(tmp, sizeof(tmp), fmt, args);
+        vappendf(fmt, args);
         va_end(args);
-        if (n > 0) append(tmp);
+    }
+
+    void vappendf(const char* fmt, va_list args) {
+        if (!active) return;
+        va_list retry;
+        va_copy(retry, args);
+        size_t space = chunkSize - pos;
+        int n = vsnprintf(buffer + pos, space + 1, fmt, args);
+        if (n >= 0 && (size_t)n <= space) {
+            pos += n;
+            if (pos >= chunkSize) flush();
+        } else if (n > 0) {
+            // 已寫入的前段就是正確輸出：補滿送出後重新格式化，只保留尾段
+            pos = chunkSize;
+            flush();
+            size_t rest = n - space;
+            if ((size_t)n <= chunkSize) {
+                vsnprintf(buffer, chunkSize + 1, fmt, retry);
+                memmove(buffer, buffer + space, rest);
+                pos = rest;
+            } else {
+                // 單筆輸出比整個分塊還大（罕見）才暫用堆積
+                char* tmp = (char*)malloc(n + 1);
+                if (tmp) {
+                    vsnprintf(tmp, n + 1, fmt, retry);
+                    append(tmp + space, rest);
+                    free(tmp);
+                }
+            }
+        }
+        va_end(retry);
     }
 
     void flush() {
         if (!active || pos == 0) return;
-        buffer[pos] = '\0';
-        server->sendContent(buffer);
+        // 以指標+長度送出，避免每個分塊再建立一個臨時 String
+        sendChunk(buffer, pos);
         pos = 0;
     }
 
     void finish() {
         if (!active) return;
         flush();
-        server->sendContent("");
+        sendChunk("", 0);
         active = false;
     }
 };
+
+// API 端點用的 JSON 串流寫入器
+using JsonResponse = JsonWriter<StreamingResponse>;
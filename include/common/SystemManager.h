@@ -2,12 +2,13 @@
 
 #include <Arduino.h>
 #include "WiFi.h"
-#include "WebServer.h"
 #include "ArduinoOTA.h"
+#include "LoopProfiler.h"
 
 // 前向宣告
 class ConfigManager;
 class WiFiManager;
+class MonitoringWebServer;
 class OTAManager;
 class IThermostatControl;
 class MockThermostatController;
@@ -25,7 +26,6 @@ private:
         unsigned long nextPowerCheck;
         unsigned long nextPairingCheck;
         unsigned long nextHeartbeat;
-        unsigned long nextWebServerHandle;
         unsigned long nextWiFiCheck;
         unsigned long homeKitReadyTime;
         
@@ -33,7 +33,6 @@ private:
         bool webServerStartScheduled;
         bool homeKitStabilized;
         bool wasPairing;
-        int webServerSkipCounter;
         uint32_t avgMemory;
         
         // 循環計數器優化 - 減少毫秒調用
@@ -41,16 +40,19 @@ private:
         uint16_t fastLoopDivider;
         
         OptimizedTimingSystem() : nextPowerCheck(0), nextPairingCheck(0), nextHeartbeat(0),
-                                 nextWebServerHandle(0), nextWiFiCheck(0), homeKitReadyTime(0),
+                                 nextWiFiCheck(0), homeKitReadyTime(0),
                                  webServerStartScheduled(false), homeKitStabilized(false),
-                                 wasPairing(false), webServerSkipCounter(0), avgMemory(0),
+                                 wasPairing(false), avgMemory(0),
                                  loopCounter(0), fastLoopDivider(100) {}
     } state;
     
+    // 主迴圈各階段耗時與間隔抖動（/api/perf/loop）
+    LoopProfiler profiler;
+    
     // 系統組件引用
     ConfigManager& configManager;
     WiFiManager*& wifiManager;
-    WebServer*& webServer;
+    MonitoringWebServer*& webServer;
     IThermostatControl*& thermostatController;
     #ifndef DISABLE_MOCK_CONTROLLER
     MockThermostatController*& mockController;
@@ -81,12 +83,10 @@ private:
     
     // 輔助方法
     bool shouldStartWebServer(unsigned long currentTime) const;
-    unsigned long calculateWebServerInterval(uint32_t freeMemory);
-    bool shouldSkipWebServerProcessing() const;
     void updatePairingDetection(uint32_t currentMemory);
     
 public:
-    SystemManager(ConfigManager& config, WiFiManager*& wifi, WebServer*& web,
+    SystemManager(ConfigManager& config, WiFiManager*& wifi, MonitoringWebServer*& web,
                  IThermostatControl*& controller, 
                  #ifndef DISABLE_MOCK_CONTROLLER
                  MockThermostatController*& mock,
@@ -116,4 +116,9 @@ public:
      * 檢查是否需要啟動 WebServer 監控
      */
     bool shouldStartMonitoring() const;
+    
+    /**
+     * 主迴圈階段分析
+     */
+    LoopProfiler& getLoopProfiler() { return profiler; }
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Metrics.h"
+
+// 遙測快照：控制器狀態、感測值、S21 通訊品質與堆積
+// 由端點取樣一次後交給 writeTelemetry()，JSON 與 CBOR 輸出同一份欄位
+struct TelemetrySnapshot {
+    uint32_t uptime = 0;
+
+    bool controller = false;
+    bool power = false;
+    uint8_t mode = 0;               // HomeKit 目標模式
+    float targetTemp = 0;
+    uint8_t fanSpeed = 0;
+    bool swingV = false;
+    bool swingH = false;
+    bool healthy = true;
+    uint32_t errors = 0;
+
+    float currentTemp = NAN;
+    bool wifi = false;
+    int32_t rssi = 0;
+
+    uint32_t s21Commands = 0;
+    uint32_t s21Errors = 0;
+    uint32_t s21RetriesTimeout = 0;
+    uint32_t s21RetriesChecksum = 0;
+    uint32_t s21RetriesOther = 0;
+    float s21Quality = 0;
+    float s21AvgResponseMs = 0;
+
+    uint32_t freeHeap = 0;
+    uint32_t minFreeHeap = 0;
+    uint32_t maxAllocHeap = 0;
+    uint32_t avgFreeHeap = 0;
+
+    // S21 與平均堆積取自指標註冊表，其餘欄位由呼叫者填入
+    void captureMetrics() {
+        s21Commands = Metrics::s21Commands.get();
+        s21Errors = Metrics::s21Errors.get();
+        s21RetriesTimeout = Metrics::s21RetriesTimeout.get();
+        s21RetriesChecksum = Metrics::s21RetriesChecksum.get();
+        s21RetriesOther = Metrics::s21RetriesOther.get();
+        s21Quality = Metrics::s21QualityScore.get();
+        uint32_t responses = Metrics::s21ResponseMs.getCount();
+        s21AvgResponseMs = responses ? (float)Metrics::s21ResponseMs.getSum() / responses : 0;
+        avgFreeHeap = (uint32_t)Metrics::avgFreeHeap.get();
+    }
+};
+
+// 欄位描述：Writer 為 JsonWriter 或 CborWriter，兩種格式的欄位名稱與結構完全相同
+template <typename Writer>
+void writeTelemetry(Writer& out, const TelemetrySnapshot& t) {
+    out.beginObject().field("uptime", t.uptime);
+
+    if (t.controller) {
+        out.beginObject("controller")
+            .field("power", t.power)
+            .field("mode", t.mode)
+            .field("targetTemp", t.targetTemp)
+            .field("fanSpeed", t.fanSpeed)
+            .field("swingV", t.swingV)
+            .field("swingH", t.swingH)
+            .field("healthy", t.healthy)
+            .field("errors", t.errors)
+            .endObject();
+    }
+
+    out.beginObject("sensors").field("currentTemp", t.currentTemp);
+    if (t.wifi) out.field("rssi", t.rssi);
+    else out.field("rssi", nullptr);
+    out.endObject();
+
+    out.beginObject("s21")
+        .field("commands", t.s21Commands)
+        .field("errors", t.s21Errors)
+        .beginObject("retries")
+            .field("timeout", t.s21RetriesTimeout)
+            .field("checksum", t.s21RetriesChecksum)
+            .field("other", t.s21RetriesOther)
+        .endObject()
+        .field("quality", t.s21Quality)
+        .field("avgResponseMs", t.s21AvgResponseMs)
+        .endObject();
+
+    out.beginObject("heap")
+        .field("free", t.freeHeap)
+        .field("minFree", t.minFreeHeap)
+        .field("maxAlloc", t.maxAllocHeap)
+        .field("avgFree", t.avgFreeHeap)
+        .endObject();
+
+    out.endObject();
+}
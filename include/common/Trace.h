@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Arduino.h>
+#include "JsonWriter.h"
+
+// 追蹤區段（在 build_flags 加 -DTRACE_SPANS 時編入）
+// TRACE_SCOPE("name") 在作用域開始與結束時讀取 CPU 週期計數器，離開作用域時寫入環形緩衝一筆記錄，
+// 滿了覆蓋最舊的記錄。名稱只存指標，必須是常駐字串（字面常數或 WebServer 路由表中的路徑）。
+// 未定義 TRACE_SPANS 時巨集展開為空敘述，參數不求值，不佔程式碼與 RAM。
+// /api/trace 匯出 Chrome trace-event JSON，可直接在 chrome://tracing 或 ui.perfetto.dev 開啟。
+// 只在主迴圈任務中記錄（HomeSpan、S21、WebServer 處理器都在這個任務），不需要鎖。
+
+#ifdef TRACE_SPANS
+
+#ifndef TRACE_CAPACITY
+#define TRACE_CAPACITY 256      // ESP32 上每筆 16 bytes
+#endif
+
+class TraceBuffer {
+public:
+    static constexpr size_t CAPACITY = TRACE_CAPACITY;
+
+    struct Span {
+        uint64_t start;         // 開機後的週期數（已處理 32 位元繞回）
+        uint32_t cycles;        // 持續週期數
+        const char* name;
+    };
+
+    static TraceBuffer& getInstance() {
+        static TraceBuffer instance;
+        return instance;
+    }
+
+    static uint32_t now() { return ESP.getCycleCount(); }
+
+    // 區段結束時呼叫；start 為區段開始時的 now()
+    void record(const char* name, uint32_t start) {
+        uint32_t end = now();
+        // 32 位元計數器在 240 MHz 約 18 秒繞回一次；主迴圈每輪都會記錄，相鄰兩次之間不會繞回兩次
+        if (end < lastEnd) epoch += 1ULL << 32;
+        lastEnd = end;
+        uint32_t cycles = end - start;
+        Span& span = spans[head];
+        span.start = (epoch | end) - cycles;
+        span.cycles = cycles;
+        span.name = name;
+        head = (head + 1) % CAPACITY;
+        if (count < CAPACITY) count++;
+        else overwritten++;
+        total++;
+    }
+
+    // 由舊到新走訪（依結束時間排列）：fn(const Span&)
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        size_t first = (head + CAPACITY - count) % CAPACITY;
+        for (size_t i = 0; i < count; i++) fn(spans[(first + i) % CAPACITY]);
+    }
+
+    // Chrome trace-event 格式（"X" 完整事件，時間單位為微秒）
+    template <typename Sink>
+    void writeJSON(JsonWriter<Sink>& json) const {
+        double mhz = ESP.getCpuFreqMHz();
+        json.beginObject();
+        json.beginArray("traceEvents");
+        json.beginObject()
+            .field("name", "thread_name")
+            .field("ph", "M")
+            .field("pid", 1)
+            .field("tid", 1)
+            .beginObject("args").field("name", "loopTask").endObject()
+            .endObject();
+        forEach([&json, mhz](const Span& span) {
+            json.beginObject()
+                .field("name", span.name)
+                .field("ph", "X")
+                .field("ts", span.start / mhz, 3)
+                .field("dur", span.cycles / mhz, 3)
+                .field("pid", 1)
+                .field("tid", 1)
+                .endObject();
+        });
+        json.endArray();
+        json.field("displayTimeUnit", "ms");
+        json.beginObject("otherData")
+            .field("cpuMHz", ESP.getCpuFreqMHz())
+            .field("capacity", (uint32_t)CAPACITY)
+            .field("recorded", total)
+            .field("overwritten", overwritten)
+            .endObject();
+        json.endObject();
+    }
+
+    void clear() { head = count = 0; }
+    size_t size() const { return count; }
+    uint32_t getRecorded() const { return total; }
+    uint32_t getOverwritten() const { return overwritten; }
+
+private:
+    Span spans[CAPACITY];
+    size_t head = 0;
+    size_t count = 0;
+    uint32_t total = 0;
+    uint32_t overwritten = 0;
+    uint64_t epoch = 0;         // 繞回次數 << 32
+    uint32_t lastEnd = 0;
+
+    TraceBuffer() {}
+};
+
+#define TRACE TraceBuffer::getInstance()
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(name), start(TraceBuffer::now()) {}
+    ~TraceScope() { TRACE.record(name, start); }
+
+private:
+    const char* name;
+    uint32_t start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+#else
+
+#define TRACE_SCOPE(name) do {} while (0)
+
+#endif // TRACE_SPANS
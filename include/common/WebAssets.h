@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+// 預先壓縮的靜態網頁資源
+// 內容由 scripts/build_web_assets.py 在建置時從 web/ 產生，
+// 以 gzip 原樣送出（不在設備上壓縮或組字串），並支援 ETag / 304 Not Modified。
+struct WebAsset {
+    const char* name;
+    const char* contentType;
+    const char* cacheControl;
+    const char* etag;           // 強 ETag（含引號）
+    const uint8_t* data;        // gzip 內容（PROGMEM）
+    uint32_t length;
+    uint32_t rawLength;         // 壓縮前大小，僅供統計
+};
+
+#include "common/WebAssetsData.h"
+
+namespace WebAssets {
+
+    struct Stats {
+        uint32_t served;            // 200 回應次數
+        uint32_t notModified;       // 304 回應次數
+        uint32_t bytesSent;         // 實際送出的內容位元組
+        uint32_t maxHandleMicros;
+        uint64_t totalHandleMicros;
+    };
+
+    inline Stats* getStats() {
+        static Stats stats[WEB_ASSET_COUNT] = {};
+        return stats;
+    }
+
+    inline int indexOf(const char* name) {
+        for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+            if (strcmp(WEB_ASSETS[i].name, name) == 0) return i;
+        }
+        return -1;
+    }
+
+    // Server 為 WebServer 或 MonitoringWebServer
+    template <typename Server>
+    void send(Server& server, size_t index) {
+        const WebAsset& asset = WEB_ASSETS[index];
+        Stats& stats = getStats()[index];
+        uint32_t start = micros();
+
+        server.sendHeader("ETag", asset.etag);
+        server.sendHeader("Cache-Control", asset.cacheControl);
+        if (server.header("If-None-Match") == asset.etag) {
+            server.send(304);
+            stats.notModified++;
+        } else {
+            // 所有支援的瀏覽器都接受 gzip，不另外保留未壓縮版本
+            server.sendHeader("Content-Encoding", "gzip");
+            server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+            stats.served++;
+            stats.bytesSent += asset.length;
+        }
+
+        uint32_t elapsed = micros() - start;
+        stats.totalHandleMicros += elapsed;
+        if (elapsed > stats.maxHandleMicros) stats.maxHandleMicros = elapsed;
+    }
+
+    // 將資源掛到指定路徑
+    template <typename Server>
+    bool on(Server& server, const char* uri, const char* name) {
+        int index = indexOf(name);
+        if (index < 0) return false;
+        server.on(uri, HTTP_GET, [&server, index]() { send(server, index); });
+        return true;
+    }
+
+    // 收集條件請求標頭，並把所有資源掛到 /static/<name>
+    // 注意 collectHeaders() 會覆蓋先前的設定，同一個 server 只應呼叫一次
+    template <typename Server>
+    void attach(Server& server) {
+        static const char* headerKeys[] = {"If-None-Match"};
+        server.collectHeaders(headerKeys, 1);
+        for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+            String uri = String("/static/") + WEB_ASSETS[i].name;
+            server.on(uri.c_str(), HTTP_GET, [&server, i]() { send(server, i); });
+        }
+    }
+
+} // namespace WebAssets
@@ -0,0 +1,277 @@
+#pragma once
+
+// 由 scripts/build_web_assets.py 自動產生，請修改 web/ 下的原始檔
+// 只能經由 common/WebAssets.h 引入（依賴其中的 WebAsset 定義）
+
+#include <Arduino.h>
+
+// style.css: 1344 -> 557 bytes
+const uint8_t WEB_ASSET_STYLE_CSS[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x95,0x54,0xcb,0x72,0xa3,0x30,
+    0x10,0xbc,0xfb,0x2b,0x5c,0xe5,0xca,0x2d,0xa4,0xc0,0x98,0x47,0xc4,0x69,0x3f,0x65,
+    0x90,0x46,0xa0,0x8d,0x90,0x28,0x21,0x62,0xbc,0x14,0xff,0xbe,0xe2,0x69,0xe3,0xe4,
+    0xe2,0xe2,0xa6,0xe9,0xe9,0xe9,0x79,0x34,0xb9,0x66,0xb7,0x9e,0x6b,0x65,0x3d,0x0e,
+    0x95,0x90,0x37,0xf2,0xc7,0x08,0x90,0x59,0x05,0xa6,0x10,0x8a,0x04,0x7e,0xdd,0x65,
+    0x39,0xd0,0xaf,0xc2,0xe8,0x56,0x31,0x72,0xe2,0xfe,0xf8,0x0d,0x87,0x0f,0xea,0x52,
+    0x40,0x28,0x34,0x7d,0x05,0x9d,0x77,0x15,0xcc,0x96,0x24,0xf6,0x47,0xf8,0x92,0xea,
+    0x1f,0xa1,0xb5,0xfa,0x31,0xf9,0x5a,0x0a,0x8b,0x59,0x0d,0x8c,0x09,0x55,0x90,0x20,
+    0x1a,0xa9,0xb5,0x61,0x68,0x3c,0x03,0x4c,0xb4,0x0d,0x71,0x2f,0xc3,0xa1,0x0c,0x7a,
+    0xaa,0xa5,0x36,0xe4,0x14,0x86,0x61,0x66,0xb1,0xb3,0x1e,0x48,0x51,0x28,0x42,0x51,
+    0x59,0x34,0x43,0x79,0x7e,0x2f,0xc3,0x07,0x88,0xd3,0x92,0xb7,0xd6,0x6a,0xd5,0x33,
+    0xd1,0xd4,0x12,0x6e,0x44,0x28,0xe9,0x84,0x79,0xb9,0xd4,0xf4,0x6b,0x2b,0x97,0xd6,
+    0xdd,0x71,0x2a,0xb9,0xc8,0x8b,0x9e,0x1a,0xf3,0xfd,0x84,0xe6,0x90,0xcd,0xbc,0xb3,
+    0xd2,0xa9,0x36,0x43,0xaa,0x0d,0x58,0xa1,0x15,0x51,0x5a,0xe1,0x93,0xe2,0x70,0xeb,
+    0x61,0x8e,0xd2,0xd6,0x34,0x2e,0xbf,0xd6,0x62,0xd2,0xba,0x4a,0x23,0xa5,0xfe,0x76,
+    0x93,0xda,0xd7,0x8b,0x20,0xcd,0x87,0x05,0xf0,0xc1,0x40,0x15,0x4f,0x08,0x46,0xc3,
+    0xe8,0x12,0x6d,0x88,0xc6,0x09,0x51,0x0c,0xcc,0x6d,0x07,0x8a,0xe3,0xd8,0x55,0xe1,
+    0xda,0x54,0xde,0xf8,0x54,0xf7,0x0f,0x8b,0x3b,0xfa,0x83,0x84,0x1c,0xe5,0x36,0x98,
+    0x79,0x22,0x33,0xc2,0xcb,0xb5,0xa3,0xad,0xa6,0x0e,0xa6,0xf5,0x5f,0x51,0x14,0xa5,
+    0x25,0xb9,0x96,0x6c,0x38,0x08,0x55,0xb7,0xf6,0xbd,0x41,0x89,0xd4,0xf6,0xf3,0x72,
+    0x03,0xdf,0x7f,0x7b,0x9c,0xe6,0xda,0x77,0xe0,0x0a,0x35,0x5a,0x0a,0x76,0x3c,0x31,
+    0xc6,0x7e,0x9d,0x4f,0xe7,0x35,0xe2,0xdf,0x98,0xb6,0x04,0xdd,0x8b,0x13,0xdd,0x58,
+    0xb0,0x6d,0xb3,0xeb,0x06,0x53,0x7e,0xe1,0xe9,0xfd,0x44,0xfc,0x1f,0x27,0x12,0xde,
+    0x37,0xb8,0xb4,0x78,0xf8,0xb8,0x82,0x51,0x0e,0xbe,0x63,0xe2,0x9c,0x87,0x94,0xbd,
+    0xca,0x24,0x14,0xd7,0xfb,0x1d,0x04,0x48,0x79,0xf0,0x2a,0x0d,0x1a,0xa3,0xf7,0xbb,
+    0xe4,0x29,0x4b,0xd8,0x7a,0x5d,0xa7,0xe4,0x1c,0xd0,0xf3,0xe5,0x55,0xd6,0x79,0x5e,
+    0x1e,0x05,0xc3,0x9e,0xb8,0xf9,0x27,0x87,0xdf,0xd6,0x81,0x78,0xc6,0xf8,0xa7,0xc7,
+    0xf6,0x16,0x5c,0xcb,0x44,0xfb,0x32,0xce,0x00,0xd5,0x76,0x38,0x5c,0x62,0x97,0xfd,
+    0x6d,0x1b,0x2b,0xf8,0xcd,0x1b,0x9d,0xef,0xac,0x48,0x9a,0x1a,0xa8,0x73,0x19,0xda,
+    0x2b,0xa2,0xda,0x38,0x27,0x9a,0x6c,0x5b,0xf4,0x74,0x63,0x0f,0x9a,0x10,0x71,0x5f,
+    0x83,0x48,0x68,0xac,0x47,0x4b,0x21,0x5d,0x57,0xbb,0xac,0xd1,0x50,0x77,0xec,0x7c,
+    0xc9,0xcf,0x97,0xba,0x4e,0xf4,0xf2,0x19,0xf9,0x51,0x32,0xac,0xe0,0x6f,0x90,0x2d,
+    0xae,0xff,0x88,0x98,0x26,0x51,0xc2,0xee,0x4c,0x85,0xd6,0x6c,0x8d,0x9d,0x53,0x48,
+    0x46,0x8f,0x2d,0xa1,0xf5,0x92,0x96,0x28,0xe7,0x34,0xf0,0xef,0xac,0xf3,0x5a,0x97,
+    0xd8,0xe2,0xce,0xc3,0x7f,0x9e,0xbd,0xee,0x8c,0x40,0x05,0x00,0x00,
+};
+
+// index.html: 3028 -> 1378 bytes
+const uint8_t WEB_ASSET_INDEX_HTML[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xad,0x56,0xed,0x6f,0xd3,0x46,
+    0x18,0xff,0x9e,0xbf,0xc2,0xb5,0x00,0xdb,0x6a,0x6a,0xa7,0x43,0x42,0x53,0x13,0xa7,
+    0x82,0xbe,0x08,0x36,0x46,0xa7,0xb5,0x68,0xda,0xc7,0x8b,0x7d,0x49,0x0e,0xec,0x73,
+    0x74,0x77,0x6e,0x1a,0x45,0x95,0xca,0xc4,0xa6,0xb2,0x52,0x3a,0x6d,0xd0,0x6d,0x80,
+    0x86,0x60,0xd2,0xd6,0x51,0x04,0xdb,0xd8,0x0a,0x82,0x4e,0x93,0xf6,0xb7,0x10,0xb7,
+    0xf9,0xc4,0xbf,0xb0,0xe7,0x6c,0xb7,0x71,0xd3,0x17,0x10,0xda,0x27,0xfb,0xee,0xf9,
+    0x3d,0x2f,0xf7,0x7b,0x5e,0xee,0x4a,0x03,0xe3,0x53,0x63,0x33,0x9f,0x7d,0x3c,0xa1,
+    0xd4,0x85,0xef,0x95,0x73,0xa5,0xf8,0x53,0xaa,0x63,0xe4,0x96,0x4b,0x3e,0x16,0x48,
+    0x71,0xea,0x88,0x71,0x2c,0x6c,0xf5,0xe2,0xcc,0xe4,0xd0,0xfb,0x6a,0xb9,0x24,0x88,
+    0xf0,0x70,0x79,0x1c,0x91,0xe9,0x06,0xa2,0x25,0x2b,0x59,0xe6,0x4a,0x1e,0xa1,0x97,
+    0x15,0x86,0x3d,0x5b,0xe5,0xa2,0xe5,0x61,0x5e,0xc7,0x58,0xa8,0x4a,0x9d,0xe1,0xaa,
+    0xad,0x5a,0x5c,0x20,0x41,0x1c,0x2b,0x96,0x98,0x0e,0xe7,0xa3,0xb3,0xf6,0x29,0x67,
+    0x18,0xe3,0x02,0xae,0xaa,0xa0,0x6b,0x25,0xfe,0x2a,0x81,0xdb,0x82,0x95,0x4b,0x66,
+    0x15,0xc7,0x43,0x9c,0xdb,0xaa,0x13,0x50,0x81,0x08,0xc5,0x4c,0xa2,0xea,0xc3,0x3d,
+    0xaf,0xf0,0xbf,0x07,0x28,0x1d,0x84,0x7c,0xc8,0x41,0xcc,0x85,0x10,0xeb,0x27,0xcb,
+    0x5b,0x4f,0x5f,0x6e,0xfd,0xf5,0xfb,0xd6,0xd2,0x42,0xf4,0xc5,0x12,0xc0,0x4f,0x1e,
+    0x08,0x27,0x02,0xfb,0x00,0xe7,0x60,0xb2,0x4f,0xe2,0xa1,0x0a,0xf6,0xd4,0xf2,0xf6,
+    0xda,0xf7,0xd1,0x97,0x1b,0xdd,0xf5,0x9b,0x23,0x25,0x4b,0xa2,0x0e,0xc4,0xce,0x22,
+    0x2f,0xc4,0xaa,0x42,0x5c,0x5b,0x85,0x73,0x34,0xd4,0xf2,0xd0,0x0e,0xd8,0x02,0x97,
+    0xef,0xe6,0xb8,0x7b,0x65,0x69,0xfb,0xfe,0xf5,0xe8,0x87,0xcf,0xbb,0xb7,0x9e,0xbd,
+    0xa5,0xef,0xb0,0x21,0x88,0x8f,0x0f,0xf6,0x2e,0xe5,0xc8,0x51,0x95,0x38,0x01,0xb6,
+    0xea,0x12,0xde,0xf0,0x50,0x6b,0x84,0x06,0x14,0xab,0xef,0x18,0xe0,0x9d,0x97,0xd1,
+    0x8b,0xaf,0xdf,0x32,0xb4,0x46,0xd0,0x94,0x29,0xfc,0x1f,0x78,0x89,0x5e,0xac,0x77,
+    0x5e,0xfc,0xfc,0x96,0x6e,0xc1,0xd8,0x01,0xd9,0x38,0xda,0x79,0xac,0xd8,0x24,0x55,
+    0xf2,0x49,0xd0,0x3c,0x84,0xaf,0x23,0xc2,0xfb,0x94,0x4c,0x92,0x37,0x06,0xa7,0xa4,
+    0x8b,0x5a,0x10,0xb8,0x3d,0x7f,0x47,0x06,0x9a,0xc6,0xe1,0x23,0x56,0x23,0x74,0x48,
+    0x04,0x8d,0x91,0xf7,0x0a,0x8d,0xb9,0xa2,0xc0,0x73,0x62,0x08,0x79,0xa4,0x46,0x47,
+    0x1c,0x4c,0x05,0x66,0x45,0x99,0x4d,0xb4,0xd3,0x75,0xb1,0xd9,0x9d,0x08,0x2a,0xa1,
+    0x10,0x01,0x4d,0x42,0x2c,0x59,0x28,0x8b,0xab,0x07,0x3e,0xbe,0x4c,0xc4,0x3e,0xe8,
+    0x59,0xd8,0xff,0x90,0x88,0x3e,0x34,0x27,0x7e,0xe8,0x41,0x3b,0x03,0xa2,0x4f,0x21,
+    0x3e,0x0b,0x88,0x4f,0x3b,0x82,0xcc,0xe2,0x43,0xd8,0x8b,0xd6,0xee,0x47,0xdf,0x3e,
+    0x8a,0x6e,0xfc,0xd2,0x59,0xdc,0x38,0xd4,0x32,0x1c,0xb1,0x56,0xf3,0x70,0x9f,0x03,
+    0x85,0x63,0x18,0x08,0x2e,0x62,0xad,0x5d,0x57,0x33,0x29,0xee,0x28,0x57,0x6b,0xf7,
+    0x3b,0x9b,0x2b,0x7d,0xae,0x02,0x81,0x0e,0x37,0x5e,0x9e,0x9a,0x39,0xdd,0x87,0x77,
+    0x71,0x25,0xac,0x1d,0xa1,0x31,0x2e,0xe5,0x89,0xce,0xde,0xec,0x71,0x87,0x91,0x86,
+    0x28,0xe7,0x00,0xc9,0x05,0x84,0x69,0xb7,0xe7,0x8b,0x39,0x0f,0x0b,0xa5,0x82,0x38,
+    0xb6,0x0b,0x79,0xf9,0x39,0x2d,0xec,0x71,0x24,0xb0,0x49,0x83,0xa6,0x6e,0xe4,0x1b,
+    0x81,0x07,0xb3,0xb4,0x66,0xd3,0xd0,0xf3,0x8a,0xb9,0x6a,0x48,0x1d,0xc9,0x88,0x72,
+    0x4c,0x27,0xae,0xd1,0x66,0x58,0x84,0x8c,0x2a,0x6e,0xe0,0x84,0x3e,0x64,0xdc,0xac,
+    0x61,0x31,0xe1,0x61,0xf9,0x7b,0xa6,0x75,0xce,0x95,0x90,0xe2,0x7c,0x4f,0xa7,0x81,
+    0x5c,0x9d,0xee,0x2a,0xd1,0xd2,0x70,0x61,0x54,0x2b,0x68,0x83,0x74,0x84,0x66,0x51,
+    0xbc,0x0e,0x7e,0x89,0x9b,0x0f,0x00,0x1a,0x7b,0x31,0x93,0x39,0x9d,0x92,0x69,0x07,
+    0x74,0x54,0xd3,0x46,0x34,0xc9,0xa9,0x96,0xd5,0x63,0x98,0xba,0x98,0xe9,0x46,0x3b,
+    0x47,0xaa,0x3a,0x17,0x66,0x95,0x61,0x7c,0x16,0x06,0xe0,0x80,0x6d,0x87,0x20,0xa9,
+    0xc2,0xdc,0x76,0x8d,0x63,0xba,0x26,0x87,0xa2,0x66,0x98,0xb2,0x58,0xc7,0x60,0x9e,
+    0x43,0xac,0x76,0x06,0x3d,0xa8,0x29,0x95,0x96,0xc0,0x5c,0x2b,0xe6,0xe2,0x40,0x34,
+    0xe4,0x68,0x79,0x90,0xcb,0xd1,0xcf,0x80,0x0a,0xcc,0x8c,0x62,0xea,0x20,0xb3,0xd5,
+    0xce,0x81,0xe1,0x78,0xac,0xec,0xb7,0x1c,0x6f,0x8f,0x6a,0xdd,0xd5,0xa5,0xce,0xad,
+    0x7b,0x10,0x78,0xf7,0xbb,0xbb,0xdd,0xd5,0x6b,0x60,0x3f,0xa3,0x12,0x27,0xf2,0x02,
+    0xf2,0xb1,0xad,0xed,0x69,0x4d,0x6d,0x50,0xef,0x59,0xc8,0xf4,0x29,0x98,0x49,0x57,
+    0x4d,0xc4,0x28,0xa4,0x47,0x33,0x62,0x7b,0x72,0xc4,0xec,0x8f,0xc0,0x09,0x19,0x90,
+    0x23,0x66,0x40,0x68,0x8a,0x60,0x92,0xcc,0x61,0x57,0x1f,0x36,0xe0,0xa4,0x16,0x38,
+    0x00,0xb9,0x80,0x3e,0xc6,0x07,0x88,0xff,0xfd,0x6d,0x0c,0xc2,0x9c,0x4f,0x89,0x48,
+    0xa7,0x50,0xcc,0x86,0xfc,0xdf,0xe5,0x21,0x5e,0x1c,0x4b,0x00,0xfb,0x9d,0x13,0x49,
+    0xa9,0x1e,0xfb,0x61,0x9c,0x13,0x58,0xb8,0x67,0x7c,0x63,0x97,0xde,0xdd,0xfe,0x8c,
+    0xed,0xf6,0x5a,0xce,0xb6,0x6d,0xa0,0x3e,0x16,0x18,0x19,0x6c,0xd2,0x60,0x07,0x61,
+    0x67,0x11,0x81,0xa9,0xe7,0xc5,0xf0,0x4c,0x55,0xf8,0x18,0xce,0xa6,0x43,0xa9,0xe6,
+    0xa6,0x2a,0x97,0xb0,0x23,0x4c,0x20,0x1a,0x06,0x14,0xc4,0x9d,0x77,0x93,0x13,0xb8,
+    0x66,0x72,0x55,0xed,0xa9,0x93,0x76,0xdc,0x0f,0x3b,0xa2,0xe2,0xbe,0xb6,0x80,0xc2,
+    0xdb,0xa9,0xb7,0x3d,0xee,0xe0,0x59,0x71,0xf9,0x62,0xac,0x23,0x0b,0x31,0xed,0x32,
+    0x5b,0xaa,0x0f,0x7e,0x84,0x44,0xdd,0xac,0x7a,0x41,0xc0,0x74,0xbd,0x67,0x68,0x28,
+    0x31,0x6d,0x58,0xc3,0x85,0x42,0xc1,0xc8,0xfb,0x76,0x06,0xc6,0xad,0x53,0x85,0x24,
+    0xaf,0x49,0x18,0x7d,0xe4,0x66,0x90,0xbe,0x44,0x0e,0x42,0x55,0x0c,0xca,0x1e,0xf3,
+    0x8f,0x67,0x57,0xfc,0x78,0x6c,0x25,0xdb,0x87,0x50,0xb4,0x10,0x5e,0x15,0x0b,0xa7,
+    0xae,0x6b,0x16,0x6a,0x10,0x2b,0xa9,0x26,0xe9,0xa0,0x8e,0xa9,0xce,0xec,0x32,0x33,
+    0x2f,0xf1,0x80,0xea,0x46,0xba,0x13,0xd3,0x08,0x75,0x8a,0xa4,0x8a,0x6e,0xd8,0xe5,
+    0xf6,0xbc,0xe4,0xc0,0xb2,0x94,0xce,0xf2,0x53,0x78,0x17,0x44,0x37,0xd6,0xba,0x0b,
+    0x57,0x3a,0x2b,0x0f,0x3b,0xcf,0x37,0xb6,0x1f,0x7f,0xd5,0xb9,0xbe,0xba,0x75,0xfb,
+    0x6a,0xf4,0xe8,0xea,0xab,0xbf,0x97,0x5f,0x6f,0xde,0xe9,0x2e,0xfc,0xb4,0xf5,0xec,
+    0xf6,0xf6,0x83,0xf5,0x68,0xe9,0x9b,0xd7,0x9b,0x8b,0x9d,0xc7,0x0f,0xa2,0xc5,0x8d,
+    0xad,0xf5,0x27,0x9d,0x67,0x7f,0x44,0x2f,0xff,0x79,0xbd,0x79,0x2d,0x5a,0x5c,0x7d,
+    0xf5,0x7c,0x39,0xba,0xf9,0x24,0x5a,0xf9,0x53,0xbe,0x32,0x16,0x16,0x3a,0x77,0x7e,
+    0xec,0x3c,0xbe,0x1d,0xdd,0xbd,0xb7,0xbd,0xf9,0x70,0xfb,0xd7,0x07,0x99,0xf1,0x10,
+    0x56,0xe4,0x10,0xab,0xe0,0xb4,0xd3,0x07,0x9a,0x84,0xba,0x41,0xd3,0x9c,0x98,0x05,
+    0x4e,0xa6,0x83,0x90,0x39,0xd8,0x68,0xef,0x0c,0x2d,0x78,0x29,0x9e,0x93,0x17,0x11,
+    0x74,0x93,0x2e,0xf7,0xf2,0x27,0x0b,0x92,0xe6,0x62,0x32,0x82,0xe0,0x00,0x49,0x86,
+    0x30,0xb7,0x29,0x6e,0x2a,0x19,0x13,0x29,0x2d,0x58,0xee,0x70,0x59,0x52,0x09,0x30,
+    0xa0,0x90,0x39,0x64,0x63,0x38,0xbf,0x60,0xad,0x76,0x52,0x5c,0x1f,0x4c,0x4f,0x5d,
+    0x30,0x1b,0xf2,0x59,0xaa,0xc3,0x94,0x02,0xb9,0x01,0xd4,0x24,0x4c,0xcd,0x19,0xed,
+    0x79,0x18,0xb0,0x98,0x9b,0xc8,0x75,0x63,0xf3,0xe7,0x09,0x87,0xe4,0x41,0xdd,0x68,
+    0x9c,0xa2,0x06,0xd4,0xb5,0xd0,0xf2,0x89,0x55,0xe3,0x10,0x9c,0x8b,0x3d,0x81,0xf6,
+    0x82,0x60,0xf4,0x31,0x16,0x30,0x3b,0x4e,0x04,0x70,0x00,0x5b,0x0c,0x9e,0xac,0xad,
+    0x69,0xc8,0x22,0x86,0x6e,0xc8,0x1c,0xc4,0x1c,0x3b,0x3f,0x35,0x3d,0x31,0x7e,0xe2,
+    0xc4,0x40,0xca,0x89,0xf1,0x26,0x6e,0xe6,0x65,0xad,0x24,0x25,0x02,0x8d,0xd7,0x63,
+    0x1b,0x16,0x19,0x8d,0x5e,0xa1,0xe7,0xe3,0xca,0x2d,0xc2,0x15,0x93,0x5e,0x2e,0x25,
+    0x2b,0x7e,0x39,0xc3,0x33,0x37,0x7e,0xc3,0xff,0x07,0x46,0x06,0x98,0xeb,0xd4,0x0b,
+    0x00,0x00,
+};
+
+// debug.html: 4963 -> 1945 bytes
+const uint8_t WEB_ASSET_DEBUG_HTML[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xa5,0x58,0x51,0x6f,0x1b,0xc7,
+    0x11,0x7e,0xe7,0xaf,0xb8,0x52,0x86,0xef,0x08,0x49,0x47,0x52,0x4e,0x5d,0xe5,0xc8,
+    0xa3,0x91,0xc8,0x36,0x9c,0xda,0x89,0x0a,0x4b,0x41,0x51,0x04,0x81,0x72,0xbc,0x1d,
+    0x92,0x0b,0xdf,0xdd,0x5e,0x76,0x97,0xa2,0x58,0x82,0x80,0x53,0xc0,0x4e,0xd2,0x04,
+    0x4e,0x0b,0xa4,0x69,0xd3,0x00,0x45,0x93,0xd4,0xae,0xe2,0xd4,0x68,0x52,0x37,0x89,
+    0x60,0x1b,0x08,0xd0,0x9f,0x52,0x58,0x94,0xf4,0x94,0xbf,0x90,0xd9,0x3d,0x92,0xba,
+    0xa3,0x45,0x4a,0x8e,0xc1,0x07,0x92,0xbb,0x33,0xdf,0xcc,0x7c,0x33,0x3b,0x3b,0x77,
+    0xd5,0x9f,0x9d,0x5f,0x5d,0x59,0xff,0xcd,0xaf,0x2e,0x18,0x2d,0x19,0x06,0xb5,0x5c,
+    0x55,0x7f,0x55,0x5b,0xe0,0x91,0x5a,0x35,0x04,0xe9,0x19,0x7e,0xcb,0xe3,0x02,0xa4,
+    0x9b,0x7f,0x75,0xfd,0xe2,0xe2,0x72,0xbe,0x56,0x95,0x54,0x06,0x50,0xdb,0xbf,0xfb,
+    0xfd,0xfe,0x17,0x77,0xaa,0xc5,0xe4,0x5f,0xae,0x2a,0x64,0x17,0xbf,0xeb,0x8c,0x74,
+    0x7b,0x0d,0x16,0xc9,0xc5,0x86,0x17,0xd2,0xa0,0xeb,0xbc,0xc0,0xa9,0x17,0x54,0x42,
+    0x8f,0x37,0x69,0xe4,0x94,0x4b,0xf1,0x56,0xa5,0xee,0xf9,0xd7,0x9a,0x9c,0xb5,0x23,
+    0xe2,0xcc,0x35,0x4a,0xea,0x53,0xd1,0x0a,0x82,0xfe,0x16,0x9c,0xf2,0x73,0xf1,0x56,
+    0x3f,0x67,0xc7,0x5e,0x04,0x41,0x2f,0x25,0xd9,0x69,0x51,0x09,0x95,0xd8,0x23,0x84,
+    0x46,0xcd,0x04,0x27,0x85,0x69,0x94,0x2a,0x75,0xc6,0x09,0xf0,0x45,0xee,0x11,0xda,
+    0x16,0xce,0xcf,0x35,0x4a,0x5d,0x46,0x69,0x8c,0xb9,0x52,0xe9,0x17,0x7e,0xdd,0xab,
+    0xf8,0x2c,0x60,0x7c,0x88,0x98,0xa8,0x39,0x11,0x8b,0x0e,0xd1,0x51,0xd9,0x48,0x5b,
+    0x58,0x52,0x4e,0x67,0xe0,0xcf,0xe0,0x8a,0xdf,0xe6,0x02,0x61,0x62,0x46,0x23,0x09,
+    0x1c,0xad,0x09,0xe9,0xc9,0xb6,0xe8,0xa5,0x51,0xc6,0x6e,0xd5,0x99,0x94,0x2c,0x74,
+    0xca,0xb8,0x26,0x58,0x40,0x89,0x31,0x07,0x00,0xfd,0xdc,0x5c,0xc0,0x9a,0x2b,0x18,
+    0xbb,0x47,0x23,0xe0,0x19,0x57,0x1b,0xcb,0xea,0x33,0x72,0x2f,0xa5,0x47,0x08,0xa9,
+    0xb4,0x80,0x36,0x5b,0xd2,0x59,0x2a,0x29,0x27,0xd9,0x26,0xf0,0x46,0xc0,0x3a,0x8b,
+    0x5d,0xc7,0x6b,0x4b,0x96,0x8e,0xa2,0x92,0x4e,0x44,0xc8,0x22,0x26,0x62,0xcf,0x87,
+    0x34,0xdb,0x4b,0x8a,0xa7,0x6a,0x31,0xc9,0x5d,0xb5,0x98,0x64,0x5d,0xe5,0x50,0x15,
+    0x42,0xb9,0x76,0xde,0xa3,0x6b,0x98,0x0a,0x63,0x94,0x6b,0x5c,0xca,0x55,0x09,0xdd,
+    0x34,0xfc,0xc0,0x13,0xc2,0xcd,0xeb,0x34,0x61,0x45,0xb4,0xce,0xd4,0xf6,0xee,0x3f,
+    0xdc,0xfb,0xe6,0xeb,0xbd,0xf7,0xae,0x0f,0x6e,0xbc,0x87,0x82,0x67,0xb2,0x82,0x09,
+    0x37,0xf9,0xda,0xfe,0xf6,0x5f,0x06,0x37,0xbf,0x3d,0xf8,0xf2,0x43,0xc7,0xa8,0x0a,
+    0x85,0x4c,0x89,0x9b,0x6f,0x70,0x80,0x4b,0xe0,0xc5,0xf9,0xda,0x22,0xba,0x82,0xab,
+    0xe8,0x09,0xea,0x1e,0x8d,0x70,0x89,0x85,0x70,0x99,0xca,0xb4,0x7e,0x2b,0x59,0x5a,
+    0x1b,0x4a,0x4c,0x82,0x3c,0x89,0x95,0x72,0x7b,0x08,0x77,0x9c,0xdf,0x07,0x9f,0x3c,
+    0x1c,0x3c,0xf8,0x43,0xda,0x68,0xcc,0x3a,0xc0,0x4f,0xe4,0xf1,0x60,0xfb,0xd3,0xdd,
+    0x47,0x1f,0xa4,0x75,0x43,0x46,0xe0,0x64,0xaa,0x0f,0xbe,0xdc,0x7d,0x70,0x27,0xad,
+    0x2a,0x21,0x3c,0x19,0x4f,0x07,0x9f,0x6d,0x0f,0xde,0x7d,0x3b,0x43,0xb3,0x17,0x3d,
+    0x25,0x39,0x83,0x9d,0x7f,0x25,0x69,0x57,0xac,0xd4,0xdb,0x58,0xc2,0xd1,0x48,0x0a,
+    0x8f,0x56,0xde,0x60,0x91,0x1f,0x50,0xff,0x1a,0x1a,0x85,0x88,0xac,0xb0,0x30,0xf4,
+    0x22,0x62,0x99,0x84,0x7a,0x4d,0x2c,0x35,0x49,0x7d,0x61,0x16,0x54,0xca,0x1f,0x0c,
+    0x3e,0xfa,0xae,0x5a,0x4c,0xf4,0x8f,0x01,0xf2,0x03,0xf0,0xf8,0x15,0xd6,0x14,0x16,
+    0x6a,0x0e,0x76,0x6e,0x1c,0x7c,0xfc,0x8f,0x13,0x6a,0x4a,0xd6,0x6c,0x06,0xb0,0x06,
+    0xaa,0xdd,0x20,0x80,0xd2,0x7f,0xbc,0xf3,0x9f,0xdd,0x0f,0x3e,0x1f,0xfc,0xf9,0xf6,
+    0xfe,0xdd,0xf7,0x4f,0x88,0xd2,0xa1,0x11,0x61,0x1d,0x3b,0x60,0xbe,0x27,0x29,0x8b,
+    0xec,0x16,0x87,0x86,0x6b,0x16,0x4d,0x0c,0xe3,0xfb,0x0f,0x77,0x3f,0xf9,0xdb,0xe3,
+    0x9d,0x87,0x07,0x7f,0x7f,0x2b,0x05,0x36,0x9b,0xbf,0xa1,0xe9,0x71,0x55,0xe9,0x73,
+    0x86,0xf9,0xd7,0x7d,0x65,0xd4,0x14,0xf0,0xa0,0xe6,0x71,0x3f,0xf0,0xea,0x80,0x8d,
+    0x97,0x46,0x71,0x5b,0x1a,0xb2,0x1b,0xa3,0x9c,0xdf,0x02,0xff,0x5a,0x9d,0x6d,0xe5,
+    0x75,0xfe,0x44,0x8b,0x75,0x92,0xf8,0xf2,0x86,0xde,0x01,0x52,0x33,0xb2,0x31,0x26,
+    0x18,0x27,0xc4,0x3a,0x0f,0xf5,0x76,0x33,0x05,0x95,0x1c,0xf2,0x49,0xa8,0x54,0x80,
+    0xd3,0xbd,0xdf,0xdf,0xfe,0xdd,0xc1,0x47,0x5f,0x3b,0xc7,0x18,0x1e,0x12,0x24,0x59,
+    0x4c,0xfd,0xbc,0xb1,0xe9,0x05,0x6d,0xdc,0xc6,0x0e,0x28,0xc6,0x4e,0xa8,0x44,0xb4,
+    0xbc,0xa8,0x89,0xeb,0xa2,0x5d,0x17,0x3e,0xa7,0x75,0x50,0x99,0x34,0x26,0xbd,0x12,
+    0x10,0x80,0x2f,0x75,0x28,0x08,0x70,0x05,0x36,0x91,0xf2,0x69,0xca,0x55,0x16,0xab,
+    0x5c,0x8e,0x0c,0x02,0xe7,0x0c,0x0f,0xee,0xc1,0xfb,0xff,0xde,0xbf,0x8b,0xc5,0x95,
+    0x6c,0x4e,0x0a,0x75,0x3c,0x8e,0x87,0x65,0xff,0xde,0x9d,0xdd,0x3f,0xfe,0x7e,0x9a,
+    0x0c,0x8d,0x1a,0x0c,0x65,0xee,0xbf,0xbd,0xbf,0x3d,0x55,0x06,0x7b,0x73,0x9d,0x09,
+    0xc8,0x1b,0x89,0xc3,0x48,0xf3,0xfe,0x17,0xf7,0xf7,0xfe,0xfb,0xd5,0xa1,0x7c,0x31,
+    0xd9,0xa9,0xfd,0x14,0xee,0x7c,0x6c,0xe4,0x9c,0x05,0x01,0x36,0xa2,0xe3,0x19,0xbc,
+    0xf5,0xcf,0xdd,0x77,0xbe,0xdd,0xfd,0x78,0xfb,0x84,0x55,0x72,0xa4,0x41,0xd5,0x69,
+    0xaf,0x51,0x79,0xbc,0xb5,0x61,0x5b,0x7d,0x16,0x5b,0x62,0xa9,0x3c,0x35,0xa5,0xc6,
+    0xda,0x52,0xd9,0x40,0xda,0x07,0x9f,0xde,0x3c,0xb2,0x52,0x87,0x75,0x31,0xbe,0x5a,
+    0x31,0xdd,0xd7,0x3f,0x1f,0xdc,0xba,0xfd,0x78,0xe7,0x9e,0x6d,0xdb,0x13,0xbd,0x4f,
+    0xc1,0xc6,0x98,0x80,0x00,0xa4,0xd1,0x11,0x6e,0xd4,0x0e,0x82,0x4a,0xae,0xd1,0x8e,
+    0x7c,0x9d,0x48,0xe4,0x38,0xc2,0xfc,0x58,0x85,0x5e,0x0e,0x7f,0x0a,0x25,0xf2,0x2a,
+    0x0f,0x5c,0xb3,0x23,0x9c,0x62,0xd1,0x9c,0x7f,0xa2,0x61,0x60,0xe3,0x8b,0xbc,0x10,
+    0xe6,0x4d,0x67,0xb9,0xb4,0x5c,0x36,0x2b,0x39,0x05,0x09,0x1d,0xe3,0xd7,0x50,0x5f,
+    0x63,0xc8,0x99,0xb4,0x34,0x40,0x41,0x6d,0xd8,0x78,0x25,0xc7,0x10,0xb9,0x56,0xc1,
+    0xad,0xf5,0x52,0x01,0x56,0x32,0xfd,0xb4,0x09,0x72,0x23,0xe9,0xea,0x66,0xa1,0x3f,
+    0x54,0x0b,0x41,0x08,0x0f,0x69,0xb1,0x40,0xa9,0xe6,0x24,0xef,0xf6,0x12,0xef,0x88,
+    0xfb,0xcb,0xb5,0xd5,0x57,0x70,0x7e,0xc2,0x91,0xcd,0x02,0x9b,0x78,0xd2,0x43,0x53,
+    0xb4,0x61,0x11,0x5b,0xb3,0xee,0x9a,0x75,0x4f,0xfa,0x2d,0x13,0xc3,0xd1,0x8b,0x84,
+    0xb3,0x38,0x06,0x52,0xc0,0xa1,0x01,0xbb,0xe6,0x05,0xac,0xa7,0xae,0x65,0xfe,0xff,
+    0xfa,0x1d,0x63,0xef,0x4f,0xb7,0x0f,0xde,0xba,0x65,0x98,0xf3,0x63,0x99,0x79,0xd3,
+    0xd8,0xbb,0x77,0xf3,0x87,0x47,0xef,0x20,0x97,0x7b,0xdf,0xfd,0x15,0x77,0x07,0x37,
+    0x3e,0xfb,0xe1,0xd1,0xbb,0xe6,0x82,0x49,0x54,0x2b,0x31,0xd1,0x50,0x83,0x71,0x2b,
+    0x71,0x04,0x36,0x0d,0xd6,0x30,0x88,0x8d,0x47,0x33,0x92,0xa2,0x80,0x59,0x24,0x01,
+    0xbc,0x9c,0xb8,0x6d,0xc1,0x26,0xca,0xf6,0x21,0x10,0x60,0x64,0x37,0x88,0x5a,0xf7,
+    0x95,0x87,0x18,0x59,0xaf,0x9f,0x1b,0xc5,0xeb,0x07,0x78,0x8a,0x34,0x4f,0x38,0x89,
+    0xae,0xd3,0x10,0x58,0x5b,0x5a,0xc3,0xd4,0x2c,0x9c,0x29,0x95,0x4a,0x4a,0xef,0x30,
+    0x69,0x93,0xa0,0xbd,0x0c,0x03,0xa2,0x2b,0xf0,0x1a,0x1d,0x73,0xda,0xcb,0x11,0xe6,
+    0xb7,0x43,0x74,0xd3,0x46,0xaa,0x2f,0x04,0xa0,0x7e,0xbe,0xd8,0x7d,0x09,0xa9,0x1f,
+    0x4d,0x26,0x66,0xc1,0x96,0xb0,0x25,0x55,0x3d,0xe1,0x9e,0x8b,0x50,0x6a,0x67,0x03,
+    0xc7,0xa5,0xb8,0x58,0x2e,0x2d,0x3d,0x87,0xdb,0xec,0x22,0xdd,0x02,0x62,0x95,0x0b,
+    0xf3,0xe6,0xe5,0x17,0x31,0xed,0x53,0x31,0x33,0xd3,0xca,0x04,0x30,0xb1,0x87,0x27,
+    0x6c,0x83,0x46,0x54,0x62,0xa7,0xc7,0x21,0x8d,0x9c,0x33,0x57,0x2f,0x9b,0x8e,0x79,
+    0xe1,0xea,0xd5,0xd5,0xab,0xe6,0x88,0xb6,0x74,0x3c,0x23,0x9d,0x61,0x40,0xa7,0x4f,
+    0xe3,0x4e,0x0b,0x78,0xc8,0xd4,0xc2,0xac,0xf0,0xf4,0x0c,0xf3,0x84,0x0b,0x87,0xba,
+    0xb6,0x16,0x40,0xfb,0xaf,0xa0,0xfd,0xd5,0x8b,0x17,0x67,0x85,0xa5,0x66,0x9a,0x59,
+    0x50,0x6a,0x7f,0x86,0xba,0x9a,0x6b,0x66,0xa9,0x4b,0xbc,0x74,0xf0,0x1c,0x28,0xb1,
+    0x79,0xf3,0x7f,0x5f,0xad,0xcc,0x72,0x05,0x07,0x9d,0x59,0x50,0xb8,0xbd,0x21,0x62,
+    0x00,0x72,0x14,0x97,0x87,0x2d,0x55,0xd3,0x09,0xe6,0xd3,0xf3,0xf7,0xac,0xa4,0xfd,
+    0x24,0xa6,0x9e,0x91,0x9e,0x99,0x9c,0x60,0x27,0xde,0x68,0x70,0x6c,0x6a,0x8a,0x8c,
+    0x4c,0xa3,0x78,0x4d,0xf5,0x61,0xdd,0x22,0x28,0x07,0x7d,0xf4,0xe6,0xcd,0xd7,0xf5,
+    0x42,0x0b,0xb6,0x6c,0x0e,0x71,0x80,0xcf,0x1b,0x56,0xd1,0xb2,0xed,0x42,0xb1,0xb9,
+    0x60,0x9e,0x42,0xe1,0xc2,0x82,0xc2,0x33,0x0b,0x47,0x19,0xc2,0x96,0xad,0xaa,0x77,
+    0x9a,0xe3,0xe3,0xa1,0x05,0xdd,0x1f,0x5e,0x40,0x13,0x0e,0x11,0xdd,0xf0,0x52,0xfd,
+    0xe8,0x88,0x60,0xf4,0x04,0xb5,0x71,0x02,0x53,0xc9,0xac,0x75,0xac,0x2d,0x31,0x14,
+    0x9b,0x6d,0x6c,0xa3,0x45,0x85,0x64,0xbc,0xab,0x4f,0xa7,0x9a,0x79,0x10,0x4d,0x35,
+    0x4b,0x75,0xe9,0xe0,0xdf,0xa4,0x57,0xea,0xf5,0xb4,0x0d,0x5c,0xc8,0x18,0x48,0xf7,
+    0xb8,0xd4,0x7d,0x31,0xba,0x9a,0xf4,0x05,0x2a,0xdc,0xd7,0xf0,0x8e,0x1b,0x47,0xf6,
+    0x66,0x1b,0x78,0x77,0x4d,0xcf,0x18,0x8c,0xbf,0x10,0x04,0x96,0x69,0x6b,0x31,0x67,
+    0x18,0x95,0x59,0x78,0xdd,0x0e,0xbd,0xd8,0x02,0xb7,0x06,0xb6,0xbe,0x7a,0xd1,0x50,
+    0xe6,0xfe,0x19,0x1b,0x32,0x17,0x7a,0x89,0x05,0x27,0xf9,0x5a,0x08,0xd4,0xdc,0xe5,
+    0x4c,0x25,0x71,0x34,0x99,0x21,0x85,0x1a,0xb8,0x9f,0x6d,0xd2,0x69,0x23,0x7e,0x48,
+    0x16,0xf0,0xce,0xf2,0x42,0xe1,0xf6,0xfa,0x49,0xbb,0xee,0x88,0xd3,0xa7,0xb1,0xf7,
+    0x73,0x7c,0x24,0xed,0xaa,0x66,0x89,0x7c,0xba,0xe5,0x02,0xae,0x28,0x3d,0x4b,0xdf,
+    0x72,0x42,0x72,0x7c,0xd2,0xa5,0x8d,0xae,0x85,0xb7,0x9f,0x06,0x72,0x14,0x10,0x86,
+    0x9f,0x60,0xf5,0x0b,0x59,0x8b,0x99,0xf4,0xa9,0xe4,0xa9,0x34,0x8d,0xd9,0xf3,0xdd,
+    0x59,0x91,0x8c,0x67,0x09,0x95,0x88,0xa1,0x82,0x7a,0x8f,0xe0,0x26,0xa9,0x1e,0xe5,
+    0xda,0x3c,0x67,0xce,0x95,0x4a,0xcb,0x78,0x23,0x99,0xce,0x78,0x07,0xeb,0x1d,0x97,
+    0x9f,0x7f,0xfe,0xec,0x59,0xb5,0xac,0x04,0xce,0x9e,0xf5,0x7d,0x3c,0xa3,0xbe,0x4d,
+    0xf1,0x0a,0xe3,0x97,0xd6,0x5f,0xbe,0x32,0xef,0xbe,0x91,0x3c,0xaa,0x0d,0xa7,0xec,
+    0xe4,0x25,0xc5,0xa9,0x9e,0xfe,0xee,0xe7,0x6b,0xa7,0x7a,0xca,0xe3,0xfe,0xe8,0xf1,
+    0xad,0xce,0x6b,0x6f,0x28,0x7d,0xcc,0x0c,0x76,0xab,0x75,0x16,0xbb,0xa3,0xdf,0x97,
+    0xf4,0xcb,0x01,0x7d,0xe7,0xfb,0x58,0xba,0x34,0x20,0x1c,0x22,0x3b,0x80,0xa8,0x29,
+    0x5b,0xb5,0x32,0xde,0x94,0x3e,0x72,0x1a,0xb2,0x4d,0x58,0x51,0x7b,0x28,0xd3,0xa0,
+    0x5c,0x48,0xfd,0x27,0xcb,0x56,0xea,0x59,0x6c,0x46,0x0f,0xcc,0x52,0x73,0x18,0x8f,
+    0x6b,0x9a,0x19,0xb4,0x27,0x9e,0xcf,0x46,0xb4,0x43,0xe4,0xd5,0x03,0x20,0xee,0x53,
+    0x9d,0xc5,0xc9,0x12,0x55,0x23,0xd2,0xe1,0x59,0xd3,0x75,0x89,0xd5,0x9a,0xd4,0xe7,
+    0xd0,0xc0,0xb9,0x25,0xa7,0x94,0x54,0xe0,0x78,0xa4,0x53,0x28,0xf2,0x25,0xf5,0xfa,
+    0x06,0xeb,0xd3,0xd2,0x53,0xd8,0xd4,0xc2,0x9b,0x3e,0x92,0x2d,0x20,0xa9,0x7a,0x00,
+    0xc1,0xdc,0x24,0xa3,0x24,0x3e,0x1f,0xaa,0x57,0x28,0xf8,0xe0,0xa7,0x5f,0xa9,0xfd,
+    0x08,0x04,0xee,0x2a,0x01,0x63,0x13,0x00,0x00,
+};
+
+#define WEB_ASSET_STYLE_CSS_URL "/static/style.css?v=6c1ee0ef"
+#define WEB_ASSET_INDEX_HTML_URL "/static/index.html?v=23e22e1c"
+#define WEB_ASSET_DEBUG_HTML_URL "/static/debug.html?v=3cac8ad2"
+
+const WebAsset WEB_ASSETS[] = {
+    {"style.css", "text/css", "public, max-age=31536000, immutable", "\"6c1ee0ef26d248bd\"",
+     WEB_ASSET_STYLE_CSS, sizeof(WEB_ASSET_STYLE_CSS), 1344},
+    {"index.html", "text/html", "no-cache", "\"23e22e1c44d60fee\"",
+     WEB_ASSET_INDEX_HTML, sizeof(WEB_ASSET_INDEX_HTML), 3028},
+    {"debug.html", "text/html", "no-cache", "\"3cac8ad2ac98489a\"",
+     WEB_ASSET_DEBUG_HTML, sizeof(WEB_ASSET_DEBUG_HTML), 4963},
+};
+
+constexpr size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
@@ -3,30 +3,12 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <memory>
+#include "common/WebAssets.h"
 
-namespace WebUI {
+// 共用樣式表：由 WebAssets 以 gzip 提供並長期快取，頁面只需引用
+#define WEBUI_STYLE_LINK "<link rel='stylesheet' href='" WEB_ASSET_STYLE_CSS_URL "'>"
 
-    inline const char* getCompactCSS() {
-        static const char CSS[] PROGMEM =
-            "body{font-family:Arial;margin:10px;background:#f0f0f0}"
-            ".container{max-width:600px;margin:0 auto;background:white;padding:15px;border-radius:5px}"
-            "h1{color:#333;text-align:center}h2,h3{color:#333}"
-            ".button{display:inline-block;padding:8px 15px;margin:5px;background:#007cba;color:white;"
-            "text-decoration:none;border-radius:3px;border:none;cursor:pointer}"
-            ".button:hover{background:#005a8b}.button.danger{background:#dc3545}.button.secondary{background:#666}"
-            ".form-group{margin:10px 0}label{display:block;margin-bottom:3px;font-weight:bold}"
-            "input,select{width:100%;padding:8px;border:1px solid #ddd;border-radius:3px;box-sizing:border-box}"
-            ".status{background:#e8f4f8;padding:10px;border-radius:3px;margin:10px 0}"
-            ".warning{background:#fff3cd;padding:10px;border-radius:3px;margin:10px 0}"
-            ".info{background:#d1ecf1;padding:10px;border-radius:3px;margin:10px 0}"
-            ".error{background:#f8d7da;color:#721c24;padding:10px;border-radius:3px;margin:10px 0}"
-            ".status-card{background:#f8f9fa;border:1px solid #dee2e6;border-radius:5px;padding:15px;margin:15px 0}"
-            ".status-item{display:flex;justify-content:space-between;padding:5px 0;border-bottom:1px solid #eee}"
-            ".status-item:last-child{border-bottom:none}"
-            ".status-label{font-weight:bold;color:#495057}.status-value{color:#6c757d}"
-            ".status-good{color:#28a745}.status-warning{color:#ffc107}.status-error{color:#dc3545}";
-        return CSS;
-    }
+namespace WebUI {
 
     // 通用 snprintf 頁面構建器
     class PageBuilder {
@@ -73,13 +55,13 @@ namespace WebUI {
         String addr = ip.length() > 0 ? ip : WiFi.localIP().toString();
         PageBuilder h(1024);
         h.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>重啟中</title>"
-                 "<style>%s</style></head><body><div class='container'>"
+                 WEBUI_STYLE_LINK "</head><body><div class='container'>"
                  "<h1>設備重啟中</h1>"
                  "<div class='info'><p>請稍候約 30 秒...</p></div>"
                  "<p><a href='http://%s'>http://%s</a></p>"
                  "<script>setTimeout(()=>location='http://%s',30000);</script>"
                  "</div></body></html>",
-                 getCompactCSS(), addr.c_str(), addr.c_str(), addr.c_str());
+                 addr.c_str(), addr.c_str(), addr.c_str());
         return h.toString();
     }
 
@@ -88,7 +70,7 @@ namespace WebUI {
                                    const String& currentSSID = "", bool showWarning = true) {
         PageBuilder h(4096);
         h.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>WiFi 配置</title>"
-                 "<style>%s</style></head><body><div class='container'><h1>WiFi 配置</h1>", getCompactCSS());
+                 WEBUI_STYLE_LINK "</head><body><div class='container'><h1>WiFi 配置</h1>");
         if (showWarning)
             h.append("<div class='warning'>配置新WiFi後設備將重啟。</div>");
         h.append("<h3>可用網路 <button type='button' class='button' onclick='scan()'>重新掃描</button></h3>"
@@ -120,7 +102,7 @@ namespace WebUI {
         String ip = deviceIP.length() > 0 ? deviceIP : WiFi.localIP().toString();
         PageBuilder h(2048);
         h.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>OTA 更新</title>"
-                 "<style>%s</style></head><body><div class='container'><h1>OTA 更新</h1>", getCompactCSS());
+                 WEBUI_STYLE_LINK "</head><body><div class='container'><h1>OTA 更新</h1>");
         h.append("<div class='status'><p>OTA 服務已啟用</p>"
                  "<p><b>主機名:</b> %s</p><p><b>IP:</b> %s</p></div>", hostname.c_str(), ip.c_str());
         h.append("<div class='info'><p>PlatformIO 指令:</p>"
@@ -140,7 +122,7 @@ namespace WebUI {
                                bool homeKitInit = false) {
         PageBuilder h(3072);
         h.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>HomeKit 配置</title>"
-                 "<style>%s</style></head><body><div class='container'><h1>HomeKit 配置</h1>", getCompactCSS());
+                 WEBUI_STYLE_LINK "</head><body><div class='container'><h1>HomeKit 配置</h1>");
         h.append("<div class='status'><p><b>配對碼:</b> %s</p>"
                  "<p><b>設備名稱:</b> %s</p><p><b>QR ID:</b> %s</p>"
                  "<p><b>狀態:</b> %s</p></div>",
@@ -167,7 +149,7 @@ namespace WebUI {
                                    bool currentMode = false) {
         PageBuilder h(1536);
         h.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>切換模式</title>"
-                 "<style>%s</style></head><body><div class='container'><h1>切換運行模式</h1>", getCompactCSS());
+                 WEBUI_STYLE_LINK "</head><body><div class='container'><h1>切換運行模式</h1>");
         h.append("<div class='warning'><p>當前: <b>%s</b></p>"
                  "<p>切換後設備將重啟。</p></div>",
                  currentMode ? "模擬模式" : "真實模式");
@@ -9,6 +9,7 @@
 #include "OTAManager.h"
 #include "LogManager.h"
 #include "WebUI.h"
+#include "StreamingResponse.h"
 #include "esp_wifi.h"
 
 // 前向聲明
@@ -323,6 +324,7 @@ public:
     void startWebServer() {
         if (webServer) delete webServer;
         webServer = new WebServer(80);
+        WebAssets::attach(*webServer);
         
         // 主頁
         webServer->on("/", [this]() {
@@ -411,8 +413,10 @@ public:
     
     // 處理主頁請求
     void handleRoot() {
-        String html = getMainPageHTML();
-        webServer->send(200, "text/html", html);
+        StreamingResponse stream;
+        stream.begin(webServer, "text/html; charset=utf-8");
+        writeMainPage(stream);
+        stream.finish();
     }
     
     // 處理配置頁面請求
@@ -575,27 +579,16 @@ public:
         webServer->send(200, "text/html", html);
     }
     
-    // 處理日誌頁面請求
+    // 處理日誌頁面請求：頁首、日誌列、頁尾依序串流輸出，不複製日誌緩衝區
     void handleLogs() {
-        // 使用簡化版本以提高性能
-        String html = getSimpleLogHTML();
-        webServer->sendHeader("Content-Type", "text/html; charset=utf-8");
-        webServer->send(200, "text/html", html);
-    }
-    
-    String getSimpleLogHTML() {
-        WebUI::PageBuilder h(4096);
-        h.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>日誌</title>"
-                 "<style>%s</style></head><body>"
-                 "<div class='container'><h1>系統日誌</h1><pre>", WebUI::getCompactCSS());
-        auto logs = LOG_MANAGER.getLogs();
-        size_t start = logs.size() > 20 ? logs.size() - 20 : 0;
-        for (size_t i = start; i < logs.size(); i++) {
-            const auto& e = logs[i];
-            h.append("[%lus] [%s] %s\n", e.timestamp / 1000, LOG_MANAGER.getLevelString(e.level), e.message.c_str());
-        }
-        h.append("</pre><div style='text-align:center'><a href='/' class='button secondary'>返回</a></div></div></body></html>");
-        return h.toString();
+        StreamingResponse stream;
+        stream.begin(webServer, "text/html; charset=utf-8");
+        stream.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>日誌</title>"
+                      WEBUI_STYLE_LINK "</head><body>"
+                      "<div class='container'><h1>系統日誌</h1><pre>");
+        LOG_MANAGER.writeLogHTML(stream, 0, 20);
+        stream.append("</pre><div style='text-align:center'><a href='/' class='button secondary'>返回</a></div></div></body></html>");
+        stream.finish();
     }
     
     // 處理清除日誌請求
@@ -605,11 +598,20 @@ public:
         webServer->send(200, "text/plain", "OK");
     }
     
-    // 處理日誌 API 請求
+    // 處理日誌 API 請求：/api/logs?since=<seq>&limit=<n>
+    // 只回傳序號大於 since 的條目；客戶端以回應中的 next 作為下一次的 since
     void handleLogsAPI() {
-        String json = LOG_MANAGER.generateLogJSON();
-        webServer->sendHeader("Content-Type", "application/json; charset=utf-8");
-        webServer->send(200, "application/json", json);
+        uint32_t since = webServer->hasArg("since") ? (uint32_t)webServer->arg("since").toInt() : 0;
+        size_t limit = LogManager::MAX_RESPONSE_ENTRIES;
+        if (webServer->hasArg("limit")) {
+            long requested = webServer->arg("limit").toInt();
+            if (requested > 0 && requested < (long)limit) limit = requested;
+        }
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json; charset=utf-8");
+        JsonResponse json(stream);
+        LOG_MANAGER.writeLogJSON(json, since, limit);
+        stream.finish();
     }
     
     // 處理重啟請求
@@ -869,21 +871,20 @@ public:
 
 private:
     String cachedNetworksJSON;
-    String getMainPageHTML() {
-        String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>DaiSpan</title>"
-                      "<style>" + String(WebUI::getCompactCSS()) + "</style></head><body>"
-                      "<div class='container'><h1>DaiSpan</h1><div class='status'>";
+    void writeMainPage(StreamingResponse& stream) {
+        stream.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>DaiSpan</title>"
+                      WEBUI_STYLE_LINK "</head><body>"
+                      "<div class='container'><h1>DaiSpan</h1><div class='status'>");
         if (isAPMode) {
-            html += "<p>AP 配置模式</p><p>SSID: " + String(AP_SSID) + "</p>";
+            stream.appendf("<p>AP 配置模式</p><p>SSID: %s</p>", AP_SSID);
         } else {
-            html += "<p>WiFi: " + WiFi.SSID() + " (" + String(WiFi.RSSI()) + " dBm)</p>"
-                    "<p>IP: " + WiFi.localIP().toString() + "</p>";
-        }
-        html += "</div><div style='text-align:center'>"
-                "<a href='/config' class='button'>WiFi 設定</a>"
-                "<a href='/restart' class='button'>重啟</a>"
-                "</div></div></body></html>";
-        return html;
+            stream.appendf("<p>WiFi: %s (%d dBm)</p><p>IP: %s</p>",
+                           WiFi.SSID().c_str(), WiFi.RSSI(), WiFi.localIP().toString().c_str());
+        }
+        stream.append("</div><div style='text-align:center'>"
+                      "<a href='/config' class='button'>WiFi 設定</a>"
+                      "<a href='/restart' class='button'>重啟</a>"
+                      "</div></div></body></html>");
     }
 
     String getConfigPageHTML() {
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 批次控制請求：部分目標狀態，只套用有設定的欄位
+// 電源/模式/溫度/風速合併為一個 D1，兩軸擺風合併為一個 D5，送出後以一次 G1 確認
+struct ControlRequest {
+    bool hasPower = false;
+    bool power = false;
+    bool hasMode = false;
+    uint8_t mode = 0;               // AC 模式（AC_MODE_*）；指定模式但未指定電源時視為開機
+    bool hasTemperature = false;
+    float temperature = 0;
+    bool hasFanSpeed = false;
+    uint8_t fanSpeed = 0;           // FAN_AUTO / FAN_SPEED_1..5 / FAN_QUIET
+    bool hasSwingVertical = false;
+    bool swingVertical = false;
+    bool hasSwingHorizontal = false;
+    bool swingHorizontal = false;
+
+    bool hasCoreFields() const { return hasPower || hasMode || hasTemperature || hasFanSpeed; }
+    bool hasSwingFields() const { return hasSwingVertical || hasSwingHorizontal; }
+    bool empty() const { return !hasCoreFields() && !hasSwingFields(); }
+};
+
+// 批次控制結果
+struct ControlResult {
+    enum class Status : uint8_t {
+        Ok = 0,
+        Invalid,        // 欄位不被協議支援或超出範圍（field 指出欄位）
+        Unavailable,    // 協議不可用或在錯誤恢復中
+        BusError        // 命令或確認查詢失敗
+    };
+
+    Status status = Status::Ok;
+    const char* field = nullptr;    // 驗證失敗的欄位
+    const char* error = nullptr;    // 失敗原因
+    bool sentD1 = false;
+    bool sentD5 = false;
+    bool confirmed = false;         // G1 回報的電源/模式/溫度/風速與請求一致
+    uint8_t unconfirmedMask = 0;    // 與請求不一致的欄位（1 << IntentField），空調可能仍在切換
+    uint32_t commandMicros = 0;     // D1 + D5 往返
+    uint32_t confirmMicros = 0;     // G1 往返
+    uint32_t totalMicros = 0;       // 驗證、命令與確認的總時間
+
+    bool ok() const { return status == Status::Ok; }
+};
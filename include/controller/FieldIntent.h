@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+
+// 用戶意圖追蹤的欄位
+enum class IntentField : uint8_t {
+    Power = 0,
+    Mode,
+    TargetTemperature,
+    FanSpeed,
+    SwingVertical,
+    SwingHorizontal,
+    COUNT
+};
+
+// 單一欄位的用戶意圖記錄
+// 用戶設定後的穩定期內，輪詢結果與意圖不符時以意圖為準（記為一次 flap），
+// 空調回報的值一致即視為確認並清除意圖；超過穩定期仍不一致則放棄意圖，接受空調狀態。
+struct FieldIntent {
+    float value;                // 用戶設定的值
+    unsigned long setTime;      // 設定時間
+    unsigned long settleTime;   // 穩定期（ms）
+    bool active;                // 等待空調確認中
+    uint32_t flaps;             // 輪詢值與意圖不符而被壓下的次數
+    uint32_t confirmed;         // 被空調確認的次數
+    uint32_t expired;           // 穩定期結束仍未確認的次數
+};
+
+// 欄位意圖表
+class FieldIntentTracker {
+public:
+    FieldIntentTracker() {
+        for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+            intents[i] = FieldIntent{0, 0, 0, false, 0, 0, 0};
+        }
+    }
+
+    void setSettleTime(IntentField field, unsigned long settleMs) {
+        intents[index(field)].settleTime = settleMs;
+    }
+
+    // 記錄用戶設定
+    void record(IntentField field, float value, unsigned long currentTime) {
+        FieldIntent& intent = intents[index(field)];
+        intent.value = value;
+        intent.setTime = currentTime;
+        intent.active = intent.settleTime > 0;
+    }
+
+    // 用輪詢值對帳，回傳 true 表示意圖仍有效、呼叫者應保留用戶設定的值
+    bool reconcile(IntentField field, float polled, unsigned long currentTime) {
+        FieldIntent& intent = intents[index(field)];
+        if (!intent.active) return false;
+
+        if (fabsf(polled - intent.value) < MATCH_TOLERANCE) {
+            intent.active = false;
+            intent.confirmed++;
+            return false;
+        }
+
+        if (currentTime - intent.setTime < intent.settleTime) {
+            intent.flaps++;
+            return true;
+        }
+
+        intent.active = false;
+        intent.expired++;
+        return false;
+    }
+
+    void clear(IntentField field) { intents[index(field)].active = false; }
+    bool isActive(IntentField field) const { return intents[index(field)].active; }
+    const FieldIntent& get(IntentField field) const { return intents[index(field)]; }
+
+    static const char* getFieldName(IntentField field) {
+        switch (field) {
+            case IntentField::Power: return "power";
+            case IntentField::Mode: return "mode";
+            case IntentField::TargetTemperature: return "targetTemp";
+            case IntentField::FanSpeed: return "fanSpeed";
+            case IntentField::SwingVertical: return "swingVertical";
+            case IntentField::SwingHorizontal: return "swingHorizontal";
+            default: return "unknown";
+        }
+    }
+
+    static constexpr uint8_t FIELD_COUNT = static_cast<uint8_t>(IntentField::COUNT);
+
+private:
+    static constexpr float MATCH_TOLERANCE = 0.05f;  // 溫度以 0.5°C 為步進，足以區分
+    FieldIntent intents[FIELD_COUNT];
+
+    static uint8_t index(IntentField field) { return static_cast<uint8_t>(field); }
+};
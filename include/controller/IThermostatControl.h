@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include "../protocol/IACProtocol.h"
+#include "ControlRequest.h"
 
 // 恆溫器控制介面
 class IThermostatControl {
@@ -30,6 +31,15 @@ public:
   virtual bool setSwing(IACProtocol::SwingAxis axis, bool enabled) = 0;
   virtual bool getSwing(IACProtocol::SwingAxis axis) const = 0;
 
+  // 批次控制：驗證後一次套用多個欄位，回傳 false 時 result 說明原因
+  virtual bool applyControl(const ControlRequest& request, ControlResult& result) = 0;
+
+  // 可選感測器輪詢：有人關注（HomeKit 操作、網頁監控）時以正常頻率查詢，否則降到背景頻率
+  virtual void noteOptionalSensorInterest() = 0;
+
+  // 擺風已註冊為 HomeKit 服務：配對的家庭中樞會持續訂閱，擺風查詢改隨核心輪詢
+  virtual void setSwingExposed(bool exposed) = 0;
+
   // 更新狀態
   virtual void update() = 0;
 };
@@ -43,6 +43,9 @@ public:
     bool supportsSwing(IACProtocol::SwingAxis) const override { return false; }
     bool setSwing(IACProtocol::SwingAxis, bool) override { return false; }
     bool getSwing(IACProtocol::SwingAxis) const override { return false; }
+    bool applyControl(const ControlRequest& request, ControlResult& result) override;
+    void noteOptionalSensorInterest() override {}
+    void setSwingExposed(bool) override {}
 
     void update() override;
     
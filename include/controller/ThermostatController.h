@@ -4,6 +4,7 @@
 #include "../protocol/IACProtocol.h"
 #include "../common/Debug.h"
 #include "../common/ThermostatMode.h"
+#include "FieldIntent.h"
 #include <memory>
 
 // 重構後的通用恆溫器控制器
@@ -20,19 +21,37 @@ private:
     unsigned long lastUpdateTime;
     unsigned long lastSuccessfulUpdate;
     
-    // 用戶互動追蹤，防止設置被queryStatus覆蓋
-    unsigned long lastFanSpeedSetTime;
-    uint8_t lastUserFanSpeed;
-    unsigned long lastModeSetTime;
-    uint8_t lastUserMode;
+    bool swingVertical;
+    bool swingHorizontal;
+    
+    // 用戶意圖追蹤，防止設置在空調確認前被輪詢結果覆蓋
+    FieldIntentTracker intents;
 
     // HomeKit 目標模式（避免 DRY/FAN → AUTO 的有損轉換覆蓋用戶意圖）
     uint8_t targetHomeKitMode;
+
+    // 擺風是否已註冊為 HomeKit 服務（是則 F5 隨核心輪詢，不受關注節流）
+    bool swingExposed;
+
+    // 可選感測器輪詢（HomeKit 未公開的感測器；目前為未註冊 HomeKit 開關時的擺風 F5）
+    unsigned long lastOptionalInterest;
+    unsigned long lastOptionalQueryTime;
+    uint32_t optionalQueries;
+    uint32_t optionalSkipped;
     
     // 錯誤處理和重試邏輯
     static constexpr unsigned long MAX_CONSECUTIVE_ERRORS = 10;     // 容許偶發通訊失敗
     static constexpr unsigned long ERROR_RECOVERY_INTERVAL = 30000; // 30秒恢復間隔
     static constexpr unsigned long UPDATE_INTERVAL = 6000;         // 6秒查詢間隔
+    static constexpr unsigned long OPTIONAL_INTEREST_HOLD = 300000; // 關注後5分鐘內保持正常輪詢
+    static constexpr unsigned long OPTIONAL_IDLE_INTERVAL = 120000; // 無人關注時2分鐘查詢一次
+
+    // 各欄位意圖穩定期（冷暖切換時 AC 需要較長時間切換模式）
+    static constexpr unsigned long POWER_SETTLE_TIME = 10000;
+    static constexpr unsigned long MODE_SETTLE_TIME = 30000;
+    static constexpr unsigned long TEMP_SETTLE_TIME = 10000;
+    static constexpr unsigned long FAN_SETTLE_TIME = 10000;
+    static constexpr unsigned long SWING_SETTLE_TIME = 15000;
 
     // Dirty flags: 恢復後需要重送的命令
     bool dirtyPower = false;
@@ -45,6 +64,11 @@ private:
     bool isInErrorRecoveryMode() const;
     void resetErrorCount();
     void syncDirtyState();
+    void applyPolledStatus(const ACStatus& status, unsigned long currentTime);
+    bool querySwingState(unsigned long currentTime);
+    bool hasOptionalSensorInterest(unsigned long currentTime) const;
+    void pollOptionalSensors(unsigned long currentTime);
+    void initIntentSettleTimes();
     
 public:
     // 構造函數使用協議實例
@@ -79,6 +103,9 @@ public:
     bool supportsSwing(IACProtocol::SwingAxis axis) const override;
     bool setSwing(IACProtocol::SwingAxis axis, bool enabled) override;
     bool getSwing(IACProtocol::SwingAxis axis) const override;
+    bool applyControl(const ControlRequest& request, ControlResult& result) override;
+    void noteOptionalSensorInterest() override { lastOptionalInterest = millis(); }
+    void setSwingExposed(bool exposed) override { swingExposed = exposed; }
 
     void update() override;
 
@@ -94,6 +121,13 @@ public:
     unsigned long getLastUpdateTime() const { return lastUpdateTime; }
     bool isProtocolHealthy() const { return consecutiveErrors < MAX_CONSECUTIVE_ERRORS; }
     void forceResetErrorState() { consecutiveErrors = 0; lastSuccessfulUpdate = millis(); }
+    bool isOptionalPollingActive() const { return hasOptionalSensorInterest(millis()); }
+    uint32_t getOptionalQueries() const { return optionalQueries; }
+    uint32_t getOptionalSkipped() const { return optionalSkipped; }
+    
+    // 用戶意圖追蹤
+    void setIntentSettleTime(IntentField field, unsigned long settleMs) { intents.setSettleTime(field, settleMs); }
+    const FieldIntent& getIntent(IntentField field) const { return intents.get(field); }
     
     // 獲取底層協議實例（用於特殊操作）
     IACProtocol* getProtocol() const { return protocol.get(); }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../controller/IThermostatControl.h"
+#include "../common/Debug.h"
+
+class ThermostatDevice;
+class FanDevice;
+class SwingSwitchService;
+
+// 控制器狀態快照（每輪只讀取一次）
+struct AccessorySnapshot {
+    bool power;
+    uint8_t targetMode;
+    float targetTemperature;
+    float currentTemperature;
+    uint8_t fanSpeed;
+    bool swingVertical;
+    bool swingHorizontal;
+};
+
+// 快照欄位變化位元
+enum AccessoryDirtyField : uint16_t {
+    DIRTY_POWER        = 1 << 0,
+    DIRTY_TARGET_MODE  = 1 << 1,
+    DIRTY_TARGET_TEMP  = 1 << 2,
+    DIRTY_CURRENT_TEMP = 1 << 3,
+    DIRTY_FAN_SPEED    = 1 << 4,
+    DIRTY_SWING_V      = 1 << 5,
+    DIRTY_SWING_H      = 1 << 6,
+    DIRTY_ALL          = 0x7F
+};
+
+// 配件同步協調器
+// 取代各服務各自的 loop() 計時器：每輪讀一次控制器快照，
+// 算出變化位元後只更新受影響的特性，最後統一 flush 通知。
+class AccessorySync {
+public:
+    static constexpr uint8_t MAX_SWING_SERVICES = 2;
+    static constexpr unsigned long SYNC_INTERVAL_MS = 1000;
+
+    struct Stats {
+        uint32_t ticks;             // 執行同步的次數
+        uint32_t dirtyTicks;        // 有欄位變化的次數
+        uint32_t getterCalls;       // 控制器 getter 呼叫總數
+        uint32_t lastTickMicros;    // 最近一輪耗時
+        uint32_t maxTickMicros;     // 最長一輪耗時
+        uint64_t totalTickMicros;   // 累計耗時
+    };
+
+    static AccessorySync& getInstance();
+
+    void begin(IThermostatControl& ctrl, ThermostatDevice* thermostat, FanDevice* fan);
+    void attachSwing(SwingSwitchService* swing);
+
+    // 主迴圈呼叫；未到同步間隔時立即返回
+    void tick(unsigned long currentTime);
+
+    // HomeKit 寫入後強制下一輪立即全量同步
+    void requestFullSync();
+
+    Stats getStats() const { return stats; }
+    const AccessorySnapshot& getSnapshot() const { return snapshot; }
+    uint8_t getGettersPerTick() const { return gettersPerTick; }
+
+private:
+    IThermostatControl* controller;
+    ThermostatDevice* thermostatDevice;
+    FanDevice* fanDevice;
+    SwingSwitchService* swingServices[MAX_SWING_SERVICES];
+    uint8_t swingCount;
+
+    AccessorySnapshot snapshot;
+    bool hasSnapshot;
+    uint16_t carriedDirty;       // 上一輪服務未能處理、需要保留的位元
+    bool fullSyncRequested;
+    bool swingVerticalSupported;
+    bool swingHorizontalSupported;
+    uint8_t gettersPerTick;
+
+    unsigned long lastSyncTime;
+    unsigned long lastHeartbeatTime;
+    Stats stats;
+
+    AccessorySync();
+    AccessorySnapshot readSnapshot();
+    uint16_t diff(const AccessorySnapshot& next) const;
+    void printHeartbeat(unsigned long currentTime) const;
+    void saveCrashSnapshot() const;
+};
+
+#define ACCESSORY_SYNC AccessorySync::getInstance()
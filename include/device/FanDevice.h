@@ -4,6 +4,8 @@
 #include "../controller/IThermostatControl.h"
 #include "../common/Debug.h"
 #include "../common/ThermostatMode.h"
+#include "HomeKitNotifier.h"
+#include "AccessorySync.h"
 
 // HomeKit 風扇速度映射定義 (針對真實AC優化)
 #define HOMEKIT_FAN_OFF     0     // 關閉
@@ -15,8 +17,7 @@
 #define HOMEKIT_FAN_SPEED_4 80    // 4檔 (80%)
 #define HOMEKIT_FAN_SPEED_5 100   // 5檔 (100%)
 
-// 更新間隔設定（優化HomeKit響應速度）
-#define FAN_UPDATE_INTERVAL  2000   // 風扇狀態更新間隔（2秒，快速響應HomeKit操作）
+// 同步設定（同步間隔由 AccessorySync 統一控制）
 #define FAN_SPEED_TOLERANCE  10     // 風扇速度容忍度（10%，減少頻繁調整）
 
 class FanDevice : public Service::Fan {
@@ -24,9 +25,10 @@ private:
     IThermostatControl& controller;
     SpanCharacteristic* fanOn;
     SpanCharacteristic* fanSpeed;
-    unsigned long lastUpdateTime;
     unsigned long lastUserInteraction;  // 最後用戶操作時間
     int lastUserSetSpeed;              // 最後用戶設置的速度
+    int8_t fanOnSlot;                  // HomeKitNotifier slot
+    int8_t fanSpeedSlot;
     
     // 內部輔助方法
     uint8_t homeKitSpeedToACSpeed(int homeKitSpeed);
@@ -35,6 +37,8 @@ private:
     
 public:
     explicit FanDevice(IThermostatControl& ctrl);
-    void loop() override;
     boolean update() override;
+    
+    // 回傳未能處理、需保留到下一輪的變化位元
+    uint16_t applySnapshot(const AccessorySnapshot& snap, uint16_t dirty, unsigned long currentTime);
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "HomeSpan.h"
+#include "../common/Debug.h"
+
+// HomeKit 通知排程器
+// 同一輪 loop 中各服務的特性變化先暫存（stage），flush() 時才一次 setVal，
+// HomeSpan 會在本次 poll() 結束時把它們合併成單一 HAP 事件訊息送出。
+// 每個特性有獨立的最小通知間隔和遲滯，避免 iOS 家居中樞對頻繁通知的配件限流。
+class HomeKitNotifier {
+public:
+    static constexpr uint8_t MAX_SLOTS = 12;
+    static constexpr int8_t INVALID_SLOT = -1;
+
+    // 通知策略
+    struct Policy {
+        unsigned long minIntervalMs;  // 最小通知間隔（0 = 不限制）
+        float hysteresis;             // 變化量小於此值視為無變化（0 = 任何變化）
+        float bypassDelta;            // 變化量達到此值時忽略最小間隔（0 = 不繞過）
+    };
+
+    // 單一特性統計
+    struct SlotStats {
+        const char* name;
+        uint32_t sent;
+        uint32_t suppressed;
+        bool pending;
+    };
+
+    // 全域統計
+    struct Stats {
+        uint32_t sent;        // 實際送出的特性通知
+        uint32_t suppressed;  // 因最小間隔被延後的變化
+        uint32_t batches;     // 含至少一個通知的 flush 次數
+    };
+
+    static HomeKitNotifier& getInstance();
+
+    // 註冊特性，回傳 slot 編號（滿了回傳 INVALID_SLOT）
+    int8_t track(SpanCharacteristic* characteristic, const char* name,
+                 const Policy& policy, bool isFloat);
+
+    // 暫存本輪的新值，回傳 true 表示將在 flush() 時送出
+    bool stage(int8_t slot, float value, unsigned long currentTime);
+
+    // 下一次 stage 忽略最小間隔（用於 HomeKit 寫入後的確認回報）
+    void expedite(int8_t slot);
+
+    // 變化是否正被最小間隔延後
+    bool isPending(int8_t slot) const {
+        return slot >= 0 && slot < slotCount && slots[slot].pending;
+    }
+
+    // 送出本輪暫存的所有變化，回傳送出數量
+    uint8_t flush(unsigned long currentTime);
+
+    Stats getStats() const { return stats; }
+    uint8_t getSlotCount() const { return slotCount; }
+    SlotStats getSlotStats(uint8_t slot) const;
+
+private:
+    struct Slot {
+        SpanCharacteristic* characteristic;
+        const char* name;
+        Policy policy;
+        bool isFloat;
+        bool staged;          // 本輪待送出
+        bool pending;         // 變化被最小間隔延後
+        bool expedited;       // 下次忽略最小間隔
+        float stagedValue;
+        unsigned long lastNotifyTime;
+        uint32_t sent;
+        uint32_t suppressed;
+    };
+
+    Slot slots[MAX_SLOTS];
+    uint8_t slotCount;
+    Stats stats;
+
+    HomeKitNotifier() : slotCount(0), stats{0, 0, 0} {}
+    float currentValue(const Slot& slot) const;
+};
+
+#define HOMEKIT_NOTIFIER HomeKitNotifier::getInstance()
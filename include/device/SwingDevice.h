@@ -4,6 +4,8 @@
 #include "../controller/IThermostatControl.h"
 #include "../protocol/IACProtocol.h"
 #include "../common/Debug.h"
+#include "HomeKitNotifier.h"
+#include "AccessorySync.h"
 
 class SwingSwitchService : public Service::Switch {
 public:
@@ -12,16 +14,16 @@ public:
                        const char* displayName);
 
     boolean update() override;
-    void loop() override;
+
+    // 由 AccessorySync 調用，回傳需保留到下一輪的變化位元
+    uint16_t applySnapshot(const AccessorySnapshot& snap, uint16_t dirty, unsigned long currentTime);
 
 private:
     IThermostatControl& controller;
     IACProtocol::SwingAxis swingAxis;
     SpanCharacteristic* onCharacteristic;
-    unsigned long lastSyncTime;
     bool axisSupported;
-
-    static constexpr unsigned long SYNC_INTERVAL_MS = 2000;
+    int8_t onSlot;  // HomeKitNotifier slot
 
     bool readCurrentState() const;
 };
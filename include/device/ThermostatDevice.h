@@ -3,6 +3,8 @@
 #include "HomeSpan.h"
 #include "../controller/IThermostatControl.h"
 #include "../common/Debug.h"
+#include "HomeKitNotifier.h"
+#include "AccessorySync.h"
 
 // HomeKit 恆溫器模式定義
 #define HAP_MODE_OFF        0
@@ -21,10 +23,12 @@
 #define MAX_TEMP         30.0f   // 最高溫度限制
 #define TEMP_STEP        0.5f    // 溫度調節步長
 
-// 更新間隔設定（毫秒）- 優化HomeKit響應速度  
-#define UPDATE_INTERVAL    1000   // 狀態更新間隔（1秒，確保 HomeKit 狀態同步）
-#define TEMP_UPDATE_PRIORITY_INTERVAL 1000  // 溫度變化時的優先更新間隔（1秒）
-// HEARTBEAT_INTERVAL 已在 Debug.h 中定義
+// 同步間隔由 AccessorySync::SYNC_INTERVAL_MS 統一控制
+
+// HomeKit 通知節流（毫秒 / °C）
+#define CURRENT_TEMP_NOTIFY_INTERVAL  30000  // 當前溫度最多每30秒通知一次
+#define CURRENT_TEMP_NOTIFY_BYPASS    1.0f   // 變化達1°C時立即通知
+#define TARGET_TEMP_NOTIFY_INTERVAL   1000   // 目標溫度通知間隔
 
 class ThermostatDevice : public Service::Thermostat {
 private:
@@ -35,9 +39,13 @@ private:
     SpanCharacteristic* currentMode;
     SpanCharacteristic* targetMode;
     SpanCharacteristic* displayUnits;  // 必需的溫度單位特性
-    unsigned long lastUpdateTime;     // 最後狀態更新時間
-    unsigned long lastHeartbeatTime;  // 最後心跳時間
     unsigned long lastSignificantChange; // 最後重要狀態變化時間
+
+    // HomeKitNotifier slot
+    int8_t currentTempSlot;
+    int8_t targetTempSlot;
+    int8_t currentModeSlot;
+    int8_t targetModeSlot;
     
     // 添加模式文字轉換函數
     static const char* getHomeKitModeText(int mode) {
@@ -54,15 +62,17 @@ private:
     void autoAdjustTemperatureForMode(uint8_t mode);
     void handleSuccessfulUpdate();
     
-    // 同步方法
-    bool syncTargetMode(unsigned long currentTime);
-    bool syncTargetTemperature(unsigned long currentTime);
-    bool syncCurrentTemperature(unsigned long currentTime);
-    bool syncCurrentMode(unsigned long currentTime);
-    uint8_t calculateAutoModeState();
+    // 同步方法（使用 AccessorySync 的快照，不直接呼叫控制器 getter）
+    bool syncTargetMode(const AccessorySnapshot& snap, unsigned long currentTime);
+    bool syncTargetTemperature(const AccessorySnapshot& snap, unsigned long currentTime);
+    bool syncCurrentTemperature(const AccessorySnapshot& snap, unsigned long currentTime);
+    bool syncCurrentMode(const AccessorySnapshot& snap, unsigned long currentTime);
+    uint8_t calculateAutoModeState(const AccessorySnapshot& snap);
     
 public:
     explicit ThermostatDevice(IThermostatControl& ctrl);
-    void loop() override;
     boolean update() override;
+    
+    // 回傳未能處理、需保留到下一輪的變化位元
+    uint16_t applySnapshot(const AccessorySnapshot& snap, uint16_t dirty, unsigned long currentTime);
 }; 
\ No newline at end of file
@@ -42,7 +42,9 @@ public:
     enum class SwingAxis : uint8_t { Vertical = 0, Horizontal = 1 };
     virtual bool supportsSwing(SwingAxis axis) const = 0;
     virtual bool setSwing(SwingAxis axis, bool enabled) = 0;
+    virtual bool setSwingState(bool vertical, bool horizontal) = 0;  // 兩軸一次設定（S21 為單一 D5）
     virtual bool getSwing(SwingAxis axis) const = 0;
+    virtual bool querySwing(ACStatus& status) = 0;  // 可選查詢，不隨 queryStatus 發送
 
     // 協議能力查詢
     virtual bool supportsMode(uint8_t mode) const = 0;
@@ -43,7 +43,9 @@ public:
     // 擺風控制
     bool supportsSwing(SwingAxis axis) const override;
     bool setSwing(SwingAxis axis, bool enabled) override;
+    bool setSwingState(bool vertical, bool horizontal) override;
     bool getSwing(SwingAxis axis) const override;
+    bool querySwing(ACStatus& status) override;
 
     // 協議能力查詢
     bool supportsMode(uint8_t mode) const override;
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+DaiSpan 靜態網頁資源打包
+將 web/ 下的 HTML/CSS/JS 以 gzip 壓縮成 PROGMEM 陣列，
+輸出 include/common/WebAssetsData.h，並以內容雜湊作為 ETag 與快取版本號。
+
+可直接執行，也可作為 PlatformIO 的 pre: extra_script 在每次建置前自動執行；
+輸出內容未變時不改寫檔案，避免觸發不必要的重新編譯。
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+try:
+    Import("env")  # noqa: F821 - PlatformIO (SCons) 環境
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+
+WEB_DIR = os.path.join(PROJECT_DIR, "web")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "common", "WebAssetsData.h")
+
+# 檔名 -> (Content-Type, Cache-Control)
+# 以 {{url:檔名}} 引用的資源帶版本號，可長期快取；HTML 每次以 ETag 重新驗證
+ASSETS = [
+    ("style.css", "text/css", "public, max-age=31536000, immutable"),
+    ("index.html", "text/html", "no-cache"),
+    ("debug.html", "text/html", "no-cache"),
+]
+
+
+def symbol_name(name: str) -> str:
+    return "WEB_ASSET_" + "".join(c if c.isalnum() else "_" for c in name).upper()
+
+
+def build():
+    urls = {}
+    entries = []
+    for name, content_type, cache_control in ASSETS:
+        with open(os.path.join(WEB_DIR, name), "rb") as f:
+            raw = f.read()
+        # 替換對其他資源的引用（被引用者需排在前面）
+        for ref, url in urls.items():
+            raw = raw.replace(("{{url:%s}}" % ref).encode(), url.encode())
+        if b"{{url:" in raw:
+            raise SystemExit(f"[WebAssets] {name} 引用了未定義或順序在後的資源")
+
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        digest = hashlib.sha256(packed).hexdigest()
+        urls[name] = f"/static/{name}?v={digest[:8]}"
+        entries.append((name, content_type, cache_control, digest[:16], raw, packed))
+    return urls, entries
+
+
+def render(urls, entries) -> str:
+    out = [
+        "#pragma once",
+        "",
+        "// 由 scripts/build_web_assets.py 自動產生，請修改 web/ 下的原始檔",
+        "// 只能經由 common/WebAssets.h 引入（依賴其中的 WebAsset 定義）",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for name, _, _, _, raw, packed in entries:
+        sym = symbol_name(name)
+        out.append(f"// {name}: {len(raw)} -> {len(packed)} bytes")
+        out.append(f"const uint8_t {sym}[] PROGMEM = {{")
+        for i in range(0, len(packed), 16):
+            out.append("    " + ",".join(f"0x{b:02x}" for b in packed[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+    for name, url in urls.items():
+        out.append(f"#define {symbol_name(name)}_URL \"{url}\"")
+    out.append("")
+    out.append("const WebAsset WEB_ASSETS[] = {")
+    for name, content_type, cache_control, etag, raw, packed in entries:
+        sym = symbol_name(name)
+        out.append(f"    {{\"{name}\", \"{content_type}\", \"{cache_control}\", \"\\\"{etag}\\\"\",")
+        out.append(f"     {sym}, sizeof({sym}), {len(raw)}}},")
+    out.append("};")
+    out.append("")
+    out.append("constexpr size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    urls, entries = build()
+    content = render(urls, entries)
+
+    existing = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r", encoding="utf-8") as f:
+            existing = f.read()
+    if existing != content:
+        with open(OUTPUT, "w", encoding="utf-8") as f:
+            f.write(content)
+
+    total_raw = sum(len(e[4]) for e in entries)
+    total_packed = sum(len(e[5]) for e in entries)
+    print(f"[WebAssets] {len(entries)} 個資源: {total_raw} -> {total_packed} bytes"
+          f"{'' if existing != content else '（未變更）'}")
+    for name, _, _, etag, raw, packed in entries:
+        print(f"[WebAssets]   {name:<12} {len(raw):>6} -> {len(packed):>5} bytes  ETag {etag}")
+
+
+main()
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+DaiSpan 調試日誌緩衝 RAM 報告
+舊版 DEBUG_*_PRINT 宏在每個呼叫點展開一個 static char buffer[DEBUG_BUFFER_SIZE]，
+現在改由 src/DebugLog.cpp 共用一個格式化緩衝。本工具列出各調試級別下被編譯進韌體的
+呼叫點數量、格式字串位元組（.rodata 的下限），以及舊宏佔用與目前共用緩衝的 .bss 大小。
+
+指定 --elf 時另外掃描韌體符號表，列出實際存在的日誌緩衝（舊版韌體為每個呼叫點的
+區域 static buffer，新版只有一個 scratch），並加總映像中的程式碼、唯讀資料與初始化資料；
+指定兩次 --elf 時列出兩次建置的差異（例如 DEBUG_LEVEL=3 與 4）。
+
+用法:
+    python3 debug_buffer_report.py
+    python3 debug_buffer_report.py --elf ../.pio/build/esp32-c3-supermini-usb/firmware.elf
+    python3 debug_buffer_report.py --elf info/firmware.elf --elf verbose/firmware.elf
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+SOURCE_DIRS = ["src", "include"]
+LEVELS = [("ERROR", 1), ("WARN", 2), ("INFO", 3), ("VERBOSE", 4)]
+CALL = re.compile(r"\bDEBUG_(ERROR|WARN|INFO|VERBOSE)_PRINT\s*\(\s*((?:\"(?:[^\"\\]|\\.)*\"\s*)*)")
+LITERAL = re.compile(r"\"((?:[^\"\\]|\\.)*)\"")
+
+SHT_PROGBITS = 1
+SHT_SYMTAB = 2
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+
+
+def buffer_size() -> int:
+    with open(os.path.join(PROJECT_DIR, "include", "common", "Debug.h"), encoding="utf-8") as f:
+        match = re.search(r"#define\s+DEBUG_BUFFER_SIZE\s+(\d+)", f.read())
+    return int(match.group(1)) if match else 256
+
+
+def literal_bytes(text: str) -> int:
+    """相鄰字串常值合併後的位元組數（跳脫序列算 1 byte，含結尾 NUL）"""
+    total = 1
+    for literal in LITERAL.findall(text):
+        total += len(re.sub(r"\\(x[0-9A-Fa-f]+|[0-7]{1,3}|.)", "_", literal).encode("utf-8"))
+    return total
+
+
+def count_call_sites():
+    counts = {name: 0 for name, _ in LEVELS}
+    format_bytes = {name: 0 for name, _ in LEVELS}
+    for directory in SOURCE_DIRS:
+        for root, _, files in os.walk(os.path.join(PROJECT_DIR, directory)):
+            for name in files:
+                if not name.endswith((".cpp", ".h")) or name == "Debug.h":
+                    continue
+                with open(os.path.join(root, name), encoding="utf-8", errors="replace") as f:
+                    for match in CALL.finditer(f.read()):
+                        counts[match.group(1)] += 1
+                        if match.group(2):
+                            format_bytes[match.group(1)] += literal_bytes(match.group(2))
+    return counts, format_bytes
+
+
+class Elf:
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} 不是 ELF 檔")
+        self.path = path
+        self.is64 = self.data[4] == 2
+        self.endian = "<" if self.data[5] == 1 else ">"
+        data, endian = self.data, self.endian
+        if self.is64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x3A)
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x2E)
+
+        # (name_offset, type, flags, offset, size, link, entsize)
+        self.sections = []
+        for i in range(shnum):
+            base = shoff + i * shentsize
+            if self.is64:
+                name, sh_type, flags, _, offset, sh_size, link, _, _, entsize = struct.unpack_from(endian + "IIQQQQIIQQ", data, base)
+            else:
+                name, sh_type, flags, _, offset, sh_size, link, _, _, entsize = struct.unpack_from(endian + "IIIIIIIIII", data, base)
+            self.sections.append((name, sh_type, flags, offset, sh_size, link, entsize))
+        self.shstrtab = self.sections[shstrndx][3] if shstrndx < len(self.sections) else None
+
+    def string(self, table_offset: int, offset: int) -> str:
+        end = self.data.index(b"\0", table_offset + offset)
+        return self.data[table_offset + offset:end].decode("ascii", "replace")
+
+    def buffers(self, size: int):
+        """符號表中大小等於 DEBUG_BUFFER_SIZE、名稱為 buffer/scratch 的資料物件"""
+        data, endian = self.data, self.endian
+        found = []
+        for _, sh_type, _, offset, sh_size, link, entsize in self.sections:
+            if sh_type != SHT_SYMTAB or entsize == 0:
+                continue
+            strtab_offset = self.sections[link][3]
+            for k in range(sh_size // entsize):
+                base = offset + k * entsize
+                if self.is64:
+                    name_offset, info, _, _, _, sym_size = struct.unpack_from(endian + "IBBHQQ", data, base)
+                else:
+                    name_offset, _, sym_size, info, _, _ = struct.unpack_from(endian + "IIIBBH", data, base)
+                if info & 0xF != 1 or sym_size != size:     # STT_OBJECT
+                    continue
+                name = self.string(strtab_offset, name_offset)
+                if re.search(r"(6buffer|7scratch)(E|_\d+|$)", name):
+                    found.append(name)
+        return found
+
+    def image_size(self):
+        """映像中實際佔空間的區段（SHF_ALLOC + PROGBITS）：程式碼、唯讀資料、初始化資料"""
+        text = rodata = initialized = 0
+        for _, sh_type, flags, _, sh_size, _, _ in self.sections:
+            if sh_type != SHT_PROGBITS or not flags & SHF_ALLOC:
+                continue
+            if flags & SHF_EXECINSTR:
+                text += sh_size
+            elif flags & SHF_WRITE:
+                initialized += sh_size
+            else:
+                rodata += sh_size
+        return {"text": text, "rodata": rodata, "data": initialized, "total": text + rodata + initialized}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DaiSpan 調試日誌緩衝 RAM 報告")
+    parser.add_argument("--elf", action="append", default=[],
+                        help="韌體 ELF，列出實際存在的日誌緩衝與映像大小（可指定兩次比較）")
+    args = parser.parse_args()
+
+    size = buffer_size()
+    counts, format_bytes = count_call_sites()
+    print(f"DEBUG_BUFFER_SIZE = {size} bytes\n")
+    print(f"{'DEBUG_LEVEL':<12} {'呼叫點':>6} {'格式字串':>8} {'舊宏 .bss':>10} {'共用緩衝':>8} {'節省':>8}")
+    enabled = 0
+    strings = 0
+    for name, _ in LEVELS:
+        enabled += counts[name]
+        strings += format_bytes[name]
+        old = enabled * size
+        print(f"{name:<12} {enabled:>6} {strings:>8} {old:>10} {size:>8} {old - size:>8}")
+    print("\n（標頭檔中 inline 函數的呼叫點在連結後只保留一份，實際節省略少於此估計；")
+    print("  格式字串只是 .rodata 的下限，不含呼叫點的程式碼）")
+
+    images = []
+    for path in args.elf:
+        elf = Elf(path)
+        buffers = elf.buffers(size)
+        image = elf.image_size()
+        images.append((path, image))
+        print(f"\n{path}: {len(buffers)} 個日誌緩衝，共 {len(buffers) * size} bytes")
+        for name in buffers[:10]:
+            print(f"  {name}")
+        if len(buffers) > 10:
+            print(f"  ... 另 {len(buffers) - 10} 個")
+        print(f"  映像 {image['total']} bytes（程式碼 {image['text']}、唯讀資料 {image['rodata']}、"
+              f"初始化資料 {image['data']}）")
+
+    if len(images) == 2:
+        (_, before), (_, after) = images
+        print("\n差異（第二個 - 第一個）: " +
+              "、".join(f"{key} {after[key] - before[key]:+d}" for key in ("total", "text", "rodata", "data")))
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except (OSError, ValueError) as e:
+        print(f"錯誤: {e}", file=sys.stderr)
+        sys.exit(1)
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+DaiSpan 二進位日誌離線解碼
+讀取 /api/binlog?format=raw 的傾印（檔案或直接從設備下載），
+以韌體 ELF 中的字串表還原格式字串並格式化輸出。
+
+記錄中的格式字串以相對於錨點字串 "DaiSpan-BinaryLog-Anchor" 的位移儲存，
+因此只需要與設備上相同版本的 firmware.elf（.pio/build/<env>/firmware.elf）。
+
+用法:
+    python3 decode_binlog.py .pio/build/esp32-c3-supermini-usb/firmware.elf binlog.bin
+    python3 decode_binlog.py .pio/build/esp32-c3-supermini-usb/firmware.elf --ip 192.168.4.1
+"""
+
+import argparse
+import re
+import struct
+import sys
+import urllib.request
+
+ANCHOR = b"DaiSpan-BinaryLog-Anchor\0"
+DUMP_MAGIC = b"DSBL"
+LEVELS = {1: "ERROR", 2: "WARN", 3: "INFO", 4: "VERBOSE"}
+ARG_SIZES = {"i": ("<i", 4), "u": ("<I", 4), "I": ("<q", 8), "U": ("<Q", 8), "F": ("<f", 4), "f": ("<d", 8)}
+
+# printf 轉換規格：旗標、寬度、精度、長度修飾詞、轉換字元
+SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(?:hh|h|ll|l|L|q|j|z|t)?([diouxXeEfFgGcsp%])")
+
+
+class Firmware:
+    """韌體 ELF 中所有會載入記憶體的區段（虛擬位址 -> 內容）"""
+
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} 不是 ELF 檔")
+        is64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x3A)
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x2E)
+
+        self.sections = []
+        for i in range(shnum):
+            base = shoff + i * shentsize
+            if is64:
+                _, sh_type, flags, addr, offset, size = struct.unpack_from(endian + "IIQQQQ", data, base)
+            else:
+                _, sh_type, flags, addr, offset, size = struct.unpack_from(endian + "IIIIII", data, base)
+            # SHT_PROGBITS 且 SHF_ALLOC
+            if sh_type == 1 and flags & 0x2 and size > 0:
+                self.sections.append((addr, data[offset:offset + size]))
+
+        self.anchor = None
+        for addr, content in self.sections:
+            index = content.find(ANCHOR)
+            if index >= 0:
+                self.anchor = addr + index
+                break
+        if self.anchor is None:
+            raise ValueError("ELF 中找不到二進位日誌錨點字串（韌體未以 BINARY_DEBUG_LOG 建置？）")
+
+    def string_at(self, offset: int) -> str:
+        address = self.anchor + offset
+        for addr, content in self.sections:
+            if addr <= address < addr + len(content):
+                start = address - addr
+                end = content.find(b"\0", start)
+                return content[start:end if end >= 0 else len(content)].decode("utf-8", "replace")
+        return f"<未知格式字串 {offset:+d}>"
+
+
+def parse_records(dump: bytes):
+    if dump[:4] != DUMP_MAGIC:
+        raise ValueError("不是二進位日誌傾印（缺少 DSBL 檔頭）")
+    header_size = dump[5]
+    pos = 6
+    while pos + header_size <= len(dump):
+        size, level, argc, seq, timestamp, fmt_offset = struct.unpack_from("<HBBIIi", dump, pos)
+        if size < header_size or pos + size > len(dump):
+            break
+        tags = dump[pos + header_size:pos + header_size + argc].decode("ascii", "replace")
+        p = pos + header_size + argc
+        args = []
+        for tag in tags:
+            if tag == "s":
+                length = dump[p]
+                args.append(dump[p + 1:p + 1 + length].decode("utf-8", "replace"))
+                p += 1 + length
+            elif tag in ARG_SIZES:
+                fmt, n = ARG_SIZES[tag]
+                args.append(struct.unpack_from(fmt, dump, p)[0])
+                p += n
+            else:
+                break
+        yield seq, timestamp, level, fmt_offset, args
+        pos += size
+
+
+def format_message(fmt: str, args) -> str:
+    remaining = list(args)
+
+    def take():
+        return remaining.pop(0) if remaining else 0
+
+    def convert(match):
+        flags, width, precision, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        spec = "%" + flags
+        if width == "*":
+            width = str(int(take()))
+        spec += width or ""
+        if precision is not None:
+            spec += "." + (str(int(take())) if precision == "*" else precision)
+        value = take()
+        if conversion == "p":
+            return "0x%x" % int(value)
+        if conversion == "u":
+            conversion = "d"
+        if conversion in "diouxXc" and isinstance(value, float):
+            value = int(value)
+        if conversion in "eEfFgG" and isinstance(value, str):
+            return "?"
+        if conversion == "o" and "#" in spec:
+            # Python 的 %#o 輸出 0o 前綴，C 為 0
+            spec = spec.replace("#", "")
+            value = int(value)
+            return (spec + "s") % (("0%o" % value) if value else "0")
+        try:
+            return (spec + conversion) % value
+        except (TypeError, ValueError):
+            return match.group(0)
+
+    return SPEC.sub(convert, fmt)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DaiSpan 二進位日誌離線解碼")
+    parser.add_argument("elf", help="與設備相同版本的 firmware.elf")
+    parser.add_argument("dump", nargs="?", help="/api/binlog?format=raw 的傾印檔")
+    parser.add_argument("--ip", help="直接從設備下載傾印")
+    parser.add_argument("--port", type=int, default=8080)
+    args = parser.parse_args()
+
+    if args.ip:
+        url = f"http://{args.ip}:{args.port}/api/binlog?format=raw"
+        with urllib.request.urlopen(url, timeout=10) as resp:
+            dump = resp.read()
+    elif args.dump:
+        with open(args.dump, "rb") as f:
+            dump = f.read()
+    else:
+        parser.error("需要傾印檔或 --ip")
+
+    firmware = Firmware(args.elf)
+    for seq, timestamp, level, fmt_offset, values in parse_records(dump):
+        message = format_message(firmware.string_at(fmt_offset), values).rstrip("\r\n")
+        print(f"{seq:>8} [{timestamp:>10}] {LEVELS.get(level, 'UNKNOWN'):<7} {message}")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except (OSError, ValueError) as e:
+        print(f"錯誤: {e}", file=sys.stderr)
+        sys.exit(1)
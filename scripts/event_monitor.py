@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+DaiSpan 即時狀態監看
+訂閱 /api/events（Server-Sent Events），列出快照與差異事件，
+結束時統計事件數與傳輸量，可與定期輪詢 /api/controller、/api/metrics 的成本比較。
+"""
+
+import argparse
+import json
+import time
+import urllib.error
+import urllib.request
+
+
+def read_events(resp):
+    """逐一產生 (event, id, data)；註解行（心跳）以 event=None 回報"""
+    event, event_id, data = "message", None, []
+    for raw in resp:
+        line = raw.decode("utf-8").rstrip("\r\n")
+        if line == "":
+            if data:
+                yield event, event_id, "\n".join(data), len(raw)
+            event, event_id, data = "message", None, []
+        elif line.startswith(":"):
+            yield None, None, line[1:].strip(), len(raw)
+        else:
+            field, _, value = line.partition(":")
+            value = value[1:] if value.startswith(" ") else value
+            if field == "event":
+                event = value
+            elif field == "id":
+                event_id = value
+            elif field == "data":
+                data.append(value)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DaiSpan SSE 即時狀態監看")
+    parser.add_argument("ip", help="設備 IP")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--duration", type=float, default=0, help="監看秒數（0 = 直到 Ctrl+C）")
+    parser.add_argument("--quiet", action="store_true", help="只輸出統計")
+    args = parser.parse_args()
+
+    url = f"http://{args.ip}:{args.port}/api/events"
+    counts = {}
+    total_bytes = 0
+    start = time.monotonic()
+
+    try:
+        with urllib.request.urlopen(url, timeout=60) as resp:
+            print(f"📡 已連線 {url}")
+            for event, event_id, data, size in read_events(resp):
+                total_bytes += size
+                name = event or "heartbeat"
+                counts[name] = counts.get(name, 0) + 1
+                if not args.quiet and event:
+                    stamp = time.strftime("%H:%M:%S")
+                    try:
+                        data = json.dumps(json.loads(data), ensure_ascii=False)
+                    except ValueError:
+                        pass
+                    print(f"[{stamp}] #{event_id} {event}: {data}")
+                if args.duration and time.monotonic() - start >= args.duration:
+                    break
+    except urllib.error.HTTPError as e:
+        print(f"❌ 連線被拒: HTTP {e.code}（客戶端已滿？）")
+        return
+    except (urllib.error.URLError, OSError) as e:
+        print(f"❌ 連線中斷: {e}")
+    except KeyboardInterrupt:
+        pass
+
+    elapsed = max(time.monotonic() - start, 0.001)
+    summary = ", ".join(f"{k} {v}" for k, v in sorted(counts.items()))
+    print(f"📊 {elapsed:.0f} 秒: {summary or '無事件'}；共 {total_bytes} bytes"
+          f"（{total_bytes / elapsed * 60:.0f} bytes/分鐘）")
+
+
+if __name__ == "__main__":
+    main()
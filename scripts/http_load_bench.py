@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+DaiSpan 監控 WebServer 負載測試
+對監控端點發送固定併發請求，統計每秒請求數與延遲百分位，
+用於比較 WebServer 處理策略（例如事件驅動 vs 固定間隔輪詢）。
+"""
+
+import argparse
+import json
+import statistics
+import threading
+import time
+import urllib.error
+import urllib.request
+from typing import Dict, List
+
+DEFAULT_ENDPOINTS = ["/api/health", "/api/controller", "/api/memory/stats"]
+
+
+def percentile(values: List[float], pct: float) -> float:
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, max(0, int(round(pct / 100.0 * len(ordered) + 0.5)) - 1))
+    return ordered[index]
+
+
+class LoadBench:
+    def __init__(self, base_url: str, endpoints: List[str], timeout: float):
+        self.base_url = base_url
+        self.endpoints = endpoints
+        self.timeout = timeout
+        self.lock = threading.Lock()
+        self.latencies: Dict[str, List[float]] = {ep: [] for ep in endpoints}
+        self.errors: Dict[str, int] = {ep: 0 for ep in endpoints}
+
+    def worker(self, deadline: float, offset: int):
+        i = offset
+        while time.monotonic() < deadline:
+            endpoint = self.endpoints[i % len(self.endpoints)]
+            i += 1
+            start = time.monotonic()
+            try:
+                with urllib.request.urlopen(self.base_url + endpoint, timeout=self.timeout) as resp:
+                    resp.read()
+                    ok = resp.status == 200
+            except (urllib.error.URLError, OSError):
+                ok = False
+            elapsed_ms = (time.monotonic() - start) * 1000.0
+            with self.lock:
+                if ok:
+                    self.latencies[endpoint].append(elapsed_ms)
+                else:
+                    self.errors[endpoint] += 1
+
+    def run(self, duration: float, concurrency: int) -> Dict:
+        deadline = time.monotonic() + duration
+        threads = [threading.Thread(target=self.worker, args=(deadline, n)) for n in range(concurrency)]
+        started = time.monotonic()
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        wall = time.monotonic() - started
+
+        all_latencies = [v for values in self.latencies.values() for v in values]
+        result = {
+            "duration_s": round(wall, 2),
+            "concurrency": concurrency,
+            "requests": len(all_latencies),
+            "errors": sum(self.errors.values()),
+            "rps": round(len(all_latencies) / wall, 2) if wall > 0 else 0.0,
+            "p50_ms": round(percentile(all_latencies, 50), 1),
+            "p99_ms": round(percentile(all_latencies, 99), 1),
+            "max_ms": round(max(all_latencies), 1) if all_latencies else 0.0,
+            "endpoints": {},
+        }
+        for endpoint, values in self.latencies.items():
+            result["endpoints"][endpoint] = {
+                "requests": len(values),
+                "errors": self.errors[endpoint],
+                "mean_ms": round(statistics.mean(values), 1) if values else 0.0,
+                "p99_ms": round(percentile(values, 99), 1),
+            }
+        return result
+
+
+def fetch_server_stats(base_url: str, timeout: float) -> Dict:
+    try:
+        with urllib.request.urlopen(base_url + "/api/web/stats", timeout=timeout) as resp:
+            return json.loads(resp.read().decode())
+    except (urllib.error.URLError, OSError, ValueError):
+        return {}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DaiSpan 監控 WebServer 負載測試")
+    parser.add_argument("ip", help="設備 IP")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--duration", type=float, default=30.0, help="測試秒數")
+    parser.add_argument("--concurrency", type=int, default=2, help="併發連線數")
+    parser.add_argument("--timeout", type=float, default=5.0, help="單一請求逾時秒數")
+    parser.add_argument("--endpoint", action="append", help="測試端點（可重複，預設為輕量 API）")
+    parser.add_argument("--json", action="store_true", help="以 JSON 輸出結果")
+    args = parser.parse_args()
+
+    base_url = f"http://{args.ip}:{args.port}"
+    endpoints = args.endpoint or DEFAULT_ENDPOINTS
+
+    bench = LoadBench(base_url, endpoints, args.timeout)
+    result = bench.run(args.duration, args.concurrency)
+    result["server"] = fetch_server_stats(base_url, args.timeout)
+
+    if args.json:
+        print(json.dumps(result, indent=2, ensure_ascii=False))
+        return
+
+    print(f"🎯 目標: {base_url}  併發: {args.concurrency}  時間: {result['duration_s']}s")
+    print(f"📊 請求: {result['requests']}  錯誤: {result['errors']}  RPS: {result['rps']}")
+    print(f"⏱️  延遲 p50: {result['p50_ms']} ms  p99: {result['p99_ms']} ms  最大: {result['max_ms']} ms")
+    for endpoint, stats in result["endpoints"].items():
+        print(f"   {endpoint:<24} {stats['requests']:>5} 次  平均 {stats['mean_ms']:>7} ms  "
+              f"p99 {stats['p99_ms']:>7} ms  錯誤 {stats['errors']}")
+    if result["server"]:
+        server = result["server"]
+        print(f"🖥️  設備端: 處理 {server.get('dispatches', 0)} 次，"
+              f"平均 {server.get('avgHandleMicros', 0)} us，最長 {server.get('maxHandleMicros', 0)} us")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,158 @@
+#include "device/AccessorySync.h"
+#include "device/ThermostatDevice.h"
+#include "device/FanDevice.h"
+#include "device/SwingDevice.h"
+#include "device/HomeKitNotifier.h"
+#include "common/CrashLog.h"
+#include "common/DebugTopics.h"
+#include "common/Metrics.h"
+
+AccessorySync& AccessorySync::getInstance() {
+    static AccessorySync instance;
+    return instance;
+}
+
+AccessorySync::AccessorySync()
+    : controller(nullptr),
+      thermostatDevice(nullptr),
+      fanDevice(nullptr),
+      swingCount(0),
+      snapshot{},
+      hasSnapshot(false),
+      carriedDirty(0),
+      fullSyncRequested(true),
+      swingVerticalSupported(false),
+      swingHorizontalSupported(false),
+      gettersPerTick(0),
+      lastSyncTime(0),
+      lastHeartbeatTime(0),
+      stats{} {
+    memset(swingServices, 0, sizeof(swingServices));
+}
+
+void AccessorySync::begin(IThermostatControl& ctrl, ThermostatDevice* thermostat, FanDevice* fan) {
+    controller = &ctrl;
+    thermostatDevice = thermostat;
+    fanDevice = fan;
+
+    // 擺風能力在運行期間不變，只查詢一次
+    swingVerticalSupported = ctrl.supportsSwing(IACProtocol::SwingAxis::Vertical);
+    swingHorizontalSupported = ctrl.supportsSwing(IACProtocol::SwingAxis::Horizontal);
+    gettersPerTick = 5 + (swingVerticalSupported ? 1 : 0) + (swingHorizontalSupported ? 1 : 0);
+
+    hasSnapshot = false;
+    fullSyncRequested = true;
+    DEBUG_INFO_PRINT("[AccessorySync] 同步協調器就緒（每輪 %d 次 getter）\n", gettersPerTick);
+}
+
+void AccessorySync::attachSwing(SwingSwitchService* swing) {
+    if (!swing || swingCount >= MAX_SWING_SERVICES) return;
+    swingServices[swingCount++] = swing;
+}
+
+void AccessorySync::requestFullSync() {
+    fullSyncRequested = true;
+    lastSyncTime = 0;
+}
+
+AccessorySnapshot AccessorySync::readSnapshot() {
+    AccessorySnapshot next;
+    next.power = controller->getPower();
+    next.targetMode = controller->getTargetMode();
+    next.targetTemperature = controller->getTargetTemperature();
+    next.currentTemperature = controller->getCurrentTemperature();
+    next.fanSpeed = controller->getFanSpeed();
+    next.swingVertical = swingVerticalSupported &&
+                         controller->getSwing(IACProtocol::SwingAxis::Vertical);
+    next.swingHorizontal = swingHorizontalSupported &&
+                           controller->getSwing(IACProtocol::SwingAxis::Horizontal);
+    stats.getterCalls += gettersPerTick;
+    return next;
+}
+
+uint16_t AccessorySync::diff(const AccessorySnapshot& next) const {
+    uint16_t dirty = 0;
+    if (next.power != snapshot.power) dirty |= DIRTY_POWER;
+    if (next.targetMode != snapshot.targetMode) dirty |= DIRTY_TARGET_MODE;
+    if (next.targetTemperature != snapshot.targetTemperature) dirty |= DIRTY_TARGET_TEMP;
+    if (next.currentTemperature != snapshot.currentTemperature) dirty |= DIRTY_CURRENT_TEMP;
+    if (next.fanSpeed != snapshot.fanSpeed) dirty |= DIRTY_FAN_SPEED;
+    if (next.swingVertical != snapshot.swingVertical) dirty |= DIRTY_SWING_V;
+    if (next.swingHorizontal != snapshot.swingHorizontal) dirty |= DIRTY_SWING_H;
+    return dirty;
+}
+
+void AccessorySync::tick(unsigned long currentTime) {
+    if (!controller) return;
+    if (lastSyncTime != 0 && currentTime - lastSyncTime < SYNC_INTERVAL_MS) return;
+    lastSyncTime = currentTime ? currentTime : 1;
+
+    controller->update();
+
+    // 只量測同步本身的耗時，不含控制器的協議查詢
+    uint32_t startMicros = micros();
+    AccessorySnapshot next = readSnapshot();
+
+    uint16_t dirty = carriedDirty;
+    if (!hasSnapshot || fullSyncRequested) {
+        dirty |= DIRTY_ALL;
+    } else {
+        dirty |= diff(next);
+    }
+    snapshot = next;
+    hasSnapshot = true;
+    fullSyncRequested = false;
+    carriedDirty = 0;
+
+    if (dirty) {
+        stats.dirtyTicks++;
+        if (thermostatDevice) {
+            carriedDirty |= thermostatDevice->applySnapshot(snapshot, dirty, currentTime);
+        }
+        if (fanDevice) {
+            carriedDirty |= fanDevice->applySnapshot(snapshot, dirty, currentTime);
+        }
+        for (uint8_t i = 0; i < swingCount; i++) {
+            carriedDirty |= swingServices[i]->applySnapshot(snapshot, dirty, currentTime);
+        }
+
+        [[maybe_unused]] uint8_t sent = HOMEKIT_NOTIFIER.flush(currentTime);
+        DEBUG_VERBOSE_PRINT("[AccessorySync] 變化位元 0x%02X，送出 %d 個通知，保留 0x%02X\n",
+                            dirty, sent, carriedDirty);
+        saveCrashSnapshot();
+        if (DEBUG_TOPIC_ENABLED(DebugTopic::ControllerState)) {
+            debugPublishControllerState(snapshot.power, snapshot.targetMode, snapshot.targetTemperature,
+                                        snapshot.currentTemperature, snapshot.fanSpeed);
+        }
+    }
+
+    uint32_t elapsed = micros() - startMicros;
+    stats.ticks++;
+    stats.lastTickMicros = elapsed;
+    stats.totalTickMicros += elapsed;
+    if (elapsed > stats.maxTickMicros) stats.maxTickMicros = elapsed;
+    Metrics::syncTicks.inc();
+    Metrics::syncTickUs.observe(elapsed);
+
+    if (currentTime - lastHeartbeatTime >= HEARTBEAT_INTERVAL) {
+        lastHeartbeatTime = currentTime;
+        printHeartbeat(currentTime);
+        saveCrashSnapshot();
+    }
+}
+
+// 狀態變化與心跳時寫入 RTC，重置後 /api/crashlog 可看到最後已知的狀態
+void AccessorySync::saveCrashSnapshot() const {
+    CRASH_LOG.updateSnapshot(snapshot.power, snapshot.targetMode, snapshot.targetTemperature,
+                             snapshot.currentTemperature, snapshot.fanSpeed);
+}
+
+void AccessorySync::printHeartbeat(unsigned long currentTime) const {
+    DEBUG_INFO_PRINT("[AccessorySync] 電源:%s 模式:%d 當前溫度:%.1f°C 目標溫度:%.1f°C 風速:%d "
+                     "(同步 %u 輪，平均 %u us，最長 %u us)\n",
+                     snapshot.power ? "開啟" : "關閉", snapshot.targetMode,
+                     snapshot.currentTemperature, snapshot.targetTemperature, snapshot.fanSpeed,
+                     stats.ticks,
+                     stats.ticks ? (uint32_t)(stats.totalTickMicros / stats.ticks) : 0,
+                     stats.maxTickMicros);
+}
@@ -0,0 +1,143 @@
+#include "common/CrashLog.h"
+#include <algorithm>
+#ifdef ESP_PLATFORM
+#include "esp_rom_crc.h"
+#endif
+
+RTC_NOINIT_ATTR CrashLogStore crashLogStore;
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x44534C47;     // "DSLG"
+constexpr uint32_t LAYOUT = (1u << 16) | sizeof(CrashLogStore);
+
+#ifndef ESP_PLATFORM
+// 半位元組查表的 CRC32（IEEE），表只有 64 bytes；韌體改用 ROM 中的實作
+constexpr uint32_t CRC_TABLE[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+#endif
+
+uint32_t headerCrc(const CrashLogStore& store) {
+    return CrashLog::crc32(&store, offsetof(CrashLogStore, headerCrc));
+}
+
+// 只涵蓋到文字結尾的 '\0'，CRC 的成本與訊息長度成正比；之後的位元組不會被讀取
+uint32_t recordCrc(const CrashLogRecord& record, size_t length) {
+    return CrashLog::crc32(&record, offsetof(CrashLogRecord, text) + length + 1);
+}
+
+uint32_t snapshotCrc(const CrashLogSnapshot& snapshot) {
+    return CrashLog::crc32(&snapshot, offsetof(CrashLogSnapshot, crc));
+}
+
+} // namespace
+
+uint32_t CrashLog::crc32(const void* data, size_t length) {
+#ifdef ESP_PLATFORM
+    return esp_rom_crc32_le(0, static_cast<const uint8_t*>(data), length);
+#else
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+    }
+    return ~crc;
+#endif
+}
+
+CrashLog::CrashLog() : recovered{}, resetReason(ESP_RST_UNKNOWN) {
+    recover();
+}
+
+void CrashLog::recover() {
+    CrashLogStore& store = crashLogStore;
+    resetReason = esp_reset_reason();
+    recovered = {};
+
+    bool valid = store.magic == MAGIC && store.layout == LAYOUT && store.headerCrc == headerCrc(store);
+    if (valid) {
+        for (const CrashLogRecord& record : store.records) {
+            size_t length = strnlen(record.text, CrashLogRecord::TEXT_SIZE);
+            if (record.seq != 0 && length < CrashLogRecord::TEXT_SIZE && record.crc == recordCrc(record, length)) {
+                recovered.records[recovered.recordCount++] = record;
+            }
+        }
+        std::sort(recovered.records, recovered.records + recovered.recordCount,
+                  [](const CrashLogRecord& a, const CrashLogRecord& b) { return a.seq < b.seq; });
+        recovered.hasSnapshot = store.snapshot.valid && store.snapshot.crc == snapshotCrc(store.snapshot);
+        if (recovered.hasSnapshot) recovered.snapshot = store.snapshot;
+    }
+
+    uint32_t bootCount = valid ? store.bootCount + 1 : 1;
+    memset(&store, 0, sizeof(store));
+    store.magic = MAGIC;
+    store.layout = LAYOUT;
+    store.bootCount = bootCount;
+    store.headerCrc = headerCrc(store);
+    nextSeq.store(1, std::memory_order_relaxed);
+}
+
+void CrashLog::record(const char* text, size_t length) {
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) length--;
+    if (length > CrashLogRecord::TEXT_SIZE - 1) {
+        length = CrashLogRecord::TEXT_SIZE - 1;
+        // 不切在 UTF-8 多位元組字元中間
+        while (length > 0 && (text[length] & 0xC0) == 0x80) length--;
+    }
+
+    uint32_t seq = nextSeq.fetch_add(1, std::memory_order_relaxed);
+    CrashLogRecord& record = crashLogStore.records[(seq - 1) % RECORD_COUNT];
+    record.seq = seq;
+    record.uptimeMs = millis();
+    memcpy(record.text, text, length);
+    record.text[length] = '\0';
+    record.crc = recordCrc(record, length);
+}
+
+void CrashLog::updateSnapshot(bool power, uint8_t targetMode, float targetTemperature,
+                              float currentTemperature, uint8_t fanSpeed) {
+    CrashLogSnapshot& snapshot = crashLogStore.snapshot;
+    snapshot.uptimeMs = millis();
+    snapshot.freeHeap = ESP.getFreeHeap();
+    snapshot.minFreeHeap = ESP.getMinFreeHeap();
+    snapshot.targetTemperature = targetTemperature;
+    snapshot.currentTemperature = currentTemperature;
+    snapshot.power = power;
+    snapshot.targetMode = targetMode;
+    snapshot.fanSpeed = fanSpeed;
+    snapshot.valid = 1;
+    snapshot.crc = snapshotCrc(snapshot);
+}
+
+bool CrashLog::isCrashReset() const {
+    switch (resetReason) {
+        case ESP_RST_PANIC:
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:
+        case ESP_RST_BROWNOUT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const char* CrashLog::resetReasonName(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return "poweron";
+        case ESP_RST_EXT:       return "external";
+        case ESP_RST_SW:        return "software";
+        case ESP_RST_PANIC:     return "panic";
+        case ESP_RST_INT_WDT:   return "int_wdt";
+        case ESP_RST_TASK_WDT:  return "task_wdt";
+        case ESP_RST_WDT:       return "wdt";
+        case ESP_RST_DEEPSLEEP: return "deepsleep";
+        case ESP_RST_BROWNOUT:  return "brownout";
+        case ESP_RST_SDIO:      return "sdio";
+        default:                return "unknown";
+    }
+}
@@ -0,0 +1,127 @@
+#include "common/Debug.h"
+#include "common/CrashLog.h"
+#include "common/LogDrain.h"
+#include "common/Metrics.h"
+#include <Arduino.h>
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+constexpr uint32_t componentMask(int level) {
+    return level <= DEBUG_NONE ? 0 : (1u << level) - 1;
+}
+
+constexpr uint32_t initialMask() {
+    uint32_t mask = 0;
+    for (uint8_t c = 0; c < (uint8_t)DebugComponent::Count; c++) {
+        mask |= componentMask(DEBUG_RUNTIME_LEVEL) << (c * 4);
+    }
+    return mask;
+}
+
+const char* const COMPONENT_NAMES[] = {"S21", "Controller", "Device", "Web", "WiFi", "System"};
+const char* const LEVEL_NAMES[] = {"none", "error", "warn", "info", "verbose"};
+
+} // namespace
+
+std::atomic<uint32_t> debugLevelMask{initialMask()};
+
+int setDebugLevel(DebugComponent component, int level) {
+    if (level < DEBUG_NONE) level = DEBUG_NONE;
+    if (level > DEBUG_LEVEL) level = DEBUG_LEVEL;
+    uint8_t shift = (uint8_t)component * 4;
+    uint32_t mask = debugLevelMask.load(std::memory_order_relaxed);
+    uint32_t updated;
+    do {
+        updated = (mask & ~(0xFu << shift)) | (componentMask(level) << shift);
+    } while (!debugLevelMask.compare_exchange_weak(mask, updated, std::memory_order_relaxed));
+    return level;
+}
+
+int getDebugLevel(DebugComponent component) {
+    uint32_t bits = (debugLevelMask.load(std::memory_order_relaxed) >> ((uint8_t)component * 4)) & 0xF;
+    int level = DEBUG_NONE;
+    while (bits & (1u << level)) level++;
+    return level;
+}
+
+const char* debugComponentName(DebugComponent component) {
+    return (uint8_t)component < (uint8_t)DebugComponent::Count ? COMPONENT_NAMES[(uint8_t)component] : "unknown";
+}
+
+const char* debugLevelName(int level) {
+    return level >= DEBUG_NONE && level <= DEBUG_VERBOSE ? LEVEL_NAMES[level] : "unknown";
+}
+
+int parseDebugLevel(const char* text) {
+    if (text[0] >= '0' && text[0] <= '4' && text[1] == '\0') return text[0] - '0';
+    for (int level = DEBUG_NONE; level <= DEBUG_VERBOSE; level++) {
+        if (strcasecmp(text, LEVEL_NAMES[level]) == 0) return level;
+    }
+    return -1;
+}
+
+#ifndef BINARY_DEBUG_LOG
+
+namespace {
+
+// 所有 DEBUG_*_PRINT 共用的格式化緩衝（取代每個呼叫點各自的 static buffer）
+char scratch[DEBUG_BUFFER_SIZE];
+std::mutex scratchMutex;
+
+// 只放進非同步佇列：串口由排空任務寫出，遠端調試由 RemoteDebugger::loop() 轉發；
+// 另外留一份在 RTC 崩潰日誌，重置後仍可從 /api/crashlog 讀到
+void emit(uint8_t level, const char* text, int length, size_t size) {
+    if (length < 0) return;
+    if ((size_t)length >= size) length = size - 1;
+    CRASH_LOG.record(text, length);
+    if (LOG_DRAIN.push(text, length, level)) Metrics::debugLogQueued.inc();
+    else Metrics::debugLogDropped.inc();
+}
+
+// 共用緩衝正被其他任務使用（或在輸出過程中再次記錄日誌）時改用堆疊緩衝；
+// 獨立成函數，一般路徑不必預留這塊堆疊
+void __attribute__((noinline)) debugLogOnStack(uint8_t level, const char* format, va_list args) {
+    char buffer[DEBUG_BUFFER_SIZE];
+    emit(level, buffer, vsnprintf(buffer, sizeof(buffer), format, args), sizeof(buffer));
+}
+
+#ifdef ESP_PLATFORM
+std::atomic<bool> drainStarted{false};
+
+// 串口排空任務：優先級只高於 idle，UART/USB-CDC 緩衝滿而阻塞時讓出 CPU 給其他任務
+void drainTask(void*) {
+    for (;;) {
+        size_t drained = LOG_DRAIN.drain([](const char* data, size_t length) {
+            Serial.write((const uint8_t*)data, length);
+        });
+        if (drained == 0) vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+// 第一筆日誌時建立，開機最早的訊息也會留在佇列中等任務寫出
+void startDrainTask() {
+    if (drainStarted.exchange(true)) return;
+    xTaskCreate(drainTask, "logDrain", 2560, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+}
+#endif
+
+} // namespace
+
+void debugLog(uint8_t level, const char* format, ...) {
+#ifdef ESP_PLATFORM
+    if (!drainStarted.load(std::memory_order_relaxed)) startDrainTask();
+#endif
+    va_list args;
+    va_start(args, format);
+    if (scratchMutex.try_lock()) {
+        emit(level, scratch, vsnprintf(scratch, sizeof(scratch), format, args), sizeof(scratch));
+        scratchMutex.unlock();
+    } else {
+        debugLogOnStack(level, format, args);
+    }
+    va_end(args);
+}
+
+#endif // BINARY_DEBUG_LOG
@@ -0,0 +1,262 @@
+#include "common/EventStream.h"
+#include "controller/ThermostatController.h"
+#include "common/Metrics.h"
+#include "common/SocketUtil.h"
+#include <math.h>
+
+EventStream& EventStream::getInstance() {
+    static EventStream instance;
+    return instance;
+}
+
+void EventStream::begin(IThermostatControl* ctrl, ThermostatController* health) {
+    controller = ctrl;
+    healthSource = health;
+    hasPublished = false;
+    DEBUG_INFO_PRINT("[Events] SSE 推送已就緒（最多 %d 個客戶端，佇列 %d）\n", MAX_CLIENTS, QUEUE_DEPTH);
+}
+
+uint8_t EventStream::getClientCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (clients[i].queue) count++;
+    }
+    return count;
+}
+
+bool EventStream::accept(WiFiClient& client) {
+    Client* slot = nullptr;
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (!clients[i].queue) {
+            slot = &clients[i];
+            break;
+        }
+    }
+    if (!slot) {
+        stats.rejected++;
+        DEBUG_WARN_PRINT("[Events] 客戶端已滿，拒絕 %s\n", client.remoteIP().toString().c_str());
+        return false;
+    }
+
+    // 保留 WiFiClient 副本，WebServer 處理完請求後 socket 仍維持開啟
+    slot->connection = client;
+    slot->queue.reset(new Event[QUEUE_DEPTH]);
+    slot->head = 0;
+    slot->count = 0;
+    slot->resync = false;
+    slot->lastWrite = millis();
+    slot->connection.print("HTTP/1.1 200 OK\r\n"
+                           "Content-Type: text/event-stream\r\n"
+                           "Cache-Control: no-cache\r\n"
+                           "Connection: keep-alive\r\n\r\n"
+                           "retry: 5000\n\n");
+
+    Sample sample = takeSample();
+    enqueueSnapshot(*slot, sample);
+    if (!hasPublished || getClientCount() == 1) {
+        published = sample;
+        hasPublished = true;
+        lastHealthTime = millis();
+    }
+
+    stats.accepted++;
+    DEBUG_INFO_PRINT("[Events] 客戶端連線 %s（%d/%d）\n",
+                     slot->connection.remoteIP().toString().c_str(), getClientCount(), MAX_CLIENTS);
+    return true;
+}
+
+void EventStream::tick(unsigned long currentTime) {
+    uint8_t active = 0;
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        Client& client = clients[i];
+        if (!client.queue) continue;
+        if (!client.connection.connected()) {
+            release(client);
+            continue;
+        }
+        active++;
+    }
+    if (active == 0) return;
+
+    // 有人在看即時狀態，可選感測器維持正常查詢頻率
+    if (controller) controller->noteOptionalSensorInterest();
+
+    if (currentTime - lastSampleTime >= SAMPLE_INTERVAL_MS) {
+        lastSampleTime = currentTime;
+        char buffer[EVENT_MAX];
+        int length = formatDelta(buffer, sizeof(buffer), takeSample(), currentTime);
+        if (length > 0) {
+            stats.published++;
+            for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+                if (clients[i].queue) enqueue(clients[i], buffer, length);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (clients[i].queue) drain(clients[i], currentTime);
+    }
+}
+
+EventStream::Sample EventStream::takeSample() const {
+    Sample sample{};
+    if (controller) {
+        sample.state.power = controller->getPower();
+        sample.state.targetMode = controller->getTargetMode();
+        sample.state.targetTemperature = controller->getTargetTemperature();
+        sample.state.currentTemperature = controller->getCurrentTemperature();
+        sample.state.fanSpeed = controller->getFanSpeed();
+        if (controller->supportsSwing(IACProtocol::SwingAxis::Vertical)) {
+            sample.state.swingVertical = controller->getSwing(IACProtocol::SwingAxis::Vertical);
+        }
+        if (controller->supportsSwing(IACProtocol::SwingAxis::Horizontal)) {
+            sample.state.swingHorizontal = controller->getSwing(IACProtocol::SwingAxis::Horizontal);
+        }
+    }
+    sample.freeHeap = ESP.getFreeHeap();
+    if (healthSource) {
+        sample.errors = healthSource->getConsecutiveErrors();
+        sample.healthy = healthSource->isProtocolHealthy();
+    } else {
+        sample.healthy = true;
+    }
+    return sample;
+}
+
+int EventStream::formatSnapshot(char* buffer, size_t size, const Sample& sample) {
+    const AccessorySnapshot& s = sample.state;
+    int length = snprintf(buffer, size,
+                          "id: %u\nevent: snapshot\ndata: {\"power\":%s,\"mode\":%u,\"targetTemp\":%.1f,"
+                          "\"currentTemp\":%.1f,\"fanSpeed\":%u,\"swingV\":%s,\"swingH\":%s,"
+                          "\"freeHeap\":%u,\"uptime\":%u,\"errors\":%u,\"healthy\":%s}\n\n",
+                          nextEventId++, s.power ? "true" : "false", s.targetMode, s.targetTemperature,
+                          s.currentTemperature, s.fanSpeed, s.swingVertical ? "true" : "false",
+                          s.swingHorizontal ? "true" : "false", sample.freeHeap,
+                          (uint32_t)(millis() / 1000), sample.errors, sample.healthy ? "true" : "false");
+    return (length > 0 && (size_t)length < size) ? length : 0;
+}
+
+int EventStream::formatDelta(char* buffer, size_t size, const Sample& sample, unsigned long currentTime) {
+    char fields[EVENT_MAX];
+    int pos = 0;
+    auto add = [&](const char* fmt, auto... args) {
+        if (pos >= (int)sizeof(fields)) return;
+        int n = snprintf(fields + pos, sizeof(fields) - pos, fmt, pos > 0 ? "," : "", args...);
+        if (n > 0) pos += n;
+    };
+
+    AccessorySnapshot& last = published.state;
+    const AccessorySnapshot& now = sample.state;
+    if (now.power != last.power) {
+        add("%s\"power\":%s", now.power ? "true" : "false");
+        last.power = now.power;
+    }
+    if (now.targetMode != last.targetMode) {
+        add("%s\"mode\":%u", now.targetMode);
+        last.targetMode = now.targetMode;
+    }
+    if (fabsf(now.targetTemperature - last.targetTemperature) >= 0.05f) {
+        add("%s\"targetTemp\":%.1f", now.targetTemperature);
+        last.targetTemperature = now.targetTemperature;
+    }
+    if (fabsf(now.currentTemperature - last.currentTemperature) >= 0.05f) {
+        add("%s\"currentTemp\":%.1f", now.currentTemperature);
+        last.currentTemperature = now.currentTemperature;
+    }
+    if (now.fanSpeed != last.fanSpeed) {
+        add("%s\"fanSpeed\":%u", now.fanSpeed);
+        last.fanSpeed = now.fanSpeed;
+    }
+    if (now.swingVertical != last.swingVertical) {
+        add("%s\"swingV\":%s", now.swingVertical ? "true" : "false");
+        last.swingVertical = now.swingVertical;
+    }
+    if (now.swingHorizontal != last.swingHorizontal) {
+        add("%s\"swingH\":%s", now.swingHorizontal ? "true" : "false");
+        last.swingHorizontal = now.swingHorizontal;
+    }
+    if (sample.errors != published.errors || sample.healthy != published.healthy) {
+        add("%s\"errors\":%u,\"healthy\":%s", sample.errors, sample.healthy ? "true" : "false");
+        published.errors = sample.errors;
+        published.healthy = sample.healthy;
+    }
+
+    // 記憶體只在變化明顯或超過回報間隔時推送，避免每次取樣都產生事件
+    uint32_t heapChange = sample.freeHeap > published.freeHeap ? sample.freeHeap - published.freeHeap
+                                                               : published.freeHeap - sample.freeHeap;
+    if (heapChange >= HEAP_DELTA || currentTime - lastHealthTime >= HEALTH_INTERVAL_MS) {
+        add("%s\"freeHeap\":%u,\"uptime\":%u", sample.freeHeap, (uint32_t)(currentTime / 1000));
+        published.freeHeap = sample.freeHeap;
+        lastHealthTime = currentTime;
+    }
+
+    if (pos == 0) return 0;
+    int length = snprintf(buffer, size, "id: %u\nevent: delta\ndata: {%s}\n\n", nextEventId++, fields);
+    return (length > 0 && (size_t)length < size) ? length : 0;
+}
+
+void EventStream::enqueue(Client& client, const char* data, int length) {
+    if (client.count == QUEUE_DEPTH) {
+        // 丟棄最舊的事件；被丟掉的差異無法重建，佇列清空後補送完整快照
+        client.head = (client.head + 1) % QUEUE_DEPTH;
+        client.count--;
+        client.resync = true;
+        stats.dropped++;
+        Metrics::sseEventsDropped.inc();
+    }
+    Event& event = client.queue[(client.head + client.count) % QUEUE_DEPTH];
+    memcpy(event.data, data, length);
+    event.length = length;
+    client.count++;
+}
+
+void EventStream::enqueueSnapshot(Client& client, const Sample& sample) {
+    char buffer[EVENT_MAX];
+    int length = formatSnapshot(buffer, sizeof(buffer), sample);
+    if (length > 0) enqueue(client, buffer, length);
+}
+
+void EventStream::drain(Client& client, unsigned long currentTime) {
+    for (uint8_t writes = 0; client.count > 0 && writes < MAX_WRITES_PER_TICK; writes++) {
+        if (!isWritable(client.connection)) return;
+        const Event& event = client.queue[client.head];
+        if (client.connection.write((const uint8_t*)event.data, event.length) != event.length) {
+            release(client);
+            return;
+        }
+        client.head = (client.head + 1) % QUEUE_DEPTH;
+        client.count--;
+        client.lastWrite = currentTime;
+        stats.sent++;
+        stats.bytesSent += event.length;
+        Metrics::sseEventsSent.inc();
+    }
+
+    if (client.count > 0) return;
+
+    if (client.resync) {
+        client.resync = false;
+        stats.resyncs++;
+        enqueueSnapshot(client, takeSample());
+    } else if (currentTime - client.lastWrite >= HEARTBEAT_INTERVAL_MS && isWritable(client.connection)) {
+        // SSE 註解行作為心跳，寫入失敗即可及早釋放斷線的客戶端
+        static const char heartbeat[] = ": ping\n\n";
+        if (client.connection.write((const uint8_t*)heartbeat, sizeof(heartbeat) - 1) != sizeof(heartbeat) - 1) {
+            release(client);
+            return;
+        }
+        client.lastWrite = currentTime;
+    }
+}
+
+bool EventStream::isWritable(WiFiClient& connection) const {
+    return socketWritable(connection.fd());
+}
+
+void EventStream::release(Client& client) {
+    client.connection.stop();
+    client.queue.reset();
+    client.count = 0;
+    client.resync = false;
+    DEBUG_INFO_PRINT("[Events] 客戶端斷線（剩餘 %d）\n", getClientCount());
+}
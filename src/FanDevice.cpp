@@ -1,19 +1,25 @@
 #include "device/FanDevice.h"
 #include "common/Debug.h"
 #include "common/RemoteDebugger.h"
+#include "common/Trace.h"
 
 FanDevice::FanDevice(IThermostatControl& ctrl) 
     : Service::Fan(),
       controller(ctrl),
-      lastUpdateTime(0),
       lastUserInteraction(0),
-      lastUserSetSpeed(-1) {
+      lastUserSetSpeed(-1),
+      fanOnSlot(HomeKitNotifier::INVALID_SLOT),
+      fanSpeedSlot(HomeKitNotifier::INVALID_SLOT) {
     
     // 初始化風扇特性
     fanOn = new Characteristic::On(false);  // 風扇開關
     fanSpeed = new Characteristic::RotationSpeed(0);  // 風扇轉速 (0-100%)
     fanSpeed->setRange(0, 100, 10);  // 0-100%，步長為10%
     
+    // 容忍度由 applySnapshot() 內的用戶設置比對處理，排程器只負責去重
+    fanOnSlot = HOMEKIT_NOTIFIER.track(fanOn, "fanOn", {0, 0, 0}, false);
+    fanSpeedSlot = HOMEKIT_NOTIFIER.track(fanSpeed, "fanSpeed", {0, 0, 0}, false);
+    
     DEBUG_INFO_PRINT("[FanDevice] 風扇服務初始化完成\n");
     
     // 初始化時同步狀態
@@ -30,6 +36,7 @@ FanDevice::FanDevice(IThermostatControl& ctrl)
 
 // 用戶在 HomeKit 上設定風扇時，會調用此函數
 boolean FanDevice::update() {
+    TRACE_SCOPE("hap.fan.update");
     DEBUG_INFO_PRINT("[FanDevice] *** HomeKit 風扇 update() 回調被觸發 ***\n");
     
     bool changed = false;
@@ -137,7 +144,7 @@ boolean FanDevice::update() {
     if (changed) {
         DEBUG_INFO_PRINT("[FanDevice] HomeKit 風扇變更處理完成\n");
         // 立即觸發狀態同步，提供快速響應
-        lastUpdateTime = 0; // 重置更新時間，強制下次loop()立即執行同步
+        ACCESSORY_SYNC.requestFullSync();
     } else {
         DEBUG_INFO_PRINT("[FanDevice] HomeKit 風扇 update() 被調用但未檢測到變更\n");
     }
@@ -145,15 +152,12 @@ boolean FanDevice::update() {
     return true; // 總是返回 true，讓 HomeKit 認為操作成功
 }
 
-// 每秒調用一次，用於同步 HomeKit 和設備狀態
-void FanDevice::loop() {
-    unsigned long currentTime = millis();
-    
-    // 檢查是否需要更新狀態
-    if (currentTime - lastUpdateTime < FAN_UPDATE_INTERVAL) {
-        return;
+// 由 AccessorySync 在風速變化時調用，用於同步 HomeKit 和設備狀態
+uint16_t FanDevice::applySnapshot(const AccessorySnapshot& snap, uint16_t dirty,
+                                  unsigned long currentTime) {
+    if (!(dirty & DIRTY_FAN_SPEED)) {
+        return 0;
     }
-    lastUpdateTime = currentTime;
     
     // 檢查是否在用戶互動保護期內 (5秒內不覆蓋用戶設置)
     const unsigned long USER_INTERACTION_GRACE_PERIOD = 5000; // 5秒保護期
@@ -163,24 +167,22 @@ void FanDevice::loop() {
     if (inGracePeriod) {
         DEBUG_INFO_PRINT("[FanDevice] 用戶互動保護期內，跳過狀態同步 (剩餘: %lu ms)\n",
                           USER_INTERACTION_GRACE_PERIOD - (currentTime - lastUserInteraction));
-        return;
+        return DIRTY_FAN_SPEED; // 保護期結束後再同步
     }
     
     DEBUG_VERBOSE_PRINT("[FanDevice] 執行狀態同步 - 上次用戶互動: %lu ms 前\n",
                        lastUserInteraction > 0 ? (currentTime - lastUserInteraction) : 0);
     
     // 同步風扇狀態
-    uint8_t currentACSpeed = controller.getFanSpeed();
+    uint8_t currentACSpeed = snap.fanSpeed;
     int currentHomeKitSpeed = acSpeedToHomeKitSpeed(currentACSpeed);
     bool currentIsOn = isFanEffectivelyOn(currentACSpeed);
     
     bool stateChanged = false;
     
     // 同步開關狀態
-    if (fanOn->getVal() != currentIsOn) {
-        fanOn->setVal(currentIsOn);
-        fanOn->timeVal(); // 強制更新時間戳
-        DEBUG_INFO_PRINT("[FanDevice] 更新風扇開關：%s (強制通知)\n",
+    if (HOMEKIT_NOTIFIER.stage(fanOnSlot, currentIsOn, currentTime)) {
+        DEBUG_INFO_PRINT("[FanDevice] 更新風扇開關：%s\n",
                        currentIsOn ? "開啟" : "關閉");
         stateChanged = true;
     }
@@ -196,10 +198,8 @@ void FanDevice::loop() {
             homeKitSpeedToACSpeed(lastUserSetSpeed) == currentACSpeed) {
             DEBUG_INFO_PRINT("[FanDevice] AC速度 %d 與用戶設置 %d%% 相符，保持用戶設置\n",
                               currentACSpeed, lastUserSetSpeed);
-        } else {
-            fanSpeed->setVal(currentHomeKitSpeed);
-            fanSpeed->timeVal(); // 強制更新時間戳
-            DEBUG_INFO_PRINT("[FanDevice] 更新風扇速度：%d%% (AC速度：%d，強制通知)\n",
+        } else if (HOMEKIT_NOTIFIER.stage(fanSpeedSlot, currentHomeKitSpeed, currentTime)) {
+            DEBUG_INFO_PRINT("[FanDevice] 更新風扇速度：%d%% (AC速度：%d)\n",
                            currentHomeKitSpeed, currentACSpeed);
             stateChanged = true;
         }
@@ -209,8 +209,9 @@ void FanDevice::loop() {
     }
     
     if (stateChanged) {
-        DEBUG_VERBOSE_PRINT("[FanDevice] 風扇狀態已同步到HomeKit\n");
+        DEBUG_VERBOSE_PRINT("[FanDevice] 風扇狀態已排入HomeKit通知\n");
     }
+    return 0;
 }
 
 // 將HomeKit速度轉換為AC速度
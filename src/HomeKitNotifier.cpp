@@ -0,0 +1,115 @@
+#include "device/HomeKitNotifier.h"
+#include "common/Metrics.h"
+#include <math.h>
+
+HomeKitNotifier& HomeKitNotifier::getInstance() {
+    static HomeKitNotifier instance;
+    return instance;
+}
+
+int8_t HomeKitNotifier::track(SpanCharacteristic* characteristic, const char* name,
+                              const Policy& policy, bool isFloat) {
+    if (!characteristic || slotCount >= MAX_SLOTS) {
+        DEBUG_ERROR_PRINT("[Notifier] 無法註冊特性 %s（已用 %d/%d）\n", name, slotCount, MAX_SLOTS);
+        return INVALID_SLOT;
+    }
+
+    Slot& slot = slots[slotCount];
+    slot.characteristic = characteristic;
+    slot.name = name;
+    slot.policy = policy;
+    slot.isFloat = isFloat;
+    slot.staged = false;
+    slot.pending = false;
+    slot.expedited = false;
+    slot.stagedValue = 0;
+    slot.lastNotifyTime = 0;
+    slot.sent = 0;
+    slot.suppressed = 0;
+
+    DEBUG_VERBOSE_PRINT("[Notifier] 註冊特性 %s：間隔 %lu ms，遲滯 %.2f，繞過 %.2f\n",
+                        name, policy.minIntervalMs, policy.hysteresis, policy.bypassDelta);
+    return slotCount++;
+}
+
+float HomeKitNotifier::currentValue(const Slot& slot) const {
+    return slot.isFloat ? slot.characteristic->getVal<float>()
+                        : (float)slot.characteristic->getVal();
+}
+
+bool HomeKitNotifier::stage(int8_t index, float value, unsigned long currentTime) {
+    if (index < 0 || index >= slotCount) return false;
+    Slot& slot = slots[index];
+
+    float delta = fabsf(currentValue(slot) - value);
+    if (delta == 0.0f || delta < slot.policy.hysteresis) {
+        // 數值已一致（或回到遲滯範圍內），取消延後中的變化
+        slot.staged = false;
+        slot.pending = false;
+        return false;
+    }
+
+    bool intervalElapsed = slot.lastNotifyTime == 0 ||
+                           currentTime - slot.lastNotifyTime >= slot.policy.minIntervalMs;
+    bool bypass = slot.expedited ||
+                  (slot.policy.bypassDelta > 0 && delta >= slot.policy.bypassDelta);
+
+    if (!intervalElapsed && !bypass) {
+        // 只在變化首次被延後時計數，避免每輪重複累加
+        if (!slot.pending) {
+            slot.pending = true;
+            slot.suppressed++;
+            stats.suppressed++;
+            Metrics::notificationsSuppressed.inc();
+            DEBUG_VERBOSE_PRINT("[Notifier] 延後 %s 通知（剩餘 %lu ms）\n", slot.name,
+                                slot.policy.minIntervalMs - (currentTime - slot.lastNotifyTime));
+        }
+        slot.staged = false;
+        return false;
+    }
+
+    slot.staged = true;
+    slot.stagedValue = value;
+    return true;
+}
+
+void HomeKitNotifier::expedite(int8_t index) {
+    if (index < 0 || index >= slotCount) return;
+    slots[index].expedited = true;
+}
+
+uint8_t HomeKitNotifier::flush(unsigned long currentTime) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < slotCount; i++) {
+        Slot& slot = slots[i];
+        if (!slot.staged) continue;
+
+        if (slot.isFloat) {
+            slot.characteristic->setVal(slot.stagedValue);
+        } else {
+            slot.characteristic->setVal((int)lroundf(slot.stagedValue));
+        }
+
+        slot.staged = false;
+        slot.pending = false;
+        slot.expedited = false;
+        slot.lastNotifyTime = currentTime ? currentTime : 1;
+        slot.sent++;
+        count++;
+    }
+
+    if (count > 0) {
+        stats.sent += count;
+        stats.batches++;
+        Metrics::notificationsSent.inc(count);
+        DEBUG_VERBOSE_PRINT("[Notifier] 送出 %d 個特性通知（累計 送出:%u 延後:%u）\n",
+                            count, stats.sent, stats.suppressed);
+    }
+    return count;
+}
+
+HomeKitNotifier::SlotStats HomeKitNotifier::getSlotStats(uint8_t index) const {
+    if (index >= slotCount) return SlotStats{"", 0, 0, false};
+    const Slot& slot = slots[index];
+    return SlotStats{slot.name, slot.sent, slot.suppressed, slot.pending};
+}
@@ -0,0 +1,102 @@
+#include "common/Metrics.h"
+
+// 所有指標與註冊表都是常數初始化：不依賴靜態建構順序，開機任何階段都能安全更新
+
+namespace {
+    const uint32_t S21_RESPONSE_BOUNDS_MS[] = {50, 100, 200, 400, 800, 1600, 3200};
+    const uint32_t SYNC_TICK_BOUNDS_US[] = {50, 100, 250, 500, 1000, 2500, 10000};
+    const uint32_t HTTP_HANDLE_BOUNDS_MS[] = {1, 5, 10, 25, 50, 100, 250, 1000};
+    const uint32_t CONTROL_BOUNDS_MS[] = {100, 200, 400, 800, 1600, 3200, 6400};
+}
+
+namespace Metrics {
+
+    Counter s21Commands;
+    Counter s21Errors;
+    Counter s21RetriesTimeout;
+    Counter s21RetriesChecksum;
+    Counter s21RetriesOther;
+    Histogram s21ResponseMs(S21_RESPONSE_BOUNDS_MS);
+    Gauge s21QualityScore;
+
+    Gauge power;
+    Gauge targetTemperature;
+    Gauge currentTemperature;
+    Gauge fanSpeed;
+    Gauge consecutiveErrors;
+    Counter optionalQueries;
+    Counter optionalSkipped;
+    Histogram controlLatencyMs(CONTROL_BOUNDS_MS);
+
+    Counter notificationsSent;
+    Counter notificationsSuppressed;
+    Counter syncTicks;
+    Histogram syncTickUs(SYNC_TICK_BOUNDS_US);
+
+    Counter httpRequests;
+    Histogram httpHandleMs(HTTP_HANDLE_BOUNDS_MS);
+    Gauge sseClients;
+    Counter sseEventsSent;
+    Counter sseEventsDropped;
+    Counter remoteDebugEventsSent;
+    Counter remoteDebugEventsDropped;
+
+    Counter debugLogQueued;
+    Counter debugLogDropped;
+    Counter loopSloBreaches;
+    Gauge uptimeSeconds;
+    Gauge freeHeap;
+    Gauge minFreeHeap;
+    Gauge maxAllocHeap;
+    Gauge avgFreeHeap;
+    Gauge wifiRssi;
+
+    namespace {
+        // 同名項目需相鄰；新增指標時在此登記即可出現在 /metrics
+        const MetricEntry ENTRIES[] = {
+            {"daispan_s21_commands", nullptr, "S21 指令成功次數", MetricType::Counter, &s21Commands},
+            {"daispan_s21_errors", nullptr, "S21 通訊錯誤次數", MetricType::Counter, &s21Errors},
+            {"daispan_s21_retries", "reason=\"timeout\"", "S21 指令重試次數（依原因）", MetricType::Counter, &s21RetriesTimeout},
+            {"daispan_s21_retries", "reason=\"checksum\"", "S21 指令重試次數（依原因）", MetricType::Counter, &s21RetriesChecksum},
+            {"daispan_s21_retries", "reason=\"other\"", "S21 指令重試次數（依原因）", MetricType::Counter, &s21RetriesOther},
+            {"daispan_s21_response_ms", nullptr, "S21 指令往返時間（毫秒）", MetricType::Histogram, &s21ResponseMs},
+            {"daispan_s21_quality_score", nullptr, "S21 通訊品質分數（0-100）", MetricType::Gauge, &s21QualityScore},
+
+            {"daispan_power_on", nullptr, "空調電源狀態（1 = 開）", MetricType::Gauge, &power},
+            {"daispan_target_temperature_celsius", nullptr, "目標溫度", MetricType::Gauge, &targetTemperature},
+            {"daispan_current_temperature_celsius", nullptr, "室內溫度", MetricType::Gauge, &currentTemperature},
+            {"daispan_fan_speed", nullptr, "風速設定", MetricType::Gauge, &fanSpeed},
+            {"daispan_controller_consecutive_errors", nullptr, "控制器連續錯誤次數", MetricType::Gauge, &consecutiveErrors},
+            {"daispan_optional_sensor_queries", "result=\"queried\"", "選用感測器查詢（依結果）", MetricType::Counter, &optionalQueries},
+            {"daispan_optional_sensor_queries", "result=\"skipped\"", "選用感測器查詢（依結果）", MetricType::Counter, &optionalSkipped},
+            {"daispan_control_latency_ms", nullptr, "批次控制命令與確認耗時（毫秒）", MetricType::Histogram, &controlLatencyMs},
+
+            {"daispan_homekit_notifications", "result=\"sent\"", "HomeKit 狀態通知（依結果）", MetricType::Counter, &notificationsSent},
+            {"daispan_homekit_notifications", "result=\"suppressed\"", "HomeKit 狀態通知（依結果）", MetricType::Counter, &notificationsSuppressed},
+            {"daispan_accessory_sync_ticks", nullptr, "配件同步執行次數", MetricType::Counter, &syncTicks},
+            {"daispan_accessory_sync_us", nullptr, "配件同步耗時（微秒）", MetricType::Histogram, &syncTickUs},
+
+            {"daispan_http_dispatches", nullptr, "監控 WebServer 處理請求次數", MetricType::Counter, &httpRequests},
+            {"daispan_http_handle_ms", nullptr, "監控 WebServer 單次處理耗時（毫秒）", MetricType::Histogram, &httpHandleMs},
+            {"daispan_sse_clients", nullptr, "SSE 推送連線數", MetricType::Gauge, &sseClients},
+            {"daispan_sse_events", "result=\"sent\"", "SSE 事件（依結果）", MetricType::Counter, &sseEventsSent},
+            {"daispan_sse_events", "result=\"dropped\"", "SSE 事件（依結果）", MetricType::Counter, &sseEventsDropped},
+            {"daispan_remote_debug_events", "result=\"sent\"", "遠端調試 WebSocket 事件（依結果）", MetricType::Counter, &remoteDebugEventsSent},
+            {"daispan_remote_debug_events", "result=\"dropped\"", "遠端調試 WebSocket 事件（依結果）", MetricType::Counter, &remoteDebugEventsDropped},
+
+            {"daispan_debug_log_lines", "result=\"queued\"", "調試日誌行數（依結果）", MetricType::Counter, &debugLogQueued},
+            {"daispan_debug_log_lines", "result=\"dropped\"", "調試日誌行數（依結果）", MetricType::Counter, &debugLogDropped},
+            {"daispan_loop_slo_breaches", nullptr, "主迴圈間隔超過 50 ms 的次數", MetricType::Counter, &loopSloBreaches},
+            {"daispan_uptime_seconds", nullptr, "開機時間（秒）", MetricType::Gauge, &uptimeSeconds},
+            {"daispan_free_heap_bytes", nullptr, "目前可用堆積", MetricType::Gauge, &freeHeap},
+            {"daispan_min_free_heap_bytes", nullptr, "開機以來最低可用堆積", MetricType::Gauge, &minFreeHeap},
+            {"daispan_max_alloc_heap_bytes", nullptr, "最大可配置區塊", MetricType::Gauge, &maxAllocHeap},
+            {"daispan_avg_free_heap_bytes", nullptr, "可用堆積移動平均", MetricType::Gauge, &avgFreeHeap},
+            {"daispan_wifi_rssi_dbm", nullptr, "WiFi 訊號強度", MetricType::Gauge, &wifiRssi},
+        };
+    }
+
+    const MetricEntry* getEntries() { return ENTRIES; }
+    size_t getEntryCount() { return sizeof(ENTRIES) / sizeof(ENTRIES[0]); }
+
+} // namespace Metrics
@@ -102,6 +102,53 @@ bool MockThermostatController::setFanSpeed(uint8_t speed) {
     return true;
 }
 
+bool MockThermostatController::applyControl(const ControlRequest& request, ControlResult& result) {
+    unsigned long start = micros();
+    result = ControlResult();
+
+    // 模擬模式只有 HomeKit 的三種模式，沒有擺風；不送任何幀，設置立即生效
+    uint8_t hapMode = HAP_MODE_OFF;
+    if (request.hasMode) {
+        switch (request.mode) {
+            case AC_MODE_HEAT: hapMode = HAP_MODE_HEAT; break;
+            case AC_MODE_COOL: hapMode = HAP_MODE_COOL; break;
+            case AC_MODE_AUTO: hapMode = HAP_MODE_AUTO; break;
+            default:
+                result.status = ControlResult::Status::Invalid;
+                result.field = "mode";
+                result.error = "模擬模式不支持此模式";
+        }
+    }
+    if (result.ok() && request.hasFanSpeed && request.fanSpeed > FAN_QUIET) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = "fan";
+        result.error = "無效的風速";
+    }
+    if (result.ok() && request.hasSwingFields()) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = request.hasSwingVertical ? "swingV" : "swingH";
+        result.error = "模擬模式不支援擺風";
+    }
+    if (result.ok() && request.hasTemperature &&
+        (isnan(request.temperature) || request.temperature < 16.0f || request.temperature > 30.0f)) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = "temp";
+        result.error = "溫度超出範圍";
+    }
+    if (!result.ok()) {
+        result.totalMicros = micros() - start;
+        return false;
+    }
+
+    if (request.hasMode) setTargetMode(hapMode);
+    if (request.hasPower) setPower(request.power);
+    if (request.hasTemperature) setTargetTemperature(request.temperature);
+    if (request.hasFanSpeed) setFanSpeed(request.fanSpeed);
+    result.confirmed = true;
+    result.totalMicros = micros() - start;
+    return true;
+}
+
 uint8_t MockThermostatController::getFanSpeed() const {
     return fanSpeed;
 }
@@ -0,0 +1,763 @@
+#include "common/MonitoringWebServer.h"
+#include "common/Metrics.h"
+#include "common/Debug.h"
+#include "common/Trace.h"
+#include "common/SocketUtil.h"
+#include <lwip/sockets.h>
+#include <errno.h>
+
+MonitoringWebServer::MonitoringWebServer(int port) : server(port), stats{} {}
+
+void MonitoringWebServer::begin() {
+    server.begin();
+    server.setNoDelay(true);
+    DEBUG_INFO_PRINT("[Web] 監控 WebServer 已啟動（最多 %d 個連線，keep-alive %lu 秒）\n",
+                     MAX_CONNECTIONS, IDLE_TIMEOUT / 1000);
+}
+
+void MonitoringWebServer::close() {
+    for (uint8_t i = 0; i < MAX_CONNECTIONS; i++) {
+        if (connections[i].state != ConnState::Free) release(connections[i]);
+    }
+    server.end();
+}
+
+void MonitoringWebServer::on(const char* uri, HTTPMethod method, Handler handler) {
+    if (routeCount >= MAX_ROUTES) {
+        DEBUG_ERROR_PRINT("[Web] 路由表已滿，忽略 %s\n", uri);
+        return;
+    }
+    // 路徑字串可能是暫時的（例如 WebAssets 組出的 /static/...），複製一份常駐
+    routes[routeCount++] = {strdup(uri), method, handler};
+}
+
+uint8_t MonitoringWebServer::getConnectionCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_CONNECTIONS; i++) {
+        if (connections[i].state != ConnState::Free) count++;
+    }
+    return count;
+}
+
+bool MonitoringWebServer::service() {
+    unsigned long currentTime = millis();
+    bool progress = acceptConnections(currentTime);
+
+    uint8_t dispatches = 0;
+    for (uint8_t i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection& conn = connections[(nextConnection + i) % MAX_CONNECTIONS];
+        if (conn.state != ConnState::Free) {
+            progress |= serviceConnection(conn, currentTime, dispatches);
+        }
+    }
+    nextConnection = (nextConnection + 1) % MAX_CONNECTIONS;
+
+    if (!progress) stats.idleChecks++;
+    return progress;
+}
+
+bool MonitoringWebServer::acceptConnections(unsigned long currentTime) {
+    bool accepted = false;
+    while (server.hasClient()) {
+        Connection* slot = nullptr;
+        for (uint8_t i = 0; i < MAX_CONNECTIONS && !slot; i++) {
+            if (connections[i].state == ConnState::Free) slot = &connections[i];
+        }
+        if (!slot) {
+            // 全部連線都在處理請求時，新連線留在 TCP backlog 等待
+            if (!evictIdleConnection()) break;
+            continue;
+        }
+
+        WiFiClient client = server.accept();
+        if (!client) break;
+        slot->socket = client;
+        slot->state = ConnState::Reading;
+        slot->rxLength = 0;
+        slot->txStart = slot->txEnd = 0;
+        slot->body = nullptr;
+        slot->bodyRemaining = 0;
+        slot->keepAlive = false;
+        slot->aborted = false;
+        slot->requests = 0;
+        slot->deadline = currentTime + REQUEST_TIMEOUT;
+        slot->lastActivity = currentTime;
+        accepted = true;
+
+        stats.accepted++;
+        uint8_t count = getConnectionCount();
+        if (count > stats.maxConcurrent) stats.maxConcurrent = count;
+        DEBUG_VERBOSE_PRINT("[Web] 新連線 %s（%d/%d）\n",
+                            client.remoteIP().toString().c_str(), count, MAX_CONNECTIONS);
+    }
+    return accepted;
+}
+
+bool MonitoringWebServer::evictIdleConnection() {
+    Connection* oldest = nullptr;
+    for (uint8_t i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection& conn = connections[i];
+        // 只踢掉已完成請求、正在 keep-alive 閒置的連線；剛接受還沒送出請求的連線不算閒置
+        if (conn.state != ConnState::Reading || conn.rxLength > 0 || conn.requests == 0) continue;
+        if (!oldest || (long)(conn.lastActivity - oldest->lastActivity) < 0) oldest = &conn;
+    }
+    if (!oldest) return false;
+    release(*oldest);
+    stats.evicted++;
+    return true;
+}
+
+bool MonitoringWebServer::serviceConnection(Connection& conn, unsigned long currentTime, uint8_t& dispatches) {
+    bool progress = false;
+
+    if (conn.state == ConnState::Writing) {
+        progress = flushConnection(conn, currentTime);
+        if (conn.state == ConnState::Free) return true;
+        if (conn.state == ConnState::Writing) {
+            if ((long)(currentTime - conn.deadline) >= 0) {
+                DEBUG_WARN_PRINT("[Web] 客戶端 %lu ms 未接收回應，關閉連線\n", WRITE_TIMEOUT);
+                stats.timeouts++;
+                release(conn);
+                return true;
+            }
+            return progress;
+        }
+        // 回應送完，繼續處理可能已管線化送達的下一個請求
+    }
+
+    progress |= readRequest(conn, currentTime);
+    if (conn.state == ConnState::Free) return true;
+
+    if (conn.rxLength > 0 && dispatches < MAX_DISPATCH_PER_SERVICE) {
+        int length = findCompleteRequest(conn);
+        if (length > 0) {
+            dispatch(conn, currentTime);
+            dispatches++;
+            return true;
+        }
+        if (length < 0) return true;
+    }
+
+    if ((long)(currentTime - conn.deadline) >= 0) {
+        if (conn.rxLength > 0) {
+            // 請求送到一半就停住（慢速或惡意客戶端）
+            stats.timeouts++;
+            rejectRequest(conn, 408, "Request Timeout");
+        } else {
+            release(conn);
+        }
+        return true;
+    }
+    return progress;
+}
+
+bool MonitoringWebServer::readRequest(Connection& conn, unsigned long currentTime) {
+    size_t space = RX_BUFFER_SIZE - conn.rxLength;
+    if (space == 0) return false;
+
+    int n = ::recv(conn.socket.fd(), conn.rx + conn.rxLength, space, MSG_DONTWAIT);
+    if (n > 0) {
+        // 新請求的第一個位元組起算收齊期限
+        if (conn.rxLength == 0) conn.deadline = currentTime + REQUEST_TIMEOUT;
+        conn.rxLength += n;
+        conn.rx[conn.rxLength] = '\0';
+        conn.lastActivity = currentTime;
+        return true;
+    }
+    if (n == 0 || (errno != EWOULDBLOCK && errno != EAGAIN)) {
+        // 對方關閉或連線錯誤
+        release(conn);
+        return true;
+    }
+    return false;
+}
+
+// Content-Length 的值：只接受十進位數字（前後可有空白），超過 32 位元視為無效
+bool MonitoringWebServer::parseContentLength(const char* value, size_t& length) {
+    while (*value == ' ' || *value == '\t') value++;
+    if (!isdigit((unsigned char)*value)) return false;
+    uint32_t parsed = 0;
+    for (; isdigit((unsigned char)*value); value++) {
+        uint32_t digit = *value - '0';
+        if (parsed > (UINT32_MAX - digit) / 10) return false;
+        parsed = parsed * 10 + digit;
+    }
+    while (*value == ' ' || *value == '\t') value++;
+    if (strncmp(value, "\r\n", 2) != 0) return false;
+    length = parsed;
+    return true;
+}
+
+int MonitoringWebServer::findCompleteRequest(Connection& conn) {
+    const char* end = strstr(conn.rx, "\r\n\r\n");
+    if (!end) {
+        if (conn.rxLength >= RX_BUFFER_SIZE) {
+            stats.badRequests++;
+            rejectRequest(conn, 431, "Request Header Fields Too Large");
+            return -1;
+        }
+        return 0;
+    }
+    size_t headerLength = end + 4 - conn.rx;
+
+    // 解析前先找 Content-Length（標頭名稱不分大小寫）；重複出現一律拒絕，避免前後端對長度認知不同
+    size_t bodyLength = 0;
+    bool hasLength = false;
+    for (const char* line = strstr(conn.rx, "\r\n"); line && line < end; line = strstr(line + 2, "\r\n")) {
+        if (strncasecmp(line + 2, "Content-Length:", 15) == 0) {
+            if (hasLength || !parseContentLength(line + 17, bodyLength)) {
+                stats.badRequests++;
+                rejectRequest(conn, 400, "Bad Request");
+                return -1;
+            }
+            hasLength = true;
+        } else if (strncasecmp(line + 2, "Transfer-Encoding:", 18) == 0) {
+            stats.badRequests++;
+            rejectRequest(conn, 411, "Length Required");
+            return -1;
+        }
+    }
+
+    // headerLength 不超過 RX_BUFFER_SIZE，相減不會溢位；不先相加以免大數值繞回
+    if (bodyLength > RX_BUFFER_SIZE - headerLength) {
+        stats.badRequests++;
+        rejectRequest(conn, 413, "Payload Too Large");
+        return -1;
+    }
+    if (conn.rxLength < headerLength + bodyLength) return 0;
+
+    if (!parseRequest(conn, headerLength, headerLength + bodyLength)) {
+        stats.badRequests++;
+        rejectRequest(conn, 400, "Bad Request");
+        return -1;
+    }
+    return headerLength + bodyLength;
+}
+
+bool MonitoringWebServer::parseRequest(Connection& conn, size_t headerLength, size_t totalLength) {
+    request.connection = nullptr;
+    request.length = totalLength;
+    request.headerCount = 0;
+    request.argCount = 0;
+    char* headerEnd = conn.rx + headerLength - 2;
+
+    // 請求行：METHOD SP PATH SP HTTP/1.x
+    char* line = conn.rx;
+    char* eol = strstr(line, "\r\n");
+    *eol = '\0';
+    char* path = strchr(line, ' ');
+    if (!path) return false;
+    *path++ = '\0';
+    char* version = strchr(path, ' ');
+    if (!version) return false;
+    *version++ = '\0';
+    if (strncmp(version, "HTTP/1.", 7) != 0) return false;
+    request.http11 = strcmp(version, "HTTP/1.1") == 0;
+
+    static const struct { const char* name; HTTPMethod method; } METHODS[] = {
+        {"GET", HTTP_GET}, {"POST", HTTP_POST}, {"HEAD", HTTP_HEAD}, {"PUT", HTTP_PUT},
+        {"DELETE", HTTP_DELETE}, {"OPTIONS", HTTP_OPTIONS}, {"PATCH", HTTP_PATCH},
+    };
+    bool known = false;
+    for (const auto& m : METHODS) {
+        if (strcmp(line, m.name) == 0) {
+            request.method = m.method;
+            known = true;
+            break;
+        }
+    }
+    if (!known) return false;
+
+    char* query = strchr(path, '?');
+    if (query) *query++ = '\0';
+    urlDecode(path);
+    request.path = path;
+    if (query) parseArgs(query);
+
+    // 標頭：名稱與值都指向 rx 緩衝
+    for (line = eol + 2; line < headerEnd; line = eol + 2) {
+        eol = strstr(line, "\r\n");
+        *eol = '\0';
+        char* colon = strchr(line, ':');
+        if (!colon || request.headerCount >= MAX_HEADERS) continue;
+        *colon = '\0';
+        char* value = colon + 1;
+        while (*value == ' ' || *value == '\t') value++;
+        request.headers[request.headerCount++] = {line, value};
+    }
+
+    const char* connection = nullptr;
+    const char* contentType = nullptr;
+    for (uint8_t i = 0; i < request.headerCount; i++) {
+        if (strcasecmp(request.headers[i].key, "Connection") == 0) connection = request.headers[i].value;
+        else if (strcasecmp(request.headers[i].key, "Content-Type") == 0) contentType = request.headers[i].value;
+    }
+    conn.keepAlive = request.http11 ? !(connection && strcasecmp(connection, "close") == 0)
+                                    : (connection && strcasecmp(connection, "keep-alive") == 0);
+
+    // 表單內容（POST /wifi-save 等）解析為參數；其他內容（JSON）與 WebServer 一樣放在 "plain"
+    if (totalLength > headerLength) {
+        char saved = conn.rx[totalLength];
+        conn.rx[totalLength] = '\0';
+        if (contentType && strncasecmp(contentType, "application/x-www-form-urlencoded", 33) == 0) {
+            parseArgs(conn.rx + headerLength);
+        } else if (request.argCount < MAX_ARGS) {
+            request.args[request.argCount++] = {"plain", conn.rx + headerLength};
+        }
+        conn.rx[totalLength] = saved;
+    }
+    return true;
+}
+
+void MonitoringWebServer::parseArgs(char* query) {
+    while (query && *query) {
+        char* next = strchr(query, '&');
+        if (next) *next++ = '\0';
+        char* value = strchr(query, '=');
+        if (value) *value++ = '\0';
+        else value = query + strlen(query);
+        if (*query && request.argCount < MAX_ARGS) {
+            urlDecode(query);
+            urlDecode(value);
+            request.args[request.argCount++] = {query, value};
+        }
+        query = next;
+    }
+}
+
+void MonitoringWebServer::dispatch(Connection& conn, unsigned long currentTime) {
+    request.connection = &conn;
+    response.headersLength = 0;
+    response.contentLength = CONTENT_LENGTH_NOT_SET;
+    response.started = false;
+    response.chunked = false;
+    response.finished = false;
+    response.headOnly = request.method == HTTP_HEAD;
+    response.detached = false;
+    response.stalledMs = 0;
+
+    conn.requests++;
+    if (conn.requests > 1) stats.reused++;
+    if (conn.requests >= MAX_REQUESTS_PER_CONNECTION) conn.keepAlive = false;
+
+    // 表單內容後面可能緊接著下一個管線化請求，先暫時截斷
+    char saved = conn.rx[request.length];
+    conn.rx[request.length] = '\0';
+
+    Route* matched = nullptr;
+    for (uint8_t i = 0; i < routeCount && !matched; i++) {
+        const Route& route = routes[i];
+        if (strcmp(route.uri, request.path) != 0) continue;
+        if (route.method == HTTP_ANY || route.method == request.method ||
+            (request.method == HTTP_HEAD && route.method == HTTP_GET)) {
+            matched = &routes[i];
+        }
+    }
+
+    uint32_t start = micros();
+    {
+        // 追蹤區段以路由路徑命名（路由表中的字串常駐）
+        TRACE_SCOPE(matched ? matched->uri : "web.notFound");
+        if (matched) matched->handler();
+        else if (notFoundHandler) notFoundHandler();
+        else send(404, "text/plain", "Not Found");
+
+        if (!response.detached) {
+            if (!response.started) send(500, "text/plain", "No response");
+            else if (response.chunked && !response.finished) sendContent("", 0);
+        }
+    }
+    uint32_t elapsed = micros() - start;
+
+    stats.dispatches++;
+    stats.lastHandleMicros = elapsed;
+    stats.totalHandleMicros += elapsed;
+    if (elapsed > stats.maxHandleMicros) stats.maxHandleMicros = elapsed;
+    Metrics::httpRequests.inc();
+    Metrics::httpHandleMs.observe(elapsed / 1000);
+
+    request.connection = nullptr;
+    if (response.detached) {
+        // socket 已由接管者持有副本，這裡只放掉連線表中的位置
+        release(conn);
+        return;
+    }
+
+    conn.rx[request.length] = saved;
+    conn.rxLength -= request.length;
+    memmove(conn.rx, conn.rx + request.length, conn.rxLength);
+    conn.rx[conn.rxLength] = '\0';
+
+    conn.state = ConnState::Writing;
+    conn.deadline = currentTime + WRITE_TIMEOUT;
+    flushConnection(conn, currentTime);
+}
+
+void MonitoringWebServer::rejectRequest(Connection& conn, int code, const char* message) {
+    DEBUG_WARN_PRINT("[Web] 拒絕請求 %s：%d %s\n",
+                     conn.socket.remoteIP().toString().c_str(), code, message);
+    request.connection = &conn;
+    request.http11 = true;
+    response.headersLength = 0;
+    response.contentLength = CONTENT_LENGTH_NOT_SET;
+    response.started = false;
+    response.chunked = false;
+    response.headOnly = false;
+    response.detached = false;
+    response.stalledMs = 0;
+    conn.keepAlive = false;
+    send(code, "text/plain", message);
+    request.connection = nullptr;
+
+    unsigned long currentTime = millis();
+    conn.rxLength = 0;
+    conn.rx[0] = '\0';
+    conn.state = ConnState::Writing;
+    conn.deadline = currentTime + WRITE_TIMEOUT;
+    flushConnection(conn, currentTime);
+}
+
+bool MonitoringWebServer::flushConnection(Connection& conn, unsigned long currentTime) {
+    bool progress = pumpOutput(conn);
+
+    if (conn.aborted) {
+        release(conn);
+        return true;
+    }
+    if (progress) {
+        conn.deadline = currentTime + WRITE_TIMEOUT;
+        conn.lastActivity = currentTime;
+    }
+    if (conn.state == ConnState::Writing && conn.txEnd == 0 &&
+        conn.overflowLength == 0 && conn.bodyRemaining == 0) {
+        finishResponse(conn, currentTime);
+    }
+    return progress;
+}
+
+// 依序送出固定緩衝、溢出區、send_P 內容，socket 收不下就停
+bool MonitoringWebServer::pumpOutput(Connection& conn) {
+    bool progress = false;
+    while (conn.txEnd > conn.txStart && !conn.aborted) {
+        size_t n = sendNow(conn, conn.tx + conn.txStart, conn.txEnd - conn.txStart);
+        if (n == 0) return progress;
+        conn.txStart += n;
+        progress = true;
+    }
+    conn.txStart = conn.txEnd = 0;
+
+    while (conn.overflowLength > conn.overflowSent && !conn.aborted) {
+        size_t n = sendNow(conn, conn.overflow + conn.overflowSent, conn.overflowLength - conn.overflowSent);
+        if (n == 0) return progress;
+        conn.overflowSent += n;
+        progress = true;
+    }
+    conn.overflowLength = conn.overflowSent = 0;
+
+    while (conn.bodyRemaining > 0 && !conn.aborted) {
+        size_t n = sendNow(conn, (const char*)conn.body, conn.bodyRemaining);
+        if (n == 0) return progress;
+        conn.body += n;
+        conn.bodyRemaining -= n;
+        progress = true;
+    }
+    return progress;
+}
+
+size_t MonitoringWebServer::appendOverflow(Connection& conn, const char* data, size_t length) {
+    if (conn.overflowSent > 0) {
+        memmove(conn.overflow, conn.overflow + conn.overflowSent, conn.overflowLength - conn.overflowSent);
+        conn.overflowLength -= conn.overflowSent;
+        conn.overflowSent = 0;
+    }
+
+    size_t needed = conn.overflowLength + length;
+    if (needed > conn.overflowCapacity && conn.overflowCapacity < MAX_OVERFLOW_PER_CONNECTION) {
+        size_t capacity = conn.overflowCapacity ? conn.overflowCapacity * 2 : TX_BUFFER_SIZE;
+        while (capacity < needed) capacity *= 2;
+        if (capacity > MAX_OVERFLOW_PER_CONNECTION) capacity = MAX_OVERFLOW_PER_CONNECTION;
+        if (overflowBytes - conn.overflowCapacity + capacity <= MAX_OVERFLOW_TOTAL) {
+            char* grown = (char*)realloc(conn.overflow, capacity);
+            if (grown) {
+                if (!conn.overflow) stats.overflows++;
+                overflowBytes += capacity - conn.overflowCapacity;
+                conn.overflow = grown;
+                conn.overflowCapacity = capacity;
+            }
+        }
+    }
+
+    size_t space = conn.overflowCapacity - conn.overflowLength;
+    size_t n = length < space ? length : space;
+    if (n > 0) {
+        memcpy(conn.overflow + conn.overflowLength, data, n);
+        conn.overflowLength += n;
+    }
+    return n;
+}
+
+void MonitoringWebServer::freeOverflow(Connection& conn) {
+    if (!conn.overflow) return;
+    free(conn.overflow);
+    overflowBytes -= conn.overflowCapacity;
+    conn.overflow = nullptr;
+    conn.overflowCapacity = conn.overflowLength = conn.overflowSent = 0;
+}
+
+void MonitoringWebServer::finishResponse(Connection& conn, unsigned long currentTime) {
+    conn.body = nullptr;
+    freeOverflow(conn);
+    if (!conn.keepAlive) {
+        release(conn);
+        return;
+    }
+    conn.state = ConnState::Reading;
+    conn.deadline = currentTime + (conn.rxLength > 0 ? REQUEST_TIMEOUT : IDLE_TIMEOUT);
+}
+
+void MonitoringWebServer::release(Connection& conn) {
+    // 只放掉這份參照；若 socket 已交給其他模組（SSE），由對方持有的副本維持開啟
+    conn.socket.stop();
+    conn.socket = WiFiClient();
+    conn.state = ConnState::Free;
+    conn.rxLength = 0;
+    conn.txStart = conn.txEnd = 0;
+    conn.body = nullptr;
+    conn.bodyRemaining = 0;
+    freeOverflow(conn);
+}
+
+size_t MonitoringWebServer::sendNow(Connection& conn, const char* data, size_t length) {
+    int n = ::send(conn.socket.fd(), data, length, MSG_DONTWAIT);
+    if (n > 0) {
+        stats.bytesSent += n;
+        if ((size_t)n < length) stats.partialWrites++;
+        return n;
+    }
+    if (n < 0 && (errno == EWOULDBLOCK || errno == EAGAIN)) return 0;
+    conn.aborted = true;
+    return 0;
+}
+
+void MonitoringWebServer::write(Connection& conn, const char* data, size_t length) {
+    while (length > 0 && !conn.aborted) {
+        // 溢出區有資料時一律往後接，維持送出順序
+        if (conn.overflowLength == 0) {
+            if (conn.txEnd == TX_BUFFER_SIZE && conn.txStart > 0) {
+                memmove(conn.tx, conn.tx + conn.txStart, conn.txEnd - conn.txStart);
+                conn.txEnd -= conn.txStart;
+                conn.txStart = 0;
+            }
+            size_t space = TX_BUFFER_SIZE - conn.txEnd;
+            if (space > 0) {
+                size_t n = length < space ? length : space;
+                memcpy(conn.tx + conn.txEnd, data, n);
+                conn.txEnd += n;
+                data += n;
+                length -= n;
+                continue;
+            }
+            // 固定緩衝已滿：先把 socket 收得下的寫出去
+            if (pumpOutput(conn)) continue;
+            if (conn.aborted) break;
+        }
+
+        size_t n = appendOverflow(conn, data, length);
+        if (n > 0) {
+            data += n;
+            length -= n;
+            continue;
+        }
+        if (pumpOutput(conn)) continue;
+        if (conn.aborted) break;
+
+        // 溢出區也滿而客戶端沒在收：短暫等待，超過上限就放棄這個連線，不讓它拖住主迴圈
+        if (response.stalledMs >= HANDLER_STALL_LIMIT) {
+            DEBUG_WARN_PRINT("[Web] 客戶端接收過慢，中止回應 %s\n", request.path);
+            stats.timeouts++;
+            conn.aborted = true;
+            break;
+        }
+        stats.handlerStalls++;
+        unsigned long start = millis();
+        socketWritable(conn.socket.fd(), HANDLER_STALL_LIMIT - response.stalledMs);
+        unsigned long waited = millis() - start;
+        response.stalledMs += waited > 0 ? waited : 1;
+    }
+}
+
+void MonitoringWebServer::writeStatus(int code, const char* contentType, size_t contentLength) {
+    Connection& conn = *request.connection;
+    response.started = true;
+
+    bool unknownLength = contentLength == CONTENT_LENGTH_UNKNOWN;
+    if (unknownLength && !response.headOnly) {
+        // HTTP/1.0 沒有 chunked，只能以關閉連線表示結束
+        if (request.http11) response.chunked = true;
+        else conn.keepAlive = false;
+    }
+
+    char line[128];
+    int n = snprintf(line, sizeof(line), "HTTP/1.%d %d %s\r\n", request.http11 ? 1 : 0, code, statusText(code));
+    write(conn, line, n);
+    if (contentType && *contentType) {
+        n = snprintf(line, sizeof(line), "Content-Type: %s\r\n", contentType);
+        write(conn, line, n < (int)sizeof(line) ? n : sizeof(line) - 1);
+    }
+    if (!unknownLength) {
+        n = snprintf(line, sizeof(line), "Content-Length: %u\r\n", (unsigned)contentLength);
+        write(conn, line, n);
+    }
+    if (response.chunked) {
+        write(conn, "Transfer-Encoding: chunked\r\n", 28);
+    }
+    if (conn.keepAlive) {
+        n = snprintf(line, sizeof(line), "Connection: keep-alive\r\nKeep-Alive: timeout=%lu\r\n", IDLE_TIMEOUT / 1000);
+        write(conn, line, n);
+    } else {
+        write(conn, "Connection: close\r\n", 19);
+    }
+    write(conn, response.headers, response.headersLength);
+    write(conn, "\r\n", 2);
+}
+
+void MonitoringWebServer::writeBody(const char* data, size_t length) {
+    if (!response.headOnly && length > 0) write(*request.connection, data, length);
+}
+
+void MonitoringWebServer::send(int code, const char* contentType, const char* content, size_t length) {
+    if (!request.connection || response.started) return;
+
+    if (response.contentLength == CONTENT_LENGTH_UNKNOWN) {
+        // StreamingResponse：先送標頭，內容由 sendContent() 分段補上
+        writeStatus(code, contentType, CONTENT_LENGTH_UNKNOWN);
+        if (length > 0) sendContent(content, length);
+        return;
+    }
+    if (response.contentLength != CONTENT_LENGTH_NOT_SET) {
+        writeStatus(code, contentType, response.contentLength);
+        writeBody(content, length);
+        return;
+    }
+    writeStatus(code, contentType, length);
+    writeBody(content, length);
+    response.finished = true;
+}
+
+void MonitoringWebServer::send_P(int code, const char* contentType, PGM_P content, size_t length) {
+    if (!request.connection || response.started) return;
+    writeStatus(code, contentType, length);
+    if (!response.headOnly) {
+        request.connection->body = (const uint8_t*)content;
+        request.connection->bodyRemaining = length;
+    }
+    response.finished = true;
+}
+
+void MonitoringWebServer::sendContent(const char* content, size_t length) {
+    if (!request.connection || !response.started || response.finished) return;
+    Connection& conn = *request.connection;
+
+    if (!response.chunked) {
+        writeBody(content, length);
+        return;
+    }
+    if (length == 0) {
+        write(conn, "0\r\n\r\n", 5);
+        response.finished = true;
+        return;
+    }
+    char size[12];
+    int n = snprintf(size, sizeof(size), "%x\r\n", (unsigned)length);
+    write(conn, size, n);
+    write(conn, content, length);
+    write(conn, "\r\n", 2);
+}
+
+void MonitoringWebServer::sendHeader(const char* name, const char* value) {
+    if (!request.connection || response.started) return;
+
+    // 連線管理由伺服器負責；處理器要求關閉時照辦
+    if (strcasecmp(name, "Connection") == 0) {
+        if (strcasecmp(value, "close") == 0) request.connection->keepAlive = false;
+        return;
+    }
+
+    size_t space = RESPONSE_HEADER_SIZE - response.headersLength;
+    int n = snprintf(response.headers + response.headersLength, space, "%s: %s\r\n", name, value);
+    if (n < 0 || (size_t)n >= space) {
+        DEBUG_WARN_PRINT("[Web] 回應標頭空間不足，略過 %s\n", name);
+        return;
+    }
+    response.headersLength += n;
+}
+
+String MonitoringWebServer::arg(const char* name) const {
+    for (uint8_t i = 0; i < request.argCount; i++) {
+        if (strcmp(request.args[i].key, name) == 0) return String(request.args[i].value);
+    }
+    return String();
+}
+
+bool MonitoringWebServer::hasArg(const char* name) const {
+    for (uint8_t i = 0; i < request.argCount; i++) {
+        if (strcmp(request.args[i].key, name) == 0) return true;
+    }
+    return false;
+}
+
+String MonitoringWebServer::header(const char* name) const {
+    for (uint8_t i = 0; i < request.headerCount; i++) {
+        if (strcasecmp(request.headers[i].key, name) == 0) return String(request.headers[i].value);
+    }
+    return String();
+}
+
+WiFiClient& MonitoringWebServer::client() {
+    static WiFiClient none;
+    return request.connection ? request.connection->socket : none;
+}
+
+void MonitoringWebServer::detachClient() {
+    if (!request.connection) return;
+    response.detached = true;
+    response.started = true;
+}
+
+void MonitoringWebServer::urlDecode(char* s) {
+    char* out = s;
+    for (char* in = s; *in; in++) {
+        if (*in == '+') {
+            *out++ = ' ';
+        } else if (*in == '%' && isxdigit((unsigned char)in[1]) && isxdigit((unsigned char)in[2])) {
+            char hex[3] = {in[1], in[2], '\0'};
+            *out++ = (char)strtol(hex, nullptr, 16);
+            in += 2;
+        } else {
+            *out++ = *in;
+        }
+    }
+    *out = '\0';
+}
+
+const char* MonitoringWebServer::statusText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 411: return "Length Required";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
@@ -1,5 +1,7 @@
 #include "common/RemoteDebugger.h"
 #include "common/Debug.h"
+#include "common/LogDrain.h"
+#include "common/SocketUtil.h"
 #include "controller/IThermostatControl.h"
 #include "device/ThermostatDevice.h"
 #include "device/FanDevice.h"
@@ -20,6 +22,24 @@ void remoteWebLog(const String& message) {
 #endif
 }
 
+// DebugTopics.h：所有客戶端訂閱的聯集，發布端據此跳過沒人訂閱的事件
+std::atomic<uint8_t> debugTopicMask{0};
+
+void debugPublishS21Frame(bool transmit, const uint8_t* frame, size_t length) {
+    RemoteDebugger::getInstance().publishS21Frame(transmit, frame, length);
+}
+
+void debugPublishControllerState(bool power, uint8_t targetMode, float targetTemperature,
+                                 float currentTemperature, uint8_t fanSpeed) {
+    RemoteDebugger::getInstance().publishControllerState(power, targetMode, targetTemperature,
+                                                         currentTemperature, fanSpeed);
+}
+
+bool DebugSocketServer::isWritable(uint8_t num) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !_clients[num].tcp) return false;
+    return socketWritable(_clients[num].tcp->fd());
+}
+
 RemoteDebugger& RemoteDebugger::getInstance() {
     static RemoteDebugger instance;
     return instance;
@@ -39,7 +59,7 @@ bool RemoteDebugger::begin(uint16_t port) {
         return false;
     }
     
-    wsServer = new WebSocketsServer(port);
+    wsServer = new DebugSocketServer(port);
     if (!wsServer) {
         DEBUG_ERROR_PRINT("[RemoteDebug] WebSocket 伺服器創建失敗\n");
         return false;
@@ -50,6 +70,10 @@ bool RemoteDebugger::begin(uint16_t port) {
         this->onWebSocketEvent(num, type, payload, length);
     });
     
+    if (!fanout) fanout.reset(new DebugFanout());
+    if (!logHistory) logHistory.reset(new MessageRing<LOG_HISTORY_BYTES>());
+    if (!serialLogHistory) serialLogHistory.reset(new MessageRing<SERIAL_LOG_HISTORY_BYTES>());
+    
     wsServer->begin();
     debugEnabled = true;
     
@@ -63,7 +87,46 @@ bool RemoteDebugger::begin(uint16_t port) {
 void RemoteDebugger::loop() {
     if (wsServer && debugEnabled) {
         wsServer->loop();
+        // 有調試客戶端在看時保持可選感測器的正常輪詢
+        if (!connectedClients.empty() && thermostatController) {
+            thermostatController->noteOptionalSensorInterest();
+        }
+        forwardDebugLogs();
+        // 到期的事件合併成批次訊框；socket 不可寫的客戶端這輪跳過
+        fanout->flush(millis(),
+            [this](uint8_t num) { return wsServer->isWritable(num); },
+            [this](uint8_t num, const char* data, size_t length, bool binary) {
+                if (binary) wsServer->sendBIN(num, (const uint8_t*)data, length);
+                else wsServer->sendTXT(num, (const uint8_t*)data, length);
+            });
+    }
+}
+
+// DEBUG_*_PRINT 的輸出在主迴圈轉發給遠端調試（WebSocket 只能在這個任務操作）
+void RemoteDebugger::forwardDebugLogs() {
+#ifdef BINARY_DEBUG_LOG
+    // 二進位日誌只在有客戶端訂閱該級別時才格式化轉發；無人觀看時直接跳過，不做任何格式化
+    if (connectedClients.empty() || !serialLogEnabled) {
+        debugLogCursor = BINARY_LOG.getLastSeq();
+        return;
+    }
+    debugLogCursor = BINARY_LOG.forEach(debugLogCursor, 8, [this](const BinaryLog::Entry& entry) {
+        if (!fanout->formatsFor(DebugTopic::Logs, entry.level)) return;
+        char text[BinaryLog::MAX_MESSAGE_SIZE];
+        BINARY_LOG.format(entry, text, sizeof(text));
+        logSerial(text, entry.level);
+    });
+#elif !defined(PRODUCTION_BUILD)
+    if (!serialLogEnabled) {
+        debugLogCursor = LOG_DRAIN.getHead();
+        return;
     }
+    // 有客戶端連線但都沒訂閱這個級別時不轉發（沒有客戶端時仍保留歷史，供下一個連線的客戶端讀取）
+    debugLogCursor = LOG_DRAIN.forEachMessage(debugLogCursor, 8, [this](const char* text, size_t, uint8_t level) {
+        if (!connectedClients.empty() && !fanout->formatsFor(DebugTopic::Logs, level)) return;
+        logSerial(text, level);
+    });
+#endif
 }
 
 void RemoteDebugger::stop() {
@@ -73,25 +136,23 @@ void RemoteDebugger::stop() {
     }
     debugEnabled = false;
     connectedClients.clear();
+    fanout.reset();
+    debugTopicMask.store(0, std::memory_order_relaxed);
     DEBUG_INFO_PRINT("[RemoteDebug] 遠端調試系統已停止\n");
 }
 
 void RemoteDebugger::log(const String& level, const String& component, const String& message) {
     if (!debugEnabled) return;
     
-    // 創建日誌條目
-    String timestamp = String(millis());
-    String logEntry = "[" + timestamp + "] [" + level + "] [" + component + "] " + message;
-    
-    // 添加到緩存
-    logBuffer.push_back(logEntry);
-    if (logBuffer.size() > MAX_LOG_BUFFER) {
-        logBuffer.erase(logBuffer.begin());
-    }
+    // 創建日誌條目並添加到緩存
+    char logEntry[256];
+    snprintf(logEntry, sizeof(logEntry), "[%lu] [%s] [%s] %s",
+             millis(), level.c_str(), component.c_str(), message.c_str());
+    logHistory->push(logEntry, strlen(logEntry) + 1);
     
-    // 廣播給所有連接的客戶端
-    String jsonMsg = createJsonMessage("log", logEntry);
-    broadcastMessage(jsonMsg);
+    // 放入訂閱該級別日誌的客戶端佇列
+    int levelValue = parseDebugLevel(level.c_str());
+    publishLog("log", levelValue > DEBUG_NONE ? levelValue : DEBUG_INFO, logEntry);
 }
 
 void RemoteDebugger::logHomeKitOperation(const String& operation, const String& service, 
@@ -114,20 +175,19 @@ void RemoteDebugger::logHomeKitOperation(const String& operation, const String&
         operationHistory.erase(operationHistory.begin());
     }
     
-    // 創建 JSON 訊息
-    JsonDocument doc;
-    doc["type"] = "homekit_operation";
-    doc["timestamp"] = op.timestamp;
-    doc["operation"] = op.operation;
-    doc["service"] = op.service;
-    doc["old_value"] = op.oldValue;
-    doc["new_value"] = op.newValue;
-    doc["success"] = op.success;
-    doc["error"] = op.errorMsg;
-    
-    String jsonString;
-    serializeJson(doc, jsonString);
-    broadcastMessage(jsonString);
+    // 只有訂閱 homekit 的客戶端才序列化
+    fanout->publish(DebugTopic::HomeKitOps, DEBUG_NONE, op.timestamp, [&op](auto& writer) {
+        writer.beginObject()
+            .field("type", "homekit_operation")
+            .field("timestamp", op.timestamp)
+            .field("operation", op.operation)
+            .field("service", op.service)
+            .field("old_value", op.oldValue)
+            .field("new_value", op.newValue)
+            .field("success", op.success)
+            .field("error", op.errorMsg)
+            .endObject();
+    });
     
     // 同時記錄到標準日誌
     String logMsg = operation + " [" + service + "] " + oldValue + " -> " + newValue + 
@@ -146,6 +206,14 @@ String RemoteDebugger::getSystemStatus() {
     doc["homekit_initialized"] = homeKitInitialized;
     doc["device_initialized"] = deviceInitialized;
     doc["debug_clients"] = connectedClients.size();
+    if (fanout) {
+        DebugFanout::Stats stats = fanout->getStats();
+        doc["debug_frames"] = stats.frames;
+        doc["debug_events_sent"] = stats.sent;
+        doc["debug_events_dropped"] = stats.dropped;
+        doc["debug_events_skipped"] = stats.skipped;
+        doc["debug_topics"] = debugTopicMask.load(std::memory_order_relaxed);
+    }
     
     String result;
     serializeJson(doc, result);
@@ -200,8 +268,8 @@ String RemoteDebugger::getLogHistory() {
     doc["timestamp"] = millis();
     
     JsonArray logs = doc["logs"].to<JsonArray>();
-    for (const auto& logEntry : logBuffer) {
-        logs.add(logEntry);
+    if (logHistory) {
+        logHistory->forEach([&logs](const char* logEntry, size_t) { logs.add(logEntry); });
     }
     
     String result;
@@ -301,35 +369,78 @@ bool RemoteDebugger::runDiagnostics() {
 }
 
 void RemoteDebugger::logSerial(const String& message) {
+    logSerial(message.c_str());
+}
+
+void RemoteDebugger::logSerial(const char* message, uint8_t level) {
     if (!serialLogEnabled || !debugEnabled) return;
     
-    // 添加時間戳記
-    String timestampedMsg = "[" + String(millis()) + "] " + message;
-    
-    // 添加到串口日誌緩存
-    serialLogBuffer.push_back(timestampedMsg);
-    if (serialLogBuffer.size() > MAX_SERIAL_LOG_BUFFER) {
-        serialLogBuffer.erase(serialLogBuffer.begin());
-    }
+    // 添加時間戳記並添加到串口日誌緩存
+    char timestampedMsg[DEBUG_BUFFER_SIZE + 16];
+    snprintf(timestampedMsg, sizeof(timestampedMsg), "[%lu] %s", millis(), message);
+    serialLogHistory->push(timestampedMsg, strlen(timestampedMsg) + 1);
     
-    // 即時廣播給所有連接的客戶端
-    String jsonMsg = createJsonMessage("serial_log", timestampedMsg);
-    broadcastMessage(jsonMsg);
+    // 放入訂閱該級別日誌的客戶端佇列，由 loop() 批次送出
+    publishLog("serial_log", level, timestampedMsg);
 }
 
 void RemoteDebugger::setSerialLogLevel(int level) {
+    if (level < DEBUG_NONE) level = DEBUG_NONE;
+    if (level > DEBUG_VERBOSE) level = DEBUG_VERBOSE;
     serialLogLevel = level;
     log("INFO", "RemoteDebug", "串口日誌級別設定為: " + String(level));
 }
 
+void RemoteDebugger::publishS21Frame(bool transmit, const uint8_t* frame, size_t length) {
+    if (!debugEnabled) return;
+    
+    // 以十六進位字串傳送（JSON 與 CBOR 相同），過長的訊框只保留開頭
+    static const size_t MAX_FRAME_BYTES = 96;
+    char hex[MAX_FRAME_BYTES * 2 + 1];
+    size_t shown = length < MAX_FRAME_BYTES ? length : MAX_FRAME_BYTES;
+    for (size_t i = 0; i < shown; i++) {
+        snprintf(hex + i * 2, 3, "%02X", frame[i]);
+    }
+    hex[shown * 2] = '\0';
+    
+    unsigned long now = millis();
+    fanout->publish(DebugTopic::S21Frames, DEBUG_NONE, now, [&](auto& writer) {
+        writer.beginObject()
+            .field("type", "s21_frame")
+            .field("timestamp", now)
+            .field("direction", transmit ? "tx" : "rx")
+            .field("length", length)
+            .field("hex", hex)
+            .endObject();
+    });
+}
+
+void RemoteDebugger::publishControllerState(bool power, uint8_t targetMode, float targetTemperature,
+                                            float currentTemperature, uint8_t fanSpeed) {
+    if (!debugEnabled) return;
+    
+    unsigned long now = millis();
+    fanout->publish(DebugTopic::ControllerState, DEBUG_NONE, now, [&](auto& writer) {
+        writer.beginObject()
+            .field("type", "controller_state")
+            .field("timestamp", now)
+            .field("power", power)
+            .field("mode", targetMode)
+            .field("target_temp", targetTemperature)
+            .field("current_temp", currentTemperature)
+            .field("fan_speed", fanSpeed)
+            .endObject();
+    });
+}
+
 String RemoteDebugger::getSerialLogHistory() {
     JsonDocument doc;
     doc["type"] = "serial_log_history";
     doc["timestamp"] = millis();
     
     JsonArray logs = doc["logs"].to<JsonArray>();
-    for (const auto& logEntry : serialLogBuffer) {
-        logs.add(logEntry);
+    if (serialLogHistory) {
+        serialLogHistory->forEach([&logs](const char* logEntry, size_t) { logs.add(logEntry); });
     }
     
     String result;
@@ -342,6 +453,8 @@ void RemoteDebugger::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
         case WStype_DISCONNECTED:
             DEBUG_INFO_PRINT("[RemoteDebug] 客戶端 %u 斷開連接\n", num);
             connectedClients.erase(std::remove(connectedClients.begin(), connectedClients.end(), num), connectedClients.end());
+            fanout->detach(num);
+            updateTopicMask();
             break;
             
         case WStype_CONNECTED:
@@ -349,6 +462,10 @@ void RemoteDebugger::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
                 IPAddress ip = wsServer->remoteIP(num);
                 DEBUG_INFO_PRINT("[RemoteDebug] 客戶端 %u 連接: %s\n", num, ip.toString().c_str());
                 connectedClients.push_back(num);
+                if (!fanout->attach(num, millis(), DEBUG_TOPICS_DEFAULT, serialLogLevel)) {
+                    DEBUG_WARN_PRINT("[RemoteDebug] 客戶端 %u 超過廣播上限，只接收查詢回應\n", num);
+                }
+                updateTopicMask();
                 
                 // 發送歡迎訊息和當前狀態
                 sendToClient(num, getSystemStatus());
@@ -387,6 +504,9 @@ void RemoteDebugger::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
                     } else if (command == "set_serial_log_level") {
                         int level = doc["level"];
                         setSerialLogLevel(level);
+                        fanout->setLogLevel(num, (uint8_t)serialLogLevel);
+                    } else if (command == "subscribe") {
+                        handleSubscribe(num, doc);
                     }
                 }
             }
@@ -400,9 +520,9 @@ void RemoteDebugger::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
 void RemoteDebugger::broadcastMessage(const String& message) {
     if (!wsServer || !debugEnabled) return;
     
+    // 命令的回應（診斷報告）不屬於任何訂閱主題，直接以文字訊框送給每個客戶端
     for (uint8_t clientId : connectedClients) {
-        String msg = message; // 創建非const副本
-        wsServer->sendTXT(clientId, msg);
+        sendToClient(clientId, message);
     }
 }
 
@@ -413,13 +533,61 @@ void RemoteDebugger::sendToClient(uint8_t clientId, const String& message) {
     wsServer->sendTXT(clientId, msg);
 }
 
-String RemoteDebugger::createJsonMessage(const String& type, const String& data) {
-    JsonDocument doc;
-    doc["type"] = type;
-    doc["timestamp"] = millis();
-    doc["data"] = data;
+// 只有訂閱該級別日誌的客戶端才序列化，每種編碼一次，不配置堆積
+void RemoteDebugger::publishLog(const char* type, uint8_t level, const char* text) {
+    unsigned long now = millis();
+    fanout->publish(DebugTopic::Logs, level, now, [&](auto& writer) {
+        writer.beginObject()
+            .field("type", type)
+            .field("timestamp", now)
+            .field("level", debugLevelName(level))
+            .field("data", text)
+            .endObject();
+    });
+}
+
+void RemoteDebugger::updateTopicMask() {
+    debugTopicMask.store(fanout ? fanout->getTopicMask() : 0, std::memory_order_relaxed);
+}
+
+// {"command":"subscribe","topics":["s21","logs"],"level":"warn","binary":true}
+// 未提供 topics 時使用預設主題；level 接受名稱或 0-4；binary 為 true 時事件改以 CBOR 二進位訊框送出
+void RemoteDebugger::handleSubscribe(uint8_t num, const JsonDocument& doc) {
+    uint8_t topics = DEBUG_TOPICS_DEFAULT;
+    if (doc["topics"].is<JsonArrayConst>()) {
+        topics = 0;
+        for (JsonVariantConst name : doc["topics"].as<JsonArrayConst>()) {
+            int topic = parseDebugTopic(name | "");
+            if (topic >= 0) topics |= 1u << topic;
+        }
+    }
+    int level = serialLogLevel;
+    if (doc["level"].is<int>()) {
+        level = doc["level"].as<int>();
+    } else if (doc["level"].is<const char*>()) {
+        level = parseDebugLevel(doc["level"].as<const char*>());
+    }
+    if (level < DEBUG_NONE || level > DEBUG_VERBOSE) level = serialLogLevel;
+    bool binary = doc["binary"] | false;
     
-    String result;
-    serializeJson(doc, result);
-    return result;
-}
\ No newline at end of file
+    if (!fanout->subscribe(num, topics, (uint8_t)level, binary)) {
+        DEBUG_WARN_PRINT("[RemoteDebug] 客戶端 %u 未配置廣播佇列，無法訂閱\n", num);
+        return;
+    }
+    updateTopicMask();
+    DEBUG_INFO_PRINT("[RemoteDebug] 客戶端 %u 訂閱主題 0x%02X，日誌級別 %s，%s\n",
+                     num, topics, debugLevelName(level), binary ? "CBOR" : "JSON");
+    
+    // 訂閱確認一律以文字訊框回應
+    JsonDocument reply;
+    reply["type"] = "subscribed";
+    JsonArray names = reply["topics"].to<JsonArray>();
+    for (uint8_t i = 0; i < (uint8_t)DebugTopic::Count; i++) {
+        if (topics & (1u << i)) names.add(DEBUG_TOPIC_NAMES[i]);
+    }
+    reply["level"] = debugLevelName(level);
+    reply["binary"] = binary;
+    String message;
+    serializeJson(reply, message);
+    sendToClient(num, message);
+}
@@ -1,6 +1,9 @@
 #include "protocol/S21Protocol.h"
 #include "protocol/S21Utils.h"
 #include "common/Debug.h"
+#include "common/DebugTopics.h"
+#include "common/Metrics.h"
+#include "common/Trace.h"
 
 // 高性能通訊常量 (基於 Faikin 規範優化)
 static constexpr uint32_t RESPONSE_TIMEOUT_MS = 500;    // 降低超時時間以提高響應性
@@ -292,6 +295,7 @@ bool S21Protocol::detectFeatures() {
 }
 
 bool S21Protocol::sendCommandInternal(char cmd0, char cmd1, const uint8_t* payload, size_t len) {
+    TRACE_SCOPE("s21.send");
     static uint8_t txBuffer[BUFFER_SIZE];
     size_t index = 0;
     
@@ -321,6 +325,11 @@ bool S21Protocol::sendCommandInternal(char cmd0, char cmd1, const uint8_t* paylo
     txBuffer[index++] = s21_checksum(txBuffer, index + 2);  // +2 for checksum and ETX
     txBuffer[index++] = ETX;
     
+    // 有遠端調試客戶端訂閱時才轉出原始訊框
+    if (DEBUG_TOPIC_ENABLED(DebugTopic::S21Frames)) {
+        debugPublishS21Frame(true, txBuffer, index);
+    }
+    
     // 發送數據前等待 (基於 Faikin 規範)
     delay(COMMAND_DELAY_MS);
     
@@ -401,6 +410,7 @@ bool S21Protocol::sendCommand(char cmd0, char cmd1, const uint8_t* payload, size
             // 命令成功，更新統計
             commQuality.totalCommands++;
             errorRecovery.consecutiveErrors = 0;
+            Metrics::s21ResponseMs.observe(millis() - commandStartTime);
             
             // 監控回應時間
             monitorResponseTimes();
@@ -424,15 +434,18 @@ bool S21Protocol::sendCommand(char cmd0, char cmd1, const uint8_t* payload, size
                     case S21ErrorCode::TIMEOUT:
                         delay(50);  // 短延遲後重試
                         commQuality.timeoutCount++;
+                        Metrics::s21RetriesTimeout.inc();
                         break;
                         
                     case S21ErrorCode::CHECKSUM_ERROR:
                         delay(50);  // 短暫延遲後重試
                         commQuality.checksumErrorCount++;
+                        Metrics::s21RetriesChecksum.inc();
                         break;
                         
                     default:
                         delay(50);
+                        Metrics::s21RetriesOther.inc();
                         break;
                 }
             } else {
@@ -548,6 +561,7 @@ bool S21Protocol::isFeatureSupported(const S21Features& feature) const {
 }
 
 bool S21Protocol::parseResponse(uint8_t& cmd0, uint8_t& cmd1, uint8_t* payload, size_t& payloadLen, size_t maxPayloadLen) {
+    TRACE_SCOPE("s21.parse");
     static uint8_t rxBuffer[BUFFER_SIZE];
     size_t index = 0;
     
@@ -603,6 +617,11 @@ bool S21Protocol::parseResponse(uint8_t& cmd0, uint8_t& cmd1, uint8_t* payload,
         return false;
     }
     
+    // 在驗證之前轉出，校驗和錯誤的訊框也能在遠端調試中看到
+    if (DEBUG_TOPIC_ENABLED(DebugTopic::S21Frames)) {
+        debugPublishS21Frame(false, rxBuffer, index);
+    }
+    
     // 檢查數據最小長度
     if (index < 5) {
         DEBUG_ERROR_PRINT("[S21] 錯誤：數據包太短（%d 字節）\n", index);
@@ -673,6 +692,7 @@ void S21Protocol::setError(S21ErrorCode error) {
 
 void S21Protocol::incrementSuccess() {
     status.successfulCommands++;
+    Metrics::s21Commands.inc();
     // 如果錯誤計數較少且最近成功，則認為連接恢復
     if (status.communicationErrors > 0 && 
         status.successfulCommands % 5 == 0) {  // 每5次成功後檢查一次
@@ -683,6 +703,7 @@ void S21Protocol::incrementSuccess() {
 
 void S21Protocol::incrementError() {
     status.communicationErrors++;
+    Metrics::s21Errors.inc();
     // 連續錯誤過多時標記為連接問題
     if (status.communicationErrors > status.successfulCommands + 10) {
         status.isConnected = false;
@@ -1235,6 +1256,7 @@ void S21Protocol::updateCommunicationQuality() {
     }
     
     commQuality.qualityScore = max(0.0f, successRate - timeoutPenalty - checksumPenalty - responsePenalty);
+    Metrics::s21QualityScore.set(commQuality.qualityScore);
     
     // 判斷連接穩定性
     commQuality.isStable = (commQuality.qualityScore > 80.0f && 
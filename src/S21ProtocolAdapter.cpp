@@ -206,19 +206,9 @@ bool S21ProtocolAdapter::queryStatus(ACStatus& status) {
     DEBUG_INFO_PRINT("[S21Adapter] 風速解析: 原始字符='%c' -> 數值=%d (%s)\n",
                       payload[3], status.fanSpeed, getFanSpeedText(status.fanSpeed));
     
-    // 查詢擺風狀態 (F5 -> G5)
-    if (s21Protocol->sendCommand('F', '5')) {
-        uint8_t swPayload[8];
-        size_t swLen;
-        uint8_t swCmd0, swCmd1;
-        if (s21Protocol->parseResponse(swCmd0, swCmd1, swPayload, swLen, sizeof(swPayload))) {
-            if (swCmd0 == 'G' && swCmd1 == '5' && swLen >= 2) {
-                status.swingVertical = (swPayload[0] != '0');
-                status.swingHorizontal = (swPayload[1] != '0');
-                DEBUG_VERBOSE_PRINT("[S21Adapter] 擺風狀態: V=%c H=%c\n", swPayload[0], swPayload[1]);
-            }
-        }
-    }
+    // 擺風狀態由 querySwing() 按需查詢，這裡沿用上次的結果
+    status.swingVertical = lastStatus.swingVertical;
+    status.swingHorizontal = lastStatus.swingHorizontal;
 
     // 更新內部緩存
     lastStatus = status;
@@ -296,8 +286,6 @@ bool S21ProtocolAdapter::supportsSwing(SwingAxis axis) const {
 }
 
 bool S21ProtocolAdapter::setSwing(SwingAxis axis, bool enabled) {
-    if (!s21Protocol) return false;
-
     // 讀取當前狀態以保留另一軸的設定
     bool curV = lastStatus.swingVertical;
     bool curH = lastStatus.swingHorizontal;
@@ -305,9 +293,15 @@ bool S21ProtocolAdapter::setSwing(SwingAxis axis, bool enabled) {
     if (axis == SwingAxis::Vertical) curV = enabled;
     else curH = enabled;
 
+    return setSwingState(curV, curH);
+}
+
+bool S21ProtocolAdapter::setSwingState(bool vertical, bool horizontal) {
+    if (!s21Protocol) return false;
+
     uint8_t payload[4];
-    payload[0] = curV ? '?' : '0';  // '?' = 自動擺風, '0' = 停止
-    payload[1] = curH ? '?' : '0';
+    payload[0] = vertical ? '?' : '0';  // '?' = 自動擺風, '0' = 停止
+    payload[1] = horizontal ? '?' : '0';
     payload[2] = '0';
     payload[3] = '0';
 
@@ -315,8 +309,8 @@ bool S21ProtocolAdapter::setSwing(SwingAxis axis, bool enabled) {
 
     bool success = s21Protocol->sendCommand('D', '5', payload, 4);
     if (success) {
-        lastStatus.swingVertical = curV;
-        lastStatus.swingHorizontal = curH;
+        lastStatus.swingVertical = vertical;
+        lastStatus.swingHorizontal = horizontal;
         lastOperationSuccess = true;
         setLastError("");
     } else {
@@ -331,6 +325,36 @@ bool S21ProtocolAdapter::getSwing(SwingAxis axis) const {
     return lastStatus.swingHorizontal;
 }
 
+bool S21ProtocolAdapter::querySwing(ACStatus& status) {
+    uint8_t payload[8];
+    size_t payloadLen;
+    uint8_t cmd0, cmd1;
+
+    // 查詢擺風狀態 (F5 -> G5)
+    if (!s21Protocol->sendCommand('F', '5')) {
+        setLastError("擺風查詢命令發送失敗");
+        return false;
+    }
+
+    if (!s21Protocol->parseResponse(cmd0, cmd1, payload, payloadLen, sizeof(payload))) {
+        setLastError("擺風回應解析失敗");
+        return false;
+    }
+
+    if (cmd0 != 'G' || cmd1 != '5' || payloadLen < 2) {
+        setLastError("擺風回應格式錯誤");
+        return false;
+    }
+
+    status.swingVertical = (payload[0] != '0');
+    status.swingHorizontal = (payload[1] != '0');
+    lastStatus.swingVertical = status.swingVertical;
+    lastStatus.swingHorizontal = status.swingHorizontal;
+    DEBUG_VERBOSE_PRINT("[S21Adapter] 擺風狀態: V=%c H=%c\n", payload[0], payload[1]);
+
+    return true;
+}
+
 bool S21ProtocolAdapter::supportsMode(uint8_t mode) const {
     auto it = std::find(SUPPORTED_MODES.begin(), SUPPORTED_MODES.end(), mode);
     return it != SUPPORTED_MODES.end();
@@ -7,15 +7,17 @@ SwingSwitchService::SwingSwitchService(IThermostatControl& ctrl,
       controller(ctrl),
       swingAxis(axis),
       onCharacteristic(nullptr),
-      lastSyncTime(0),
-      axisSupported(ctrl.supportsSwing(axis)) {
+      axisSupported(ctrl.supportsSwing(axis)),
+      onSlot(HomeKitNotifier::INVALID_SLOT) {
 
     new Characteristic::Name(displayName);
     onCharacteristic = new Characteristic::On(false);
 
     if (axisSupported) {
+        controller.setSwingExposed(true);
         bool current = readCurrentState();
         onCharacteristic->setVal(current);
+        onSlot = HOMEKIT_NOTIFIER.track(onCharacteristic, displayName, {0, 0, 0}, false);
         DEBUG_INFO_PRINT("[SwingSwitch] %s 初始化: %s\n", displayName, current ? "開啟" : "關閉");
     } else {
         DEBUG_INFO_PRINT("[SwingSwitch] %s 不支援\n", displayName);
@@ -40,26 +42,26 @@ boolean SwingSwitchService::update() {
             DEBUG_INFO_PRINT("[SwingSwitch] 擺風狀態更新為 %s\n",
                              desired ? "開啟" : "關閉");
         }
-        lastSyncTime = millis();
+        ACCESSORY_SYNC.requestFullSync();
     }
 
     return true;
 }
 
-void SwingSwitchService::loop() {
-    if (!axisSupported) return;
+uint16_t SwingSwitchService::applySnapshot(const AccessorySnapshot& snap, uint16_t dirty,
+                                           unsigned long currentTime) {
+    if (!axisSupported) return 0;
 
-    unsigned long now = millis();
-    if (now - lastSyncTime < SYNC_INTERVAL_MS) return;
-    lastSyncTime = now;
+    uint16_t axisBit = (swingAxis == IACProtocol::SwingAxis::Vertical) ? DIRTY_SWING_V : DIRTY_SWING_H;
+    if (!(dirty & axisBit)) return 0;
 
-    bool current = readCurrentState();
-    if (onCharacteristic->getVal() != current) {
-        onCharacteristic->setVal(current);
-        onCharacteristic->timeVal();
+    bool current = (swingAxis == IACProtocol::SwingAxis::Vertical) ? snap.swingVertical
+                                                                  : snap.swingHorizontal;
+    if (HOMEKIT_NOTIFIER.stage(onSlot, current, currentTime)) {
         DEBUG_VERBOSE_PRINT("[SwingSwitch] 同步擺風狀態為 %s\n",
                             current ? "開啟" : "關閉");
     }
+    return 0;
 }
 
 bool SwingSwitchService::readCurrentState() const {
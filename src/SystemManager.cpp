@@ -1,11 +1,16 @@
 #include "common/SystemManager.h"
 #include "common/Config.h"
+#include "common/MonitoringWebServer.h"
+#include "common/EventStream.h"
 #include "controller/IThermostatControl.h"
 #ifndef DISABLE_MOCK_CONTROLLER
 #include "controller/MockThermostatController.h"
 #endif
 #include "device/ThermostatDevice.h"
+#include "device/AccessorySync.h"
+#include "common/Metrics.h"
 #include "common/Debug.h"
+#include "common/Trace.h"
 #include "HomeSpan.h"
 
 // 前向宣告避免包含問題的頭文件
@@ -21,10 +26,9 @@ static constexpr unsigned long SYSTEM_HEARTBEAT_INTERVAL = 30000; // 系統心
 
 // 記憶體閾值 - 優化後減少偽休眠問題
 static constexpr uint32_t MEMORY_DROP_THRESHOLD = 35000;         // 記憶體下降閾值（提高避免誤判）
-static constexpr uint32_t MEMORY_TIGHT_THRESHOLD = 40000;        // 記憶體緊張閾值（降低減少觸發）
 static constexpr uint32_t MEMORY_MEDIUM_THRESHOLD = 70000;       // 記憶體中等閾值（調整平衡點）
 
-SystemManager::SystemManager(ConfigManager& config, WiFiManager*& wifi, WebServer*& web,
+SystemManager::SystemManager(ConfigManager& config, WiFiManager*& wifi, MonitoringWebServer*& web,
                            IThermostatControl*& controller, 
                            #ifndef DISABLE_MOCK_CONTROLLER
                            MockThermostatController*& mock,
@@ -43,6 +47,8 @@ SystemManager::SystemManager(ConfigManager& config, WiFiManager*& wifi, WebServe
 }
 
 void SystemManager::processMainLoop() {
+    TRACE_SCOPE("loop");
+    profiler.beginLoop();
     // 高性能循環計數器系統 - 減少millis()調用
     state.loopCounter++;
     bool shouldCheckTiming = (state.loopCounter % state.fastLoopDivider) == 0;
@@ -52,16 +58,39 @@ void SystemManager::processMainLoop() {
     
     // 關鍵系統處理 - 每次循環都執行
     if (homeKitInitialized) {
+        TRACE_SCOPE("homespan.poll");
+        LoopProfiler::Scope phase(profiler, LoopPhase::HomeSpan);
         homeSpan.poll(); // 最高優先級
     }
     
     // 中等優先級處理 - 每10次循環檢查一次
     if ((state.loopCounter % 10) == 0) {
-        handleOTAUpdates();
+        {
+            TRACE_SCOPE("ota");
+            LoopProfiler::Scope phase(profiler, LoopPhase::OTA);
+            handleOTAUpdates();
+        }
+        
+        // 監控 WebServer 連線泵：接受新連線，各連線只做 socket 當下可讀寫的非阻塞 I/O，
+        // 收齊的請求每次最多分派 MAX_DISPATCH_PER_SERVICE 個；之後推送 SSE 事件
+        if (homeKitInitialized && !homeKitPairingActive && monitoringEnabled && webServer) {
+            TRACE_SCOPE("web.service");
+            LoopProfiler::Scope phase(profiler, LoopPhase::Web);
+            webServer->service();
+            EVENT_STREAM.tick(millis());
+        }
+        
+        // 配件狀態同步（內部自行節流到同步間隔）
+        if (homeKitInitialized) {
+            TRACE_SCOPE("accessory.sync");
+            LoopProfiler::Scope phase(profiler, LoopPhase::Controller);
+            ACCESSORY_SYNC.tick(millis());
+        }
     }
     
     // 定時任務處理 - 使用優化的定時系統
     if (shouldCheckTiming) {
+        TRACE_SCOPE("timing.tasks");
         handleOptimizedTimingTasks(currentTime);
     }
 }
@@ -72,6 +101,7 @@ void SystemManager::handleOptimizedTimingTasks(unsigned long currentTime) {
     // 全局WiFi監控 (最高優先級 - 快速重連)
     if (currentTime >= state.nextWiFiCheck) {
         state.nextWiFiCheck = currentTime + 5000; // 5秒檢查間隔（優化：從15秒縮短）
+        LoopProfiler::Scope phase(profiler, LoopPhase::WiFi);
         handleGlobalWiFiMonitoring(currentTime);
     }
     
@@ -79,6 +109,7 @@ void SystemManager::handleOptimizedTimingTasks(unsigned long currentTime) {
     if (currentTime >= state.nextPowerCheck) {
         state.nextPowerCheck = currentTime + POWER_CHECK_INTERVAL;
         #if defined(ESP32C3_SUPER_MINI)
+        LoopProfiler::Scope phase(profiler, LoopPhase::WiFi);
         handleSmartWiFiPowerManagement();
         #endif
     }
@@ -89,19 +120,6 @@ void SystemManager::handleOptimizedTimingTasks(unsigned long currentTime) {
         handleHomeKitPairingDetection(currentTime);
     }
     
-    // WebServer 處理
-    if (homeKitInitialized && !homeKitPairingActive && monitoringEnabled && webServer) {
-        uint32_t freeMemory = ESP.getFreeHeap();
-        unsigned long handleInterval = calculateWebServerInterval(freeMemory);
-        
-        if (currentTime >= state.nextWebServerHandle) {
-            state.nextWebServerHandle = currentTime + handleInterval;
-            if (!shouldSkipWebServerProcessing()) {
-                webServer->handleClient();
-            }
-        }
-    }
-    
     // WebServer 啟動檢查
     if (homeKitInitialized) {
         handleWebServerStartup(currentTime);
@@ -110,6 +128,7 @@ void SystemManager::handleOptimizedTimingTasks(unsigned long currentTime) {
     // 系統心跳
     if (currentTime >= state.nextHeartbeat) {
         state.nextHeartbeat = currentTime + SYSTEM_HEARTBEAT_INTERVAL;
+        LoopProfiler::Scope phase(profiler, LoopPhase::Heartbeat);
         printHeartbeatInfo(currentTime);
     }
 }
@@ -264,6 +283,15 @@ void SystemManager::printHeartbeatInfo(unsigned long currentTime) {
     DEBUG_INFO_PRINT("[SystemManager] 主循環運行中... 模式：%s，WiFi：%s，設備：%s，IP：%s\n", 
                      mode.c_str(), wifiStatus.c_str(), deviceStatus.c_str(), ipAddress.c_str());
     
+    // 主迴圈間隔與抖動（詳細分佈見 /api/perf/loop）
+    const LoopProfiler::CycleHistogram& period = profiler.getPeriod();
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    DEBUG_INFO_PRINT("[SystemManager] 主迴圈 - 平均間隔: %lu µs, 抖動: %lu µs, 最長: %lu µs, SLO 違規: %lu, 最耗時階段: %s\n",
+                     (unsigned long)(period.count ? period.total / period.count / mhz : 0),
+                     (unsigned long)(profiler.getJitterCycles() / mhz),
+                     (unsigned long)(period.max / mhz), (unsigned long)profiler.getBreaches(),
+                     LOOP_PHASE_NAMES[(uint8_t)profiler.worstOffender()]);
+    
     // HomeKit 模式的詳細狀態
     if (homeKitInitialized) {
         // 記憶體監控和分析
@@ -295,32 +323,10 @@ bool SystemManager::shouldStartWebServer(unsigned long currentTime) const {
            !homeKitPairingActive;
 }
 
-unsigned long SystemManager::calculateWebServerInterval(uint32_t freeMemory) {
-    if (freeMemory < MEMORY_TIGHT_THRESHOLD) {
-        state.webServerSkipCounter++;
-        return 200; // 記憶體緊張時降低頻率
-    } else if (freeMemory < MEMORY_MEDIUM_THRESHOLD) {
-        return 100; // 中等記憶體時中等頻率
-    } else {
-        state.webServerSkipCounter = 0;
-        return 50;  // 記憶體充足時正常頻率
-    }
-}
-
-bool SystemManager::shouldSkipWebServerProcessing() const {
-    // 優化WebServer跳過邏輯 - 減少跳過頻率，提高響應性
-    // 只有在真正記憶體不足時才跳過，且跳過比例從2/3降低為1/2
-    if (state.webServerSkipCounter <= 5) {
-        return false; // 初期不跳過，確保基本響應
-    }
-    
-    // 記憶體嚴重不足時，每2次跳過1次（改善前是每3次跳過2次）
-    return (state.webServerSkipCounter % 2) != 0;
-}
-
 void SystemManager::updatePairingDetection(uint32_t currentMemory) {
     // 高性能記憶體檢測，使用移動平均減少波動影響
     state.avgMemory = (state.avgMemory * 7 + currentMemory) / 8; // 更穩定的移動平均
+    Metrics::avgFreeHeap.set(state.avgMemory);
     
     // 改良的配對檢測邏輯 - 使用 HomeSpan 實際連接狀態
     static unsigned long lastPairingCheckTime = 0;
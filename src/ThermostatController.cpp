@@ -1,5 +1,7 @@
 #include "controller/ThermostatController.h"
 #include "common/Debug.h"
+#include "common/Metrics.h"
+#include "common/Trace.h"
 
 ThermostatController::ThermostatController(std::unique_ptr<IACProtocol> p) 
     : protocol(std::move(p)),
@@ -11,17 +13,22 @@ ThermostatController::ThermostatController(std::unique_ptr<IACProtocol> p)
       consecutiveErrors(0),
       lastUpdateTime(0),
       lastSuccessfulUpdate(0),
-      lastFanSpeedSetTime(0),
-      lastUserFanSpeed(AC_FAN_AUTO),
-      lastModeSetTime(0),
-      lastUserMode(AC_MODE_AUTO),
-      targetHomeKitMode(HAP_MODE_AUTO) {
+      swingVertical(false),
+      swingHorizontal(false),
+      targetHomeKitMode(HAP_MODE_AUTO),
+      swingExposed(false),
+      lastOptionalInterest(0),
+      lastOptionalQueryTime(0),
+      optionalQueries(0),
+      optionalSkipped(0) {
     
     if (!protocol) {
         DEBUG_ERROR_PRINT("[Controller] 錯誤：協議實例為空\n");
         return;
     }
     
+    initIntentSettleTimes();
+    
     DEBUG_INFO_PRINT("[Controller] 開始初始化通用控制器 - 協議: %s\n", 
                       protocol->getProtocolName());
     
@@ -48,11 +55,15 @@ ThermostatController::ThermostatController(ThermostatController&& other) noexcep
       consecutiveErrors(other.consecutiveErrors),
       lastUpdateTime(other.lastUpdateTime),
       lastSuccessfulUpdate(other.lastSuccessfulUpdate),
-      lastFanSpeedSetTime(other.lastFanSpeedSetTime),
-      lastUserFanSpeed(other.lastUserFanSpeed),
-      lastModeSetTime(other.lastModeSetTime),
-      lastUserMode(other.lastUserMode),
+      swingVertical(other.swingVertical),
+      swingHorizontal(other.swingHorizontal),
+      intents(other.intents),
       targetHomeKitMode(other.targetHomeKitMode),
+      swingExposed(other.swingExposed),
+      lastOptionalInterest(other.lastOptionalInterest),
+      lastOptionalQueryTime(other.lastOptionalQueryTime),
+      optionalQueries(other.optionalQueries),
+      optionalSkipped(other.optionalSkipped),
       dirtyPower(other.dirtyPower),
       dirtyMode(other.dirtyMode),
       dirtyTemp(other.dirtyTemp),
@@ -70,11 +81,15 @@ ThermostatController& ThermostatController::operator=(ThermostatController&& oth
         consecutiveErrors = other.consecutiveErrors;
         lastUpdateTime = other.lastUpdateTime;
         lastSuccessfulUpdate = other.lastSuccessfulUpdate;
-        lastFanSpeedSetTime = other.lastFanSpeedSetTime;
-        lastUserFanSpeed = other.lastUserFanSpeed;
-        lastModeSetTime = other.lastModeSetTime;
-        lastUserMode = other.lastUserMode;
+        swingVertical = other.swingVertical;
+        swingHorizontal = other.swingHorizontal;
+        intents = other.intents;
         targetHomeKitMode = other.targetHomeKitMode;
+        swingExposed = other.swingExposed;
+        lastOptionalInterest = other.lastOptionalInterest;
+        lastOptionalQueryTime = other.lastOptionalQueryTime;
+        optionalQueries = other.optionalQueries;
+        optionalSkipped = other.optionalSkipped;
         dirtyPower = other.dirtyPower;
         dirtyMode = other.dirtyMode;
         dirtyTemp = other.dirtyTemp;
@@ -83,11 +98,21 @@ ThermostatController& ThermostatController::operator=(ThermostatController&& oth
     return *this;
 }
 
+void ThermostatController::initIntentSettleTimes() {
+    intents.setSettleTime(IntentField::Power, POWER_SETTLE_TIME);
+    intents.setSettleTime(IntentField::Mode, MODE_SETTLE_TIME);
+    intents.setSettleTime(IntentField::TargetTemperature, TEMP_SETTLE_TIME);
+    intents.setSettleTime(IntentField::FanSpeed, FAN_SETTLE_TIME);
+    intents.setSettleTime(IntentField::SwingVertical, SWING_SETTLE_TIME);
+    intents.setSettleTime(IntentField::SwingHorizontal, SWING_SETTLE_TIME);
+}
+
 bool ThermostatController::setPower(bool on) {
     if (!protocol) return false;
 
     DEBUG_INFO_PRINT("[Controller] 設置電源狀態：%s\n", on ? "開啟" : "關閉");
     power = on;
+    intents.record(IntentField::Power, on ? 1.0f : 0.0f, millis());
     dirtyPower = true;
 
     if (isInErrorRecoveryMode()) {
@@ -123,8 +148,7 @@ bool ThermostatController::setTargetMode(uint8_t newMode) {
 
     mode = acMode;
     targetHomeKitMode = newMode;
-    lastModeSetTime = millis();
-    lastUserMode = acMode;
+    intents.record(IntentField::Mode, acMode, millis());
     dirtyMode = true;
 
     if (!power && !setPower(true)) {
@@ -161,6 +185,7 @@ bool ThermostatController::setTargetTemperature(float temperature) {
 
     DEBUG_INFO_PRINT("[Controller] 設置目標溫度：%.1f°C\n", temperature);
     targetTemperature = temperature;
+    intents.record(IntentField::TargetTemperature, temperature, millis());
     dirtyTemp = true;
 
     if (isInErrorRecoveryMode()) {
@@ -189,8 +214,7 @@ bool ThermostatController::setFanSpeed(uint8_t speed) {
 
     DEBUG_INFO_PRINT("[Controller] 設置風速：%d (%s)\n", speed, getFanSpeedText(speed));
     fanSpeed = speed;
-    lastFanSpeedSetTime = millis();
-    lastUserFanSpeed = speed;
+    intents.record(IntentField::FanSpeed, speed, millis());
     dirtyFan = true;
 
     if (isInErrorRecoveryMode()) {
@@ -218,14 +242,16 @@ void ThermostatController::syncDirtyState() {
     // 用一次 setPowerAndMode 送出電源+模式+溫度+風速
     if (dirtyPower || dirtyMode || dirtyFan) {
         if (protocol->setPowerAndMode(power, mode, targetTemperature, fanSpeed)) {
+            // 命令實際送出後才重啟對應欄位的穩定期
+            unsigned long now = millis();
+            if (dirtyPower) intents.record(IntentField::Power, power ? 1.0f : 0.0f, now);
+            if (dirtyMode) intents.record(IntentField::Mode, mode, now);
+            if (dirtyFan) intents.record(IntentField::FanSpeed, fanSpeed, now);
+            if (dirtyTemp) intents.record(IntentField::TargetTemperature, targetTemperature, now);
             dirtyPower = false;
+            dirtyMode = false;
             dirtyFan = false;
             dirtyTemp = false; // setPowerAndMode 已包含溫度
-            if (dirtyMode) {
-                lastModeSetTime = millis(); // 只在模式變更時重啟保護期
-                lastUserMode = mode;
-                dirtyMode = false;
-            }
             resetErrorCount();
             lastSuccessfulUpdate = millis();
             DEBUG_INFO_PRINT("[Controller] 狀態同步成功\n");
@@ -237,6 +263,7 @@ void ThermostatController::syncDirtyState() {
 
     if (dirtyTemp) {
         if (protocol->setTemperature(targetTemperature)) {
+            intents.record(IntentField::TargetTemperature, targetTemperature, millis());
             dirtyTemp = false;
             resetErrorCount();
             lastSuccessfulUpdate = millis();
@@ -247,6 +274,7 @@ void ThermostatController::syncDirtyState() {
 }
 
 void ThermostatController::update() {
+    TRACE_SCOPE("controller.update");
     unsigned long currentTime = millis();
     
     if (!protocol) {
@@ -293,56 +321,8 @@ void ThermostatController::update() {
     ACStatus status;
     if (protocol->queryStatus(status)) {
         if (status.isValid) {
-            power = status.power;
-            
-            // 用戶互動保護：冷暖切換時 AC 需要較長時間切換模式
-            const unsigned long MODE_PROTECTION_PERIOD = 30000; // 30秒保護期
-
-            if (lastModeSetTime > 0 && (currentTime - lastModeSetTime) < MODE_PROTECTION_PERIOD) {
-                DEBUG_INFO_PRINT("[Controller] 用戶模式保護期內，跳過模式更新 (剩餘: %lu ms, 用戶設置: %d, AC回報: %d)\n",
-                                MODE_PROTECTION_PERIOD - (currentTime - lastModeSetTime),
-                                lastUserMode, status.mode);
-                // 保持用戶設置的模式
-                mode = lastUserMode;
-            } else {
-                // 保護期外，正常更新模式
-                if (mode != status.mode) {
-                    DEBUG_INFO_PRINT("[Controller] 模式從AC狀態更新：%d -> %d\n", mode, status.mode);
-                }
-                mode = status.mode;
-                // 只有在 AC mode 能無損轉換為 HomeKit mode 時才更新 targetHomeKitMode
-                // DRY/FAN 模式在 HomeKit 沒有對應，保留用戶原始設定
-                switch (status.mode) {
-                    case AC_MODE_HEAT: targetHomeKitMode = HAP_MODE_HEAT; break;
-                    case AC_MODE_COOL: targetHomeKitMode = HAP_MODE_COOL; break;
-                    case AC_MODE_AUTO:
-                    case AC_MODE_AUTO_2:
-                    case AC_MODE_AUTO_3: targetHomeKitMode = HAP_MODE_AUTO; break;
-                    // DRY, FAN: 不更新 targetHomeKitMode，保留用戶意圖
-                }
-            }
-            
-            targetTemperature = status.targetTemperature;
-            
-            // 用戶互動保護：如果用戶在10秒內設置過風速，不要被AC狀態覆蓋
-            const unsigned long FAN_SPEED_PROTECTION_PERIOD = 10000; // 10秒保護期
-            unsigned long timeSinceLastFanSet = currentTime - lastFanSpeedSetTime;
-            
-            if (lastFanSpeedSetTime > 0 && timeSinceLastFanSet < FAN_SPEED_PROTECTION_PERIOD) {
-                DEBUG_INFO_PRINT("[Controller] 用戶風速保護期內，跳過風速更新 (剩餘: %lu ms, 用戶設置: %s, AC回報: %s)\n",
-                                FAN_SPEED_PROTECTION_PERIOD - timeSinceLastFanSet,
-                                getFanSpeedText(lastUserFanSpeed), getFanSpeedText(status.fanSpeed));
-                // 保持用戶設置的風速
-                fanSpeed = lastUserFanSpeed;
-            } else {
-                // 保護期外，正常更新風速
-                if (fanSpeed != status.fanSpeed) {
-                    DEBUG_INFO_PRINT("[Controller] 風速從AC狀態更新：%s -> %s\n", 
-                                    getFanSpeedText(fanSpeed), getFanSpeedText(status.fanSpeed));
-                }
-                fanSpeed = status.fanSpeed;
-            }
-            
+            applyPolledStatus(status, currentTime);
+
             DEBUG_VERBOSE_PRINT("[Controller] 狀態更新成功 - 電源：%s，模式：%d，目標溫度：%.1f°C，風速：%s\n",
                                power ? "開啟" : "關閉", mode, targetTemperature, getFanSpeedText(fanSpeed));
             successfulOperations++;
@@ -370,6 +350,105 @@ void ThermostatController::update() {
         lastSuccessfulUpdate = currentTime;
         DEBUG_VERBOSE_PRINT("[Controller] 所有操作成功，重置錯誤計數\n");
     }
+
+    // 擺風與可選感測器放在核心查詢之後，且不影響錯誤計數
+    if (successfulOperations > 0) {
+        if (swingExposed) querySwingState(currentTime);
+        pollOptionalSensors(currentTime);
+    }
+}
+
+void ThermostatController::applyPolledStatus(const ACStatus& status, unsigned long currentTime) {
+    // 每個欄位先和用戶意圖對帳，未確認的用戶設置不被輪詢結果覆蓋
+    if (intents.reconcile(IntentField::Power, status.power ? 1.0f : 0.0f, currentTime)) {
+        DEBUG_INFO_PRINT("[Controller] 電源意圖未確認，保留用戶設置 (用戶: %d, AC回報: %d)\n",
+                        power, status.power);
+    } else {
+        power = status.power;
+    }
+
+    // AUTO 的變體視為同一模式
+    uint8_t polledMode = (status.mode == AC_MODE_AUTO_2 || status.mode == AC_MODE_AUTO_3)
+                         ? AC_MODE_AUTO : status.mode;
+    if (intents.reconcile(IntentField::Mode, polledMode, currentTime)) {
+        DEBUG_INFO_PRINT("[Controller] 模式意圖未確認，保留用戶設置 (用戶: %d, AC回報: %d)\n",
+                        mode, status.mode);
+    } else {
+        if (mode != status.mode) {
+            DEBUG_INFO_PRINT("[Controller] 模式從AC狀態更新：%d -> %d\n", mode, status.mode);
+        }
+        mode = status.mode;
+        // 只有在 AC mode 能無損轉換為 HomeKit mode 時才更新 targetHomeKitMode
+        // DRY/FAN 模式在 HomeKit 沒有對應，保留用戶原始設定
+        switch (status.mode) {
+            case AC_MODE_HEAT: targetHomeKitMode = HAP_MODE_HEAT; break;
+            case AC_MODE_COOL: targetHomeKitMode = HAP_MODE_COOL; break;
+            case AC_MODE_AUTO:
+            case AC_MODE_AUTO_2:
+            case AC_MODE_AUTO_3: targetHomeKitMode = HAP_MODE_AUTO; break;
+            // DRY, FAN: 不更新 targetHomeKitMode，保留用戶意圖
+        }
+    }
+    
+    if (intents.reconcile(IntentField::TargetTemperature, status.targetTemperature, currentTime)) {
+        DEBUG_INFO_PRINT("[Controller] 溫度意圖未確認，保留用戶設置 (用戶: %.1f°C, AC回報: %.1f°C)\n",
+                        targetTemperature, status.targetTemperature);
+    } else {
+        targetTemperature = status.targetTemperature;
+    }
+    
+    if (intents.reconcile(IntentField::FanSpeed, status.fanSpeed, currentTime)) {
+        DEBUG_INFO_PRINT("[Controller] 風速意圖未確認，保留用戶設置 (用戶: %s, AC回報: %s)\n",
+                        getFanSpeedText(fanSpeed), getFanSpeedText(status.fanSpeed));
+    } else {
+        if (fanSpeed != status.fanSpeed) {
+            DEBUG_INFO_PRINT("[Controller] 風速從AC狀態更新：%s -> %s\n", 
+                            getFanSpeedText(fanSpeed), getFanSpeedText(status.fanSpeed));
+        }
+        fanSpeed = status.fanSpeed;
+    }
+}
+
+bool ThermostatController::hasOptionalSensorInterest(unsigned long currentTime) const {
+    return lastOptionalInterest > 0 && currentTime - lastOptionalInterest < OPTIONAL_INTEREST_HOLD;
+}
+
+bool ThermostatController::querySwingState(unsigned long currentTime) {
+    ACStatus status;
+    if (!protocol->querySwing(status)) {
+        DEBUG_VERBOSE_PRINT("[Controller] 擺風查詢失敗：%s\n", protocol->getLastError());
+        return false;
+    }
+    if (!intents.reconcile(IntentField::SwingVertical, status.swingVertical ? 1.0f : 0.0f, currentTime)) {
+        swingVertical = status.swingVertical;
+    }
+    if (!intents.reconcile(IntentField::SwingHorizontal, status.swingHorizontal ? 1.0f : 0.0f, currentTime)) {
+        swingHorizontal = status.swingHorizontal;
+    }
+    return true;
+}
+
+void ThermostatController::pollOptionalSensors(unsigned long currentTime) {
+    // HomeKit 公開的擺風由核心輪詢負責；這裡只節流 HomeKit 看不到的感測器
+    if (swingExposed ||
+        (!protocol->supportsSwing(IACProtocol::SwingAxis::Vertical) &&
+         !protocol->supportsSwing(IACProtocol::SwingAxis::Horizontal))) {
+        return;
+    }
+
+    // 有人關注時隨每次核心查詢一起輪詢，否則降到背景頻率
+    if (!hasOptionalSensorInterest(currentTime) && lastOptionalQueryTime > 0 &&
+        currentTime - lastOptionalQueryTime < OPTIONAL_IDLE_INTERVAL) {
+        optionalSkipped++;
+        Metrics::optionalSkipped.inc();
+        return;
+    }
+    lastOptionalQueryTime = currentTime;
+
+    if (querySwingState(currentTime)) {
+        optionalQueries++;
+        Metrics::optionalQueries.inc();
+    }
 }
 
 bool ThermostatController::supportsSwing(IACProtocol::SwingAxis axis) const {
@@ -379,11 +458,182 @@ bool ThermostatController::supportsSwing(IACProtocol::SwingAxis axis) const {
 bool ThermostatController::setSwing(IACProtocol::SwingAxis axis, bool enabled) {
     if (!protocol) return false;
     DEBUG_INFO_PRINT("[Controller] 設置擺風: axis=%d, enabled=%d\n", (int)axis, enabled);
-    return protocol->setSwing(axis, enabled);
+    noteOptionalSensorInterest();
+    if (!protocol->setSwing(axis, enabled)) {
+        return false;
+    }
+
+    if (axis == IACProtocol::SwingAxis::Vertical) {
+        swingVertical = enabled;
+        intents.record(IntentField::SwingVertical, enabled ? 1.0f : 0.0f, millis());
+    } else {
+        swingHorizontal = enabled;
+        intents.record(IntentField::SwingHorizontal, enabled ? 1.0f : 0.0f, millis());
+    }
+    return true;
 }
 
 bool ThermostatController::getSwing(IACProtocol::SwingAxis axis) const {
-    return protocol ? protocol->getSwing(axis) : false;
+    return axis == IACProtocol::SwingAxis::Vertical ? swingVertical : swingHorizontal;
+}
+
+bool ThermostatController::applyControl(const ControlRequest& request, ControlResult& result) {
+    unsigned long start = micros();
+    result = ControlResult();
+
+    if (!protocol) {
+        result.status = ControlResult::Status::Unavailable;
+        result.error = "協議不可用";
+        return false;
+    }
+
+    // 先驗證所有欄位，任何一個不合法就不送出任何命令
+    bool nextPower = request.hasPower ? request.power : (request.hasMode ? true : power);
+    uint8_t nextMode = request.hasMode ? request.mode : mode;
+    float nextTemperature = targetTemperature;
+    uint8_t nextFanSpeed = request.hasFanSpeed ? request.fanSpeed : fanSpeed;
+
+    if (request.hasMode && !protocol->supportsMode(request.mode)) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = "mode";
+        result.error = "協議不支持此模式";
+    } else if (request.hasTemperature) {
+        auto tempRange = protocol->getTemperatureRange();
+        // S21 以 0.5°C 為單位，先對齊才能和 G1 回報比對
+        nextTemperature = round(request.temperature * 2.0f) / 2.0f;
+        if (isnan(request.temperature) || nextTemperature < tempRange.first || nextTemperature > tempRange.second) {
+            result.status = ControlResult::Status::Invalid;
+            result.field = "temp";
+            result.error = "溫度超出範圍";
+        }
+    }
+    if (result.ok() && request.hasFanSpeed && !protocol->supportsFanSpeed(request.fanSpeed)) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = "fan";
+        result.error = "協議不支持此風速";
+    }
+    if (result.ok() && request.hasSwingVertical && !protocol->supportsSwing(IACProtocol::SwingAxis::Vertical)) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = "swingV";
+        result.error = "不支援垂直擺風";
+    }
+    if (result.ok() && request.hasSwingHorizontal && !protocol->supportsSwing(IACProtocol::SwingAxis::Horizontal)) {
+        result.status = ControlResult::Status::Invalid;
+        result.field = "swingH";
+        result.error = "不支援水平擺風";
+    }
+    if (result.ok() && isInErrorRecoveryMode()) {
+        result.status = ControlResult::Status::Unavailable;
+        result.error = "錯誤恢復模式中";
+    }
+    if (!result.ok()) {
+        DEBUG_WARN_PRINT("[Controller] 批次控制被拒絕：%s %s\n", result.field ? result.field : "", result.error);
+        result.totalMicros = micros() - start;
+        return false;
+    }
+
+    DEBUG_INFO_PRINT("[Controller] 批次控制：電源=%d 模式=%d 溫度=%.1f 風速=%d 擺風=%d/%d\n",
+                     nextPower, nextMode, nextTemperature, nextFanSpeed,
+                     request.hasSwingVertical ? request.swingVertical : -1,
+                     request.hasSwingHorizontal ? request.swingHorizontal : -1);
+
+    // 電源/模式/溫度/風速合併為一個 D1
+    unsigned long commandStart = micros();
+    if (request.hasCoreFields()) {
+        result.sentD1 = true;
+        if (!protocol->setPowerAndMode(nextPower, nextMode, nextTemperature, nextFanSpeed)) {
+            handleProtocolError("applyControl");
+            result.status = ControlResult::Status::BusError;
+            result.error = "D1 命令失敗";
+            result.commandMicros = micros() - commandStart;
+            result.totalMicros = micros() - start;
+            return false;
+        }
+
+        unsigned long now = millis();
+        power = nextPower;
+        mode = nextMode;
+        targetTemperature = nextTemperature;
+        fanSpeed = nextFanSpeed;
+        switch (nextMode) {
+            case AC_MODE_HEAT: targetHomeKitMode = HAP_MODE_HEAT; break;
+            case AC_MODE_COOL: targetHomeKitMode = HAP_MODE_COOL; break;
+            case AC_MODE_AUTO: targetHomeKitMode = HAP_MODE_AUTO; break;
+        }
+        if (request.hasPower || request.hasMode) intents.record(IntentField::Power, power ? 1.0f : 0.0f, now);
+        if (request.hasMode) intents.record(IntentField::Mode, mode, now);
+        if (request.hasTemperature) intents.record(IntentField::TargetTemperature, targetTemperature, now);
+        if (request.hasFanSpeed) intents.record(IntentField::FanSpeed, fanSpeed, now);
+        // D1 已包含完整的核心狀態，先前待同步的欄位一併送出
+        dirtyPower = dirtyMode = dirtyTemp = dirtyFan = false;
+    }
+
+    // 兩軸擺風合併為一個 D5
+    if (request.hasSwingFields()) {
+        bool vertical = request.hasSwingVertical ? request.swingVertical : swingVertical;
+        bool horizontal = request.hasSwingHorizontal ? request.swingHorizontal : swingHorizontal;
+        result.sentD5 = true;
+        noteOptionalSensorInterest();
+        if (!protocol->setSwingState(vertical, horizontal)) {
+            handleProtocolError("applyControl");
+            result.status = ControlResult::Status::BusError;
+            result.error = "D5 命令失敗";
+            result.commandMicros = micros() - commandStart;
+            result.totalMicros = micros() - start;
+            return false;
+        }
+        unsigned long now = millis();
+        swingVertical = vertical;
+        swingHorizontal = horizontal;
+        if (request.hasSwingVertical) intents.record(IntentField::SwingVertical, vertical ? 1.0f : 0.0f, now);
+        if (request.hasSwingHorizontal) intents.record(IntentField::SwingHorizontal, horizontal ? 1.0f : 0.0f, now);
+    }
+    result.commandMicros = micros() - commandStart;
+    resetErrorCount();
+    lastSuccessfulUpdate = millis();
+
+    // 以一次 G1 確認核心欄位；擺風不在 G1 中，以 D5 的 ACK 為準
+    result.confirmed = true;
+    if (request.hasCoreFields()) {
+        unsigned long confirmStart = micros();
+        ACStatus status;
+        bool queried = protocol->queryStatus(status) && status.isValid;
+        result.confirmMicros = micros() - confirmStart;
+        if (!queried) {
+            handleProtocolError("applyControl");
+            result.status = ControlResult::Status::BusError;
+            result.error = "G1 確認查詢失敗";
+            result.confirmed = false;
+            result.totalMicros = micros() - start;
+            return false;
+        }
+
+        uint8_t polledMode = (status.mode == AC_MODE_AUTO_2 || status.mode == AC_MODE_AUTO_3)
+                             ? AC_MODE_AUTO : status.mode;
+        if ((request.hasPower || request.hasMode) && status.power != nextPower) {
+            result.unconfirmedMask |= 1 << (uint8_t)IntentField::Power;
+        }
+        if (request.hasMode && polledMode != nextMode) {
+            result.unconfirmedMask |= 1 << (uint8_t)IntentField::Mode;
+        }
+        if (request.hasTemperature && fabsf(status.targetTemperature - nextTemperature) >= 0.25f) {
+            result.unconfirmedMask |= 1 << (uint8_t)IntentField::TargetTemperature;
+        }
+        if (request.hasFanSpeed && status.fanSpeed != nextFanSpeed) {
+            result.unconfirmedMask |= 1 << (uint8_t)IntentField::FanSpeed;
+        }
+        result.confirmed = result.unconfirmedMask == 0;
+
+        // 與輪詢相同的對帳：一致的欄位清除意圖，不一致的保留請求值直到穩定期結束
+        applyPolledStatus(status, millis());
+    }
+
+    result.totalMicros = micros() - start;
+    Metrics::controlLatencyMs.observe((result.commandMicros + result.confirmMicros) / 1000);
+    DEBUG_INFO_PRINT("[Controller] 批次控制完成：D1=%d D5=%d 確認=%d 命令 %lu us，確認 %lu us\n",
+                     result.sentD1, result.sentD5, result.confirmed,
+                     (unsigned long)result.commandMicros, (unsigned long)result.confirmMicros);
+    return true;
 }
 
 bool ThermostatController::supportsMode(uint8_t mode) const {
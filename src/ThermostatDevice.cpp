@@ -1,26 +1,23 @@
 #include "device/ThermostatDevice.h"
 #include "common/Debug.h"
 #include "common/RemoteDebugger.h"
+#include "common/Trace.h"
 
 
-// 靜態變量用於記錄上一次輸出的值
-static float lastOutputCurrentTemp = 0;
-static float lastOutputTargetTemp = 0;
-static int lastOutputMode = -1;
-
 // 常量定義
 namespace {
     constexpr float TEMP_ADJUSTMENT_DELTA = 1.0f;
     constexpr float AUTO_MODE_TEMP_THRESHOLD = 0.5f;
-    constexpr int FORCED_UPDATE_INTERVAL = 0; // 強制更新間隔
 }
 
 ThermostatDevice::ThermostatDevice(IThermostatControl& thermostatControl) 
     : Service::Thermostat(),
       controller(thermostatControl),
-      lastUpdateTime(0),
-      lastHeartbeatTime(0),
-      lastSignificantChange(0) {
+      lastSignificantChange(0),
+      currentTempSlot(HomeKitNotifier::INVALID_SLOT),
+      targetTempSlot(HomeKitNotifier::INVALID_SLOT),
+      currentModeSlot(HomeKitNotifier::INVALID_SLOT),
+      targetModeSlot(HomeKitNotifier::INVALID_SLOT) {
     
     // 初始化特性（使用HomeSpan推薦方式，支持NVS存儲）
     currentTemp = new Characteristic::CurrentTemperature(21.0);
@@ -40,6 +37,15 @@ ThermostatDevice::ThermostatDevice(IThermostatControl& thermostatControl)
     // 必需的溫度單位特性（對HomeKit正常運作至關重要）
     displayUnits = new Characteristic::TemperatureDisplayUnits(0);  // 0 = 攝氏度
     
+    // 註冊到通知排程器：當前溫度節流，目標值與模式即時
+    HomeKitNotifier& notifier = HOMEKIT_NOTIFIER;
+    currentTempSlot = notifier.track(currentTemp, "currentTemp",
+        {CURRENT_TEMP_NOTIFY_INTERVAL, TEMP_THRESHOLD, CURRENT_TEMP_NOTIFY_BYPASS}, true);
+    targetTempSlot = notifier.track(targetTemp, "targetTemp",
+        {TARGET_TEMP_NOTIFY_INTERVAL, TEMP_THRESHOLD, 0}, true);
+    currentModeSlot = notifier.track(currentMode, "currentMode", {0, 0, 0}, false);
+    targetModeSlot = notifier.track(targetMode, "targetMode", {0, 0, 0}, false);
+    
     // 確保特性能觸發 update() 回調
     DEBUG_INFO_PRINT("[Device] 恆溫器特性已配置，等待 HomeKit 連接\n");
     
@@ -50,6 +56,7 @@ ThermostatDevice::ThermostatDevice(IThermostatControl& thermostatControl)
 
 // 用戶在 HomeKit 上設定溫度或模式時，會調用此函數（HomeKit → 設備）
 boolean ThermostatDevice::update() {
+    TRACE_SCOPE("hap.thermostat.update");
     DEBUG_INFO_PRINT("[Device] *** HomeKit update() 回調被觸發 ***\n");
     
     bool changed = false;
@@ -161,33 +168,33 @@ void ThermostatDevice::handleSuccessfulUpdate() {
     DEBUG_INFO_PRINT("[Device] HomeKit 變更處理完成，已應用到設備\n");
     
     // 立即觸發狀態同步，提供快速響應
-    lastUpdateTime = FORCED_UPDATE_INTERVAL; // 重置更新時間，強制下次loop()立即執行同步
+    ACCESSORY_SYNC.requestFullSync();
     
+    // 用戶操作後的確認回報不受最小通知間隔限制
+    HOMEKIT_NOTIFIER.expedite(targetTempSlot);
+    HOMEKIT_NOTIFIER.expedite(currentModeSlot);
 }
 
 // 同步目標模式的輔助方法
-bool ThermostatDevice::syncTargetMode(unsigned long currentTime) {
+bool ThermostatDevice::syncTargetMode(const AccessorySnapshot& snap, unsigned long currentTime) {
     uint8_t newTargetMode;
-    bool devicePowerState = controller.getPower();
     
-    if (!devicePowerState) {
+    if (!snap.power) {
         // 電源關閉時，目標模式必須是關閉
         newTargetMode = HAP_MODE_OFF;
     } else {
         // 電源開啟時，使用控制器的目標模式
-        newTargetMode = controller.getTargetMode();
+        newTargetMode = snap.targetMode;
         // 確保模式值在有效範圍內
         if (newTargetMode > HAP_MODE_AUTO) {
             newTargetMode = HAP_MODE_OFF;
         }
     }
     
-    if (targetMode->getVal() != newTargetMode) {
-        targetMode->setVal(newTargetMode);
-        targetMode->timeVal(); // 強制更新時間戳，觸發HomeKit通知
-        DEBUG_INFO_PRINT("[Device] 更新目標模式：%d(%s) (強制通知) [電源:%s]\n", 
+    if (HOMEKIT_NOTIFIER.stage(targetModeSlot, newTargetMode, currentTime)) {
+        DEBUG_INFO_PRINT("[Device] 更新目標模式：%d(%s) [電源:%s]\n", 
                       newTargetMode, getHomeKitModeText(newTargetMode),
-                      devicePowerState ? "開啟" : "關閉");
+                      snap.power ? "開啟" : "關閉");
         lastSignificantChange = currentTime; // 記錄重要變化時間
         return true;
     }
@@ -195,12 +202,9 @@ bool ThermostatDevice::syncTargetMode(unsigned long currentTime) {
 }
 
 // 同步目標溫度的輔助方法
-bool ThermostatDevice::syncTargetTemperature(unsigned long currentTime) {
-    float newTargetTemp = controller.getTargetTemperature();
-    if (abs(targetTemp->getVal<float>() - newTargetTemp) >= TEMP_THRESHOLD) {
-        targetTemp->setVal(newTargetTemp);
-        targetTemp->timeVal(); // 強制更新時間戳，觸發HomeKit通知
-        DEBUG_INFO_PRINT("[Device] 更新目標溫度：%.1f°C (強制通知)\n", newTargetTemp);
+bool ThermostatDevice::syncTargetTemperature(const AccessorySnapshot& snap, unsigned long currentTime) {
+    if (HOMEKIT_NOTIFIER.stage(targetTempSlot, snap.targetTemperature, currentTime)) {
+        DEBUG_INFO_PRINT("[Device] 更新目標溫度：%.1f°C\n", snap.targetTemperature);
         lastSignificantChange = currentTime; // 記錄重要變化時間
         return true;
     }
@@ -208,14 +212,12 @@ bool ThermostatDevice::syncTargetTemperature(unsigned long currentTime) {
 }
 
 // 同步當前溫度的輔助方法
-bool ThermostatDevice::syncCurrentTemperature(unsigned long currentTime) {
-    float newCurrentTemp = controller.getCurrentTemperature();
-    if (abs(currentTemp->getVal<float>() - newCurrentTemp) >= TEMP_THRESHOLD) {
+bool ThermostatDevice::syncCurrentTemperature(const AccessorySnapshot& snap, unsigned long currentTime) {
+    // 當前溫度受最小通知間隔限制，變化超過 CURRENT_TEMP_NOTIFY_BYPASS 時才立即通知
+    if (HOMEKIT_NOTIFIER.stage(currentTempSlot, snap.currentTemperature, currentTime)) {
         DEBUG_VERBOSE_PRINT("[Device] 原本溫度：%.1f°C, 新溫度：%.1f°C\n", 
-                           currentTemp->getVal<float>(), newCurrentTemp);
-        currentTemp->setVal(newCurrentTemp);
-        currentTemp->timeVal(); // 強制更新時間戳，觸發HomeKit通知
-        DEBUG_INFO_PRINT("[Device] 更新當前溫度：%.1f°C (強制通知)\n", newCurrentTemp);
+                           currentTemp->getVal<float>(), snap.currentTemperature);
+        DEBUG_INFO_PRINT("[Device] 更新當前溫度：%.1f°C\n", snap.currentTemperature);
         lastSignificantChange = currentTime; // 記錄重要變化時間
         return true;
     }
@@ -223,8 +225,8 @@ bool ThermostatDevice::syncCurrentTemperature(unsigned long currentTime) {
 }
 
 // 計算自動模式下的當前模式
-uint8_t ThermostatDevice::calculateAutoModeState() {
-    float tempDiff = controller.getTargetTemperature() - controller.getCurrentTemperature();
+uint8_t ThermostatDevice::calculateAutoModeState(const AccessorySnapshot& snap) {
+    float tempDiff = snap.targetTemperature - snap.currentTemperature;
     if (tempDiff > AUTO_MODE_TEMP_THRESHOLD) {
         return HAP_STATE_HEAT;
     } else if (tempDiff < -AUTO_MODE_TEMP_THRESHOLD) {
@@ -235,17 +237,15 @@ uint8_t ThermostatDevice::calculateAutoModeState() {
 }
 
 // 同步當前模式的輔助方法
-bool ThermostatDevice::syncCurrentMode(unsigned long currentTime) {
+bool ThermostatDevice::syncCurrentMode(const AccessorySnapshot& snap, unsigned long currentTime) {
     uint8_t newCurrentMode;
-    bool devicePower = controller.getPower();
     
-    if (!devicePower) {
+    if (!snap.power) {
         // 設備關閉時，當前模式必須是OFF
         newCurrentMode = HAP_STATE_OFF;
     } else {
         // 設備開啟時，根據目標模式決定當前模式
-        uint8_t targetModeValue = controller.getTargetMode();
-        switch (targetModeValue) {
+        switch (snap.targetMode) {
             case 1: // 制熱
                 newCurrentMode = HAP_STATE_HEAT;
                 break;
@@ -253,7 +253,7 @@ bool ThermostatDevice::syncCurrentMode(unsigned long currentTime) {
                 newCurrentMode = HAP_STATE_COOL;
                 break;
             case 3: // 自動 - 根據溫度差決定
-                newCurrentMode = calculateAutoModeState();
+                newCurrentMode = calculateAutoModeState(snap);
                 break;
             default: // 關閉或其他
                 newCurrentMode = HAP_STATE_OFF;
@@ -261,69 +261,41 @@ bool ThermostatDevice::syncCurrentMode(unsigned long currentTime) {
         }
     }
     
-    // 只在實際狀態發生變化時更新並強制通知
-    if (newCurrentMode != currentMode->getVal()) {
-        currentMode->setVal(newCurrentMode);
-        currentMode->timeVal(); // 強制更新時間戳，觸發HomeKit通知
-        DEBUG_INFO_PRINT("[Device] 更新當前模式：%d(%s) (強制通知) [電源:%s]\n", 
+    // 只在實際狀態發生變化時排入通知
+    if (HOMEKIT_NOTIFIER.stage(currentModeSlot, newCurrentMode, currentTime)) {
+        DEBUG_INFO_PRINT("[Device] 更新當前模式：%d(%s) [電源:%s]\n", 
                       newCurrentMode, getHomeKitModeText(newCurrentMode), 
-                      devicePower ? "開啟" : "關閉");
+                      snap.power ? "開啟" : "關閉");
         lastSignificantChange = currentTime; // 記錄重要變化時間
         return true;
     }
     return false;
 }
 
-// 每秒調用一次，用於同步 HomeKit 和機器狀態（設備 → HomeKit）
-void ThermostatDevice::loop() {
-    unsigned long currentTime = millis();
-    bool changed = false; // 追蹤是否有狀態變更
-    
-    // 移除調試日誌以節省資源
-    
-    // 檢查是否需要輸出心跳信息和當前狀態
-    if (currentTime - lastHeartbeatTime >= HEARTBEAT_INTERVAL) {
-        DEBUG_INFO_PRINT("[Device] HomeSpan loop 運行中... 電源:%s 模式:%d 當前溫度:%.1f°C 目標溫度:%.1f°C\n", 
-                        controller.getPower() ? "開啟" : "關閉",
-                        controller.getTargetMode(),
-                        controller.getCurrentTemperature(),
-                        controller.getTargetTemperature());
-        lastHeartbeatTime = currentTime;
-    }
-    
-    // 根據 UPDATE_INTERVAL 限制同步頻率，避免 HomeKit 通知過於頻繁
-    if (currentTime - lastUpdateTime < UPDATE_INTERVAL) {
-        return;
-    }
-    lastUpdateTime = currentTime;
-    
-    controller.update();
-    
+// 由 AccessorySync 每輪調用，只同步變化位元涉及的特性（設備 → HomeKit）
+uint16_t ThermostatDevice::applySnapshot(const AccessorySnapshot& snap, uint16_t dirty,
+                                         unsigned long currentTime) {
     // 在Thermostat服務中，電源狀態通過TargetHeatingCoolingState反映
-    // 不需要單獨的電源狀態同步
-    
-    // 同步目標模式
-    if (syncTargetMode(currentTime)) {
-        changed = true;
+    if (dirty & (DIRTY_POWER | DIRTY_TARGET_MODE)) {
+        syncTargetMode(snap, currentTime);
     }
     
-    // 同步目標溫度
-    if (syncTargetTemperature(currentTime)) {
-        changed = true;
+    if (dirty & DIRTY_TARGET_TEMP) {
+        syncTargetTemperature(snap, currentTime);
     }
     
-    // 同步當前溫度
-    if (syncCurrentTemperature(currentTime)) {
-        changed = true;
+    if (dirty & DIRTY_CURRENT_TEMP) {
+        syncCurrentTemperature(snap, currentTime);
     }
     
-    // 更新當前模式
-    if (syncCurrentMode(currentTime)) {
-        changed = true;
+    // 自動模式下當前狀態取決於溫差，溫度變化也需要重算
+    if (dirty & (DIRTY_POWER | DIRTY_TARGET_MODE | DIRTY_TARGET_TEMP | DIRTY_CURRENT_TEMP)) {
+        syncCurrentMode(snap, currentTime);
     }
     
-    // 如果有任何狀態變更，立即通知HomeSpan處理
-    if (changed) {
-        DEBUG_INFO_PRINT("[Device] 檢測到狀態變更，觸發HomeKit通知\n");
-    }
-}
\ No newline at end of file
+    // 被最小通知間隔延後的欄位保留到下一輪
+    uint16_t carried = 0;
+    if (HOMEKIT_NOTIFIER.isPending(currentTempSlot)) carried |= DIRTY_CURRENT_TEMP;
+    if (HOMEKIT_NOTIFIER.isPending(targetTempSlot)) carried |= DIRTY_TARGET_TEMP;
+    return carried;
+}
@@ -8,10 +8,13 @@
 #include "device/ThermostatDevice.h"
 #include "device/FanDevice.h"
 #include "device/SwingDevice.h"
+#include "device/HomeKitNotifier.h"
+#include "device/AccessorySync.h"
 #include "protocol/S21Protocol.h"
 #include "protocol/IACProtocol.h"
 #include "protocol/ACProtocolFactory.h"
 #include "common/Debug.h"
+#include "common/CrashLog.h"
 #include "common/Config.h"
 #include "common/WiFiManager.h"
 #include "common/SystemManager.h"
@@ -21,8 +24,15 @@
 #include "WebServer.h"
 #include "common/WebUI.h"
 #include "common/RemoteDebugger.h"
-#include "common/DebugWebClient.h"
+#include "common/WebAssets.h"
 #include "common/StreamingResponse.h"
+#include "common/MonitoringWebServer.h"
+#include "common/EventStream.h"
+#include "common/Metrics.h"
+#include "common/CborWriter.h"
+#include "common/Telemetry.h"
+#include "common/Trace.h"
+#include "common/FlatJson.h"
 
 // 硬體定義
 #if defined(ESP32C3_SUPER_MINI)
@@ -55,14 +65,13 @@ OTAManager* otaManager = nullptr;
 SystemManager* systemManager = nullptr;
 
 // WebServer
-WebServer* webServer = nullptr;
+MonitoringWebServer* webServer = nullptr;
 bool monitoringEnabled = false;
 bool homeKitPairingActive = false;
 
 
 // 函數聲明
 void safeRestart();
-void generateMainPage();
 #ifndef DISABLE_SIMULATION_MODE
 void generateSimulationPage();
 #endif
@@ -73,73 +82,11 @@ void initializeHardware();
 
 void safeRestart() {
     DEBUG_INFO_PRINT("[Main] 安全重啟...\n");
+    CRASH_LOG.record("[Main] safeRestart");
     delay(500);
     ESP.restart();
 }
 
-void generateMainPage() {
-    if (!webServer) return;
-
-    StreamingResponse stream;
-    stream.begin(webServer);
-
-    stream.append("<!DOCTYPE html><html><head><meta charset='UTF-8'>");
-    stream.append("<title>DaiSpan</title>");
-    stream.append("<meta http-equiv='refresh' content='30'>");
-    stream.append("<style>");
-    stream.append(WebUI::getCompactCSS());
-    stream.append("</style></head><body>");
-    stream.append("<div class='container'>");
-    stream.append("<h1>DaiSpan</h1>");
-
-    // 系統狀態
-    stream.append("<div class='status-card'><h3>系統狀態</h3>");
-    stream.appendf("<div class='status-item'><span class='status-label'>記憶體:</span>"
-                   "<span class='status-value'>%u bytes</span></div>", ESP.getFreeHeap());
-
-    unsigned long sec = millis() / 1000;
-    unsigned long min = sec / 60;
-    unsigned long hr = min / 60;
-    stream.appendf("<div class='status-item'><span class='status-label'>運行時長:</span>"
-                   "<span class='status-value'>%lu:%02lu:%02lu</span></div>", hr, min % 60, sec % 60);
-
-    if (thermostatController) {
-        bool on = thermostatController->getPower();
-        stream.appendf("<div class='status-item'><span class='status-label'>電源:</span>"
-                       "<span class='status-value %s'>%s</span></div>",
-                       on ? "status-good" : "status-warning", on ? "開啟" : "關閉");
-        stream.appendf("<div class='status-item'><span class='status-label'>溫度:</span>"
-                       "<span class='status-value'>%.1f / %.1f °C</span></div>",
-                       thermostatController->getCurrentTemperature(),
-                       thermostatController->getTargetTemperature());
-    }
-
-    if (WiFi.status() == WL_CONNECTED) {
-        stream.appendf("<div class='status-item'><span class='status-label'>WiFi:</span>"
-                       "<span class='status-value status-good'>%s (%d dBm)</span></div>",
-                       WiFi.localIP().toString().c_str(), WiFi.RSSI());
-    }
-    stream.append("</div>");
-
-    // 導航
-    stream.append("<div style='margin-top:20px;text-align:center;'>");
-    stream.append("<a href='/wifi' class='button'>WiFi</a>");
-    stream.append("<a href='/homekit' class='button'>HomeKit</a>");
-#ifndef DISABLE_SIMULATION_MODE
-    if (configManager.getSimulationMode() && mockController) {
-        stream.append("<a href='/simulation' class='button'>模擬控制</a>");
-    } else {
-        stream.append("<a href='/simulation-toggle' class='button secondary'>模擬模式</a>");
-    }
-#endif
-    stream.append("<a href='/ota' class='button secondary'>OTA</a>");
-    stream.append("<a href='/debug' class='button secondary'>Debug</a>");
-    stream.append("</div>");
-
-    stream.append("</div></body></html>");
-    stream.finish();
-}
-
 #ifndef DISABLE_SIMULATION_MODE
 void generateSimulationPage() {
     if (!webServer || !mockController) return;
@@ -148,9 +95,7 @@ void generateSimulationPage() {
     stream.begin(webServer);
 
     stream.append("<!DOCTYPE html><html><head><meta charset='UTF-8'>");
-    stream.append("<title>模擬控制</title><style>");
-    stream.append(WebUI::getCompactCSS());
-    stream.append("</style></head><body><div class='container'>");
+    stream.append("<title>模擬控制</title>" WEBUI_STYLE_LINK "</head><body><div class='container'>");
     stream.append("<h1>模擬控制台</h1>");
 
     // 狀態
@@ -195,6 +140,104 @@ void generateSimulationPage() {
 #endif
 
 
+// 批次控制欄位：表單參數，或 JSON 物件本體（{"power":true,"mode":"cool","temp":24.5}）的頂層欄位
+// 回傳 1 = 取得欄位值，0 = 沒有此欄位，-1 = 值無效（放不進 value、重複或不是純量），不截斷
+static int getControlField(const char* name, char* value, size_t size) {
+    if (webServer->hasArg(name)) {
+        String arg = webServer->arg(name);
+        if (arg.length() >= size) return -1;
+        memcpy(value, arg.c_str(), arg.length() + 1);
+        return 1;
+    }
+    if (!webServer->hasArg("plain")) return 0;
+    return FlatJson::getField(webServer->arg("plain").c_str(), name, value, size);
+}
+
+// JSON 本體必須整個有效才處理任何欄位，避免格式錯誤的請求被部分套用
+static bool controlBodyValid() {
+    return !webServer->hasArg("plain") || FlatJson::isValidObject(webServer->arg("plain").c_str());
+}
+
+static bool parseControlBool(const char* value, bool& out) {
+    if (strcmp(value, "true") == 0 || strcmp(value, "1") == 0 || strcasecmp(value, "on") == 0) {
+        out = true;
+        return true;
+    }
+    if (strcmp(value, "false") == 0 || strcmp(value, "0") == 0 || strcasecmp(value, "off") == 0) {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+// 解析批次控制請求，回傳格式錯誤的欄位名稱（nullptr = 成功；本體不是有效 JSON 時為 "body"）
+static const char* parseControlRequest(ControlRequest& request) {
+    char value[16];
+    if (!controlBodyValid()) return "body";
+
+    int found = getControlField("power", value, sizeof(value));
+    if (found < 0) return "power";
+    if (found) {
+        if (!parseControlBool(value, request.power)) return "power";
+        request.hasPower = true;
+    }
+
+    found = getControlField("mode", value, sizeof(value));
+    if (found < 0) return "mode";
+    if (found) {
+        static const struct { const char* name; uint8_t mode; } MODES[] = {
+            {"auto", AC_MODE_AUTO}, {"cool", AC_MODE_COOL}, {"heat", AC_MODE_HEAT},
+            {"dry", AC_MODE_DRY}, {"fan", AC_MODE_FAN},
+        };
+        if (strcasecmp(value, "off") == 0) {
+            if (request.hasPower && request.power) return "mode";
+            request.hasPower = true;
+            request.power = false;
+        } else {
+            for (const auto& m : MODES) {
+                if (strcasecmp(value, m.name) == 0) {
+                    request.hasMode = true;
+                    request.mode = m.mode;
+                }
+            }
+            if (!request.hasMode) return "mode";
+        }
+    }
+
+    found = getControlField("temp", value, sizeof(value));
+    if (found < 0) return "temp";
+    if (found) {
+        char* end = nullptr;
+        request.temperature = strtof(value, &end);
+        if (end == value || *end != '\0') return "temp";
+        request.hasTemperature = true;
+    }
+
+    found = getControlField("fan", value, sizeof(value));
+    if (found < 0) return "fan";
+    if (found) {
+        if (strcasecmp(value, "auto") == 0) request.fanSpeed = FAN_AUTO;
+        else if (strcasecmp(value, "quiet") == 0) request.fanSpeed = FAN_QUIET;
+        else if (value[0] >= '1' && value[0] <= '5' && value[1] == '\0') request.fanSpeed = FAN_SPEED_1 + (value[0] - '1');
+        else return "fan";
+        request.hasFanSpeed = true;
+    }
+
+    found = getControlField("swingV", value, sizeof(value));
+    if (found < 0) return "swingV";
+    if (found) {
+        if (!parseControlBool(value, request.swingVertical)) return "swingV";
+        request.hasSwingVertical = true;
+    }
+    found = getControlField("swingH", value, sizeof(value));
+    if (found < 0) return "swingH";
+    if (found) {
+        if (!parseControlBool(value, request.swingHorizontal)) return "swingH";
+        request.hasSwingHorizontal = true;
+    }
+    return nullptr;
+}
+
 // WebServer 初始化函數
 void initializeMonitoring() {
     if (monitoringEnabled || !homeKitInitialized) {
@@ -204,17 +247,66 @@ void initializeMonitoring() {
     DEBUG_INFO_PRINT("[Main] 啟動WebServer (記憶體: %u bytes)\n", ESP.getFreeHeap());
     
     if (!webServer) {
-        webServer = new WebServer(8080);
+        webServer = new MonitoringWebServer(8080);
         if (!webServer) {
             DEBUG_ERROR_PRINT("[Main] WebServer創建失敗\n");
             return;
         }
     }
     
-    // 基本路由處理 - 使用記憶體優化
-    webServer->on("/", [](){
-        webServer->sendHeader("Cache-Control", "no-cache, must-revalidate");
-        generateMainPage();
+    // 靜態資源（gzip + ETag）：主頁外殼與調試界面不在設備上組裝
+    WebAssets::attach(*webServer);
+    WebAssets::on(*webServer, "/", "index.html");
+    WebAssets::on(*webServer, "/debug", "debug.html");
+
+    // 即時狀態推送（SSE）：一條長連線取代定期輪詢
+    ThermostatController* healthSource = nullptr;
+    #ifndef DISABLE_MOCK_CONTROLLER
+    if (thermostatController && !configManager.getSimulationMode()) {
+    #else
+    if (thermostatController) {
+    #endif
+        healthSource = static_cast<ThermostatController*>(thermostatController);
+    }
+    EVENT_STREAM.begin(thermostatController, healthSource);
+    webServer->on("/api/events", HTTP_GET, [](){
+        if (EVENT_STREAM.accept(webServer->client())) {
+            webServer->detachClient();
+        } else {
+            webServer->sendHeader("Retry-After", "30");
+            webServer->send(503, "text/plain", "Too many event clients");
+        }
+    });
+
+    // 主頁狀態資料（首次載入與不支援 SSE 時使用）
+    webServer->on("/api/status", [](){
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("freeHeap", ESP.getFreeHeap())
+            .field("uptime", (uint32_t)(millis() / 1000));
+        json.field("controller", thermostatController != nullptr);
+        if (thermostatController) {
+            thermostatController->noteOptionalSensorInterest();
+            json.field("power", thermostatController->getPower())
+                .field("currentTemp", thermostatController->getCurrentTemperature())
+                .field("targetTemp", thermostatController->getTargetTemperature());
+        }
+        bool wifiConnected = WiFi.status() == WL_CONNECTED;
+        json.field("wifi", wifiConnected);
+        if (wifiConnected) {
+            json.field("ip", WiFi.localIP().toString())
+                .field("rssi", WiFi.RSSI());
+        }
+        const char* simulation = "disabled";
+#ifndef DISABLE_SIMULATION_MODE
+        simulation = (configManager.getSimulationMode() && mockController) ? "active" : "available";
+#endif
+        json.field("simulation", simulation);
+        json.endObject();
+        stream.finish();
     });
     
     // WiFi配置頁面
@@ -225,32 +317,25 @@ void initializeMonitoring() {
     
     // WiFi掃描API
     webServer->on("/wifi-scan", [](){
+
         DEBUG_INFO_PRINT("[Main] 開始WiFi掃描...\n");
         int networkCount = WiFi.scanNetworks();
-        
-        String json = "[";
-        int validNetworks = 0;
-        
-        if (networkCount > 0) {
-            for (int i = 0; i < networkCount && i < 15; i++) {
-                String ssid = WiFi.SSID(i);
-                if (ssid.length() == 0) continue;
-                
-                int rssi = WiFi.RSSI(i);
-                bool secure = (WiFi.encryptionType(i) != WIFI_AUTH_OPEN);
-                
-                if (validNetworks > 0) json += ",";
-                json += "{";
-                json += "\"ssid\":\"" + ssid + "\",";
-                json += "\"rssi\":" + String(rssi) + ",";
-                json += "\"secure\":" + String(secure ? "true" : "false");
-                json += "}";
-                validNetworks++;
-            }
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginArray();
+        for (int i = 0; i < networkCount && i < 15; i++) {
+            String ssid = WiFi.SSID(i);
+            if (ssid.length() == 0) continue;
+            json.beginObject()
+                .field("ssid", ssid)
+                .field("rssi", WiFi.RSSI(i))
+                .field("secure", WiFi.encryptionType(i) != WIFI_AUTH_OPEN)
+                .endObject();
         }
-        
-        json += "]";
-        webServer->send(200, "application/json", json);
+        json.endArray();
+        stream.finish();
     });
     
     // WiFi配置保存處理
@@ -408,7 +493,7 @@ void initializeMonitoring() {
         
         String message = "模擬參數已成功更新！";
         String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>設置已更新</title>";
-        html += "<style>" + String(WebUI::getCompactCSS()) + "</style></head><body>";
+        html += WEBUI_STYLE_LINK "</head><body>";
         html += "<div class='container'><h1>✅ 設置已更新</h1>";
         html += "<div class='status'>" + message + "</div>";
         html += "<div style='text-align:center;margin:20px 0;'>";
@@ -438,82 +523,192 @@ void initializeMonitoring() {
     
     // 系統健康檢查端點
     webServer->on("/api/health", [](){
-        char buf[128];
-        snprintf(buf, sizeof(buf),
-            "{\"status\":\"ok\",\"freeHeap\":%u,\"uptime\":%u}",
-            ESP.getFreeHeap(), (uint32_t)(millis() / 1000));
-        webServer->send(200, "application/json", buf);
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("status", "ok")
+            .field("freeHeap", ESP.getFreeHeap())
+            .field("uptime", (uint32_t)(millis() / 1000))
+            .endObject();
+        stream.finish();
     });
 
     webServer->on("/api/metrics", [](){
-        static char buffer[1024];
-        
-        // 收集數據到局部變量
+
         uint32_t freeHeap = ESP.getFreeHeap();
         uint32_t heapSize = ESP.getHeapSize();
         uint32_t uptime = millis() / 1000;
-        float memUsage = (float)(freeHeap) / (float)(heapSize) * 100.0f;
-        
-        // 構建 JSON 字符串
-        int written = snprintf(buffer, sizeof(buffer),
-            "{"
-            "\"performance\":{"
-            "\"uptime\":%u,"
-            "\"freeHeap\":%u,"
-            "\"heapSize\":%u,"
-            "\"memoryUsage\":%.1f,"
-            "\"cpuFreq\":%u,"
-            "\"flashSize\":%u,"
-            "\"minFreeHeap\":%u,"
-            "\"maxAllocHeap\":%u,"
-            "\"sketchSize\":%u,"
-            "\"freeSketchSpace\":%u"
-            "},"
-            "\"network\":{"
-            "\"rssi\":%d,"
-            "\"ip\":\"%s\","
-            "\"mac\":\"%s\","
-            "\"channel\":%d,"
-            "\"hostname\":\"%s\""
-            "}",
-            uptime, freeHeap, heapSize, memUsage,
-            ESP.getCpuFreqMHz(), ESP.getFlashChipSize(),
-            ESP.getMinFreeHeap(), ESP.getMaxAllocHeap(),
-            ESP.getSketchSize(), ESP.getFreeSketchSpace(),
-            WiFi.RSSI(), WiFi.localIP().toString().c_str(),
-            WiFi.macAddress().c_str(), WiFi.channel(),
-            WiFi.getHostname()
-        );
-        
-        // 添加 HomeKit 指標
-        if (thermostatDevice && thermostatController && written < sizeof(buffer) - 200) {
-            written += snprintf(buffer + written, sizeof(buffer) - written,
-                ",\"homekit\":{"
-                "\"power\":%s,"
-                "\"targetMode\":%d,"
-                "\"currentTemp\":%.1f,"
-                "\"targetTemp\":%.1f,"
-                "\"initialized\":%s,"
-                "\"pairingActive\":%s"
-                "}",
-                thermostatController->getPower() ? "true" : "false",
-                thermostatController->getTargetMode(),
-                thermostatController->getCurrentTemperature(),
-                thermostatController->getTargetTemperature(),
-                homeKitInitialized ? "true" : "false",
-                homeKitPairingActive ? "true" : "false"
-            );
-        }
-        
-        // 添加時間戳並結束
-        if (written < sizeof(buffer) - 50) {
-            snprintf(buffer + written, sizeof(buffer) - written,
-                ",\"timestamp\":%u}", uptime);
-        }
-        
-        webServer->send(200, "application/json", buffer);
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject();
+
+        json.beginObject("performance")
+            .field("uptime", uptime)
+            .field("freeHeap", freeHeap)
+            .field("heapSize", heapSize)
+            .field("memoryUsage", (float)freeHeap / (float)heapSize * 100.0f)
+            .field("cpuFreq", ESP.getCpuFreqMHz())
+            .field("flashSize", ESP.getFlashChipSize())
+            .field("minFreeHeap", ESP.getMinFreeHeap())
+            .field("maxAllocHeap", ESP.getMaxAllocHeap())
+            .field("sketchSize", ESP.getSketchSize())
+            .field("freeSketchSpace", ESP.getFreeSketchSpace())
+            .endObject();
+
+        json.beginObject("network")
+            .field("rssi", WiFi.RSSI())
+            .field("ip", WiFi.localIP().toString())
+            .field("mac", WiFi.macAddress())
+            .field("channel", WiFi.channel())
+            .field("hostname", WiFi.getHostname())
+            .endObject();
+
+        if (thermostatDevice && thermostatController) {
+            json.beginObject("homekit")
+                .field("power", thermostatController->getPower())
+                .field("targetMode", thermostatController->getTargetMode())
+                .field("currentTemp", thermostatController->getCurrentTemperature())
+                .field("targetTemp", thermostatController->getTargetTemperature())
+                .field("initialized", homeKitInitialized)
+                .field("pairingActive", homeKitPairingActive)
+                .endObject();
+        }
+
+        json.field("timestamp", uptime);
+        json.endObject();
+        stream.finish();
     });
-    
+
+    // 遙測：控制器、感測值、S21 品質與堆積；Accept: application/cbor 時輸出 CBOR，欄位與 JSON 相同
+    webServer->on("/api/telemetry", HTTP_GET, [](){
+
+        TelemetrySnapshot t;
+        t.uptime = millis() / 1000;
+        if (thermostatController) {
+            t.controller = true;
+            t.power = thermostatController->getPower();
+            t.mode = thermostatController->getTargetMode();
+            t.targetTemp = thermostatController->getTargetTemperature();
+            t.fanSpeed = thermostatController->getFanSpeed();
+            t.swingV = thermostatController->getSwing(IACProtocol::SwingAxis::Vertical);
+            t.swingH = thermostatController->getSwing(IACProtocol::SwingAxis::Horizontal);
+            t.currentTemp = thermostatController->getCurrentTemperature();
+            #ifndef DISABLE_MOCK_CONTROLLER
+            if (!configManager.getSimulationMode()) {
+            #endif
+                auto* tc = static_cast<ThermostatController*>(thermostatController);
+                t.healthy = tc->isProtocolHealthy();
+                t.errors = tc->getConsecutiveErrors();
+            #ifndef DISABLE_MOCK_CONTROLLER
+            }
+            #endif
+        }
+        t.wifi = WiFi.status() == WL_CONNECTED;
+        if (t.wifi) t.rssi = WiFi.RSSI();
+        t.freeHeap = ESP.getFreeHeap();
+        t.minFreeHeap = ESP.getMinFreeHeap();
+        t.maxAllocHeap = ESP.getMaxAllocHeap();
+        t.captureMetrics();
+
+        webServer->sendHeader("Vary", "Accept");
+        StreamingResponse stream;
+        if (webServer->header("Accept").indexOf("application/cbor") >= 0) {
+            stream.begin(webServer, "application/cbor");
+            CborWriter<StreamingResponse> cbor(stream);
+            writeTelemetry(cbor, t);
+        } else {
+            stream.begin(webServer, "application/json");
+            JsonResponse json(stream);
+            writeTelemetry(json, t);
+        }
+        stream.finish();
+    });
+
+    // Prometheus / OpenMetrics 指標（計數器由各模組即時更新，這裡只刷新取樣型量測值）
+    webServer->on("/metrics", [](){
+
+        Metrics::uptimeSeconds.set(millis() / 1000);
+        Metrics::freeHeap.set(ESP.getFreeHeap());
+        Metrics::minFreeHeap.set(ESP.getMinFreeHeap());
+        Metrics::maxAllocHeap.set(ESP.getMaxAllocHeap());
+        Metrics::wifiRssi.set(WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : NAN);
+        Metrics::sseClients.set(EVENT_STREAM.getClientCount());
+        if (thermostatController) {
+            Metrics::power.set(thermostatController->getPower() ? 1 : 0);
+            Metrics::targetTemperature.set(thermostatController->getTargetTemperature());
+            Metrics::currentTemperature.set(thermostatController->getCurrentTemperature());
+            Metrics::fanSpeed.set(thermostatController->getFanSpeed());
+            #ifndef DISABLE_MOCK_CONTROLLER
+            if (!configManager.getSimulationMode()) {
+            #endif
+                auto* tc = static_cast<ThermostatController*>(thermostatController);
+                Metrics::consecutiveErrors.set(tc->getConsecutiveErrors());
+            #ifndef DISABLE_MOCK_CONTROLLER
+            }
+            #endif
+        }
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/openmetrics-text; version=1.0.0; charset=utf-8");
+        renderOpenMetrics(stream, Metrics::getEntries(), Metrics::getEntryCount());
+        stream.finish();
+    });
+
+    // 主迴圈階段分析：各階段週期數直方圖、間隔抖動與 SLO 違規；?reset=1 在讀取後重新統計
+    webServer->on("/api/perf/loop", HTTP_GET, [](){
+        if (!systemManager) {
+            webServer->send(503, "application/json", "{\"error\":\"system manager not ready\"}");
+            return;
+        }
+        LoopProfiler& profiler = systemManager->getLoopProfiler();
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        profiler.writeJSON(json);
+        stream.finish();
+        if (webServer->arg("reset") == "1") profiler.reset();
+    });
+
+    #ifdef BINARY_DEBUG_LOG
+    // 二進位調試日誌：預設格式化成 JSON（欄位同 /api/logs）；?format=raw 輸出原始記錄，
+    // 以 scripts/decode_binlog.py 搭配韌體 ELF 離線解碼
+    webServer->on("/api/binlog", HTTP_GET, [](){
+        StreamingResponse stream;
+        if (webServer->arg("format") == "raw") {
+            stream.begin(webServer, "application/octet-stream");
+            BINARY_LOG.writeRaw(stream);
+        } else {
+            uint32_t since = webServer->hasArg("since") ? (uint32_t)webServer->arg("since").toInt() : 0;
+            size_t limit = 100;
+            if (webServer->hasArg("limit")) {
+                long requested = webServer->arg("limit").toInt();
+                if (requested > 0 && requested < (long)limit) limit = requested;
+            }
+            stream.begin(webServer, "application/json; charset=utf-8");
+            JsonResponse json(stream);
+            BINARY_LOG.writeJSON(json, since, limit);
+        }
+        stream.finish();
+    });
+    #endif
+
+    #ifdef TRACE_SPANS
+    // 追蹤區段：Chrome trace-event JSON，存檔後以 chrome://tracing 或 ui.perfetto.dev 開啟；
+    // ?clear=1 在下載後清空緩衝，方便擷取下一段
+    webServer->on("/api/trace", HTTP_GET, [](){
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        TRACE.writeJSON(json);
+        stream.finish();
+        if (webServer->arg("clear") == "1") TRACE.clear();
+    });
+    #endif
+
     // OTA 頁面
     webServer->on("/ota", [](){
         String deviceIP = WiFi.localIP().toString();
@@ -523,60 +718,353 @@ void initializeMonitoring() {
     
     // 記憶體清理 API 端點
     webServer->on("/api/memory/stats", [](){
-        char buffer[256];
+
         uint32_t freeHeap = ESP.getFreeHeap();
         uint32_t maxAlloc = ESP.getMaxAllocHeap();
         uint32_t fragmentation = (maxAlloc > 0) ? (100 - (maxAlloc * 100 / freeHeap)) : 0;
 
-        snprintf(buffer, sizeof(buffer),
-            "{"
-            "\"freeHeap\":%u,"
-            "\"maxAllocHeap\":%u,"
-            "\"fragmentation\":%u,"
-            "\"timestamp\":%u"
-            "}",
-            freeHeap, maxAlloc, fragmentation, (uint32_t)(millis() / 1000)
-        );
-        webServer->send(200, "application/json", buffer);
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("freeHeap", freeHeap)
+            .field("maxAllocHeap", maxAlloc)
+            .field("fragmentation", fragmentation)
+            .field("timestamp", (uint32_t)(millis() / 1000))
+            .endObject();
+        stream.finish();
     });
     
+    // WebServer 處理統計端點
+    webServer->on("/api/web/stats", [](){
+
+        MonitoringWebServer::Stats stats = webServer->getStats();
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("dispatches", stats.dispatches)
+            .field("idleChecks", stats.idleChecks)
+            .field("lastHandleMicros", stats.lastHandleMicros)
+            .field("maxHandleMicros", stats.maxHandleMicros)
+            .field("avgHandleMicros", stats.dispatches ? (uint32_t)(stats.totalHandleMicros / stats.dispatches) : 0)
+            .field("connections", webServer->getConnectionCount())
+            .field("maxConcurrent", stats.maxConcurrent)
+            .field("accepted", stats.accepted)
+            .field("reused", stats.reused)
+            .field("evicted", stats.evicted)
+            .field("timeouts", stats.timeouts)
+            .field("badRequests", stats.badRequests)
+            .field("partialWrites", stats.partialWrites)
+            .field("overflows", stats.overflows)
+            .field("handlerStalls", stats.handlerStalls)
+            .field("bytesSent", stats.bytesSent);
+
+        json.beginArray("assets");
+        const WebAssets::Stats* assetStats = WebAssets::getStats();
+        for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+            const WebAssets::Stats& a = assetStats[i];
+            uint32_t requests = a.served + a.notModified;
+            json.beginObject()
+                .field("name", WEB_ASSETS[i].name)
+                .field("rawBytes", WEB_ASSETS[i].rawLength)
+                .field("gzipBytes", WEB_ASSETS[i].length)
+                .field("served", a.served)
+                .field("notModified", a.notModified)
+                .field("bytesSent", a.bytesSent)
+                .field("maxHandleMicros", a.maxHandleMicros)
+                .field("avgHandleMicros", requests ? (uint32_t)(a.totalHandleMicros / requests) : 0)
+                .endObject();
+        }
+        json.endArray();
+
+        EventStream::Stats events = EVENT_STREAM.getStats();
+        json.beginObject("events")
+            .field("clients", EVENT_STREAM.getClientCount())
+            .field("accepted", events.accepted)
+            .field("rejected", events.rejected)
+            .field("published", events.published)
+            .field("sent", events.sent)
+            .field("dropped", events.dropped)
+            .field("resyncs", events.resyncs)
+            .field("bytesSent", events.bytesSent)
+            .endObject();
+        json.endObject();
+        stream.finish();
+    });
+
     // Controller 狀態端點
     webServer->on("/api/controller", [](){
-        char buffer[256];
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject();
         if (thermostatController) {
+            thermostatController->noteOptionalSensorInterest();
             bool healthy = true;
             unsigned long errors = 0;
+            uint32_t optionalQueries = 0;
+            uint32_t optionalSkipped = 0;
             #ifndef DISABLE_MOCK_CONTROLLER
             if (!configManager.getSimulationMode()) {
             #endif
                 auto* tc = static_cast<ThermostatController*>(thermostatController);
                 healthy = tc->isProtocolHealthy();
                 errors = tc->getConsecutiveErrors();
+                optionalQueries = tc->getOptionalQueries();
+                optionalSkipped = tc->getOptionalSkipped();
             #ifndef DISABLE_MOCK_CONTROLLER
             }
             #endif
-            snprintf(buffer, sizeof(buffer),
-                "{"
-                "\"healthy\":%s,"
-                "\"errors\":%lu,"
-                "\"power\":%s,"
-                "\"mode\":%d,"
-                "\"targetTemp\":%.1f,"
-                "\"currentTemp\":%.1f,"
-                "\"fanSpeed\":%d"
-                "}",
-                healthy ? "true" : "false",
-                errors,
-                thermostatController->getPower() ? "true" : "false",
-                thermostatController->getTargetMode(),
-                thermostatController->getTargetTemperature(),
-                thermostatController->getCurrentTemperature(),
-                thermostatController->getFanSpeed()
-            );
+            json.field("healthy", healthy)
+                .field("errors", errors)
+                .field("power", thermostatController->getPower())
+                .field("mode", thermostatController->getTargetMode())
+                .field("targetTemp", thermostatController->getTargetTemperature())
+                .field("currentTemp", thermostatController->getCurrentTemperature())
+                .field("fanSpeed", thermostatController->getFanSpeed())
+                .field("optionalQueries", optionalQueries)
+                .field("optionalSkipped", optionalSkipped);
+        } else {
+            json.field("error", "no controller");
+        }
+        json.endObject();
+        stream.finish();
+    });
+
+    // 批次控制：一次套用多個欄位（最多一個 D1 + 一個 D5），回傳 G1 確認後的狀態與各階段耗時
+    webServer->on("/api/control", HTTP_POST, [](){
+        uint32_t start = micros();
+        ControlRequest request;
+        ControlResult result;
+        const char* invalid = parseControlRequest(request);
+        int code = 200;
+        if (!thermostatController) {
+            result.status = ControlResult::Status::Unavailable;
+            result.error = "no controller";
+            code = 503;
+        } else if (invalid || request.empty()) {
+            result.status = ControlResult::Status::Invalid;
+            result.field = invalid;
+            result.error = !invalid ? "no fields" : strcmp(invalid, "body") == 0 ? "malformed JSON" : "invalid value";
+            code = 400;
+        } else if (!thermostatController->applyControl(request, result)) {
+            switch (result.status) {
+                case ControlResult::Status::Invalid: code = 400; break;
+                case ControlResult::Status::Unavailable: code = 503; break;
+                default: code = 502; break;
+            }
+        }
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json", code);
+        JsonResponse json(stream);
+        json.beginObject().field("ok", result.ok());
+        if (!result.ok()) {
+            json.field("error", result.error);
+            if (result.field) json.field("field", result.field);
+        }
+        json.beginObject("sent")
+            .field("d1", result.sentD1)
+            .field("d5", result.sentD5)
+            .endObject();
+        json.field("confirmed", result.confirmed);
+        json.beginArray("unconfirmed");
+        for (uint8_t i = 0; i < FieldIntentTracker::FIELD_COUNT; i++) {
+            if (result.unconfirmedMask & (1 << i)) {
+                json.value(FieldIntentTracker::getFieldName(static_cast<IntentField>(i)));
+            }
+        }
+        json.endArray();
+        if (thermostatController) {
+            json.beginObject("state")
+                .field("power", thermostatController->getPower())
+                .field("mode", thermostatController->getTargetMode())
+                .field("targetTemp", thermostatController->getTargetTemperature())
+                .field("currentTemp", thermostatController->getCurrentTemperature())
+                .field("fanSpeed", thermostatController->getFanSpeed())
+                .field("swingV", thermostatController->getSwing(IACProtocol::SwingAxis::Vertical))
+                .field("swingH", thermostatController->getSwing(IACProtocol::SwingAxis::Horizontal))
+                .endObject();
+        }
+        json.beginObject("latency")
+            .field("commandUs", result.commandMicros)
+            .field("confirmUs", result.confirmMicros)
+            .field("controlUs", result.totalMicros)
+            .field("handlerUs", (uint32_t)(micros() - start))
+            .endObject();
+        json.endObject();
+        stream.finish();
+    });
+
+    // 依元件的調試日誌級別：GET 查詢；POST 以表單或 JSON 欄位設定（{"S21":"verbose"}），
+    // 立即生效、重啟後恢復預設；高於編譯期 DEBUG_LEVEL 的級別會被限制
+    webServer->on("/api/debug/levels", [](){
+        const char* invalid = nullptr;
+        if (webServer->method() == HTTP_POST) {
+            // 先驗證全部欄位再套用，格式錯誤的請求不會只改到一部分
+            int levels[(uint8_t)DebugComponent::Count];
+            if (!controlBodyValid()) invalid = "body";
+            for (uint8_t c = 0; c < (uint8_t)DebugComponent::Count && !invalid; c++) {
+                DebugComponent component = static_cast<DebugComponent>(c);
+                char value[16];
+                int found = getControlField(debugComponentName(component), value, sizeof(value));
+                levels[c] = found > 0 ? parseDebugLevel(value) : -1;
+                if (found < 0 || (found > 0 && levels[c] < 0)) invalid = debugComponentName(component);
+            }
+            for (uint8_t c = 0; c < (uint8_t)DebugComponent::Count && !invalid; c++) {
+                if (levels[c] >= 0) setDebugLevel(static_cast<DebugComponent>(c), levels[c]);
+            }
+        }
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json", invalid ? 400 : 200);
+        JsonResponse json(stream);
+        json.beginObject();
+        if (invalid) json.field("error", "invalid level").field("field", invalid);
+        json.field("floor", debugLevelName(DEBUG_LEVEL));
+        json.beginObject("levels");
+        for (uint8_t c = 0; c < (uint8_t)DebugComponent::Count; c++) {
+            DebugComponent component = static_cast<DebugComponent>(c);
+            json.field(debugComponentName(component), debugLevelName(getDebugLevel(component)));
+        }
+        json.endObject();
+        json.endObject();
+        stream.finish();
+    });
+
+    // 崩潰日誌：上一輪開機在 RTC 記憶體留下的最後幾行日誌與控制器狀態，以及本次的重置原因
+    webServer->on("/api/crashlog", [](){
+        const CrashLog::Recovered& previous = CRASH_LOG.getRecovered();
+        esp_reset_reason_t reason = CRASH_LOG.getResetReason();
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("resetReason", CrashLog::resetReasonName(reason))
+            .field("resetCode", (int)reason)
+            .field("crash", CRASH_LOG.isCrashReset())
+            .field("bootCount", CRASH_LOG.getBootCount())
+            .field("recordedThisBoot", CRASH_LOG.getRecorded());
+
+        json.beginArray("logs");
+        for (uint8_t i = 0; i < previous.recordCount; i++) {
+            const CrashLogRecord& record = previous.records[i];
+            json.beginObject()
+                .field("seq", record.seq)
+                .field("uptime", record.uptimeMs)
+                .field("message", record.text)
+                .endObject();
+        }
+        json.endArray();
+
+        if (previous.hasSnapshot) {
+            const CrashLogSnapshot& s = previous.snapshot;
+            json.beginObject("controller")
+                .field("uptime", s.uptimeMs)
+                .field("power", s.power != 0)
+                .field("mode", s.targetMode)
+                .field("targetTemperature", s.targetTemperature)
+                .field("currentTemperature", s.currentTemperature)
+                .field("fanSpeed", s.fanSpeed)
+                .field("freeHeap", s.freeHeap)
+                .field("minFreeHeap", s.minFreeHeap)
+                .endObject();
         } else {
-            snprintf(buffer, sizeof(buffer), "{\"error\":\"no controller\"}");
+            json.field("controller", nullptr);
+        }
+        json.endObject();
+        stream.finish();
+    });
+
+    // 用戶意圖追蹤統計端點
+    webServer->on("/api/controller/intents", [](){
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject();
+        #ifndef DISABLE_MOCK_CONTROLLER
+        if (!thermostatController || configManager.getSimulationMode()) {
+        #else
+        if (!thermostatController) {
+        #endif
+            json.field("error", "no controller").endObject();
+            stream.finish();
+            return;
+        }
+
+        auto* tc = static_cast<ThermostatController*>(thermostatController);
+        unsigned long now = millis();
+        json.beginArray("fields");
+        for (uint8_t i = 0; i < FieldIntentTracker::FIELD_COUNT; i++) {
+            IntentField field = static_cast<IntentField>(i);
+            const FieldIntent& intent = tc->getIntent(field);
+            json.beginObject()
+                .field("name", FieldIntentTracker::getFieldName(field))
+                .field("active", intent.active)
+                .field("value", intent.value)
+                .field("ageMs", intent.setTime > 0 ? now - intent.setTime : 0UL)
+                .field("settleMs", intent.settleTime)
+                .field("flaps", intent.flaps)
+                .field("confirmed", intent.confirmed)
+                .field("expired", intent.expired)
+                .endObject();
+        }
+        json.endArray();
+        json.endObject();
+        stream.finish();
+    });
+
+    // HomeKit 通知統計端點
+    webServer->on("/api/homekit/notifications", [](){
+
+        HomeKitNotifier& notifier = HOMEKIT_NOTIFIER;
+        HomeKitNotifier::Stats stats = notifier.getStats();
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("sent", stats.sent)
+            .field("suppressed", stats.suppressed)
+            .field("batches", stats.batches);
+        json.beginArray("characteristics");
+        for (uint8_t i = 0; i < notifier.getSlotCount(); i++) {
+            HomeKitNotifier::SlotStats slot = notifier.getSlotStats(i);
+            json.beginObject()
+                .field("name", slot.name)
+                .field("sent", slot.sent)
+                .field("suppressed", slot.suppressed)
+                .field("pending", slot.pending)
+                .endObject();
         }
-        webServer->send(200, "application/json", buffer);
+        json.endArray();
+        json.endObject();
+        stream.finish();
+    });
+
+    // 配件同步統計端點
+    webServer->on("/api/homekit/sync", [](){
+
+        AccessorySync& sync = ACCESSORY_SYNC;
+        AccessorySync::Stats stats = sync.getStats();
+
+        StreamingResponse stream;
+        stream.begin(webServer, "application/json");
+        JsonResponse json(stream);
+        json.beginObject()
+            .field("ticks", stats.ticks)
+            .field("dirtyTicks", stats.dirtyTicks)
+            .field("getterCalls", stats.getterCalls)
+            .field("gettersPerTick", sync.getGettersPerTick())
+            .field("lastTickMicros", stats.lastTickMicros)
+            .field("maxTickMicros", stats.maxTickMicros)
+            .field("avgTickMicros", stats.ticks ? (uint32_t)(stats.totalTickMicros / stats.ticks) : 0)
+            .endObject();
+        stream.finish();
     });
 
     // 重啟端點
@@ -587,15 +1075,8 @@ void initializeMonitoring() {
         safeRestart();
     });
     
-    // 遠端調試界面
-    webServer->on("/debug", [](){
-        String html = DebugWebClient::getDebugHTML();
-        webServer->send(200, "text/html", html);
-    });
-    
-    // 404 處理
+    // 404 處理（保持 keep-alive，連線由伺服器管理）
     webServer->onNotFound([](){
-        webServer->sendHeader("Connection", "close");
         webServer->send(404, "text/plain", "Not Found");
     });
     
@@ -675,9 +1156,12 @@ void initializeHomeKit() {
             DEBUG_INFO_PRINT("[Main] FanDevice 創建成功並註冊到HomeKit\n");
         }
 
+        ACCESSORY_SYNC.begin(*thermostatController, thermostatDevice, fanDevice);
+
         // 擺風開關（作為獨立 Switch 服務掛在同一個 Accessory 上）
         if (thermostatController->supportsSwing(IACProtocol::SwingAxis::Vertical)) {
-            new SwingSwitchService(*thermostatController, IACProtocol::SwingAxis::Vertical, "擺風");
+            ACCESSORY_SYNC.attachSwing(
+                new SwingSwitchService(*thermostatController, IACProtocol::SwingAxis::Vertical, "擺風"));
             DEBUG_INFO_PRINT("[Main] 垂直擺風開關已註冊到HomeKit\n");
         }
     } else {
@@ -752,6 +1236,11 @@ void initializeHardware() {
 void setup() {
     Serial.begin(115200);
     DEBUG_INFO_PRINT("\n[Main] DaiSpan 智能恆溫器啟動...\n");
+    // 第一行日誌寫入時 CRASH_LOG 已取回上一輪留在 RTC 記憶體的內容
+    if (CRASH_LOG.isCrashReset()) {
+        DEBUG_ERROR_PRINT("[Main] 非預期重置: %s，上一輪日誌見 /api/crashlog\n",
+                          CrashLog::resetReasonName(CRASH_LOG.getResetReason()));
+    }
     
     DEBUG_INFO_PRINT("[Main] 可用堆內存: %d bytes\n", ESP.getFreeHeap());
 
@@ -900,7 +1389,10 @@ void setup() {
 
 void loop() {
     // 處理遠端調試器
-    RemoteDebugger::getInstance().loop();
+    {
+        TRACE_SCOPE("remote_debug.loop");
+        RemoteDebugger::getInstance().loop();
+    }
     
     
     // 使用系統管理器處理主迴圈邏輯
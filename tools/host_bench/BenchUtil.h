@@ -0,0 +1,46 @@
+#pragma once
+
+// 主機端基準測試共用工具
+// 1. nsPerCall()：重複呼叫 fn(i) 並回傳平均每次的主機時間；
+// 2. 取代全域 operator new / delete：計數配置次數，並以每塊前置 16 bytes 記錄大小來追蹤
+// 使用中與峰值位元組（16 bytes 維持 max_align_t 對齊）。計數器為 relaxed atomic，
+// 多執行緒的測試也能使用。取代函式不能是 inline，每個執行檔只能有一個翻譯單元 include 此標頭；
+// 標記 noinline 讓它們和真正的配置器一樣不被內聯（內聯後 GCC 會對 p - 16 誤報 -Warray-bounds）。
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<size_t> liveBytes{0};
+static std::atomic<size_t> peakBytes{0};
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    char* p = (char*)malloc(size + 16);
+    if (!p) throw std::bad_alloc();
+    *(size_t*)p = size;
+    size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return p + 16;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    char* base = (char*)p - 16;
+    liveBytes.fetch_sub(*(size_t*)base, std::memory_order_relaxed);
+    free(base);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+template <typename Fn>
+double nsPerCall(int iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// 最小 CBOR 解碼器：只支援 CborWriter 會產生的項目，解碼結果直接交給 JsonWriter 重新輸出
+struct CborReader {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool byte(uint8_t& b) {
+        if (p >= end) return false;
+        b = *p++;
+        return true;
+    }
+
+    bool argument(uint8_t info, uint64_t& v) {
+        if (info < 24) {
+            v = info;
+            return true;
+        }
+        int length = info == 24 ? 1 : info == 25 ? 2 : info == 26 ? 4 : info == 27 ? 8 : 0;
+        if (length == 0 || end - p < length) return false;
+        v = 0;
+        for (int i = 0; i < length; i++) v = (v << 8) | *p++;
+        return true;
+    }
+
+    static float halfToFloat(uint16_t h) {
+        int exponent = (h >> 10) & 0x1F;
+        float mantissa = (float)(h & 0x3FF);
+        float v = exponent == 0 ? ldexpf(mantissa, -24) : ldexpf(mantissa + 1024.0f, exponent - 25);
+        return (h & 0x8000) ? -v : v;
+    }
+
+    template <typename Json>
+    bool transcode(Json& out) {
+        uint8_t initial;
+        if (!byte(initial)) return false;
+        uint8_t major = initial >> 5;
+        uint8_t info = initial & 0x1F;
+        uint64_t v = 0;
+
+        switch (major) {
+            case 0:
+                if (!argument(info, v)) return false;
+                out.value((unsigned long long)v);
+                return true;
+            case 1:
+                if (!argument(info, v)) return false;
+                out.value(-1LL - (long long)v);
+                return true;
+            case 3: {
+                if (!argument(info, v) || (uint64_t)(end - p) < v) return false;
+                std::string s((const char*)p, v);
+                p += v;
+                out.value(s.c_str());
+                return true;
+            }
+            case 4:
+                if (info != 31) return false;
+                out.beginArray();
+                while (p < end && *p != 0xFF) {
+                    if (!transcode(out)) return false;
+                }
+                if (p >= end) return false;
+                p++;
+                out.endArray();
+                return true;
+            case 5:
+                if (info != 31) return false;
+                out.beginObject();
+                while (p < end && *p != 0xFF) {
+                    uint8_t keyInitial;
+                    if (!byte(keyInitial) || (keyInitial >> 5) != 3) return false;
+                    if (!argument(keyInitial & 0x1F, v) || (uint64_t)(end - p) < v) return false;
+                    std::string key((const char*)p, v);
+                    p += v;
+                    out.key(key.c_str());
+                    if (!transcode(out)) return false;
+                }
+                if (p >= end) return false;
+                p++;
+                out.endObject();
+                return true;
+            case 7:
+                if (info == 20 || info == 21) {
+                    out.value(info == 21);
+                    return true;
+                }
+                if (info == 22) {
+                    out.value(nullptr);
+                    return true;
+                }
+                if (info == 25 || info == 26) {
+                    if (!argument(info, v)) return false;
+                    float f;
+                    if (info == 25) {
+                        f = halfToFloat((uint16_t)v);
+                    } else {
+                        uint32_t bits = (uint32_t)v;
+                        memcpy(&f, &bits, sizeof(f));
+                    }
+                    out.value(f);
+                    return true;
+                }
+                return false;
+            default:
+                return false;
+        }
+    }
+};
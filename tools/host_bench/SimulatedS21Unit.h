@@ -0,0 +1,173 @@
+#pragma once
+
+#include "protocol/IACProtocol.h"
+
+// 模擬的 S21 室內機
+// 在 IACProtocol 層模擬 S21ProtocolAdapter 的行為：每個呼叫對應它實際會送出的 S21 幀，
+// 控制命令在 applyDelayMs 後才反映在查詢結果（模擬空調切換時間），
+// 並沿用適配器「以上次查詢結果組裝 D1」的快取語義。
+class SimulatedS21Unit : public IACProtocol {
+public:
+    enum Frame : uint8_t { FRAME_D1 = 0, FRAME_D5, FRAME_F1, FRAME_RH, FRAME_F5, FRAME_COUNT };
+
+    // 2400 baud 8E2 約 5 ms/byte：命令幀 9 bytes + ACK，查詢再加回應幀
+    static constexpr unsigned long COMMAND_FRAME_MS = 50;
+    static constexpr unsigned long QUERY_FRAME_MS = 100;
+
+    struct State {
+        bool power;
+        uint8_t mode;
+        float targetTemperature;
+        uint8_t fanSpeed;
+        bool swingVertical;
+        bool swingHorizontal;
+    };
+
+    explicit SimulatedS21Unit(const State& initial, unsigned long applyDelay)
+        : applied(initial), pending(initial), cache(initial), applyDelayMs(applyDelay),
+          applyAt(0), roomTemperature(26.0f), busTimeMs(0) {
+        for (uint8_t i = 0; i < FRAME_COUNT; i++) frames[i] = 0;
+    }
+
+    // 推進模擬時間，到期的命令生效
+    void advance(unsigned long now) {
+        if (applyAt != 0 && now >= applyAt) {
+            applied = pending;
+            applyAt = 0;
+        }
+    }
+
+    // 以紅外線遙控器直接改變空調狀態（不經過 S21 匯流排）
+    void remoteControl(const State& state) {
+        applied = pending = state;
+        applyAt = 0;
+    }
+
+    void setRoomTemperature(float temperature) { roomTemperature = temperature; }
+
+    const State& getAppliedState() const { return applied; }
+    uint32_t getFrames(Frame frame) const { return frames[frame]; }
+    uint32_t getTotalFrames() const {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < FRAME_COUNT; i++) total += frames[i];
+        return total;
+    }
+    unsigned long getBusTimeMs() const { return busTimeMs; }
+    static const char* getFrameName(Frame frame) {
+        static const char* names[FRAME_COUNT] = {"D1", "D5", "F1", "RH", "F5"};
+        return names[frame];
+    }
+
+    // IACProtocol
+    bool begin() override { return true; }
+
+    bool setPowerAndMode(bool power, uint8_t mode, float temperature, uint8_t fanSpeed) override {
+        count(FRAME_D1, COMMAND_FRAME_MS);
+        cache.power = power;
+        cache.mode = mode;
+        cache.targetTemperature = temperature;
+        cache.fanSpeed = fanSpeed;
+        command();
+        return true;
+    }
+
+    bool setTemperature(float temperature) override {
+        // 與適配器一致：關機時只記錄不送幀
+        cache.targetTemperature = temperature;
+        if (!cache.power) return true;
+        count(FRAME_D1, COMMAND_FRAME_MS);
+        command();
+        return true;
+    }
+
+    bool queryStatus(ACStatus& status) override {
+        count(FRAME_F1, QUERY_FRAME_MS);
+        status.power = applied.power;
+        status.mode = applied.mode;
+        status.targetTemperature = applied.targetTemperature;
+        status.fanSpeed = applied.fanSpeed;
+        status.swingVertical = cache.swingVertical;
+        status.swingHorizontal = cache.swingHorizontal;
+        status.isValid = true;
+        // 適配器以查詢結果覆寫快取
+        cache.power = applied.power;
+        cache.mode = applied.mode;
+        cache.targetTemperature = applied.targetTemperature;
+        cache.fanSpeed = applied.fanSpeed;
+        return true;
+    }
+
+    bool queryTemperature(float& temperature) override {
+        count(FRAME_RH, QUERY_FRAME_MS);
+        temperature = roomTemperature;
+        return true;
+    }
+
+    bool supportsSwing(SwingAxis axis) const override { return axis == SwingAxis::Vertical; }
+
+    bool setSwing(SwingAxis axis, bool enabled) override {
+        count(FRAME_D5, COMMAND_FRAME_MS);
+        if (axis == SwingAxis::Vertical) cache.swingVertical = enabled;
+        else cache.swingHorizontal = enabled;
+        command();
+        return true;
+    }
+
+    bool setSwingState(bool vertical, bool horizontal) override {
+        count(FRAME_D5, COMMAND_FRAME_MS);
+        cache.swingVertical = vertical;
+        cache.swingHorizontal = horizontal;
+        command();
+        return true;
+    }
+
+    bool getSwing(SwingAxis axis) const override {
+        return axis == SwingAxis::Vertical ? cache.swingVertical : cache.swingHorizontal;
+    }
+
+    bool querySwing(ACStatus& status) override {
+        count(FRAME_F5, QUERY_FRAME_MS);
+        status.swingVertical = cache.swingVertical = applied.swingVertical;
+        status.swingHorizontal = cache.swingHorizontal = applied.swingHorizontal;
+        return true;
+    }
+
+    bool supportsMode(uint8_t mode) const override {
+        return mode == AC_MODE_AUTO || mode == AC_MODE_COOL || mode == AC_MODE_HEAT ||
+               mode == AC_MODE_DRY || mode == AC_MODE_FAN;
+    }
+    bool supportsFanSpeed(uint8_t fanSpeed) const override { return fanSpeed <= FAN_QUIET; }
+    std::pair<float, float> getTemperatureRange() const override { return {16.0f, 30.0f}; }
+    std::vector<uint8_t> getSupportedModes() const override {
+        return {AC_MODE_AUTO, AC_MODE_COOL, AC_MODE_HEAT, AC_MODE_DRY, AC_MODE_FAN};
+    }
+    std::vector<uint8_t> getSupportedFanSpeeds() const override {
+        return {FAN_AUTO, FAN_SPEED_1, FAN_SPEED_2, FAN_SPEED_3, FAN_SPEED_4, FAN_SPEED_5, FAN_QUIET};
+    }
+
+    const char* getProtocolName() const override { return "S21-Sim"; }
+    const char* getProtocolVersion() const override { return "host"; }
+    bool isLastOperationSuccessful() const override { return true; }
+    const char* getLastError() const override { return ""; }
+
+private:
+    State applied;   // 空調實際狀態（查詢回報）
+    State pending;   // 已收到、尚未生效的命令
+    State cache;     // 適配器端快取（lastStatus）
+    unsigned long applyDelayMs;
+    unsigned long applyAt;
+    float roomTemperature;
+    unsigned long busTimeMs;
+    uint32_t frames[FRAME_COUNT];
+
+    void count(Frame frame, unsigned long busMs) {
+        frames[frame]++;
+        busTimeMs += busMs;
+    }
+
+    // 新命令重新計時，生效內容為最後一次命令
+    void command() {
+        pending = cache;
+        applyAt = millis() + applyDelayMs;
+    }
+};
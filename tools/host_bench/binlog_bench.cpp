@@ -0,0 +1,182 @@
+// 二進位日誌基準測試（主機端）
+// 以韌體中實際的 DEBUG_*_PRINT 格式字串比較：
+// 1. 原本的文字日誌宏（每個呼叫點各自格式化兩次）：Serial.printf（模擬 ESP32 Print::printf 的 64 bytes 區域緩衝，超長時 malloc）
+//    + snprintf 到 256 bytes 緩衝 + remoteWebLog（開發建置：加時間戳 String 放入 50 筆 vector）；
+// 2. BinaryLog::write：只記錄格式字串位移與原始參數（不格式化、不輸出串口）。
+// 報告每次呼叫的主機 CPU 時間、堆積配置次數，以及每 KB RAM 可保存的日誌筆數；
+// 並檢查讀取端延遲格式化的結果與 snprintf 逐字相同。
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "common/BinaryLog.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 200000;
+constexpr size_t TEXT_LOG_ENTRIES = 50;     // 原本 RemoteDebugger 串口日誌緩存的筆數
+constexpr size_t LOG_MANAGER_RECORD = 128;  // LogManager 固定長度記錄
+
+// ESP32 Print::printf：先格式化到 64 bytes 區域緩衝，放不下時 malloc 後再格式化一次
+int emulatedSerialPrintf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+int emulatedSerialPrintf(const char* fmt, ...) {
+    char localBuffer[64];
+    char* text = localBuffer;
+    va_list args;
+    va_start(args, fmt);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(localBuffer, sizeof(localBuffer), fmt, copy);
+    va_end(copy);
+    if (length >= (int)sizeof(localBuffer)) {
+        text = (char*)malloc(length + 1);
+        vsnprintf(text, length + 1, fmt, args);
+    }
+    va_end(args);
+    asm volatile("" : : "r"(text) : "memory");     // 模擬 write(text, length)
+    if (text != localBuffer) free(text);
+    return length;
+}
+
+// RemoteDebugger::logSerial（WebSocket 廣播不計入）
+std::vector<String> serialLogBuffer;
+void emulatedRemoteWebLog(const String& message) {
+    String timestampedMsg = "[" + String(millis()) + "] " + message;
+    serialLogBuffer.push_back(timestampedMsg);
+    if (serialLogBuffer.size() > TEXT_LOG_ENTRIES) serialLogBuffer.erase(serialLogBuffer.begin());
+}
+
+#define TEXT_LOG(...) do { \
+    emulatedSerialPrintf(__VA_ARGS__); \
+    static char buffer[256]; \
+    snprintf(buffer, sizeof(buffer), __VA_ARGS__); \
+    emulatedRemoteWebLog(buffer); \
+} while (0)
+
+#define BINARY_WRITE(fmt, ...) BINARY_LOG.write(DEBUG_INFO_LEVEL, "" fmt, ##__VA_ARGS__)
+constexpr uint8_t DEBUG_INFO_LEVEL = 3;
+
+// 韌體中的代表性日誌（依出現頻率混合：狀態同步、溫度、風速、S21 通訊）
+#define LOG_SAMPLES(LOG, i) \
+    switch ((i) % 6) { \
+        case 0: LOG("[Controller] 設置目標溫度：%.1f°C\n", 24.5f + (i % 10) * 0.5f); break; \
+        case 1: LOG("[Controller] 同步待發送狀態 (P:%d M:%d T:%d F:%d)\n", 1, (int)(i % 4), 0, 1); break; \
+        case 2: LOG("[Controller] 設置風速：%d (%s)\n", (int)(i % 6), "自動"); break; \
+        case 3: LOG("[Controller] 溫度意圖未確認，保留用戶設置 (用戶: %.1f°C, AC回報: %.1f°C)\n", 24.5f, 26.0f); break; \
+        case 4: LOG("[Controller] 批次控制完成：D1=%d D5=%d 確認=%d 命令 %lu us，確認 %lu us\n", \
+                    1, 0, 1, (unsigned long)(18000 + i % 977), (unsigned long)(42000 + i % 1301)); break; \
+        default: LOG("[S21] 命令 %c%c 回應逾時，重試第 %d 次\n", 'F', '1', (int)(i % 3) + 1); break; \
+    }
+
+struct Result {
+    double nsPerLog;
+    double allocsPerLog;
+};
+
+template <typename Fn>
+Result measure(Fn fn) {
+    for (int i = 0; i < 1000; i++) fn(i);   // 預熱：填滿緩衝
+    uint64_t allocsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Result r;
+    r.nsPerLog = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+    r.allocsPerLog = (double)(allocationCount - allocsBefore) / ITERATIONS;
+    return r;
+}
+
+void report(const char* name, const Result& r) {
+    printf("%-28s %9.1f %8.2f\n", name, r.nsPerLog, r.allocsPerLog);
+}
+
+// 讀取端格式化結果必須與 snprintf 相同
+bool check(const char* expected) {
+    bool match = false;
+    BINARY_LOG.forEach(BINARY_LOG.getLastSeq() - 1, 1, [&](const BinaryLog::Entry& entry) {
+        char text[BinaryLog::MAX_MESSAGE_SIZE];
+        BINARY_LOG.format(entry, text, sizeof(text));
+        match = strcmp(text, expected) == 0;
+        if (!match) printf("格式化不符:\n  期望 %s  實際 %s", expected, text);
+    });
+    return match;
+}
+
+bool validUtf8(const char* text, size_t length) {
+    for (size_t i = 0; i < length;) {
+        uint8_t c = (uint8_t)text[i];
+        size_t n = c < 0x80 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 0;
+        if (n == 0 || i + n > length) return false;
+        for (size_t k = 1; k < n; k++) {
+            if (((uint8_t)text[i + k] & 0xC0) != 0x80) return false;
+        }
+        i += n;
+    }
+    return true;
+}
+
+#define CHECK_FORMAT(fmt, ...) do { \
+    char expected[BinaryLog::MAX_MESSAGE_SIZE]; \
+    snprintf(expected, sizeof(expected), fmt, ##__VA_ARGS__); \
+    BINARY_WRITE(fmt, ##__VA_ARGS__); \
+    ok &= check(expected); \
+} while (0)
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    printf("%-28s %9s %8s\n", "method", "ns/log", "allocs");
+    report("text (Serial + remoteWebLog)", measure([](int i) { LOG_SAMPLES(TEXT_LOG, i) }));
+    Result binary = measure([](int i) { LOG_SAMPLES(BINARY_WRITE, i) });
+    report("binary (deferred)", binary);
+    ok &= binary.allocsPerLog == 0;
+
+    // 讀取端成本：有人觀看時才付出
+    Result decode = measure([](int) {
+        BINARY_LOG.forEach(BINARY_LOG.getLastSeq() - 1, 1, [](const BinaryLog::Entry& entry) {
+            char text[BinaryLog::MAX_MESSAGE_SIZE];
+            BINARY_LOG.format(entry, text, sizeof(text));
+            asm volatile("" : : "r"(text) : "memory");
+        });
+    });
+    report("binary read + format", decode);
+
+    // 容量：緩衝穩態下實際保存的筆數與位元組
+    BinaryLog::Stats stats = BINARY_LOG.getStats();
+    double binaryBytes = (double)stats.bytesUsed / stats.stored;
+    size_t textBytes = 0;
+    for (const String& s : serialLogBuffer) textBytes += s.length() + 1;
+    double textAverage = (double)textBytes / serialLogBuffer.size();
+
+    printf("\n%-28s %9s %8s\n", "storage", "bytes/log", "logs/KB");
+    printf("%-28s %9.1f %8.1f\n", "text (exact length)", textAverage, 1024.0 / textAverage);
+    printf("%-28s %9zu %8.1f\n", "LogManager record", LOG_MANAGER_RECORD, 1024.0 / LOG_MANAGER_RECORD);
+    printf("%-28s %9.1f %8.1f\n", "binary record", binaryBytes, 1024.0 / binaryBytes);
+    printf("binary 緩衝 %zu bytes：保存 %u 筆，累計丟棄 %u 筆\n",
+           BinaryLog::BUFFER_SIZE, stats.stored, stats.evicted);
+
+    // 格式化正確性：旗標、寬度、精度、*、長度修飾詞、%%、UTF-8 字串
+    CHECK_FORMAT("[Controller] 設置目標溫度：%.1f°C\n", 24.5f);
+    CHECK_FORMAT("[Controller] 批次控制完成：D1=%d D5=%d 確認=%d 命令 %lu us，確認 %lu us\n", 1, 0, 1, 18234UL, 42001UL);
+    CHECK_FORMAT("[FanDevice] 初始狀態 - 開關：%s，速度：%d%% (AC速度：%d)\n", "開啟", 60, 3);
+    CHECK_FORMAT("[Main] 剩餘堆積 %u bytes，運行 %llu ms，負數 %ld\n", 142336u, 123456789012ULL, -42L);
+    CHECK_FORMAT("[S21] 封包 %02X %02x %#o |%-6s|%6s| %+d % d\n", 0x3A, 0xF1, 8, "ab", "cd", 5, 7);
+    CHECK_FORMAT("[Test] 寬度 |%*d| 精度 |%.*f| %e %g %c\n", 6, 42, 3, 3.14159, 0.000123, 1234567.0, 'Z');
+    CHECK_FORMAT("[Test] 無參數 100%%\n");
+
+    // 超長字串參數截短在 UTF-8 字元邊界上
+    BINARY_WRITE("[WiFi] SSID %s\n", "很長很長很長很長很長很長很長很長很長很長的網路名稱");
+    BINARY_LOG.forEach(BINARY_LOG.getLastSeq() - 1, 1, [&](const BinaryLog::Entry& entry) {
+        char text[BinaryLog::MAX_MESSAGE_SIZE];
+        size_t length = BINARY_LOG.format(entry, text, sizeof(text));
+        ok &= length <= strlen("[WiFi] SSID \n") + BinaryLog::MAX_STRING_ARG && validUtf8(text, length);
+    });
+
+    printf("零配置且格式化結果一致: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
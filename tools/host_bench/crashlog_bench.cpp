@@ -0,0 +1,128 @@
+// RTC 崩潰日誌測試（主機端，RTC 記憶體就是一般全域變數，以 recover() 模擬重啟）
+// 1. 寫入成本：record() 與 updateSnapshot() 每次呼叫的耗時，對照一次完整的 DEBUG_ERROR_PRINT；
+// 2. 看門狗重置後取回最近 RECORD_COUNT 行（依序號排列）與最後的控制器快照；
+// 3. 寫到一半的記錄（CRC 不符）個別丟棄，其他記錄照常取回；
+// 4. 上電時的隨機內容、標頭損壞都視為空白，開機計數從 1 重新開始；
+// 5. 超長的中文日誌在 UTF-8 字元邊界截斷。
+
+#include <Arduino.h>
+#include <random>
+
+#include "common/CrashLog.h"
+#include "common/Debug.h"
+#include "common/LogDrain.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 200000;
+
+// 模擬重啟：RTC 內容不變，以指定的重置原因重新開機
+void reboot(esp_reset_reason_t reason) {
+    HostReset::reason = reason;
+    CRASH_LOG.recover();
+}
+
+bool validUtf8(const char* text) {
+    for (size_t i = 0; text[i]; ) {
+        uint8_t c = (uint8_t)text[i];
+        size_t n = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+        if (n == 0) return false;
+        for (size_t k = 1; k < n; k++) {
+            if (((uint8_t)text[i + k] & 0xC0) != 0x80) return false;
+        }
+        i += n;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok &= CrashLog::crc32("123456789", 9) == 0xCBF43926;
+
+    // 1. 寫入成本
+    reboot(ESP_RST_POWERON);
+    double recordNs = nsPerCall(ITERATIONS, [](int i) {
+        CRASH_LOG.record("[S21] 通訊錯誤: 命令 F1 超時 (重試 3 次)\n");
+        asm volatile("" : : "r"(i) : "memory");
+    });
+    double snapshotNs = nsPerCall(ITERATIONS, [](int i) {
+        CRASH_LOG.updateSnapshot(true, 2, 24.5f, 23.0f + (i & 3), 3);
+    });
+    double printNs = nsPerCall(ITERATIONS, [](int i) {
+        DEBUG_ERROR_PRINT("[S21] 通訊錯誤: 命令 F%d 超時 (重試 %d 次)\n", i & 7, 3);
+        if ((i & 15) == 15) LOG_DRAIN.drain([](const char*, size_t) {});
+    });
+    LOG_DRAIN.drain([](const char*, size_t) {});
+
+    printf("RTC 區塊 %zu bytes（%zu 筆 x %zu bytes + 快照 %zu bytes）\n\n",
+           sizeof(CrashLogStore), CrashLog::RECORD_COUNT, sizeof(CrashLogRecord), sizeof(CrashLogSnapshot));
+    printf("%-32s %9s\n", "call", "ns/call");
+    printf("%-32s %9.1f\n", "CRASH_LOG.record", recordNs);
+    printf("%-32s %9.1f\n", "CRASH_LOG.updateSnapshot", snapshotNs);
+    printf("%-32s %9.1f\n", "DEBUG_ERROR_PRINT (含 record)", printNs);
+
+    // 2. 看門狗重置：取回最後 RECORD_COUNT 行與快照
+    reboot(ESP_RST_POWERON);
+    uint32_t boot = CRASH_LOG.getBootCount();
+    HostClock::set(120000);
+    CRASH_LOG.updateSnapshot(true, 2, 25.5f, 27.0f, 4);
+    for (int i = 1; i <= 20; i++) {
+        DEBUG_ERROR_PRINT("[Main] 第 %d 行\n", i);
+    }
+    LOG_DRAIN.drain([](const char*, size_t) {});
+    reboot(ESP_RST_TASK_WDT);
+
+    const CrashLog::Recovered& recovered = CRASH_LOG.getRecovered();
+    bool ordered = recovered.recordCount == CrashLog::RECORD_COUNT;
+    for (uint8_t i = 0; ordered && i < recovered.recordCount; i++) {
+        char expected[32];
+        snprintf(expected, sizeof(expected), "[Main] 第 %d 行", i + 5);
+        ordered = strcmp(recovered.records[i].text, expected) == 0 && recovered.records[i].uptimeMs == 120000;
+    }
+    bool snapshot = recovered.hasSnapshot && recovered.snapshot.power && recovered.snapshot.targetMode == 2 &&
+                    recovered.snapshot.targetTemperature == 25.5f && recovered.snapshot.fanSpeed == 4 &&
+                    recovered.snapshot.uptimeMs == 120000;
+    bool crash = CRASH_LOG.isCrashReset() && CRASH_LOG.getBootCount() == boot + 1 &&
+                 strcmp(CrashLog::resetReasonName(CRASH_LOG.getResetReason()), "task_wdt") == 0;
+    printf("\n看門狗重置後取回 %u/%zu 行、順序正確: %s，快照: %s，重置原因 %s（開機 %u 次）\n",
+           recovered.recordCount, CrashLog::RECORD_COUNT, ordered ? "yes" : "NO", snapshot ? "yes" : "NO",
+           CrashLog::resetReasonName(CRASH_LOG.getResetReason()), CRASH_LOG.getBootCount());
+    ok &= ordered && snapshot && crash;
+
+    // 3. 寫到一半的記錄
+    for (int i = 0; i < 8; i++) CRASH_LOG.record("[Controller] 狀態同步失敗");
+    crashLogStore.records[3].text[5] ^= 0x20;
+    reboot(ESP_RST_BROWNOUT);
+    bool torn = CRASH_LOG.getRecovered().recordCount == 7 && !CRASH_LOG.getRecovered().hasSnapshot;
+    printf("一筆記錄損壞時取回 %u/8 行: %s\n", CRASH_LOG.getRecovered().recordCount, torn ? "yes" : "NO");
+    ok &= torn;
+
+    // 4. 上電隨機內容與標頭損壞
+    std::mt19937 rng(46);
+    uint8_t* raw = reinterpret_cast<uint8_t*>(&crashLogStore);
+    for (size_t i = 0; i < sizeof(CrashLogStore); i++) raw[i] = (uint8_t)rng();
+    reboot(ESP_RST_POWERON);
+    bool garbage = CRASH_LOG.getRecovered().recordCount == 0 && !CRASH_LOG.getRecovered().hasSnapshot &&
+                   CRASH_LOG.getBootCount() == 1 && !CRASH_LOG.isCrashReset();
+    CRASH_LOG.record("[Main] safeRestart");
+    crashLogStore.bootCount = 99;
+    reboot(ESP_RST_SW);
+    bool header = CRASH_LOG.getRecovered().recordCount == 0 && CRASH_LOG.getBootCount() == 1;
+    printf("上電隨機內容視為空白: %s，標頭損壞視為空白: %s\n", garbage ? "yes" : "NO", header ? "yes" : "NO");
+    ok &= garbage && header;
+
+    // 5. UTF-8 截斷
+    CRASH_LOG.record("[S21] 收到無法解析的回應，協議版本不相符，請確認空調型號與連接線是否正確，再重新啟動裝置\n");
+    reboot(ESP_RST_PANIC);
+    const char* truncated = CRASH_LOG.getRecovered().records[0].text;
+    bool utf8 = CRASH_LOG.getRecovered().recordCount == 1 && strlen(truncated) < CrashLogRecord::TEXT_SIZE &&
+                strlen(truncated) > CrashLogRecord::TEXT_SIZE - 4 && validUtf8(truncated);
+    printf("長訊息截斷於字元邊界: %s（%s）\n", utf8 ? "yes" : "NO", truncated);
+    ok &= utf8;
+
+    printf("崩潰日誌跨重啟保留且損壞記錄被拒絕: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
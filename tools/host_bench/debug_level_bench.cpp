@@ -0,0 +1,86 @@
+// 依元件日誌級別測試（主機端，以 DEBUG_LEVEL=VERBOSE 編譯，所有級別都編入）
+// 1. 元件由格式字串的 [標籤] 在編譯期判斷（static_assert）；
+// 2. 級別關閉時的呼叫成本：只有一次載入與比較，不格式化、不求值參數；
+// 3. 執行期只開啟 S21 的 VERBOSE：S21 詳細日誌進入佇列，其他元件的 VERBOSE 不進入；
+// 4. setDebugLevel 不會超過編譯期下限以外的範圍，其他元件的級別不受影響。
+
+#include <Arduino.h>
+
+#include "common/Debug.h"
+#include "common/LogDrain.h"
+#include "BenchUtil.h"
+
+static_assert(debugComponentOf("[S21] 發送命令\n") == DebugComponent::S21, "S21");
+static_assert(debugComponentOf("[S21Adapter] 初始化\n") == DebugComponent::S21, "S21Adapter");
+static_assert(debugComponentOf("[ACFactory] 偵測協議\n") == DebugComponent::S21, "ACFactory");
+static_assert(debugComponentOf("[Controller] 設置電源\n") == DebugComponent::Controller, "Controller");
+static_assert(debugComponentOf("[FanDevice] 初始狀態\n") == DebugComponent::Device, "FanDevice");
+static_assert(debugComponentOf("[Events] 客戶端連線\n") == DebugComponent::Web, "Events");
+static_assert(debugComponentOf("\n[WiFiManager] 啟動\n") == DebugComponent::WiFi, "WiFiManager");
+static_assert(debugComponentOf("[Main] 啟動\n") == DebugComponent::System, "Main");
+static_assert(debugComponentOf("  - 溫度格式\n") == DebugComponent::System, "continuation");
+
+namespace {
+
+constexpr int ITERATIONS = 2000000;
+
+int evaluated = 0;
+int sideEffect() { return ++evaluated; }
+
+// 排空佇列，回傳其間的訊息數
+size_t drainMessages() {
+    size_t messages = 0;
+    static uint32_t cursor = 0;
+    cursor = LOG_DRAIN.forEachMessage(cursor, LogDrain::SLOT_COUNT, [&messages](const char*, size_t, uint8_t) { messages++; });
+    LOG_DRAIN.drain([](const char*, size_t) {});
+    return messages;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // 開機預設：所有元件 INFO
+    for (uint8_t c = 0; c < (uint8_t)DebugComponent::Count; c++) {
+        ok &= getDebugLevel((DebugComponent)c) == DEBUG_RUNTIME_LEVEL;
+    }
+
+    double disabled = nsPerCall(ITERATIONS, [](int i) {
+        DEBUG_VERBOSE_PRINT("[S21] 收到回應: 02 47 %02X 30 31 32 33 %02X 03 (%d ms)\n", i & 0xFF, sideEffect(), 40);
+    });
+    ok &= evaluated == 0;
+
+    setDebugLevel(DebugComponent::S21, DEBUG_VERBOSE);
+    drainMessages();
+    double enabled = nsPerCall(ITERATIONS, [](int i) {
+        DEBUG_VERBOSE_PRINT("[S21] 收到回應: 02 47 %02X 30 31 32 33 %02X 03 (%d ms)\n", i & 0xFF, i & 0x7F, 40);
+        if ((i & 15) == 15) LOG_DRAIN.drain([](const char*, size_t) {});
+    });
+    drainMessages();
+
+    printf("%-32s %9s\n", "call", "ns/call");
+    printf("%-32s %9.1f\n", "VERBOSE [S21] (S21 = info)", disabled);
+    printf("%-32s %9.1f\n", "VERBOSE [S21] (S21 = verbose)", enabled);
+
+    // 只有 S21 開啟 VERBOSE
+    DEBUG_VERBOSE_PRINT("[S21] 發送命令: F1\n");
+    DEBUG_VERBOSE_PRINT("[Controller] 詳細狀態\n");
+    DEBUG_VERBOSE_PRINT("[WiFiManager] 掃描結果\n");
+    DEBUG_INFO_PRINT("[Controller] 狀態同步完成\n");
+    size_t delivered = drainMessages();
+    printf("S21=verbose、其他=info 時送出 %zu/4 筆（預期 2）\n", delivered);
+    ok &= delivered == 2;
+
+    // 級別限制在 NONE..DEBUG_LEVEL 之內，其他元件不受影響
+    ok &= setDebugLevel(DebugComponent::Web, 9) == DEBUG_LEVEL;
+    ok &= setDebugLevel(DebugComponent::Web, -3) == DEBUG_NONE;
+    ok &= getDebugLevel(DebugComponent::Web) == DEBUG_NONE;
+    ok &= getDebugLevel(DebugComponent::S21) == DEBUG_VERBOSE;
+    ok &= getDebugLevel(DebugComponent::Controller) == DEBUG_INFO;
+    ok &= parseDebugLevel("Verbose") == DEBUG_VERBOSE && parseDebugLevel("2") == DEBUG_WARN && parseDebugLevel("loud") == -1;
+
+    ok &= disabled * 10 < enabled;
+    printf("依元件級別切換正確且關閉時不格式化: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
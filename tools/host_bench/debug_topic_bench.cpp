@@ -0,0 +1,255 @@
+// 遠端調試主題訂閱測試（主機端，直接驅動 DebugFanout）
+// 1. 只訂閱 s21 的客戶端：日誌、HomeKit 操作與控制器狀態事件不呼叫 describe、不序列化、不配置堆積，
+//    每次 publish() 的成本與有訂閱者時（序列化 + 放入佇列）並列；
+// 2. logs 依級別過濾：訂閱 warn 的客戶端只收到 error / warn；
+// 3. CBOR 客戶端與 JSON 客戶端訂閱相同主題：CBOR 訊框解碼後的事件與 JSON 訊框逐字相同，並比較大小；
+// 4. 切換編碼時佇列中舊編碼的事件計入 dropped；主題聯集（debugTopicMask）隨訂閱更新；
+// 5. DEBUG_*_PRINT 的級別經 LogDrain 傳到轉發端，RemoteDebugger 據此過濾。
+
+#include <Arduino.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Debug.h"
+#include "common/DebugFanout.h"
+#include "common/LogDrain.h"
+#include "CborReader.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 200000;
+constexpr uint8_t LOGS = debugTopicBit(DebugTopic::Logs);
+constexpr uint8_t S21 = debugTopicBit(DebugTopic::S21Frames);
+constexpr uint8_t CONTROLLER = debugTopicBit(DebugTopic::ControllerState);
+constexpr uint8_t HOMEKIT = debugTopicBit(DebugTopic::HomeKitOps);
+
+uint32_t describeCalls = 0;
+
+struct StringSink {
+    std::string text;
+    void append(const char* data, size_t len) { text.append(data, len); }
+};
+
+// RemoteDebugger 的三種主要事件（欄位與 src/RemoteDebugger.cpp 相同）
+void publishLog(DebugFanout& fanout, uint8_t level, const char* text, unsigned long now) {
+    fanout.publish(DebugTopic::Logs, level, now, [&](auto& writer) {
+        describeCalls++;
+        writer.beginObject()
+            .field("type", "serial_log")
+            .field("timestamp", now)
+            .field("level", debugLevelName(level))
+            .field("data", text)
+            .endObject();
+    });
+}
+
+void publishControllerState(DebugFanout& fanout, int i, unsigned long now) {
+    fanout.publish(DebugTopic::ControllerState, DEBUG_NONE, now, [&](auto& writer) {
+        describeCalls++;
+        writer.beginObject()
+            .field("type", "controller_state")
+            .field("timestamp", now)
+            .field("power", true)
+            .field("mode", (uint8_t)(i % 4))
+            .field("target_temp", 24.5f)
+            .field("current_temp", 26.0f + (i % 8) * 0.5f)
+            .field("fan_speed", (uint8_t)3)
+            .endObject();
+    });
+}
+
+void publishS21Frame(DebugFanout& fanout, bool transmit, int i, unsigned long now) {
+    char hex[32];
+    snprintf(hex, sizeof(hex), "024631%02X03", (unsigned)(i & 0xFF));
+    fanout.publish(DebugTopic::S21Frames, DEBUG_NONE, now, [&](auto& writer) {
+        describeCalls++;
+        writer.beginObject()
+            .field("type", "s21_frame")
+            .field("timestamp", now)
+            .field("direction", transmit ? "tx" : "rx")
+            .field("length", (size_t)5)
+            .field("hex", hex)
+            .endObject();
+    });
+}
+
+// 一次 S21 週期的事件：兩個訊框、三行不同級別的日誌、一次狀態變化
+void cycle(DebugFanout& fanout, int i, unsigned long now) {
+    publishS21Frame(fanout, true, i, now);
+    publishS21Frame(fanout, false, i, now);
+    publishLog(fanout, DEBUG_VERBOSE, "[S21] 成功解析回應：cmd=G1，payload長度=4\n", now);
+    publishLog(fanout, DEBUG_INFO, "[S21] 空調狀態更新: 電源=1 大金模式=3(冷氣) 目標溫度=24.5°C\n", now);
+    if (i % 16 == 0) publishLog(fanout, DEBUG_WARN, "[S21] 警告：回應延遲 180 ms\n", now);
+    if (i % 64 == 0) publishLog(fanout, DEBUG_ERROR, "[S21] 錯誤：等待 ETX 超時或緩衝區溢出\n", now);
+    publishControllerState(fanout, i, now);
+}
+
+struct Received {
+    std::vector<std::string> frames;    // JSON 文字（CBOR 訊框解碼後）
+    size_t bytes = 0;                   // 實際送出的位元組
+    bool binary = false;
+};
+
+// 收集每個客戶端的訊框；CBOR 訊框解碼成 JSON 文字後再比對
+void collect(DebugFanout& fanout, unsigned long now, std::vector<Received>& received) {
+    fanout.flush(now,
+        [](uint8_t) { return true; },
+        [&](uint8_t id, const char* data, size_t length, bool binary) {
+            Received& r = received[id];
+            r.bytes += length;
+            r.binary = binary;
+            if (!binary) {
+                r.frames.emplace_back(data, length);
+                return;
+            }
+            StringSink sink;
+            JsonWriter<StringSink> json(sink);
+            CborReader reader{(const uint8_t*)data, (const uint8_t*)data + length};
+            if (!reader.transcode(json) || reader.p != reader.end) sink.text = "<malformed>";
+            r.frames.push_back(sink.text);
+        });
+}
+
+// 取出訊框中的事件陣列內容並累計 dropped
+std::string events(const Received& r, uint32_t& dropped) {
+    static const char prefix[] = "{\"type\":\"batch\",\"dropped\":";
+    std::string joined;
+    dropped = 0;
+    for (const std::string& frame : r.frames) {
+        if (frame.compare(0, sizeof(prefix) - 1, prefix) != 0) return "<malformed>";
+        size_t p = sizeof(prefix) - 1;
+        dropped += strtoul(frame.c_str() + p, nullptr, 10);
+        size_t open = frame.find('[', p);
+        if (open == std::string::npos || frame.size() < open + 3) return "<malformed>";
+        if (!joined.empty()) joined += ',';
+        joined += frame.substr(open + 1, frame.size() - open - 3);
+    }
+    return joined;
+}
+
+size_t count(const std::string& text, const char* needle) {
+    size_t n = 0;
+    for (size_t p = text.find(needle); p != std::string::npos; p = text.find(needle, p + 1)) n++;
+    return n;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // 1. 未訂閱主題的成本
+    {
+        std::unique_ptr<DebugFanout> fanout(new DebugFanout());
+        fanout->attach(0, 0, S21, DEBUG_VERBOSE);
+        describeCalls = 0;
+        uint64_t allocsBefore = allocationCount;
+        double unsubscribedNs = nsPerCall(ITERATIONS, [&](int i) {
+            publishLog(*fanout, DEBUG_INFO, "[Controller] 狀態同步完成 - 電源:1 模式:2 溫度:24.5°C 風速:3\n", i);
+            publishControllerState(*fanout, i, i);
+        }) / 2;
+        uint64_t unsubscribedAllocs = allocationCount - allocsBefore;
+        uint32_t unsubscribedCalls = describeCalls;
+        uint32_t skipped = fanout->getStats().skipped;
+
+        fanout->subscribe(0, LOGS | CONTROLLER, DEBUG_VERBOSE, false);
+        double subscribedNs = nsPerCall(ITERATIONS, [&](int i) {
+            publishLog(*fanout, DEBUG_INFO, "[Controller] 狀態同步完成 - 電源:1 模式:2 溫度:24.5°C 風速:3\n", i);
+            publishControllerState(*fanout, i, i);
+        }) / 2;
+
+        printf("%-28s %9s %9s\n", "publish", "ns/event", "describe");
+        printf("%-28s %9.1f %9u\n", "unsubscribed (s21 only)", unsubscribedNs, unsubscribedCalls);
+        printf("%-28s %9.1f %9u\n", "subscribed (json)", subscribedNs, describeCalls - unsubscribedCalls);
+        bool free = unsubscribedCalls == 0 && unsubscribedAllocs == 0 && skipped == 2u * ITERATIONS;
+        printf("未訂閱的事件不序列化、不配置: %s（略過 %u 筆，配置 %llu 次）\n\n",
+               free ? "yes" : "NO", skipped, (unsigned long long)unsubscribedAllocs);
+        ok &= free;
+    }
+
+    // 2 + 3. 級別過濾與 CBOR / JSON 一致性
+    {
+        std::unique_ptr<DebugFanout> fanout(new DebugFanout());
+        fanout->attach(0, 0, LOGS, DEBUG_WARN);                             // 只看警告以上
+        fanout->attach(1, 0, S21 | LOGS | CONTROLLER | HOMEKIT, DEBUG_VERBOSE);   // JSON
+        fanout->attach(2, 0);
+        fanout->subscribe(2, S21 | LOGS | CONTROLLER | HOMEKIT, DEBUG_VERBOSE, true);  // CBOR
+        bool masked = fanout->getTopicMask() == DEBUG_TOPICS_ALL && fanout->formatsFor(DebugTopic::Logs, DEBUG_VERBOSE) ==
+                      (DebugFanout::FORMAT_JSON | DebugFanout::FORMAT_CBOR);
+
+        std::vector<Received> received(3);
+        for (int i = 0; i < 256; i++) {
+            unsigned long now = 1000 + i * 20;
+            cycle(*fanout, i, now);
+            collect(*fanout, now, received);
+        }
+        collect(*fanout, 1000000, received);
+
+        uint32_t dropped[3];
+        std::string warnOnly = events(received[0], dropped[0]);
+        std::string json = events(received[1], dropped[1]);
+        std::string cbor = events(received[2], dropped[2]);
+
+        size_t errors = count(warnOnly, "\"level\":\"error\"");
+        size_t warnings = count(warnOnly, "\"level\":\"warn\"");
+        bool levels = errors == 4 && warnings == 16 && count(warnOnly, "\"level\":") == errors + warnings &&
+                      count(json, "\"level\":\"verbose\"") == 256 && count(warnOnly, "s21_frame") == 0;
+        bool identical = !json.empty() && json == cbor && received[2].binary && !received[1].binary &&
+                         count(json, "\"type\":\"s21_frame\"") == 512 && count(json, "controller_state") == 256;
+        bool lossless = dropped[0] == 0 && dropped[1] == 0 && dropped[2] == 0;
+
+        printf("%-10s %7s %8s\n", "format", "frames", "bytes");
+        printf("%-10s %7zu %8zu\n", "json", received[1].frames.size(), received[1].bytes);
+        printf("%-10s %7zu %8zu (%.0f%%)\n", "cbor", received[2].frames.size(), received[2].bytes,
+               100.0 * received[2].bytes / received[1].bytes);
+        printf("warn 訂閱者收到 error %zu 筆、warn %zu 筆，其餘級別與主題未收到: %s\n",
+               errors, warnings, levels ? "yes" : "NO");
+        printf("CBOR 訊框解碼後與 JSON 逐字相同: %s，主題聯集與編碼判斷正確: %s\n",
+               identical ? "yes" : "NO", masked ? "yes" : "NO");
+        if (!identical) printf("JSON: %.200s\nCBOR: %.200s\n", json.c_str(), cbor.c_str());
+        ok &= levels && identical && lossless && masked;
+    }
+
+    // 4. 切換編碼與取消訂閱
+    {
+        std::unique_ptr<DebugFanout> fanout(new DebugFanout());
+        fanout->attach(0, 0, LOGS, DEBUG_VERBOSE);
+        for (int i = 0; i < 5; i++) publishLog(*fanout, DEBUG_INFO, "[Main] 排隊中", 0);
+        fanout->subscribe(0, S21, DEBUG_VERBOSE, true);
+        publishS21Frame(*fanout, true, 1, 0);
+        uint32_t reported = 0;
+        size_t events = 0;
+        fanout->flush(1000, [](uint8_t) { return true; },
+            [&](uint8_t, const char* data, size_t length, bool binary) {
+                StringSink sink;
+                JsonWriter<StringSink> json(sink);
+                CborReader reader{(const uint8_t*)data, (const uint8_t*)data + length};
+                if (!binary || !reader.transcode(json)) return;
+                reported = strtoul(sink.text.c_str() + strlen("{\"type\":\"batch\",\"dropped\":"), nullptr, 10);
+                events = count(sink.text, "s21_frame");
+            });
+        bool switched = reported == 5 && events == 1 && fanout->getTopicMask() == S21;
+        fanout->detach(0);
+        switched &= fanout->getTopicMask() == 0 && !fanout->subscribe(0, LOGS, DEBUG_INFO, false);
+        printf("切換編碼時舊事件計入 dropped（%u 筆）、斷線後主題聯集清空: %s\n", reported, switched ? "yes" : "NO");
+        ok &= switched;
+    }
+
+    // 5. 日誌級別經 LogDrain 傳到轉發端
+    {
+        debugLog(DEBUG_WARN, "[S21] 警告：回應延遲 %d ms\n", 180);
+        debugLog(DEBUG_VERBOSE, "[S21] 收到 ETX\n");
+        std::vector<uint8_t> levels;
+        LOG_DRAIN.forEachMessage(0, LogDrain::SLOT_COUNT, [&levels](const char*, size_t, uint8_t level) {
+            levels.push_back(level);
+        });
+        bool carried = levels.size() == 2 && levels[0] == DEBUG_WARN && levels[1] == DEBUG_VERBOSE;
+        printf("LogDrain 訊息帶有級別: %s\n", carried ? "yes" : "NO");
+        ok &= carried;
+    }
+
+    printf("未訂閱的主題不序列化且 CBOR 與 JSON 內容一致: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// 批次控制請求本體解析測試（主機端，直接驅動 include/common/FlatJson.h）
+// /api/control 的欄位會轉成 D1/D5 指令，格式錯誤的本體必須整個以 400 拒絕、不能部分套用。
+// 以相同的案例對照原本在 main.cpp 中以子字串搜尋欄位名稱的做法（legacy）：
+//   - 字串值中的跳脫引號、巢狀物件中的同名鍵不得被當成頂層欄位；
+//   - 放不進 16 bytes 緩衝的值要拒絕，不得截斷；
+//   - 未結束的字串、物件後的多餘內容、重複的鍵與非純量值都要拒絕。
+// 另量測每次欄位查詢的成本。
+
+#include <Arduino.h>
+#include <string>
+
+#include "common/FlatJson.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr size_t VALUE_SIZE = 16;      // 與 parseControlRequest() 的 value[] 相同
+constexpr int ITERATIONS = 200000;
+
+// 原本的做法（main.cpp getControlField 的 JSON 分支）：找到 "name" 後接冒號即取值，過長時截斷
+int legacyGetField(const char* json, const char* name, char* value, size_t size) {
+    size_t nameLength = strlen(name);
+    for (const char* p = strstr(json, name); p; p = strstr(p + 1, name)) {
+        if (p == json || p[-1] != '"' || p[nameLength] != '"') continue;
+        const char* v = p + nameLength + 1;
+        while (*v == ' ' || *v == '\t' || *v == '\r' || *v == '\n') v++;
+        if (*v++ != ':') continue;
+        while (*v == ' ' || *v == '\t' || *v == '\r' || *v == '\n') v++;
+
+        size_t n = 0;
+        if (*v == '"') {
+            v++;
+            while (v[n] && v[n] != '"') n++;
+        } else {
+            while (v[n] && !strchr(",} \t\r\n", v[n])) n++;
+        }
+        if (n >= size) n = size - 1;
+        memcpy(value, v, n);
+        value[n] = '\0';
+        return 1;
+    }
+    return 0;
+}
+
+struct Case {
+    const char* name;
+    const char* body;
+    const char* field;
+    int expected;               // 1 / 0 / -1，同 FlatJson::getField
+    const char* value;          // expected == 1 時的值
+    bool wellFormed;            // 本體是有效的 JSON 物件（不論查詢的欄位是否可用）
+};
+
+const Case CASES[] = {
+    {"flat object", "{\"power\":true,\"mode\":\"cool\",\"temp\":24.5}", "temp", 1, "24.5", true},
+    {"whitespace", " {\r\n  \"mode\" : \"heat\" ,\n  \"fan\" : 3\n}\n", "mode", 1, "heat", true},
+    {"missing field", "{\"power\":true}", "fan", 0, nullptr, true},
+    {"empty object", "{}", "power", 0, nullptr, true},
+    {"escaped quote in value", "{\"mode\":\"c\\\"ool\"}", "mode", 1, "c\"ool", true},
+    {"key inside string value", "{\"note\":\"x\\\",\\\"temp\\\":99\",\"temp\":24}", "temp", 1, "24", true},
+    {"key in nested object", "{\"opts\":{\"temp\":30},\"temp\":24}", "temp", 1, "24", true},
+    {"only nested key", "{\"opts\":{\"temp\":30,\"list\":[1,\"]\"]}}", "temp", 0, nullptr, true},
+    {"unicode escape", "{\"mode\":\"\\u0063ool\"}", "mode", 1, "cool", true},
+    {"string too long", "{\"temp\":\"24.5000000000000001\"}", "temp", -1, nullptr, true},
+    {"number too long", "{\"temp\":24.5000000000000001}", "temp", -1, nullptr, true},
+    {"unterminated string", "{\"mode\":\"cool", "mode", -1, nullptr, false},
+    {"missing close brace", "{\"mode\":\"cool\"", "mode", -1, nullptr, false},
+    {"trailing content", "{\"temp\":24}{\"temp\":30}", "temp", -1, nullptr, false},
+    {"malformed other field", "{\"fan\":3,\"swingV\":}", "power", -1, nullptr, false},
+    {"duplicate key", "{\"temp\":24,\"temp\":25}", "temp", -1, nullptr, true},
+    {"array value", "{\"temp\":[24]}", "temp", -1, nullptr, true},
+    {"bad literal", "{\"power\":tru}", "power", -1, nullptr, false},
+    {"leading zero", "{\"temp\":024}", "temp", -1, nullptr, false},
+    {"single quotes", "{'temp':24}", "temp", -1, nullptr, false},
+    {"lone surrogate", "{\"mode\":\"\\ud83d\"}", "mode", -1, nullptr, false},
+    {"raw control char", "{\"mode\":\"co\nol\"}", "mode", -1, nullptr, false},
+    {"not an object", "[{\"temp\":24}]", "temp", -1, nullptr, false},
+};
+
+bool matches(int result, const char* value, const Case& c) {
+    if (result != c.expected) return false;
+    return result != 1 || strcmp(value, c.value) == 0;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    int legacyWrong = 0;
+
+    printf("%-26s %8s %8s\n", "case", "legacy", "flat");
+    for (const Case& c : CASES) {
+        char value[VALUE_SIZE];
+        int result = FlatJson::getField(c.body, c.field, value, sizeof(value));
+        bool pass = matches(result, value, c);
+        // 格式錯誤時，其他欄位的查詢也必須失敗；驗證函式與查詢一致
+        pass &= FlatJson::isValidObject(c.body) == c.wellFormed;
+
+        char legacyValue[VALUE_SIZE];
+        int legacy = legacyGetField(c.body, c.field, legacyValue, sizeof(legacyValue));
+        bool legacyPass = matches(legacy, legacyValue, c);
+        if (!legacyPass) legacyWrong++;
+
+        printf("%-26s %8s %8s\n", c.name, legacyPass ? "ok" : "wrong", pass ? "ok" : "FAIL");
+        ok &= pass;
+    }
+
+    const char* body = "{\"power\":true,\"mode\":\"cool\",\"temp\":24.5,\"fan\":\"auto\",\"swingV\":false,\"swingH\":true}";
+    char value[VALUE_SIZE];
+    double flatNs = nsPerCall(ITERATIONS, [&](int) { FlatJson::getField(body, "swingH", value, sizeof(value)); });
+    double legacyNs = nsPerCall(ITERATIONS, [&](int) { legacyGetField(body, "swingH", value, sizeof(value)); });
+    printf("\n%-26s %8.1f %8.1f ns/lookup（%zu bytes 本體，查詢最後一個欄位）\n", "cost", legacyNs, flatNs, strlen(body));
+
+    printf("legacy 錯誤 %d / %zu 個案例；格式錯誤與過長的值一律拒絕、不截斷: %s\n",
+           legacyWrong, sizeof(CASES) / sizeof(CASES[0]), ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
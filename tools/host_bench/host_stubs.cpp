@@ -0,0 +1,69 @@
+#include <Arduino.h>
+#include <HomeSpan.h>
+#include <atomic>
+#include <chrono>
+
+namespace HostClock {
+    unsigned long nowMs = 1;
+}
+
+unsigned long millis() {
+    return HostClock::nowMs;
+}
+
+unsigned long micros() {
+    static const auto start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+uint32_t HostEsp::getCycleCount() const {
+    static const auto start = std::chrono::steady_clock::now();
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return (uint32_t)(ns * cpuFreqMHz / 1000) + cycleOffset;
+}
+
+HostSerial Serial;
+
+void remoteWebLog(const String&) {}
+
+// 遠端調試訂閱（src/RemoteDebugger.cpp）：主機端沒有客戶端，遮罩恆為 0
+std::atomic<uint8_t> debugTopicMask{0};
+void debugPublishS21Frame(bool, const uint8_t*, size_t) {}
+void debugPublishControllerState(bool, uint8_t, float, float, uint8_t) {}
+
+SpanService* SpanService::current = nullptr;
+
+SpanService::SpanService() {
+    current = this;
+}
+
+SpanCharacteristic::SpanCharacteristic(double initial, bool isFloat)
+    : service(SpanService::current), value(initial), newValue(initial), isFloat(isFloat) {
+    if (service) service->characteristics.push_back(this);
+}
+
+namespace HostHap {
+
+bool write(std::initializer_list<Write> writes) {
+    SpanService* service = nullptr;
+    for (const Write& w : writes) {
+        w.characteristic->newValue = w.value;
+        w.characteristic->isUpdated = true;
+        service = w.characteristic->service;
+    }
+
+    bool ok = service ? service->update() : false;
+
+    for (const Write& w : writes) {
+        if (ok && w.characteristic->isUpdated) {
+            w.characteristic->value = w.characteristic->newValue;
+        }
+        w.characteristic->newValue = w.characteristic->value;
+        w.characteristic->isUpdated = false;
+    }
+    return ok;
+}
+
+}
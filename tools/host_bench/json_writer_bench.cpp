@@ -0,0 +1,357 @@
+// API JSON 輸出基準測試（主機端）
+// 比較 JsonWriter 串流輸出與舊作法（固定緩衝區 snprintf、String 串接）：
+// 每個回應的主機 CPU 時間、輸出位元組、吞吐量（bytes/us）、堆積配置次數與峰值堆積，
+// 並檢查輸出是否為合法 JSON（舊作法不轉義訊息中的引號與換行）。
+// 日誌另外比較以序號游標增量取得與 HTML 頁面的串流輸出。
+
+#include <Arduino.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/JsonWriter.h"
+#include "common/LogManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 20000;
+
+// 模擬 StreamingResponse：512 bytes 分塊送出，只計數不真的送
+struct ChunkSink {
+    static constexpr size_t CHUNK_SIZE = 512;
+    char buffer[CHUNK_SIZE];
+    size_t pos = 0;
+    size_t bytes = 0;
+    uint32_t chunks = 0;
+    std::string* capture = nullptr;
+
+    void append(const char* data, size_t len) {
+        while (len > 0) {
+            size_t n = std::min(len, CHUNK_SIZE - pos);
+            memcpy(buffer + pos, data, n);
+            pos += n;
+            data += n;
+            len -= n;
+            if (pos == CHUNK_SIZE) flush();
+        }
+    }
+
+    void flush() {
+        if (pos == 0) return;
+        if (capture) capture->append(buffer, pos);
+        bytes += pos;
+        chunks++;
+        pos = 0;
+    }
+};
+
+// 最小 JSON 語法檢查（遞迴下降）
+struct JsonValidator {
+    const char* p;
+
+    bool ws() { while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++; return true; }
+    bool literal(const char* word) {
+        size_t n = strlen(word);
+        if (strncmp(p, word, n) != 0) return false;
+        p += n;
+        return true;
+    }
+    bool string() {
+        if (*p++ != '"') return false;
+        while (*p && *p != '"') {
+            unsigned char c = (unsigned char)*p++;
+            if (c < 0x20) return false;
+            if (c == '\\') {
+                char e = *p++;
+                if (e == 'u') {
+                    for (int i = 0; i < 4; i++) if (!isxdigit((unsigned char)*p++)) return false;
+                } else if (!strchr("\"\\/bfnrt", e)) {
+                    return false;
+                }
+            }
+        }
+        return *p++ == '"';
+    }
+    bool number() {
+        const char* start = p;
+        if (*p == '-') p++;
+        while (isdigit((unsigned char)*p) || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-') p++;
+        return p > start;
+    }
+    bool value() {
+        ws();
+        switch (*p) {
+            case '{': {
+                p++; ws();
+                if (*p == '}') { p++; return true; }
+                do {
+                    ws();
+                    if (!string()) return false;
+                    ws();
+                    if (*p++ != ':') return false;
+                    if (!value()) return false;
+                    ws();
+                } while (*p == ',' && p++);
+                return *p++ == '}';
+            }
+            case '[': {
+                p++; ws();
+                if (*p == ']') { p++; return true; }
+                do {
+                    if (!value()) return false;
+                    ws();
+                } while (*p == ',' && p++);
+                return *p++ == ']';
+            }
+            case '"': return string();
+            case 't': return literal("true");
+            case 'f': return literal("false");
+            case 'n': return literal("null");
+            default: return number();
+        }
+    }
+    static bool check(const std::string& text) {
+        JsonValidator v{text.c_str()};
+        return v.value() && v.ws() && *v.p == '\0';
+    }
+};
+
+// /api/metrics 的固定測資
+struct Metrics {
+    uint32_t uptime = 86400, freeHeap = 142336, heapSize = 327680;
+    uint32_t cpuFreq = 160, flashSize = 4194304, minFreeHeap = 98304, maxAllocHeap = 65524;
+    uint32_t sketchSize = 1572864, freeSketchSpace = 1966080;
+    int rssi = -61, channel = 6;
+    const char* ip = "192.168.50.23";
+    const char* mac = "84:F7:03:12:34:56";
+    const char* hostname = "DaiSpan-Thermostat";
+    bool power = true, initialized = true, pairingActive = false;
+    int targetMode = 2;
+    float currentTemp = 26.4f, targetTemp = 25.0f;
+};
+
+// 舊作法：static char[1024] + 單一大 snprintf
+size_t legacyMetrics(const Metrics& m, std::string* capture) {
+    static char buffer[1024];
+    int written = snprintf(buffer, sizeof(buffer),
+        "{\"performance\":{\"uptime\":%u,\"freeHeap\":%u,\"heapSize\":%u,\"memoryUsage\":%.1f,"
+        "\"cpuFreq\":%u,\"flashSize\":%u,\"minFreeHeap\":%u,\"maxAllocHeap\":%u,\"sketchSize\":%u,"
+        "\"freeSketchSpace\":%u},\"network\":{\"rssi\":%d,\"ip\":\"%s\",\"mac\":\"%s\",\"channel\":%d,"
+        "\"hostname\":\"%s\"}",
+        m.uptime, m.freeHeap, m.heapSize, (float)m.freeHeap / (float)m.heapSize * 100.0f,
+        m.cpuFreq, m.flashSize, m.minFreeHeap, m.maxAllocHeap, m.sketchSize, m.freeSketchSpace,
+        m.rssi, m.ip, m.mac, m.channel, m.hostname);
+    if (written < (int)sizeof(buffer) - 200) {
+        written += snprintf(buffer + written, sizeof(buffer) - written,
+            ",\"homekit\":{\"power\":%s,\"targetMode\":%d,\"currentTemp\":%.1f,\"targetTemp\":%.1f,"
+            "\"initialized\":%s,\"pairingActive\":%s}",
+            m.power ? "true" : "false", m.targetMode, m.currentTemp, m.targetTemp,
+            m.initialized ? "true" : "false", m.pairingActive ? "true" : "false");
+    }
+    if (written < (int)sizeof(buffer) - 50) {
+        written += snprintf(buffer + written, sizeof(buffer) - written, ",\"timestamp\":%u}", m.uptime);
+    }
+    if (capture) capture->assign(buffer, written);
+    return written;
+}
+
+// 新作法：與 main.cpp /api/metrics 相同的 JsonWriter 呼叫
+size_t streamedMetrics(const Metrics& m, std::string* capture) {
+    ChunkSink sink;
+    sink.capture = capture;
+    JsonWriter<ChunkSink> json(sink);
+    json.beginObject();
+    json.beginObject("performance")
+        .field("uptime", m.uptime)
+        .field("freeHeap", m.freeHeap)
+        .field("heapSize", m.heapSize)
+        .field("memoryUsage", (float)m.freeHeap / (float)m.heapSize * 100.0f)
+        .field("cpuFreq", m.cpuFreq)
+        .field("flashSize", m.flashSize)
+        .field("minFreeHeap", m.minFreeHeap)
+        .field("maxAllocHeap", m.maxAllocHeap)
+        .field("sketchSize", m.sketchSize)
+        .field("freeSketchSpace", m.freeSketchSpace)
+        .endObject();
+    json.beginObject("network")
+        .field("rssi", m.rssi)
+        .field("ip", m.ip)
+        .field("mac", m.mac)
+        .field("channel", m.channel)
+        .field("hostname", m.hostname)
+        .endObject();
+    json.beginObject("homekit")
+        .field("power", m.power)
+        .field("targetMode", m.targetMode)
+        .field("currentTemp", m.currentTemp)
+        .field("targetTemp", m.targetTemp)
+        .field("initialized", m.initialized)
+        .field("pairingActive", m.pairingActive)
+        .endObject();
+    json.field("timestamp", m.uptime);
+    json.endObject();
+    sink.flush();
+    return sink.bytes;
+}
+
+// 舊版 LogManager 的日誌條目（元件與訊息各一個 String），以及 getLogs() 的整份複製
+struct LegacyLogEntry {
+    unsigned long timestamp;
+    LogLevel level;
+    String component;
+    String message;
+};
+
+std::vector<LegacyLogEntry> copyLogs() {
+    std::vector<LegacyLogEntry> logs;
+    logs.reserve(LOG_CAPACITY);
+    LOG_MANAGER.forEach(0, LOG_CAPACITY, [&logs](const LogEntry& e) {
+        logs.push_back({e.timestamp, e.level, e.component, e.message});
+    });
+    return logs;
+}
+
+// 舊作法：LogManager::generateLogJSON 的 String += 串接
+size_t legacyLogs(const std::vector<LegacyLogEntry>& entries, std::string* capture) {
+    String json = "{\"logs\":[";
+    bool first = true;
+    for (const auto& entry : entries) {
+        if (!first) json += ",";
+        first = false;
+        json += "{";
+        json += "\"timestamp\":" + String(entry.timestamp) + ",";
+        json += "\"level\":\"" + String(LOG_MANAGER.getLevelString(entry.level)) + "\",";
+        json += "\"component\":\"" + entry.component + "\",";
+        json += "\"message\":\"" + entry.message + "\"";
+        json += "}";
+    }
+    json += "]}";
+    if (capture) capture->assign(json.c_str(), json.length());
+    return json.length();
+}
+
+// 新作法：LogManager::writeLogJSON 串流輸出
+size_t streamedLogs(const std::vector<LegacyLogEntry>&, std::string* capture) {
+    ChunkSink sink;
+    sink.capture = capture;
+    JsonWriter<ChunkSink> json(sink);
+    LOG_MANAGER.writeLogJSON(json);
+    sink.flush();
+    return sink.bytes;
+}
+
+// 增量取得：客戶端帶上一次回應的 next 作為 since，只收到之後新增的 5 筆
+size_t cursorLogs(uint32_t since, std::string* capture) {
+    ChunkSink sink;
+    sink.capture = capture;
+    JsonWriter<ChunkSink> json(sink);
+    LOG_MANAGER.writeLogJSON(json, since);
+    sink.flush();
+    return sink.bytes;
+}
+
+// 舊 /logs 頁面：複製整個日誌緩衝區，寫進 4 KB PageBuilder 後再複製成 String
+size_t legacyLogHTML(std::string* capture) {
+    std::unique_ptr<char[]> buf(new char[4096]);
+    char* p = buf.get();
+    int rem = 4096;
+    auto append = [&](const char* fmt, auto... args) {
+        int n = snprintf(p, rem, fmt, args...);
+        if (n > 0 && n < rem) { p += n; rem -= n; }
+    };
+    append("%s", "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>日誌</title></head><body><pre>");
+    std::vector<LegacyLogEntry> logs = copyLogs();
+    size_t start = logs.size() > 20 ? logs.size() - 20 : 0;
+    for (size_t i = start; i < logs.size(); i++) {
+        const auto& e = logs[i];
+        append("[%lus] [%s] %s\n", e.timestamp / 1000, LOG_MANAGER.getLevelString(e.level), e.message.c_str());
+    }
+    append("%s", "</pre></body></html>");
+    String html(buf.get());
+    if (capture) capture->assign(html.c_str(), html.length());
+    return html.length();
+}
+
+// 新 /logs 頁面：頁首、LogManager::writeLogHTML、頁尾依序寫進分塊串流
+size_t streamedLogHTML(std::string* capture) {
+    static const char head[] = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>日誌</title></head><body><pre>";
+    static const char tail[] = "</pre></body></html>";
+    ChunkSink sink;
+    sink.capture = capture;
+    sink.append(head, sizeof(head) - 1);
+    LOG_MANAGER.writeLogHTML(sink, 0, 20);
+    sink.append(tail, sizeof(tail) - 1);
+    sink.flush();
+    return sink.bytes;
+}
+
+struct Result {
+    double nsPerResponse;
+    size_t bytes;
+    double allocsPerResponse;
+    size_t peakHeap;
+    const char* valid;
+};
+
+template <typename Fn>
+Result measure(Fn fn, bool json = true) {
+    Result result{};
+    std::string output;
+    result.bytes = fn(&output);
+    result.valid = !json ? "-" : JsonValidator::check(output) ? "yes" : "NO";
+
+    // 單一回應期間的峰值堆積（不含輸出擷取）
+    size_t baseline = liveBytes;
+    peakBytes = liveBytes.load();
+    fn(nullptr);
+    result.peakHeap = peakBytes - baseline;
+
+    fn(nullptr);  // 預熱
+    uint64_t allocsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) fn(nullptr);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    result.nsPerResponse = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+    result.allocsPerResponse = (double)(allocationCount - allocsBefore) / ITERATIONS;
+    return result;
+}
+
+void report(const char* payload, const char* method, const Result& r) {
+    printf("%-8s %-18s %7zu %10.0f %9.1f %10.2f %7zu  %s\n",
+           payload, method, r.bytes, r.nsPerResponse, r.bytes / (r.nsPerResponse / 1000.0),
+           r.allocsPerResponse, r.peakHeap, r.valid);
+}
+
+} // namespace
+
+int main() {
+    // 100 筆日誌，部分訊息含引號、反斜線、換行與中文
+    static const char* components[] = {"Main", "Thermostat", "WiFiManager", "S21"};
+    for (int i = 0; i < 100; i++) {
+        char message[96];
+        switch (i % 4) {
+            case 0: snprintf(message, sizeof(message), "溫度更新 %d.%d°C", 20 + i % 10, i % 10); break;
+            case 1: snprintf(message, sizeof(message), "SSID \"Home-%d\" 已連線", i); break;
+            case 2: snprintf(message, sizeof(message), "路徑 C:\\daispan\\%d", i); break;
+            default: snprintf(message, sizeof(message), "S21 回應逾時\n重試 %d", i % 3); break;
+        }
+        LOG_MANAGER.info(components[i % 4], message);
+    }
+    std::vector<LegacyLogEntry> entries = copyLogs();
+    Metrics metrics;
+
+    uint32_t cursor = LOG_MANAGER.getLastSeq() - 5;
+
+    printf("%-8s %-18s %7s %10s %9s %10s %7s  %s\n",
+           "payload", "method", "bytes", "ns/resp", "bytes/us", "allocs", "peak", "valid");
+    report("metrics", "snprintf[1024]", measure([&](std::string* c) { return legacyMetrics(metrics, c); }));
+    report("metrics", "JsonWriter", measure([&](std::string* c) { return streamedMetrics(metrics, c); }));
+    report("logs", "String +=", measure([&](std::string* c) { return legacyLogs(entries, c); }));
+    report("logs", "JsonWriter", measure([&](std::string* c) { return streamedLogs(entries, c); }));
+    report("logs", "since=next-5", measure([&](std::string* c) { return cursorLogs(cursor, c); }));
+    report("logs", "PageBuilder(4096)", measure([&](std::string* c) { return legacyLogHTML(c); }, false));
+    report("logs", "writeLogHTML", measure([&](std::string* c) { return streamedLogHTML(c); }, false));
+    return 0;
+}
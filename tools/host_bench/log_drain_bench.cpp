@@ -0,0 +1,189 @@
+// 非同步日誌排空基準測試（主機端）
+// 模擬 115200 baud 的 UART（128 bytes FIFO、每 byte 約 87 us，FIFO 滿時寫入端睡眠等待），
+// 主迴圈每 10 ms 執行一次 S21 週期：約 300 us 的計算加上 INFO 或 VERBOSE 級別的日誌。
+// 比較：
+//   sync  - 舊版宏：Serial.printf + snprintf 兩次格式化，直接在呼叫端寫 UART；
+//   async - debugLog()：格式化一次放入 LogDrain，由另一個執行緒（韌體為低優先級任務）寫 UART。
+// 報告主迴圈單次耗時的 p50 / p99 / max、寫出與因佇列滿而丟棄的行數，
+// 以及主迴圈以 forEachMessage() 轉發（遠端調試路徑）讀到的完整訊息數。
+
+#include <Arduino.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/Debug.h"
+#include "common/LogDrain.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int ITERATIONS = 300;
+constexpr auto LOOP_PERIOD = std::chrono::milliseconds(10);
+constexpr auto S21_WORK = std::chrono::microseconds(300);
+
+class SimulatedUart {
+public:
+    static constexpr size_t FIFO_SIZE = 128;
+    static constexpr double US_PER_BYTE = 1e6 / (115200 / 10);
+
+    void write(const char* data, size_t length) {
+        (void)data;
+        while (length > 0) {
+            Clock::time_point now = Clock::now();
+            if (emptyAt < now) emptyAt = now;
+            double backlogUs = std::chrono::duration<double, std::micro>(emptyAt - now).count();
+            size_t queued = (size_t)(backlogUs / US_PER_BYTE);
+            size_t space = queued < FIFO_SIZE ? FIFO_SIZE - queued : 0;
+            size_t wanted = std::min(length, FIFO_SIZE);
+            if (space < wanted) {
+                // 驅動阻塞到 FIFO 有足夠空間
+                std::this_thread::sleep_for(std::chrono::microseconds((long)((wanted - space) * US_PER_BYTE)));
+                continue;
+            }
+            emptyAt += std::chrono::microseconds((long)(wanted * US_PER_BYTE));
+            length -= wanted;
+            bytes += wanted;
+        }
+    }
+
+    size_t bytes = 0;
+    Clock::time_point emptyAt = Clock::now();
+};
+
+SimulatedUart uart;
+
+// 舊版 DEBUG_*_PRINT：Serial.printf 直接寫 UART，再 snprintf 一次給 remoteWebLog
+#define LEGACY_PRINT(...) do { \
+    char line[256]; \
+    int n = snprintf(line, sizeof(line), __VA_ARGS__); \
+    uart.write(line, n); \
+    static char buffer[DEBUG_BUFFER_SIZE]; \
+    snprintf(buffer, DEBUG_BUFFER_SIZE, __VA_ARGS__); \
+    asm volatile("" : : "r"(buffer) : "memory"); \
+} while (0)
+
+#define ASYNC_PRINT(...) debugLog(DEBUG_INFO, __VA_ARGS__)
+
+// 一次 S21 週期的日誌：INFO 為狀態摘要；VERBOSE 另有每個命令的收發封包
+#define S21_CYCLE_LOGS(PRINT, verbose, i) do { \
+    if (verbose) { \
+        for (int c = 0; c < 3; c++) { \
+            PRINT("[S21] 發送命令: F%c 02 46 %02X 03\n", '1' + c, 0x31 + c); \
+            PRINT("[S21] 收到回應: 02 47 %02X 30 31 32 33 %02X 03 (%d ms)\n", 0x31 + c, (i + c) & 0xFF, 40 + c); \
+        } \
+    } \
+    PRINT("[Controller] 狀態同步完成 - 電源:%d 模式:%d 溫度:%.1f°C 風速:%d\n", 1, 2, 24.5f + (i % 4) * 0.5f, 3); \
+} while (0)
+
+void spin(Clock::duration d) {
+    Clock::time_point until = Clock::now() + d;
+    while (Clock::now() < until) {}
+}
+
+struct Result {
+    double p50Us, p99Us, maxUs;
+    uint32_t dropped;
+    size_t forwarded = 0;       // 遠端調試路徑（forEachMessage）讀到的完整訊息
+    size_t malformed = 0;
+};
+
+// RemoteDebugger::loop() 的轉發：每次迴圈以游標讀取新訊息，檢查每筆都完整
+uint32_t forwardCursor = 0;
+void forward(Result& r) {
+    forwardCursor = LOG_DRAIN.forEachMessage(forwardCursor, 8, [&r](const char* text, size_t length, uint8_t) {
+        r.forwarded++;
+        if (length < 2 || text[0] != '[' || text[length - 1] != '\n' || strlen(text) != length) r.malformed++;
+    });
+}
+
+template <typename Cycle>
+Result runLoop(Cycle cycle, bool forwarding = false) {
+    Result r{};
+    std::vector<double> times;
+    times.reserve(ITERATIONS);
+    Clock::time_point next = Clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        Clock::time_point start = Clock::now();
+        spin(S21_WORK);
+        cycle(i);
+        times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        if (forwarding) forward(r);
+        next += LOOP_PERIOD;
+        std::this_thread::sleep_until(next);   // 韌體的 loop() 在這裡讓出 CPU
+    }
+    if (forwarding) forward(r);
+    std::sort(times.begin(), times.end());
+    r.p50Us = times[times.size() / 2];
+    r.p99Us = times[times.size() * 99 / 100];
+    r.maxUs = times.back();
+    return r;
+}
+
+Result runSync(bool verbose) {
+    uart = SimulatedUart();
+    Result r = runLoop([verbose](int i) { S21_CYCLE_LOGS(LEGACY_PRINT, verbose, i); });
+    r.dropped = 0;
+    return r;
+}
+
+Result runAsync(bool verbose) {
+    uart = SimulatedUart();
+    std::atomic<bool> done{false};
+    // 韌體中的 logDrain 任務
+    std::thread drainer([&done]() {
+        while (true) {
+            size_t drained = LOG_DRAIN.drain([](const char* data, size_t length) { uart.write(data, length); });
+            if (drained == 0) {
+                if (done.load()) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+    uint32_t droppedBefore = LOG_DRAIN.getDropped();
+    forwardCursor = LOG_DRAIN.getHead();
+    Result r = runLoop([verbose](int i) { S21_CYCLE_LOGS(ASYNC_PRINT, verbose, i); }, true);
+    done.store(true);
+    drainer.join();
+    r.dropped = LOG_DRAIN.getDropped() - droppedBefore;
+    return r;
+}
+
+void report(const char* name, const Result& r, size_t expectedLines) {
+    printf("%-16s %9.0f %9.0f %9.0f %7zu %7zu %7u %9zu\n",
+           name, r.p50Us, r.p99Us, r.maxUs, expectedLines, expectedLines - r.dropped, r.dropped, r.forwarded);
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    printf("主迴圈週期 %lld ms，S21 計算 %lld us，UART 115200 baud / FIFO %zu bytes\n\n",
+           (long long)LOOP_PERIOD.count(), (long long)S21_WORK.count(), SimulatedUart::FIFO_SIZE);
+    printf("%-16s %9s %9s %9s %7s %7s %7s %9s\n",
+           "logging", "p50 us", "p99 us", "max us", "lines", "written", "dropped", "forwarded");
+
+    const size_t infoLines = ITERATIONS;
+    const size_t verboseLines = ITERATIONS * 7;
+
+    Result syncInfo = runSync(false);
+    report("INFO sync", syncInfo, infoLines);
+    Result asyncInfo = runAsync(false);
+    report("INFO async", asyncInfo, infoLines);
+    Result syncVerbose = runSync(true);
+    report("VERBOSE sync", syncVerbose, verboseLines);
+    Result asyncVerbose = runAsync(true);
+    report("VERBOSE async", asyncVerbose, verboseLines);
+
+    // 非同步路徑的呼叫端不得被 UART 阻塞；INFO 的流量在 UART 頻寬內，不應丟棄
+    ok &= asyncVerbose.p99Us < syncVerbose.p99Us / 4;
+    ok &= asyncInfo.dropped == 0;
+    // 遠端調試轉發讀到的訊息都必須完整；INFO 每行都應轉發到
+    ok &= asyncInfo.forwarded == infoLines && asyncInfo.malformed == 0 && asyncVerbose.malformed == 0;
+
+    printf("\n呼叫端不被 UART 阻塞、INFO 無丟棄且轉發訊息完整: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
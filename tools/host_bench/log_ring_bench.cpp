@@ -0,0 +1,177 @@
+// LogManager 環形緩衝基準測試（主機端）
+// 1. 單執行緒：比較舊作法（vector<LogEntry> + 兩個 String、滿了 erase(begin)）與環形緩衝的
+//    每筆日誌 CPU 時間與堆積配置次數；穩態寫入必須為 0 次配置，否則回傳失敗。
+// 2. 多生產者：數個執行緒同時寫入、一個讀取執行緒持續以 forEach 走訪，
+//    檢查讀到的每筆訊息內容完整（未被撕裂）、序號遞增，且序號總數與寫入次數相符。
+
+#include <Arduino.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/LogManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 200000;
+constexpr int PRODUCERS = 4;
+constexpr uint32_t LOGS_PER_PRODUCER = 200000;
+
+// 舊版 LogManager 的緩衝方式
+struct LegacyLogEntry {
+    unsigned long timestamp;
+    LogLevel level;
+    String component;
+    String message;
+
+    LegacyLogEntry(LogLevel lvl, const String& comp, const String& msg) :
+        timestamp(millis()), level(lvl), component(comp), message(msg) {}
+};
+
+struct LegacyLogBuffer {
+    std::vector<LegacyLogEntry> logBuffer;
+    size_t maxLogEntries = LOG_CAPACITY;
+
+    LegacyLogBuffer() { logBuffer.reserve(maxLogEntries); }
+
+    void log(LogLevel level, const String& component, const String& message) {
+        LegacyLogEntry entry(level, component, message);
+        if (logBuffer.size() >= maxLogEntries) logBuffer.erase(logBuffer.begin());
+        logBuffer.push_back(entry);
+    }
+};
+
+struct Result {
+    double nsPerLog;
+    double allocsPerLog;
+};
+
+template <typename Fn>
+Result measure(Fn fn) {
+    for (int i = 0; i < 1000; i++) fn(i);   // 預熱：填滿緩衝、登記元件名稱
+    uint64_t allocsBefore = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Result r;
+    r.nsPerLog = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+    r.allocsPerLog = (double)(allocationCount.load() - allocsBefore) / ITERATIONS;
+    return r;
+}
+
+void report(const char* name, const Result& r) {
+    printf("%-28s %9.1f %8.2f\n", name, r.nsPerLog, r.allocsPerLog);
+}
+
+// 訊息內容由生產者編號與計數決定，讀取端可重算並比對
+int formatMessage(char* out, size_t size, int producer, uint32_t n) {
+    char fill = (char)('a' + (n + producer) % 26);
+    return snprintf(out, size, "p%d n%07u %c%c%c%c%c%c%c%c%c%c%c%c%c%c%c%c 溫度更新", producer, n,
+                    fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill);
+}
+
+struct ConcurrencyResult {
+    uint64_t read = 0;
+    uint64_t torn = 0;
+    uint64_t outOfOrder = 0;
+    uint32_t lastSeq = 0;
+};
+
+ConcurrencyResult runConcurrent() {
+    LOG_MANAGER.clearLogs();
+    uint32_t firstSeq = LOG_MANAGER.getLastSeq() + 1;
+    std::atomic<bool> done{false};
+    ConcurrencyResult result;
+
+    std::thread reader([&]() {
+        char expected[LOG_MESSAGE_SIZE];
+        while (!done.load()) {
+            uint32_t previous = 0;
+            LOG_MANAGER.forEach(0, LOG_CAPACITY, [&](const LogEntry& e) {
+                int producer;
+                unsigned n;
+                result.read++;
+                if (e.seq <= previous) result.outOfOrder++;
+                previous = e.seq;
+                if (sscanf(e.message, "p%d n%u", &producer, &n) != 2 ||
+                    (formatMessage(expected, sizeof(expected), producer, n), strcmp(expected, e.message) != 0) ||
+                    strcmp(e.component, "Producer") != 0) {
+                    result.torn++;
+                }
+            });
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([p]() {
+            char message[LOG_MESSAGE_SIZE];
+            for (uint32_t n = 0; n < LOGS_PER_PRODUCER; n++) {
+                if (n % 2) {
+                    formatMessage(message, sizeof(message), p, n);
+                    LOG_MANAGER.info("Producer", message);
+                } else {
+                    char fill = (char)('a' + (n + p) % 26);
+                    LOG_MANAGER.logf(LogLevel::INFO, "Producer", "p%d n%07u %c%c%c%c%c%c%c%c%c%c%c%c%c%c%c%c 溫度更新", p, n,
+                                     fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill, fill);
+                }
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    done.store(true);
+    reader.join();
+
+    result.lastSeq = LOG_MANAGER.getLastSeq() - firstSeq + 1;
+    return result;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    LOG_MANAGER.configure(LogLevel::INFO, false, true);   // 只量測緩衝，不輸出串口
+
+    static const char* components[] = {"Main", "Thermostat", "WiFiManager", "S21"};
+    static const char* messages[] = {"溫度更新 24.5°C -> 25.0°C", "SSID \"Home\" 已連線，RSSI -61 dBm",
+                                     "S21 回應逾時，重試第 2 次", "HomeKit 配對狀態已變更"};
+    String componentStrings[4], messageStrings[4];
+    for (int i = 0; i < 4; i++) {
+        componentStrings[i] = components[i];
+        messageStrings[i] = messages[i];
+    }
+
+    printf("%-28s %9s %8s\n", "method", "ns/log", "allocs");
+    LegacyLogBuffer legacy;
+    report("vector + String (legacy)", measure([&](int i) {
+        legacy.log(LogLevel::INFO, components[i % 4], messages[i % 4]);
+    }));
+
+    Result ring = measure([&](int i) { LOG_MANAGER.info(components[i % 4], messages[i % 4]); });
+    report("ring const char*", ring);
+    ok &= ring.allocsPerLog == 0;
+
+    Result ringString = measure([&](int i) { LOG_MANAGER.info(componentStrings[i % 4], messageStrings[i % 4]); });
+    report("ring String", ringString);
+    ok &= ringString.allocsPerLog == 0;
+
+    Result ringFormat = measure([&](int i) {
+        LOG_MANAGER.logf(LogLevel::INFO, components[i % 4], "S21 命令 %d 完成，耗時 %d ms", i, i % 200);
+    });
+    report("ring logf", ringFormat);
+    ok &= ringFormat.allocsPerLog == 0;
+
+    ConcurrencyResult concurrent = runConcurrent();
+    uint32_t expectedLogs = PRODUCERS * LOGS_PER_PRODUCER;
+    printf("\n%d 個生產者 × %u 筆：序號 %u/%u，讀取 %llu 筆，撕裂 %llu，亂序 %llu\n",
+           PRODUCERS, LOGS_PER_PRODUCER, concurrent.lastSeq, expectedLogs,
+           (unsigned long long)concurrent.read, (unsigned long long)concurrent.torn,
+           (unsigned long long)concurrent.outOfOrder);
+    ok &= concurrent.lastSeq == expectedLogs && concurrent.torn == 0 && concurrent.outOfOrder == 0;
+
+    printf("穩態零配置且無撕裂: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
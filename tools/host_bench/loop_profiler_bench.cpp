@@ -0,0 +1,163 @@
+// 主迴圈階段分析測試（主機端，直接驅動 LoopProfiler）
+// 1. 每個階段 Scope 與每輪 beginLoop() 的成本（主機以 steady_clock 模擬週期計數器）；
+// 2. 直方圖分桶與分位數：已知分佈的 p50 / p99 落在正確的桶上界；
+// 3. 間隔抖動：固定間隔時接近 0，交替 0.5 / 1.5 ms 時接近 0.5 ms；
+// 4. SLO：某一輪 web 階段卡住 60 ms、另一輪未計時的部分卡住 80 ms，違規分別歸給 web 與 other，
+//    Metrics 計數器同步增加，最長間隔與最耗時階段正確；
+// 5. /api/perf/loop 的 JSON 輸出。
+// 模擬的耗時以 ESP.cycleOffset 推進週期計數器，不實際等待。
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+
+#include "common/LoopProfiler.h"
+
+namespace {
+
+constexpr int ITERATIONS = 1000000;
+
+struct StringSink {
+    std::string text;
+    void append(const char* data, size_t len) { text.append(data, len); }
+};
+
+uint32_t usToCycles(uint32_t us) {
+    return us * ESP.getCpuFreqMHz();
+}
+
+void elapse(uint32_t us) {
+    ESP.cycleOffset += usToCycles(us);
+}
+
+// 一輪模擬主迴圈：與 SystemManager::processMainLoop 相同的階段
+void simulatedLoop(LoopProfiler& profiler, uint32_t webUs, uint32_t otherUs) {
+    profiler.beginLoop();
+    {
+        LoopProfiler::Scope phase(profiler, LoopPhase::HomeSpan);
+        elapse(300);
+    }
+    {
+        LoopProfiler::Scope phase(profiler, LoopPhase::OTA);
+        elapse(20);
+    }
+    {
+        LoopProfiler::Scope phase(profiler, LoopPhase::Web);
+        elapse(webUs);
+    }
+    {
+        LoopProfiler::Scope phase(profiler, LoopPhase::Controller);
+        elapse(150);
+    }
+    elapse(otherUs);
+}
+
+bool near(float value, float expected, float tolerance) {
+    return fabsf(value - expected) <= tolerance;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // 1. 成本
+    {
+        LoopProfiler profiler;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; i++) {
+            LoopProfiler::Scope phase(profiler, LoopPhase::HomeSpan);
+        }
+        double scopeNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; i++) profiler.beginLoop();
+        double loopNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+        printf("%-26s %9s\n", "LoopProfiler", "ns/call");
+        printf("%-26s %9.1f\n", "Scope (host clock)", scopeNs);
+        printf("%-26s %9.1f\n\n", "beginLoop (host clock)", loopNs);
+        ok &= profiler.getPhase(LoopPhase::HomeSpan).histogram.count == (uint32_t)ITERATIONS &&
+              profiler.getPeriod().count == (uint32_t)ITERATIONS - 1;
+    }
+
+    // 2. 分桶與分位數
+    {
+        LoopProfiler::CycleHistogram h{};
+        for (int i = 0; i < 98; i++) h.observe(3000);       // 桶 [2048, 4096)
+        h.observe(100000);                                  // 桶 [65536, 131072)
+        h.observe(500);                                     // 桶 0
+        bool buckets = LoopProfiler::CycleHistogram::bucketOf(1023) == 0 &&
+                       LoopProfiler::CycleHistogram::bucketOf(1024) == 1 &&
+                       LoopProfiler::CycleHistogram::bucketOf(0xFFFFFFFFu) == LoopProfiler::CycleHistogram::BUCKETS - 1 &&
+                       h.buckets[2] == 98 && h.buckets[7] == 1 && h.buckets[0] == 1;
+        bool quantiles = h.quantile(0.5f) == 4096 && h.quantile(0.99f) == 4096 && h.quantile(1.0f) == 100000;
+        printf("分桶與分位數正確: %s（p50 %u、p99 %u、max %u 週期）\n", buckets && quantiles ? "yes" : "NO",
+               h.quantile(0.5f), h.quantile(0.99f), h.max);
+        ok &= buckets && quantiles;
+    }
+
+    // 3. 抖動
+    {
+        LoopProfiler steady, alternating;
+        for (int i = 0; i < 2000; i++) {
+            steady.beginLoop();
+            elapse(1000);
+        }
+        for (int i = 0; i < 2000; i++) {
+            alternating.beginLoop();
+            elapse(i % 2 ? 1500 : 500);
+        }
+        float mhz = ESP.getCpuFreqMHz();
+        float steadyUs = steady.getJitterCycles() / mhz;
+        float alternatingUs = alternating.getJitterCycles() / mhz;
+        bool jitter = steadyUs < 20 && near(alternatingUs, 500, 50);
+        printf("抖動：固定間隔 %.1f µs、交替 0.5/1.5 ms %.1f µs: %s\n", steadyUs, alternatingUs, jitter ? "yes" : "NO");
+        ok &= jitter;
+    }
+
+    // 4. SLO 違規歸屬
+    {
+        LoopProfiler profiler;
+        uint32_t metricBefore = Metrics::loopSloBreaches.get();
+        for (int i = 0; i < 1000; i++) {
+            uint32_t webUs = i == 300 ? 60000 : 50;
+            uint32_t otherUs = i == 700 ? 80000 : 100;
+            simulatedLoop(profiler, webUs, otherUs);
+        }
+        profiler.beginLoop();
+
+        bool attributed = profiler.getBreaches() == 2 &&
+                          profiler.getPhase(LoopPhase::Web).breaches == 1 &&
+                          profiler.getPhase(LoopPhase::Other).breaches == 1 &&
+                          Metrics::loopSloBreaches.get() - metricBefore == 2 &&
+                          profiler.getWorstGapPhase() == LoopPhase::Other &&
+                          near(profiler.getWorstGapCycles() / (float)ESP.getCpuFreqMHz(), 80520, 500);
+        bool histogram = profiler.getPhase(LoopPhase::Web).histogram.count == 1000 &&
+                         profiler.getPhase(LoopPhase::Web).histogram.quantile(0.99f) < usToCycles(100) &&
+                         profiler.getPhase(LoopPhase::Web).histogram.max >= usToCycles(60000);
+        printf("SLO 違規 %u 次，分別歸給 web / other，最長間隔 %.1f ms（%s）: %s\n", profiler.getBreaches(),
+               profiler.getWorstGapCycles() / (float)ESP.getCpuFreqMHz() / 1000,
+               LOOP_PHASE_NAMES[(uint8_t)profiler.getWorstGapPhase()], attributed && histogram ? "yes" : "NO");
+        ok &= attributed && histogram;
+
+        // 5. JSON
+        StringSink sink;
+        JsonWriter<StringSink> json(sink);
+        profiler.writeJSON(json);
+        const std::string& text = sink.text;
+        bool fields = text.compare(0, 10, "{\"cpuMHz\":") == 0 && text.back() == '}' &&
+                      text.find("\"slo\":{\"gapUs\":50000,\"breaches\":2,") != std::string::npos &&
+                      text.find("\"worstGapPhase\":\"other\"") != std::string::npos &&
+                      text.find("{\"name\":\"web\",\"count\":1000,") != std::string::npos &&
+                      text.find("\"bucketBounds\":[1024,2048,") != std::string::npos;
+        printf("JSON 輸出 %zu bytes，欄位正確: %s\n", text.size(), fields ? "yes" : "NO");
+        if (!fields) printf("%.600s\n", text.c_str());
+        ok &= fields;
+    }
+
+    printf("主迴圈階段分析與 SLO 歸屬正確: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
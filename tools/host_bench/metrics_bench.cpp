@@ -0,0 +1,221 @@
+// 指標註冊表基準測試（主機端）
+// 量測 Counter/Gauge/Histogram 更新成本（單執行緒與兩個執行緒搶同一個計數器），
+// 以及數百個時間序列的 OpenMetrics 輸出時間、位元組與堆積配置次數，並檢查輸出格式。
+
+#include <Arduino.h>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/Metrics.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int UPDATE_ITERATIONS = 10000000;
+constexpr int RENDER_ITERATIONS = 2000;
+
+constexpr int COUNTER_FAMILIES = 50;   // 每個 family 3 個標籤值
+constexpr int GAUGES = 100;
+constexpr int HISTOGRAMS = 50;         // 每個 8 桶 + Inf + sum + count
+
+const uint32_t BOUNDS[] = {1, 5, 10, 25, 50, 100, 250, 1000};
+
+// 模擬 StreamingResponse：512 bytes 分塊送出，只計數不真的送
+struct ChunkSink {
+    static constexpr size_t CHUNK_SIZE = 512;
+    char buffer[CHUNK_SIZE];
+    size_t pos = 0;
+    size_t bytes = 0;
+    std::string* capture = nullptr;
+
+    void append(const char* data, size_t len) {
+        while (len > 0) {
+            size_t n = std::min(len, CHUNK_SIZE - pos);
+            memcpy(buffer + pos, data, n);
+            pos += n;
+            data += n;
+            len -= n;
+            if (pos == CHUNK_SIZE) flush();
+        }
+    }
+
+    void flush() {
+        if (pos == 0) return;
+        if (capture) capture->append(buffer, pos);
+        bytes += pos;
+        pos = 0;
+    }
+};
+
+// 合成註冊表：名稱與指標存放在不會搬移的容器中
+struct SyntheticRegistry {
+    std::deque<std::string> names;
+    std::deque<Counter> counters;
+    std::deque<Gauge> gauges;
+    std::deque<Histogram> histograms;
+    std::vector<MetricEntry> entries;
+    size_t series = 0;
+
+    SyntheticRegistry() {
+        static const char* LABELS[] = {"result=\"ok\"", "result=\"timeout\"", "result=\"error\""};
+        for (int f = 0; f < COUNTER_FAMILIES; f++) {
+            names.push_back("bench_requests_" + std::to_string(f));
+            for (const char* label : LABELS) {
+                counters.emplace_back();
+                entries.push_back({names.back().c_str(), label, "合成計數器", MetricType::Counter, &counters.back()});
+                series++;
+            }
+        }
+        for (int g = 0; g < GAUGES; g++) {
+            names.push_back("bench_level_" + std::to_string(g));
+            gauges.emplace_back();
+            entries.push_back({names.back().c_str(), nullptr, "合成量測值", MetricType::Gauge, &gauges.back()});
+            series++;
+        }
+        for (int h = 0; h < HISTOGRAMS; h++) {
+            names.push_back("bench_latency_ms_" + std::to_string(h));
+            histograms.emplace_back(BOUNDS);
+            entries.push_back({names.back().c_str(), nullptr, "合成直方圖", MetricType::Histogram, &histograms.back()});
+            series += sizeof(BOUNDS) / sizeof(BOUNDS[0]) + 3;
+        }
+
+        // 填入非零值，讓輸出長度接近實際
+        uint32_t seed = 1;
+        for (auto& c : counters) c.inc(seed = seed * 1103515245 + 12345);
+        for (auto& g : gauges) g.set((float)(seed = seed * 1103515245 + 12345) / 1e6f);
+        for (auto& h : histograms) {
+            for (int i = 0; i < 100; i++) h.observe((seed = seed * 1103515245 + 12345) % 1500);
+        }
+    }
+};
+
+// OpenMetrics 格式檢查：每個樣本行為「名稱[{標籤}] 數值」，且以 # EOF 結尾
+bool validOpenMetrics(const std::string& text) {
+    if (text.size() < 6 || text.compare(text.size() - 6, 6, "# EOF\n") != 0) return false;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) return false;
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+        if (line.empty()) return false;
+        if (line[0] == '#') continue;
+        size_t space = line.rfind(' ');
+        if (space == std::string::npos || space == 0) return false;
+        std::string value = line.substr(space + 1);
+        if (value != "NaN" && value != "+Inf" && value != "-Inf") {
+            char* parsed = nullptr;
+            strtod(value.c_str(), &parsed);
+            if (*parsed != '\0') return false;
+        }
+        size_t brace = line.find('{');
+        if (brace != std::string::npos && line[space - 1] != '}') return false;
+    }
+    return true;
+}
+
+template <typename Fn>
+double nsPerOp(int iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations;
+}
+
+void reportUpdate(const char* name, double ns) {
+    printf("%-28s %8.2f ns/op\n", name, ns);
+}
+
+struct RenderResult {
+    double usPerRender;
+    size_t bytes;
+    double allocsPerRender;
+    bool valid;
+};
+
+RenderResult measureRender(const MetricEntry* entries, size_t count) {
+    RenderResult result{};
+    std::string output;
+    {
+        ChunkSink sink;
+        sink.capture = &output;
+        renderOpenMetrics(sink, entries, count);
+        sink.flush();
+        result.bytes = sink.bytes;
+    }
+    result.valid = validOpenMetrics(output);
+
+    uint64_t allocsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RENDER_ITERATIONS; i++) {
+        ChunkSink sink;
+        renderOpenMetrics(sink, entries, count);
+        sink.flush();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    result.usPerRender = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 1000.0 / RENDER_ITERATIONS;
+    result.allocsPerRender = (double)(allocationCount - allocsBefore) / RENDER_ITERATIONS;
+    return result;
+}
+
+void reportRender(const char* name, size_t entries, size_t series, const RenderResult& r) {
+    printf("%-12s %7zu %7zu %8zu %10.1f %9.1f %8.2f  %s\n",
+           name, entries, series, r.bytes, r.usPerRender, r.bytes / r.usPerRender,
+           r.allocsPerRender, r.valid ? "yes" : "NO");
+}
+
+} // namespace
+
+int main() {
+    SyntheticRegistry registry;
+
+    printf("== 更新成本 ==\n");
+    Counter& hot = registry.counters.front();
+    reportUpdate("Counter::inc", nsPerOp(UPDATE_ITERATIONS, [&](int) { hot.inc(); }));
+    size_t counterCount = registry.counters.size();
+    reportUpdate("Counter::inc (150 series)", nsPerOp(UPDATE_ITERATIONS, [&](int i) {
+        registry.counters[i % counterCount].inc();
+    }));
+    Gauge& gauge = registry.gauges.front();
+    reportUpdate("Gauge::set", nsPerOp(UPDATE_ITERATIONS, [&](int i) { gauge.set((float)i); }));
+    Histogram& histogram = registry.histograms.front();
+    reportUpdate("Histogram::observe", nsPerOp(UPDATE_ITERATIONS, [&](int i) {
+        histogram.observe((uint32_t)i & 1023);
+    }));
+
+    // 兩個執行緒同時更新同一個計數器（Web 任務與主迴圈）
+    {
+        Counter shared;
+        auto start = std::chrono::steady_clock::now();
+        std::thread other([&] { for (int i = 0; i < UPDATE_ITERATIONS; i++) shared.inc(); });
+        for (int i = 0; i < UPDATE_ITERATIONS; i++) shared.inc();
+        other.join();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        reportUpdate("Counter::inc (2 threads)",
+                     (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / UPDATE_ITERATIONS);
+        if (shared.get() != 2u * UPDATE_ITERATIONS) {
+            printf("計數遺失：%u != %u\n", shared.get(), 2u * UPDATE_ITERATIONS);
+            return 1;
+        }
+    }
+
+    printf("\n== OpenMetrics 輸出 ==\n");
+    printf("%-12s %7s %7s %8s %10s %9s %8s  %s\n",
+           "registry", "entries", "series", "bytes", "us/render", "bytes/us", "allocs", "valid");
+    reportRender("synthetic", registry.entries.size(), registry.series,
+                 measureRender(registry.entries.data(), registry.entries.size()));
+
+    size_t firmwareSeries = 0;
+    for (size_t i = 0; i < Metrics::getEntryCount(); i++) {
+        const MetricEntry& e = Metrics::getEntries()[i];
+        firmwareSeries += e.type == MetricType::Histogram
+            ? static_cast<const Histogram*>(e.metric)->getBucketCount() + 3 : 1;
+    }
+    reportRender("firmware", Metrics::getEntryCount(), firmwareSeries,
+                 measureRender(Metrics::getEntries(), Metrics::getEntryCount()));
+    return 0;
+}
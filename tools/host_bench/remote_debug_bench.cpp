@@ -0,0 +1,293 @@
+// 遠端調試 WebSocket 廣播基準測試（主機端）
+// 3 個客戶端連線（2 個正常、1 個只有 4 KB/s 的慢速客戶端），主迴圈每 10 ms 執行一次約 300 us 的 S21 週期，
+// 並開啟 VERBOSE 級別的 S21 追蹤（每週期 7 行），比較：
+//   legacy  - 原本的 logSerial()：每行組出時間戳 String、放入 50 筆 vector、序列化成 JSON String，
+//             再逐一同步送給每個客戶端（送出緩衝滿時阻塞到寫得進去）；
+//   batched - DebugFanout：每行只序列化一次到固定緩衝，複製進每個客戶端的有界佇列，
+//             主迴圈在 socket 可寫時才把多個事件合併成一個訊框送出，佇列滿時丟棄最舊的事件。
+// 模擬的 socket 有 5744 bytes 的送出緩衝（lwIP TCP_SND_BUF），依各自的頻寬排空；
+// select() 可寫的條件是緩衝有一半空間（TCP_SNDLOWAT）。
+// 報告主迴圈單次耗時的 p50 / p99 / max、每個事件的堆積配置次數，以及各客戶端收到與被丟棄的事件數。
+// 另外以隨機操作對照 std::deque，檢查 MessageRing 的繞回與丟棄最舊邏輯。
+
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/Debug.h"
+#include "common/DebugFanout.h"
+#include "common/JsonWriter.h"
+#include "BenchUtil.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int ITERATIONS = 300;
+constexpr int LEGACY_ITERATIONS = 30;       // 舊路徑每輪被慢速客戶端拖住約 190 ms，只跑較少輪
+constexpr auto LOOP_PERIOD = std::chrono::milliseconds(10);
+constexpr auto S21_WORK = std::chrono::microseconds(300);
+constexpr int LINES_PER_CYCLE = 7;
+constexpr uint8_t CLIENTS = 3;
+constexpr size_t LEGACY_HISTORY = 50;
+
+class SimulatedSocket {
+public:
+    static constexpr size_t SEND_BUFFER = 5744;
+
+    explicit SimulatedSocket(double bytesPerSecond) : usPerByte(1e6 / bytesPerSecond) {}
+
+    size_t queued() {
+        Clock::time_point now = Clock::now();
+        if (emptyAt < now) emptyAt = now;
+        return (size_t)(std::chrono::duration<double, std::micro>(emptyAt - now).count() / usPerByte);
+    }
+
+    bool writable() { return SEND_BUFFER - std::min(queued(), SEND_BUFFER) >= SEND_BUFFER / 2; }
+
+    // 與 lwIP 的阻塞 write 相同：送出緩衝不夠時等到排空足夠的空間
+    void write(size_t length) {
+        while (length > 0) {
+            size_t space = SEND_BUFFER - std::min(queued(), SEND_BUFFER);
+            size_t chunk = std::min(length, SEND_BUFFER / 2);
+            if (space < chunk) {
+                std::this_thread::sleep_for(std::chrono::microseconds((long)((chunk - space) * usPerByte)));
+                continue;
+            }
+            emptyAt += std::chrono::microseconds((long)(chunk * usPerByte));
+            length -= chunk;
+            bytes += chunk;
+        }
+    }
+
+    double usPerByte;
+    Clock::time_point emptyAt = Clock::now();
+    size_t bytes = 0;
+    uint32_t events = 0;
+    uint32_t dropped = 0;
+    uint32_t malformed = 0;
+};
+
+std::vector<SimulatedSocket> makeSockets() {
+    return {SimulatedSocket(1e6), SimulatedSocket(1e6), SimulatedSocket(4096)};
+}
+
+unsigned long nowMs() {
+    static const Clock::time_point start = Clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+// 一次 S21 週期的 VERBOSE 追蹤（與 log_drain_bench 相同）
+template <typename Emit>
+void s21Cycle(int i, Emit emit) {
+    char line[256];
+    for (int c = 0; c < 3; c++) {
+        snprintf(line, sizeof(line), "[S21] 發送命令: F%c 02 46 %02X 03\n", '1' + c, 0x31 + c);
+        emit(line);
+        snprintf(line, sizeof(line), "[S21] 收到回應: 02 47 %02X 30 31 32 33 %02X 03 (%d ms)\n",
+                 0x31 + c, (i + c) & 0xFF, 40 + c);
+        emit(line);
+    }
+    snprintf(line, sizeof(line), "[Controller] 狀態同步完成 - 電源:%d 模式:%d 溫度:%.1f°C 風速:%d\n",
+             1, 2, 24.5f + (i % 4) * 0.5f, 3);
+    emit(line);
+}
+
+void spin(Clock::duration d) {
+    Clock::time_point until = Clock::now() + d;
+    while (Clock::now() < until) {}
+}
+
+struct Result {
+    double p50Us, p99Us, maxUs;
+    double allocsPerEvent;
+    uint32_t frames = 0;
+};
+
+template <typename Cycle, typename After>
+Result runLoop(int iterations, Cycle cycle, After after) {
+    Result r{};
+    std::vector<double> times;
+    times.reserve(iterations);
+    uint64_t allocsBefore = allocationCount;
+    Clock::time_point next = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        Clock::time_point start = Clock::now();
+        spin(S21_WORK);
+        cycle(i);
+        times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        next += LOOP_PERIOD;
+        std::this_thread::sleep_until(next);   // 韌體的 loop() 在這裡讓出 CPU
+    }
+    r.allocsPerEvent = (double)(allocationCount - allocsBefore) / (iterations * LINES_PER_CYCLE);
+    after();
+    std::sort(times.begin(), times.end());
+    r.p50Us = times[times.size() / 2];
+    r.p99Us = times[times.size() * 99 / 100];
+    r.maxUs = times.back();
+    return r;
+}
+
+// 原本的 logSerial() + createJsonMessage() + broadcastMessage()
+Result runLegacy(std::vector<SimulatedSocket>& sockets) {
+    std::vector<String> serialLogBuffer;
+    auto logSerial = [&](const char* message) {
+        String timestampedMsg = "[" + String(nowMs()) + "] " + String(message);
+        serialLogBuffer.push_back(timestampedMsg);
+        if (serialLogBuffer.size() > LEGACY_HISTORY) serialLogBuffer.erase(serialLogBuffer.begin());
+
+        // JsonDocument + serializeJson(doc, String)：以 String 組出同樣的內容
+        std::string escaped;
+        for (const char* p = timestampedMsg.c_str(); *p; p++) {
+            if (*p == '\n') escaped += "\\n";
+            else escaped += *p;
+        }
+        String jsonMsg = "{\"type\":\"serial_log\",\"timestamp\":" + String(nowMs()) +
+                         ",\"data\":\"" + String(escaped) + "\"}";
+        for (SimulatedSocket& socket : sockets) {
+            String msg = jsonMsg;   // 創建非const副本
+            socket.write(msg.length() + 4);
+            socket.events++;
+        }
+    };
+    serialLogBuffer.reserve(LEGACY_HISTORY + 1);
+    return runLoop(LEGACY_ITERATIONS, [&](int i) { s21Cycle(i, logSerial); }, []() {});
+}
+
+Result runBatched(std::vector<SimulatedSocket>& sockets) {
+    std::unique_ptr<DebugFanout> fanout(new DebugFanout());
+    std::unique_ptr<MessageRing<4096>> serialLogHistory(new MessageRing<4096>());
+    for (uint8_t id = 0; id < CLIENTS; id++) fanout->attach(id, nowMs());
+
+    // RemoteDebugger::logSerial() + publishLog()
+    auto logSerial = [&](const char* message) {
+        char timestampedMsg[DEBUG_BUFFER_SIZE + 16];
+        snprintf(timestampedMsg, sizeof(timestampedMsg), "[%lu] %s", nowMs(), message);
+        serialLogHistory->push(timestampedMsg, strlen(timestampedMsg) + 1);
+        unsigned long now = nowMs();
+        fanout->publish(DebugTopic::Logs, DEBUG_INFO, now, [&](auto& writer) {
+            writer.beginObject()
+                .field("type", "serial_log")
+                .field("timestamp", now)
+                .field("data", timestampedMsg)
+                .endObject();
+        });
+    };
+    auto flush = [&](unsigned long now) {
+        fanout->flush(now,
+            [&](uint8_t id) { return sockets[id].writable(); },
+            [&](uint8_t id, const char* data, size_t length, bool) {
+                SimulatedSocket& socket = sockets[id];
+                socket.write(length + 4);
+                // 檢查訊框時不配置堆積，避免計入每個事件的配置次數
+                static const char prefix[] = "{\"type\":\"batch\",\"dropped\":";
+                static const char marker[] = "{\"type\":\"serial_log\"";
+                if (length < sizeof(prefix) + 3 || memcmp(data, prefix, sizeof(prefix) - 1) != 0 ||
+                    memcmp(data + length - 3, "}]}", 3) != 0) {
+                    socket.malformed++;
+                    return;
+                }
+                socket.dropped += strtoul(data + sizeof(prefix) - 1, nullptr, 10);
+                for (size_t p = 0; p + sizeof(marker) - 1 <= length; p++) {
+                    if (memcmp(data + p, marker, sizeof(marker) - 1) == 0) socket.events++;
+                }
+            });
+    };
+
+    Result r = runLoop(ITERATIONS, [&](int i) {
+        s21Cycle(i, logSerial);
+        flush(nowMs());    // RemoteDebugger::loop() 的 flush
+    }, [&]() {
+        // 結束後讓佇列排空（慢速客戶端可能仍有等待中的事件）
+        for (int k = 0; k < 400; k++) {
+            flush(nowMs() + 1000);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+    r.frames = fanout->getStats().frames;
+    return r;
+}
+
+void report(const char* name, const Result& r, const std::vector<SimulatedSocket>& sockets) {
+    printf("%-10s %9.0f %9.0f %9.0f %8.2f %7u %7u %7u %7u %7u %7u\n",
+           name, r.p50Us, r.p99Us, r.maxUs, r.allocsPerEvent,
+           sockets[0].events, sockets[0].dropped, sockets[1].events, sockets[1].dropped,
+           sockets[2].events, sockets[2].dropped);
+}
+
+// MessageRing 與 std::deque 對照：隨機長度寫入與讀出，容量不足時兩邊都丟棄最舊的訊息
+bool checkMessageRing() {
+    std::mt19937 rng(47);
+    static MessageRing<512> ring;
+    std::deque<std::string> reference;
+    size_t referenceBytes = 0;
+    for (int op = 0; op < 200000; op++) {
+        if (rng() % 3 != 0) {
+            std::string message(1 + rng() % 200, (char)('a' + op % 26));
+            uint32_t evicted = ring.push(message.data(), message.size());
+            for (uint32_t k = 0; k < evicted; k++) {
+                if (reference.empty()) return false;
+                referenceBytes -= reference.front().size();
+                reference.pop_front();
+            }
+            reference.push_back(message);
+            referenceBytes += message.size();
+        } else if (!reference.empty()) {
+            size_t length;
+            const char* data = ring.front(length);
+            if (std::string(data, length) != reference.front()) return false;
+            ring.pop();
+            referenceBytes -= reference.front().size();
+            reference.pop_front();
+        }
+        if (ring.size() != reference.size() || ring.bytes() != referenceBytes) return false;
+    }
+    size_t index = 0;
+    bool same = true;
+    ring.forEach([&](const char* data, size_t length) {
+        same &= index < reference.size() && std::string(data, length) == reference[index++];
+    });
+    return same && index == reference.size();
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    printf("主迴圈週期 %lld ms，S21 計算 %lld us，VERBOSE 追蹤每週期 %d 行；客戶端頻寬 1 MB/s、1 MB/s、4 KB/s\n\n",
+           (long long)LOOP_PERIOD.count(), (long long)S21_WORK.count(), LINES_PER_CYCLE);
+    printf("%-10s %9s %9s %9s %8s %7s %7s %7s %7s %7s %7s\n",
+           "fan-out", "p50 us", "p99 us", "max us", "allocs", "fast1", "drop", "fast2", "drop", "slow", "drop");
+
+    const uint32_t lines = ITERATIONS * LINES_PER_CYCLE;
+
+    std::vector<SimulatedSocket> legacySockets = makeSockets();
+    Result legacy = runLegacy(legacySockets);
+    report("legacy", legacy, legacySockets);
+
+    std::vector<SimulatedSocket> batchedSockets = makeSockets();
+    Result batched = runBatched(batchedSockets);
+    report("batched", batched, batchedSockets);
+    printf("\n%u 行、%u 個訊框（平均每訊框 %.1f 個事件）\n", lines, batched.frames,
+           batched.frames ? (double)(batchedSockets[0].events + batchedSockets[1].events + batchedSockets[2].events) / batched.frames : 0.0);
+
+    // 慢速客戶端不得拖慢主迴圈；每個事件不配置堆積
+    ok &= batched.p99Us < legacy.p99Us / 4;
+    ok &= batched.allocsPerEvent == 0;
+    // 正常客戶端收到全部事件；慢速客戶端的收到數加丟棄數等於總行數，訊框格式正確
+    for (int c = 0; c < 2; c++) ok &= batchedSockets[c].events == lines && batchedSockets[c].dropped == 0;
+    ok &= batchedSockets[2].dropped > 0 && batchedSockets[2].events + batchedSockets[2].dropped == lines;
+    for (const SimulatedSocket& socket : batchedSockets) ok &= socket.malformed == 0;
+
+    bool ring = checkMessageRing();
+    printf("MessageRing 與參考佇列一致: %s\n", ring ? "yes" : "NO");
+    ok &= ring;
+
+    printf("慢速客戶端不阻塞主迴圈、零配置且丟棄數正確: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
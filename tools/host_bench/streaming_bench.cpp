@@ -0,0 +1,216 @@
+// StreamingResponse 基準測試（主機端）
+// 以同一份頁面模板（WiFiManager 主頁狀態區 + 模擬控制表單 + PROGMEM 內嵌腳本 + 一行超過 256 字元的診斷列）
+// 比較舊版（appendf 先寫進 tmp[256] 再複製、固定 512 bytes 分塊）與目前的 StreamingResponse：
+// 每頁主機 CPU 時間、送出分塊數與平均大小、經過分塊緩衝複製的位元組、堆積配置次數，
+// 並與一次性 snprintf 產生的參考輸出比對，檢查是否被截斷。
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+
+#include "common/StreamingResponse.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 50000;
+
+// 舊版 StreamingResponse（只保留 WebServer 路徑）
+class LegacyStreamingResponse {
+    static constexpr size_t CHUNK_SIZE = 512;
+    char buffer[CHUNK_SIZE];
+    size_t pos = 0;
+    WebServer* server = nullptr;
+    bool active = false;
+
+public:
+    void begin(WebServer* srv, const char* contentType = "text/html") {
+        server = srv;
+        server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+        server->send(200, contentType, "");
+        active = true;
+        pos = 0;
+    }
+    void append(const char* content) { append(content, strlen(content)); }
+    void append(const char* content, size_t len) {
+        if (!active) return;
+        size_t i = 0;
+        while (i < len) {
+            size_t n = min(len - i, CHUNK_SIZE - pos);
+            memcpy(buffer + pos, content + i, n);
+            pos += n;
+            i += n;
+            if (pos >= CHUNK_SIZE) flush();
+        }
+    }
+    void append_P(PGM_P content) { append(content); }
+    void appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char tmp[256];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(tmp, sizeof(tmp), fmt, args);
+        va_end(args);
+        if (n > 0) append(tmp);
+    }
+    void flush() {
+        if (!active || pos == 0) return;
+        server->sendContent(buffer, pos);
+        pos = 0;
+    }
+    void finish() {
+        if (!active) return;
+        flush();
+        server->sendContent("", 0);
+        active = false;
+    }
+};
+
+// 頁面內嵌腳本（約 3 KB，放在 flash）
+#define SCRIPT_LINE "function refresh(){fetch('/api/status').then(r=>r.json()).then(s=>{document.getElementById('t').textContent=s.currentTemp;});}\n"
+#define SCRIPT_BLOCK SCRIPT_LINE SCRIPT_LINE SCRIPT_LINE SCRIPT_LINE SCRIPT_LINE SCRIPT_LINE
+const char PAGE_SCRIPT[] PROGMEM = "<script>" SCRIPT_BLOCK SCRIPT_BLOCK SCRIPT_BLOCK SCRIPT_BLOCK "</script>";
+
+struct PageState {
+    const char* ssid = "Home-Network-5G";
+    int rssi = -61;
+    const char* ip = "192.168.1.47";
+    bool power = true;
+    int mode = 2;
+    float currentTemp = 26.4f;
+    float targetTemp = 24.5f;
+    float roomTemp = 26.0f;
+    int fan = 3;
+    uint32_t s21Commands = 214523;
+    uint32_t s21Errors = 37;
+    uint32_t freeHeap = 142336;
+    uint32_t maxAlloc = 110580;
+};
+
+template <typename Response>
+void renderMainPage(Response& stream, const PageState& s) {
+    stream.append("<!DOCTYPE html><html><head><meta charset='UTF-8'><title>DaiSpan</title>"
+                  "<link rel='stylesheet' href='/assets/style.css'></head><body>"
+                  "<div class='container'><h1>DaiSpan</h1><div class='status'>");
+    stream.appendf("<p>WiFi: %s (%d dBm)</p><p>IP: %s</p>", s.ssid, s.rssi, s.ip);
+    stream.appendf("<p>電源: <b>%s</b> | 溫度: <b>%.1f / %.1f °C</b> | %s</p>",
+                   s.power ? "ON" : "OFF", s.currentTemp, s.targetTemp, "制冷中");
+    // 診斷列超過 256 字元：舊版 tmp[256] 會在這裡截斷
+    stream.appendf("<table class='diag'><tr><th>S21 命令</th><td>%u</td><th>S21 錯誤</th><td>%u</td></tr>"
+                   "<tr><th>剩餘堆積</th><td>%u bytes</td><th>最大可配置</th><td>%u bytes</td></tr>"
+                   "<tr><th>WiFi</th><td>%s</td><th>RSSI</th><td>%d dBm</td></tr></table>",
+                   s.s21Commands, s.s21Errors, s.freeHeap, s.maxAlloc, s.ssid, s.rssi);
+    stream.append("</div><form method='post' action='/simulation-control'>");
+    stream.appendf("<p><label>電源: <select name='power'>"
+                   "<option value='0'%s>關閉</option><option value='1'%s>開啟</option></select></label></p>",
+                   !s.power ? " selected" : "", s.power ? " selected" : "");
+    stream.append("<p><label>模式: <select name='mode'>");
+    const char* modeNames[] = {"關閉", "制熱", "制冷", "自動"};
+    for (int i = 0; i < 4; i++)
+        stream.appendf("<option value='%d'%s>%s</option>", i, s.mode == i ? " selected" : "", modeNames[i]);
+    stream.append("</select></label></p>");
+    stream.appendf("<p><label>目標溫度: <input type='number' name='target_temp' min='16' max='30' step='0.5' value='%.1f'></label></p>",
+                   s.targetTemp);
+    stream.appendf("<p><label>房間溫度: <input type='number' name='room_temp' min='10' max='40' step='0.5' value='%.1f'></label></p>",
+                   s.roomTemp);
+    stream.append("<p><label>風速: <select name='fan_speed'>");
+    stream.appendf("<option value='0'%s>自動</option>", s.fan == 0 ? " selected" : "");
+    for (int i = 1; i <= 5; i++)
+        stream.appendf("<option value='%d'%s>%d檔</option>", i, s.fan == i ? " selected" : "", i);
+    stream.append("</select></label></p>");
+    stream.append("<p style='text-align:center'><button type='submit' class='button'>套用</button> "
+                  "<a href='/' class='button secondary'>返回</a></p></form>");
+    stream.append_P(PAGE_SCRIPT);
+    stream.append("</div></body></html>");
+}
+
+// 參考輸出：一次性 snprintf 到大緩衝，不經過分塊
+struct ReferenceResponse {
+    std::string text;
+    void append(const char* content) { text += content; }
+    void append_P(PGM_P content) { text += content; }
+    void appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char tmp[2048];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(tmp, sizeof(tmp), fmt, args);
+        va_end(args);
+        if (n > 0) text.append(tmp, n);
+    }
+};
+
+struct Result {
+    size_t bytes = 0;
+    uint32_t chunks = 0;
+    size_t copied = 0;          // 經過分塊緩衝複製後才送出的位元組
+    double nsPerPage = 0;
+    double allocsPerPage = 0;
+    bool complete = false;
+};
+
+template <typename Response>
+Result measure(const PageState& state, const std::string& reference) {
+    Result result;
+    WebServer server;
+    std::string output;
+    const char* scriptEnd = PAGE_SCRIPT + sizeof(PAGE_SCRIPT);
+    server.onContent = [&](const char* content, size_t length) {
+        if (length == 0) return;
+        output.append(content, length);
+        result.chunks++;
+        if (content < PAGE_SCRIPT || content >= scriptEnd) result.copied += length;
+    };
+    {
+        Response stream;
+        stream.begin(&server);
+        renderMainPage(stream, state);
+        stream.finish();
+    }
+    result.bytes = output.size();
+    result.complete = output == reference;
+
+    size_t sink = 0;
+    server.onContent = [&sink](const char*, size_t length) { sink += length; };
+    uint64_t allocsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        Response stream;
+        stream.begin(&server);
+        renderMainPage(stream, state);
+        stream.finish();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    result.nsPerPage = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+    // 計數 lambda 的 std::function 建構不算在渲染內
+    result.allocsPerPage = (double)(allocationCount - allocsBefore) / ITERATIONS;
+    if (sink != result.bytes * ITERATIONS) result.complete = false;
+    return result;
+}
+
+void report(const char* name, size_t chunkSize, const Result& r) {
+    printf("%-22s %6zu %6zu %6u %7.0f %7zu %9.0f %7.2f  %s\n",
+           name, chunkSize, r.bytes, r.chunks, r.chunks ? (double)r.bytes / r.chunks : 0.0, r.copied,
+           r.nsPerPage, r.allocsPerPage, r.complete ? "yes" : "NO");
+}
+
+} // namespace
+
+int main() {
+    PageState state;
+    ReferenceResponse reference;
+    renderMainPage(reference, state);
+
+    printf("%-22s %6s %6s %6s %7s %7s %9s %7s  %s\n",
+           "response", "chunk", "bytes", "chunks", "avg", "copied", "ns/page", "allocs", "complete");
+    report("legacy (tmp[256])", 512, measure<LegacyStreamingResponse>(state, reference.text));
+
+    // 分塊大小由 begin() 依剩餘堆積決定
+    ESP.freeHeap = 160000;
+    Result v2 = measure<StreamingResponse>(state, reference.text);
+    report("streaming", StreamingResponse::chooseChunkSize(ESP.freeHeap, StreamingResponse::TCP_SEGMENT_SIZE), v2);
+
+    ESP.freeHeap = 24000;
+    Result lowHeap = measure<StreamingResponse>(state, reference.text);
+    report("streaming (low heap)", StreamingResponse::chooseChunkSize(ESP.freeHeap, StreamingResponse::TCP_SEGMENT_SIZE), lowHeap);
+
+    return v2.complete && lowHeap.complete ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+// 主機端 Arduino 最小替身：只提供設備/控制器原始碼用到的部分
+// millis() 走模擬時鐘（由基準測試推進），micros() 走真實時鐘以量測 CPU 時間
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <strings.h>
+#include <string>
+#include <memory>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+
+#define PROGMEM
+#define PGM_P const char*
+#define strlen_P strlen
+
+class HardwareSerial;
+
+// 模擬時鐘
+namespace HostClock {
+    extern unsigned long nowMs;
+    inline void advance(unsigned long ms) { nowMs += ms; }
+    inline void set(unsigned long ms) { nowMs = ms; }
+}
+
+unsigned long millis();
+unsigned long micros();
+inline void delay(unsigned long ms) { HostClock::advance(ms); }
+
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high) {
+    return value < low ? (T)low : (value > high ? (T)high : value);
+}
+
+// 最小 String 實作
+class String {
+public:
+    String() {}
+    String(const char* s) : str(s ? s : "") {}
+    String(const std::string& s) : str(s) {}
+    String(int value) : str(std::to_string(value)) {}
+    String(unsigned int value) : str(std::to_string(value)) {}
+    String(long value) : str(std::to_string(value)) {}
+    String(unsigned long value) : str(std::to_string(value)) {}
+    String(float value, unsigned int decimals = 2) { format(value, decimals); }
+    String(double value, unsigned int decimals = 2) { format(value, decimals); }
+
+    const char* c_str() const { return str.c_str(); }
+    size_t length() const { return str.length(); }
+    bool isEmpty() const { return str.empty(); }
+
+    String& operator+=(const String& other) { str += other.str; return *this; }
+    String& operator+=(const char* other) { str += other; return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+    friend String operator+(const String& a, const char* b) { return String(a.str + b); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a) + b.str); }
+    bool operator==(const String& other) const { return str == other.str; }
+
+private:
+    std::string str;
+
+    void format(double value, unsigned int decimals) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        str = buffer;
+    }
+};
+
+// 串口替身：預設丟棄輸出，只計數，避免日誌 I/O 干擾 CPU 量測
+class HostSerial {
+public:
+    bool echo = false;
+    uint32_t lines = 0;
+
+    void begin(unsigned long) {}
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        lines++;
+        if (!echo) return 0;
+        va_list args;
+        va_start(args, fmt);
+        int n = vprintf(fmt, args);
+        va_end(args);
+        return n;
+    }
+    void println(const char* s = "") { lines++; if (echo) puts(s); }
+    void print(const char* s) { if (echo) fputs(s, stdout); }
+    size_t write(const uint8_t* data, size_t length) { lines++; return echo ? fwrite(data, 1, length, stdout) : length; }
+    explicit operator bool() const { return true; }
+};
+
+extern HostSerial Serial;
+
+// ESP 替身：剩餘堆積可由基準測試設定
+class HostEsp {
+public:
+    uint32_t freeHeap = 160000;
+    uint32_t minFreeHeap = 120000;
+    uint32_t getFreeHeap() const { return freeHeap; }
+    uint32_t getMinFreeHeap() const { return minFreeHeap; }
+    // CPU 週期計數器：真實時鐘換算成 cpuFreqMHz 的週期，cycleOffset 可用來模擬 32 位元繞回
+    uint32_t cpuFreqMHz = 160;
+    uint32_t cycleOffset = 0;
+    uint32_t getCycleCount() const;
+    uint32_t getCpuFreqMHz() const { return cpuFreqMHz; }
+};
+
+inline HostEsp ESP;
+
+// RTC 記憶體替身：主機端就是一般的全域變數，「重啟」由基準測試模擬
+#define RTC_NOINIT_ATTR
+
+typedef enum {
+    ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO,
+} esp_reset_reason_t;
+
+namespace HostReset {
+    inline esp_reset_reason_t reason = ESP_RST_POWERON;
+}
+
+inline esp_reset_reason_t esp_reset_reason() { return HostReset::reason; }
@@ -0,0 +1,87 @@
+#pragma once
+
+// 主機端 HomeSpan 替身
+// 只模擬設備服務用到的特性 API：getVal/setVal/updated/getNewVal，
+// 並提供 HostHap::write() 模擬一次 HAP PUT（寫入新值 → 呼叫服務 update() → 提交）
+
+#include "Arduino.h"
+#include <vector>
+#include <initializer_list>
+#include <type_traits>
+
+class SpanService;
+
+class SpanCharacteristic {
+public:
+    explicit SpanCharacteristic(double initial, bool isFloat = false);
+    virtual ~SpanCharacteristic() = default;
+
+    template <typename T = int> T getVal() const { return convert<T>(value); }
+    template <typename T = int> T getNewVal() const { return convert<T>(newValue); }
+    boolean updated() const { return isUpdated; }
+
+    template <typename T> void setVal(T val, boolean notify = true) {
+        value = (double)val;
+        newValue = value;
+        if (notify) notifications++;
+    }
+
+    SpanCharacteristic* setRange(double min, double max, double step = 0) {
+        rangeMin = min; rangeMax = max; rangeStep = step;
+        return this;
+    }
+    SpanCharacteristic* setValidValues(int n, ...) { (void)n; return this; }
+
+    // 主機端專用
+    SpanService* service;
+    uint32_t notifications = 0;
+    double value;
+    double newValue;
+    bool isUpdated = false;
+    bool isFloat;
+    double rangeMin = 0, rangeMax = 100, rangeStep = 0;
+
+private:
+    template <typename T> static T convert(double v) {
+        return std::is_floating_point<T>::value ? (T)v : (T)lround(v);
+    }
+};
+
+class SpanService {
+public:
+    SpanService();
+    virtual ~SpanService() = default;
+    virtual boolean update() { return true; }
+    virtual void loop() {}
+
+    std::vector<SpanCharacteristic*> characteristics;
+    static SpanService* current;  // 建構中的服務，新特性自動掛上
+};
+
+namespace Service {
+    struct Thermostat : SpanService {};
+    struct Fan : SpanService {};
+    struct Switch : SpanService {};
+}
+
+namespace Characteristic {
+    struct CurrentTemperature : SpanCharacteristic { CurrentTemperature(double v = 0) : SpanCharacteristic(v, true) {} };
+    struct TargetTemperature : SpanCharacteristic { TargetTemperature(double v = 0) : SpanCharacteristic(v, true) {} };
+    struct CurrentHeatingCoolingState : SpanCharacteristic { CurrentHeatingCoolingState(int v = 0) : SpanCharacteristic(v) {} };
+    struct TargetHeatingCoolingState : SpanCharacteristic { TargetHeatingCoolingState(int v = 0) : SpanCharacteristic(v) {} };
+    struct TemperatureDisplayUnits : SpanCharacteristic { TemperatureDisplayUnits(int v = 0) : SpanCharacteristic(v) {} };
+    struct On : SpanCharacteristic { On(bool v = false) : SpanCharacteristic(v) {} };
+    struct RotationSpeed : SpanCharacteristic { RotationSpeed(double v = 0) : SpanCharacteristic(v, true) {} };
+    struct Name : SpanCharacteristic { Name(const char*) : SpanCharacteristic(0) {} };
+}
+
+namespace HostHap {
+    struct Write {
+        SpanCharacteristic* characteristic;
+        double value;
+    };
+
+    // 模擬一次 HAP PUT：同一服務的多個特性一起寫入，只呼叫一次 update()
+    // 回傳 update() 結果；成功時新值被提交
+    bool write(std::initializer_list<Write> writes);
+}
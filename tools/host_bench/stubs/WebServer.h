@@ -0,0 +1,23 @@
+#pragma once
+
+// 主機端 WebServer 替身：只提供 HTTP 方法與內容長度常數，
+// 以及 StreamingResponse 用到的介面；送出的內容交給 onContent（基準測試用來計數）
+#include <Arduino.h>
+#include <functional>
+
+enum HTTPMethod {
+    HTTP_DELETE = 0, HTTP_GET = 1, HTTP_HEAD = 2, HTTP_POST = 3,
+    HTTP_PUT = 4, HTTP_OPTIONS = 6, HTTP_PATCH = 28
+};
+#define HTTP_ANY (HTTPMethod)(255)
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+class WebServer {
+public:
+    void setContentLength(size_t) {}
+    void send(int, const char*, const char*) {}
+    std::function<void(const char*, size_t)> onContent;
+    void sendContent(const char* content, size_t length) { if (onContent) onContent(content, length); }
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+// 主機端 WiFiClient / WiFiServer 替身，以 POSIX socket 實作
+// 與 ESP32 核心相同：WiFiClient 副本共用同一個 socket，最後一份釋放時才關閉；
+// 接受的連線把送出緩衝設成 lwIP 預設的 TCP_SND_BUF，讓慢速客戶端的背壓與設備上相近。
+#include <Arduino.h>
+#include <lwip/sockets.h>
+#include <fcntl.h>
+#include <memory>
+
+class IPAddress {
+public:
+    IPAddress(uint32_t address = 0) : address(address) {}
+    String toString() const {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u",
+                 address & 0xFF, (address >> 8) & 0xFF, (address >> 16) & 0xFF, address >> 24);
+        return String(buffer);
+    }
+private:
+    uint32_t address;
+};
+
+class WiFiClient {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(int fd) : handle(std::make_shared<Handle>(fd)) {}
+
+    int fd() const { return handle ? handle->fd : -1; }
+    void stop() { handle.reset(); }
+    explicit operator bool() const { return handle != nullptr; }
+
+    IPAddress remoteIP() const {
+        sockaddr_in addr{};
+        socklen_t length = sizeof(addr);
+        if (!handle || getpeername(handle->fd, (sockaddr*)&addr, &length) != 0) return IPAddress();
+        return IPAddress(addr.sin_addr.s_addr);
+    }
+
+    size_t write(const uint8_t* data, size_t length) {
+        if (!handle) return 0;
+        ssize_t n = ::send(handle->fd, data, length, MSG_NOSIGNAL);
+        return n > 0 ? n : 0;
+    }
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+private:
+    struct Handle {
+        int fd;
+        explicit Handle(int fd) : fd(fd) {}
+        ~Handle() { ::close(fd); }
+    };
+    std::shared_ptr<Handle> handle;
+};
+
+class WiFiServer {
+public:
+    static constexpr int LWIP_TCP_SND_BUF = 5744;
+
+    explicit WiFiServer(int port) : port(port) {}
+    ~WiFiServer() { end(); }
+
+    void begin() {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 8) != 0) {
+            perror("WiFiServer");
+            exit(1);
+        }
+        fcntl(listenFd, F_SETFL, O_NONBLOCK);
+    }
+    void end() {
+        if (pendingFd >= 0) ::close(pendingFd);
+        if (listenFd >= 0) ::close(listenFd);
+        pendingFd = listenFd = -1;
+    }
+    void setNoDelay(bool enabled) { noDelay = enabled; }
+
+    bool hasClient() {
+        if (pendingFd < 0 && listenFd >= 0) pendingFd = ::accept(listenFd, nullptr, nullptr);
+        return pendingFd >= 0;
+    }
+    WiFiClient accept() {
+        if (!hasClient()) return WiFiClient();
+        int fd = pendingFd;
+        pendingFd = -1;
+        int one = 1;
+        if (noDelay) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        int sendBuffer = LWIP_TCP_SND_BUF;
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+        return WiFiClient(fd);
+    }
+
+private:
+    int port;
+    int listenFd = -1;
+    int pendingFd = -1;
+    bool noDelay = false;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+// 主機端遠端調試替身：HomeKit 操作記錄只計數
+#include <Arduino.h>
+
+class RemoteDebugger {
+public:
+    static RemoteDebugger& getInstance() {
+        static RemoteDebugger instance;
+        return instance;
+    }
+
+    void log(const String&, const String&, const String&) {}
+    void logHomeKitOperation(const String&, const String&, const String&, const String&,
+                             bool, const String& = "") {
+        homeKitOperations++;
+    }
+    void logSerial(const String&) {}
+
+    uint32_t homeKitOperations = 0;
+};
+
+#define REMOTE_LOG_INFO(component, message) \
+    RemoteDebugger::getInstance().log("INFO", component, message)
+
+#define REMOTE_LOG_WARN(component, message) \
+    RemoteDebugger::getInstance().log("WARN", component, message)
+
+#define REMOTE_LOG_ERROR(component, message) \
+    RemoteDebugger::getInstance().log("ERROR", component, message)
+
+#define REMOTE_LOG_HOMEKIT_OP(operation, service, oldVal, newVal, success, error) \
+    RemoteDebugger::getInstance().logHomeKitOperation(operation, service, oldVal, newVal, success, error)
+
+#define REMOTE_WEBLOG(message) \
+    RemoteDebugger::getInstance().logSerial(message)
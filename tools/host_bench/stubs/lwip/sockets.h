@@ -0,0 +1,11 @@
+#pragma once
+
+// 主機端以 POSIX socket 代替 lwIP（同為 BSD socket 介面）
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
@@ -0,0 +1,158 @@
+// 遙測編碼基準測試（主機端）
+// 以同一份 writeTelemetry() 欄位描述分別輸出 JSON 與 CBOR，比較大小、序列化時間與堆積配置次數；
+// 並把 CBOR 解碼後重新以 JsonWriter 輸出，確認與 JSON 路徑逐字相同（兩種格式內容一致）。
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+
+#include "common/JsonWriter.h"
+#include "common/CborWriter.h"
+#include "common/Telemetry.h"
+#include "CborReader.h"
+#include "BenchUtil.h"
+
+namespace {
+
+constexpr int ITERATIONS = 200000;
+
+// 模擬 StreamingResponse：512 bytes 分塊送出，只計數不真的送
+struct ChunkSink {
+    static constexpr size_t CHUNK_SIZE = 512;
+    char buffer[CHUNK_SIZE];
+    size_t pos = 0;
+    size_t bytes = 0;
+    std::string* capture = nullptr;
+
+    void append(const char* data, size_t len) {
+        while (len > 0) {
+            size_t n = std::min(len, CHUNK_SIZE - pos);
+            memcpy(buffer + pos, data, n);
+            pos += n;
+            data += n;
+            len -= n;
+            if (pos == CHUNK_SIZE) flush();
+        }
+    }
+
+    void flush() {
+        if (pos == 0) return;
+        if (capture) capture->append(buffer, pos);
+        bytes += pos;
+        pos = 0;
+    }
+};
+
+struct StringSink {
+    std::string text;
+    void append(const char* data, size_t len) { text.append(data, len); }
+};
+
+TelemetrySnapshot sampleSnapshot() {
+    TelemetrySnapshot t;
+    t.uptime = 1234567;
+    t.controller = true;
+    t.power = true;
+    t.mode = 2;
+    t.targetTemp = 24.5f;
+    t.fanSpeed = 3;
+    t.swingV = true;
+    t.swingH = false;
+    t.healthy = true;
+    t.errors = 0;
+    t.currentTemp = 26.3f;
+    t.wifi = true;
+    t.rssi = -58;
+    t.s21Commands = 214523;
+    t.s21Errors = 37;
+    t.s21RetriesTimeout = 21;
+    t.s21RetriesChecksum = 4;
+    t.s21RetriesOther = 1;
+    t.s21Quality = 98.7f;
+    t.s21AvgResponseMs = 143.2f;
+    t.freeHeap = 142336;
+    t.minFreeHeap = 98304;
+    t.maxAllocHeap = 110580;
+    t.avgFreeHeap = 140112;
+    return t;
+}
+
+struct EncodeResult {
+    size_t bytes;
+    double nsPerEncode;
+    double allocsPerEncode;
+    std::string output;
+};
+
+template <template <typename> class Writer>
+EncodeResult measure(const TelemetrySnapshot& t) {
+    EncodeResult result{};
+    {
+        ChunkSink sink;
+        sink.capture = &result.output;
+        Writer<ChunkSink> writer(sink);
+        writeTelemetry(writer, t);
+        sink.flush();
+        result.bytes = sink.bytes;
+    }
+
+    size_t checksum = 0;
+    uint64_t allocsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ChunkSink sink;
+        Writer<ChunkSink> writer(sink);
+        writeTelemetry(writer, t);
+        sink.flush();
+        checksum += sink.bytes;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    result.nsPerEncode = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+    result.allocsPerEncode = (double)(allocationCount - allocsBefore) / ITERATIONS;
+    if (checksum != result.bytes * ITERATIONS) result.bytes = 0;
+    return result;
+}
+
+void report(const char* name, const EncodeResult& r, size_t jsonBytes) {
+    printf("%-12s %6zu %7.0f%% %9.1f %8.2f\n",
+           name, r.bytes, 100.0 * r.bytes / jsonBytes, r.nsPerEncode, r.allocsPerEncode);
+}
+
+bool matchesJson(const std::string& cbor, const std::string& json) {
+    StringSink sink;
+    JsonWriter<StringSink> out(sink);
+    CborReader reader{(const uint8_t*)cbor.data(), (const uint8_t*)cbor.data() + cbor.size()};
+    if (!reader.transcode(out) || reader.p != reader.end) return false;
+    if (sink.text != json) {
+        printf("CBOR 解碼: %s\nJSON 輸出: %s\n", sink.text.c_str(), json.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    printf("%-12s %6s %8s %9s %8s\n", "format", "bytes", "vs JSON", "ns/encode", "allocs");
+
+    TelemetrySnapshot full = sampleSnapshot();
+    EncodeResult json = measure<JsonWriter>(full);
+    EncodeResult cbor = measure<CborWriter>(full);
+    report("json", json, json.bytes);
+    report("cbor", cbor, json.bytes);
+    ok &= matchesJson(cbor.output, json.output);
+
+    // 無控制器、WiFi 斷線（null 值）與未初始化的浮點數（NaN → null）
+    TelemetrySnapshot minimal;
+    minimal.uptime = 42;
+    EncodeResult minimalJson = measure<JsonWriter>(minimal);
+    EncodeResult minimalCbor = measure<CborWriter>(minimal);
+    report("json (min)", minimalJson, minimalJson.bytes);
+    report("cbor (min)", minimalCbor, minimalJson.bytes);
+    ok &= matchesJson(minimalCbor.output, minimalJson.output);
+
+    printf("\nJSON: %s\n", json.output.c_str());
+    printf("CBOR 與 JSON 內容一致: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+// 追蹤區段測試（主機端，以 -DTRACE_SPANS 編譯）
+// 1. 每個 TRACE_SCOPE 的成本（主機以 steady_clock 模擬週期計數器，ESP32 上讀 CCOUNT 只要一個指令），
+//    以及未定義 TRACE_SPANS 時（trace_off.cpp）參數不求值；
+// 2. 模擬一輪主迴圈的巢狀區段，匯出 Chrome trace-event JSON 後子區段都落在父區段的時間範圍內；
+// 3. 環形緩衝滿了覆蓋最舊的區段，保留最新的 CAPACITY 筆並計數；
+// 4. 32 位元週期計數器繞回後時間戳仍遞增。
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "common/Trace.h"
+
+uint32_t traceDisabledLoop(int iterations);
+uint32_t traceDisabledEvaluations();
+
+namespace {
+
+constexpr int ITERATIONS = 1000000;
+
+struct StringSink {
+    std::string text;
+    void append(const char* data, size_t len) { text.append(data, len); }
+};
+
+struct Event {
+    std::string name;
+    double ts;
+    double dur;
+};
+
+// 從匯出的 JSON 取出 "X" 事件（欄位順序固定：name, ph, ts, dur）
+std::vector<Event> parseEvents(const std::string& text) {
+    std::vector<Event> events;
+    static const char marker[] = "{\"name\":\"";
+    for (size_t p = text.find(marker); p != std::string::npos; p = text.find(marker, p + 1)) {
+        size_t nameStart = p + sizeof(marker) - 1;
+        size_t nameEnd = text.find('"', nameStart);
+        if (text.compare(nameEnd, 12, "\",\"ph\":\"X\",\"") != 0) continue;
+        Event event;
+        event.name = text.substr(nameStart, nameEnd - nameStart);
+        event.ts = strtod(text.c_str() + text.find("\"ts\":", nameEnd) + 5, nullptr);
+        event.dur = strtod(text.c_str() + text.find("\"dur\":", nameEnd) + 6, nullptr);
+        events.push_back(event);
+    }
+    return events;
+}
+
+std::string exportTrace() {
+    StringSink sink;
+    JsonWriter<StringSink> json(sink);
+    TRACE.writeJSON(json);
+    return sink.text;
+}
+
+void spin(uint32_t cycles) {
+    uint32_t start = ESP.getCycleCount();
+    while (ESP.getCycleCount() - start < cycles) {}
+}
+
+// 一輪主迴圈：與 SystemManager / ThermostatController / S21Protocol 中的區段名稱相同
+void mainLoop() {
+    TRACE_SCOPE("loop");
+    {
+        TRACE_SCOPE("homespan.poll");
+        spin(800);
+    }
+    {
+        TRACE_SCOPE("accessory.sync");
+        TRACE_SCOPE("controller.update");
+        {
+            TRACE_SCOPE("s21.send");
+            spin(400);
+        }
+        {
+            TRACE_SCOPE("s21.parse");
+            spin(1200);
+        }
+    }
+    {
+        TRACE_SCOPE("web.service");
+        TRACE_SCOPE("/api/metrics");
+        spin(600);
+    }
+}
+
+const char* parentOf(const std::string& name) {
+    if (name == "homespan.poll" || name == "accessory.sync" || name == "web.service") return "loop";
+    if (name == "controller.update") return "accessory.sync";
+    if (name == "s21.send" || name == "s21.parse") return "controller.update";
+    if (name == "/api/metrics") return "web.service";
+    return nullptr;
+}
+
+// 每個子區段都找得到包住它的父區段（匯出的時間戳精度為 0.001 µs）
+bool nested(const std::vector<Event>& events) {
+    const double EPS = 0.002;
+    size_t children = 0;
+    for (const Event& child : events) {
+        const char* parent = parentOf(child.name);
+        if (!parent) continue;
+        children++;
+        bool found = false;
+        for (const Event& e : events) {
+            if (e.name == parent && e.ts <= child.ts + EPS && child.ts + child.dur <= e.ts + e.dur + EPS) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+    return children > 0;
+}
+
+bool increasing(const std::vector<Event>& events, const char* name) {
+    double last = -1;
+    for (const Event& e : events) {
+        if (e.name != name) continue;
+        if (e.ts <= last) return false;
+        last = e.ts;
+    }
+    return last >= 0;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // 1. 每個區段的成本
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; i++) {
+            TRACE_SCOPE("bench");
+        }
+        double enabledNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+        start = std::chrono::steady_clock::now();
+        volatile uint32_t sum = traceDisabledLoop(ITERATIONS);
+        (void)sum;
+        double disabledNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+        printf("%-26s %9s\n", "TRACE_SCOPE", "ns/span");
+        printf("%-26s %9.1f\n", "enabled (host clock)", enabledNs);
+        printf("%-26s %9.1f\n", "disabled", disabledNs);
+        bool compiledOut = traceDisabledEvaluations() == 0;
+        printf("未定義 TRACE_SPANS 時參數不求值: %s\n\n", compiledOut ? "yes" : "NO");
+        ok &= compiledOut && TRACE.getRecorded() == (uint32_t)ITERATIONS;
+    }
+
+    // 2. 巢狀區段匯出
+    {
+        TRACE.clear();
+        for (int i = 0; i < 8; i++) mainLoop();
+        std::string text = exportTrace();
+        std::vector<Event> events = parseEvents(text);
+        bool metadata = text.find("\"ph\":\"M\"") != std::string::npos &&
+                        text.compare(0, 15, "{\"traceEvents\":") == 0;
+        bool complete = events.size() == 8 * 8 && TRACE.size() == events.size();
+        bool inside = nested(events);
+        printf("匯出 %zu 個區段（%zu bytes），子區段都在父區段範圍內: %s\n",
+               events.size(), text.size(), complete && inside && metadata ? "yes" : "NO");
+        if (!(complete && inside && metadata)) printf("%.400s\n", text.c_str());
+        ok &= complete && inside && metadata;
+    }
+
+    // 3. 環形緩衝覆蓋
+    {
+        TRACE.clear();
+        uint32_t overwrittenBefore = TRACE.getOverwritten();
+        const size_t extra = 100;
+        for (size_t i = 0; i < TraceBuffer::CAPACITY + extra - 1; i++) {
+            TRACE_SCOPE("old");
+        }
+        {
+            TRACE_SCOPE("newest");
+        }
+        std::vector<Event> events = parseEvents(exportTrace());
+        bool kept = events.size() == TraceBuffer::CAPACITY && events.back().name == "newest" &&
+                    TRACE.getOverwritten() - overwrittenBefore == extra && increasing(events, "old");
+        printf("緩衝滿了保留最新 %zu 筆、覆蓋 %u 筆: %s\n", TraceBuffer::CAPACITY,
+               TRACE.getOverwritten() - overwrittenBefore, kept ? "yes" : "NO");
+        ok &= kept;
+    }
+
+    // 4. 週期計數器繞回
+    {
+        TRACE.clear();
+        // 把計數器撥到繞回前約 1 ms（160 MHz），之後的 4 ms 內繞回
+        ESP.cycleOffset = 0xFFFFFFFFu - ESP.getCycleCount() - 160 * 1000;
+        bool wrapped = false;
+        uint32_t last = ESP.getCycleCount();
+        for (int i = 0; i < 64; i++) {
+            mainLoop();
+            spin(10000);
+            uint32_t now = ESP.getCycleCount();
+            if (now < last) wrapped = true;
+            last = now;
+        }
+        std::vector<Event> events = parseEvents(exportTrace());
+        bool monotonic = wrapped && increasing(events, "loop") && nested(events);
+        for (const Event& e : events) monotonic &= e.dur < 1000;    // 繞回不會產生異常長的區段
+        printf("週期計數器繞回後時間戳遞增、持續時間正確: %s\n", monotonic ? "yes" : "NO");
+        ok &= monotonic;
+        ESP.cycleOffset = 0;
+    }
+
+    printf("追蹤區段巢狀與匯出正確: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
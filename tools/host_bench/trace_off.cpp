@@ -0,0 +1,23 @@
+// 未定義 TRACE_SPANS 時的 TRACE_SCOPE（與 trace_bench.cpp 分開編譯）：巨集展開為空敘述，參數不求值
+#include <Arduino.h>
+#include "common/Trace.h"
+
+static uint32_t evaluations = 0;
+
+static const char* spanName() {
+    evaluations++;
+    return "disabled";
+}
+
+uint32_t traceDisabledLoop(int iterations) {
+    uint32_t sum = 0;
+    for (int i = 0; i < iterations; i++) {
+        TRACE_SCOPE(spanName());
+        sum += i;
+    }
+    return sum;
+}
+
+uint32_t traceDisabledEvaluations() {
+    return evaluations;
+}
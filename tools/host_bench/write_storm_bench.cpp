@@ -0,0 +1,434 @@
+// HomeKit 寫入風暴基準測試（主機端）
+// 將 ThermostatDevice / FanDevice / SwingSwitchService / ThermostatController /
+// AccessorySync 原始碼連結到 HomeSpan 替身與模擬 S21 室內機，重播 HomeKit 寫入突發，
+// 回報送出的 S21 幀、最終收斂時間、遺失的用戶意圖與每次寫入的 CPU 時間；
+// 另量測沒有寫入時配件同步的 getter 呼叫數與 CPU 時間。
+
+#include <Arduino.h>
+#include <HomeSpan.h>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "controller/ThermostatController.h"
+#include "device/ThermostatDevice.h"
+#include "device/FanDevice.h"
+#include "device/SwingDevice.h"
+#include "device/AccessorySync.h"
+#include "device/HomeKitNotifier.h"
+#include "SimulatedS21Unit.h"
+
+namespace {
+
+constexpr unsigned long STEP_MS = 10;                 // 主迴圈模擬步長
+constexpr unsigned long CONVERGENCE_TIMEOUT_MS = 60000;
+
+unsigned long applyDelayMs = 1500;
+
+// 計數 getter 呼叫並記錄 update() 耗時的控制器（同步成本量測時扣除協議查詢）
+class CountingController : public ThermostatController {
+public:
+    using ThermostatController::ThermostatController;
+
+    mutable uint32_t getterCalls = 0;
+    uint64_t updateNanos = 0;
+
+    bool getPower() const override { getterCalls++; return ThermostatController::getPower(); }
+    uint8_t getTargetMode() const override { getterCalls++; return ThermostatController::getTargetMode(); }
+    float getTargetTemperature() const override { getterCalls++; return ThermostatController::getTargetTemperature(); }
+    float getCurrentTemperature() const override { getterCalls++; return ThermostatController::getCurrentTemperature(); }
+    uint8_t getFanSpeed() const override { getterCalls++; return ThermostatController::getFanSpeed(); }
+    bool getSwing(IACProtocol::SwingAxis axis) const override {
+        getterCalls++;
+        return ThermostatController::getSwing(axis);
+    }
+
+    void update() override {
+        auto start = std::chrono::steady_clock::now();
+        ThermostatController::update();
+        updateNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// 被測系統
+struct Rig {
+    SimulatedS21Unit* unit;
+    CountingController* controller;
+    ThermostatDevice* thermostat;
+    FanDevice* fan;
+    SwingSwitchService* swing;
+    SpanCharacteristic* targetMode;
+    SpanCharacteristic* targetTemp;
+    SpanCharacteristic* fanOn;
+    SpanCharacteristic* fanSpeed;
+    SpanCharacteristic* swingOn;
+};
+
+// 期望的最終狀態（最後一次用戶意圖）
+struct Expected {
+    bool power;
+    uint8_t mode;
+    float targetTemperature;
+    uint8_t fanSpeed;
+    bool swingVertical;
+};
+
+struct TimedWrite {
+    unsigned long at;
+    std::function<void(Rig&)> apply;
+};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    SimulatedS21Unit::State initial;
+    std::vector<TimedWrite> writes;
+    Expected expected;
+};
+
+Rig buildRig(const SimulatedS21Unit::State& initial) {
+    Rig rig{};
+    auto unit = std::unique_ptr<SimulatedS21Unit>(new SimulatedS21Unit(initial, applyDelayMs));
+    rig.unit = unit.get();
+    rig.controller = new CountingController(std::move(unit));
+
+    rig.thermostat = new ThermostatDevice(*rig.controller);
+    for (SpanCharacteristic* c : rig.thermostat->characteristics) {
+        if (dynamic_cast<Characteristic::TargetHeatingCoolingState*>(c)) rig.targetMode = c;
+        if (dynamic_cast<Characteristic::TargetTemperature*>(c)) rig.targetTemp = c;
+    }
+    rig.fan = new FanDevice(*rig.controller);
+    rig.fanOn = rig.fan->characteristics[0];
+    rig.fanSpeed = rig.fan->characteristics[1];
+    rig.swing = new SwingSwitchService(*rig.controller, IACProtocol::SwingAxis::Vertical, "swing");
+    rig.swingOn = rig.swing->characteristics[1];
+
+    ACCESSORY_SYNC.begin(*rig.controller, rig.thermostat, rig.fan);
+    ACCESSORY_SYNC.attachSwing(rig.swing);
+    return rig;
+}
+
+bool unitMatches(const Rig& rig, const Expected& e, uint8_t* mismatchedFields) {
+    const SimulatedS21Unit::State& s = rig.unit->getAppliedState();
+    uint8_t mismatched = 0;
+    if (s.power != e.power) mismatched++;
+    if (e.power && s.mode != e.mode) mismatched++;
+    if (fabsf(s.targetTemperature - e.targetTemperature) > 0.05f) mismatched++;
+    if (e.power && s.fanSpeed != e.fanSpeed) mismatched++;
+    if (s.swingVertical != e.swingVertical) mismatched++;
+    if (mismatchedFields) *mismatchedFields = mismatched;
+    return mismatched == 0;
+}
+
+bool homeKitMatches(const Rig& rig, const Expected& e) {
+    int expectedMode = e.power ? convertACToHomeKitMode(e.mode, true) : HAP_MODE_OFF;
+    return rig.targetMode->getVal() == expectedMode &&
+           fabsf(rig.targetTemp->getVal<float>() - e.targetTemperature) < 0.05f &&
+           rig.swingOn->getVal() == (int)e.swingVertical;
+}
+
+void runScenario(const Scenario& scenario) {
+    HostClock::set(1);
+    Rig rig = buildRig(scenario.initial);
+
+    // 初始狀態穩定後再開始計數
+    for (unsigned long t = 0; t < 3000; t += STEP_MS) {
+        HostClock::advance(STEP_MS);
+        rig.unit->advance(millis());
+        ACCESSORY_SYNC.tick(millis());
+    }
+    uint32_t framesBefore[SimulatedS21Unit::FRAME_COUNT];
+    for (uint8_t i = 0; i < SimulatedS21Unit::FRAME_COUNT; i++) {
+        framesBefore[i] = rig.unit->getFrames((SimulatedS21Unit::Frame)i);
+    }
+    unsigned long busBefore = rig.unit->getBusTimeMs();
+    uint32_t notifyBefore = HOMEKIT_NOTIFIER.getStats().sent;
+
+    unsigned long start = millis();
+    size_t nextWrite = 0;
+    unsigned long lastWriteAt = start;
+    uint64_t writeNanos = 0;
+    uint32_t writeCount = 0;
+    long convergedAt = -1;
+
+    while (millis() - start < CONVERGENCE_TIMEOUT_MS) {
+        unsigned long elapsed = millis() - start;
+
+        while (nextWrite < scenario.writes.size() && scenario.writes[nextWrite].at <= elapsed) {
+            auto t0 = std::chrono::steady_clock::now();
+            scenario.writes[nextWrite].apply(rig);
+            auto t1 = std::chrono::steady_clock::now();
+            writeNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            writeCount++;
+            lastWriteAt = millis();
+            nextWrite++;
+        }
+
+        rig.unit->advance(millis());
+        ACCESSORY_SYNC.tick(millis());
+
+        bool done = nextWrite == scenario.writes.size();
+        if (done && unitMatches(rig, scenario.expected, nullptr) && homeKitMatches(rig, scenario.expected)) {
+            if (convergedAt < 0) convergedAt = (long)(millis() - lastWriteAt);
+        } else {
+            convergedAt = -1;  // 收斂後又被改回（flap）則重新計時
+        }
+
+        HostClock::advance(STEP_MS);
+    }
+
+    uint8_t dropped = 0;
+    unitMatches(rig, scenario.expected, &dropped);
+
+    uint32_t intentExpired = 0;
+    uint32_t intentFlaps = 0;
+    for (uint8_t i = 0; i < FieldIntentTracker::FIELD_COUNT; i++) {
+        const FieldIntent& intent = rig.controller->getIntent(static_cast<IntentField>(i));
+        intentExpired += intent.expired;
+        intentFlaps += intent.flaps;
+    }
+
+    printf("%-16s %5u", scenario.name, writeCount);
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < SimulatedS21Unit::FRAME_COUNT; i++) {
+        uint32_t n = rig.unit->getFrames((SimulatedS21Unit::Frame)i) - framesBefore[i];
+        total += n;
+        printf(" %4u", n);
+    }
+    printf(" %5u %6lu", total, rig.unit->getBusTimeMs() - busBefore);
+    if (convergedAt >= 0) printf(" %8ld", convergedAt);
+    else printf(" %8s", "never");
+    printf(" %7u %6u %6u %6u %8.2f\n", dropped, intentFlaps, intentExpired,
+           HOMEKIT_NOTIFIER.getStats().sent - notifyBefore,
+           writeCount ? (double)writeNanos / writeCount / 1000.0 : 0.0);
+}
+
+// 沒有 HomeKit 寫入時的同步成本：每 10 ms 一輪主迴圈，量測 getter 呼叫數與同步 CPU 時間
+// （扣除 controller.update() 的協議查詢）。roomStepMs > 0 時室溫每隔該時間變化 0.5°C
+void runSyncCost(const char* name, unsigned long roomStepMs) {
+    constexpr unsigned long DURATION_MS = 60000;
+    HostClock::set(1);
+    Rig rig = buildRig({true, AC_MODE_COOL, 24.0f, FAN_AUTO, false, false});
+
+    for (unsigned long t = 0; t < 3000; t += STEP_MS) {
+        HostClock::advance(STEP_MS);
+        rig.unit->advance(millis());
+        ACCESSORY_SYNC.tick(millis());
+    }
+    rig.controller->getterCalls = 0;
+    rig.controller->updateNanos = 0;
+    AccessorySync::Stats before = ACCESSORY_SYNC.getStats();
+
+    // 整段計時一次，避免每輪讀時鐘的成本蓋過同步本身
+    uint32_t loops = 0;
+    float room = 26.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long t = 0; t < DURATION_MS; t += STEP_MS) {
+        if (roomStepMs && t % roomStepMs == 0) {
+            room += 0.5f;
+            rig.unit->setRoomTemperature(room);
+        }
+        rig.unit->advance(millis());
+        ACCESSORY_SYNC.tick(millis());
+        loops++;
+        HostClock::advance(STEP_MS);
+    }
+    uint64_t syncNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() - rig.controller->updateNanos;
+
+    AccessorySync::Stats after = ACCESSORY_SYNC.getStats();
+    uint32_t ticks = after.ticks - before.ticks;
+    double seconds = DURATION_MS / 1000.0;
+    printf("%-16s %6u %6u %9.1f %9.2f %9.3f\n", name, ticks, after.dirtyTicks - before.dirtyTicks,
+           rig.controller->getterCalls / seconds, syncNanos / 1000.0 / ticks, syncNanos / 1000.0 / loops);
+}
+
+// 場景定義
+std::vector<Scenario> buildScenarios() {
+    std::vector<Scenario> scenarios;
+    const SimulatedS21Unit::State coolOn{true, AC_MODE_COOL, 24.0f, FAN_AUTO, false, false};
+    const SimulatedS21Unit::State off{false, AC_MODE_COOL, 24.0f, FAN_AUTO, false, false};
+
+    // 滑桿拖曳：2 秒內 40 次目標溫度寫入（20 次/秒），22.0 → 26.0，以 0.5 步進量化
+    {
+        Scenario s{"slider-drag", "20 setpoints/s for 2 s", coolOn, {}, {}};
+        for (int i = 0; i < 40; i++) {
+            float value = 22.0f + roundf(i * 0.1026f / 0.5f) * 0.5f;
+            s.writes.push_back({(unsigned long)i * 50, [value](Rig& rig) {
+                HostHap::write({{rig.targetTemp, value}});
+            }});
+        }
+        s.expected = {true, AC_MODE_COOL, 26.0f, FAN_AUTO, false};
+        scenarios.push_back(s);
+    }
+
+    // 場景切換：模式+溫度（同一 PUT）與風速同時變更，每 2 秒一次共 5 次
+    {
+        Scenario s{"scene-burst", "mode+temp+fan x5, 2 s apart", coolOn, {}, {}};
+        for (int i = 0; i < 5; i++) {
+            bool heat = (i % 2) == 0;
+            unsigned long at = (unsigned long)i * 2000;
+            s.writes.push_back({at, [heat](Rig& rig) {
+                HostHap::write({{rig.targetMode, (double)(heat ? HAP_MODE_HEAT : HAP_MODE_COOL)},
+                                {rig.targetTemp, heat ? 25.0 : 22.0}});
+            }});
+            s.writes.push_back({at, [heat](Rig& rig) {
+                HostHap::write({{rig.fanOn, 1}, {rig.fanSpeed, heat ? 80.0 : 35.0}});
+            }});
+        }
+        s.expected = {true, AC_MODE_HEAT, 25.0f, FAN_SPEED_4, false};
+        scenarios.push_back(s);
+    }
+
+    // 關機狀態下的場景：一次打開並設定模式、溫度、風速
+    {
+        Scenario s{"scene-from-off", "power on with mode+temp+fan", off, {}, {}};
+        s.writes.push_back({0, [](Rig& rig) {
+            HostHap::write({{rig.targetMode, (double)HAP_MODE_HEAT}, {rig.targetTemp, 26.0}});
+        }});
+        s.writes.push_back({0, [](Rig& rig) {
+            HostHap::write({{rig.fanOn, 1}, {rig.fanSpeed, 55.0}});
+        }});
+        s.expected = {true, AC_MODE_HEAT, 26.0f, FAN_SPEED_3, false};
+        scenarios.push_back(s);
+    }
+
+    // 同一場景改走 /api/control：電源+模式+溫度+風速+擺風一次套用（一個 D1 + 一個 D5 + 確認 G1）
+    {
+        Scenario s{"batch-from-off", "/api/control power+mode+temp+fan+swing", off, {}, {}};
+        s.writes.push_back({0, [](Rig& rig) {
+            ControlRequest request;
+            request.hasMode = true;
+            request.mode = AC_MODE_HEAT;
+            request.hasTemperature = true;
+            request.temperature = 26.0f;
+            request.hasFanSpeed = true;
+            request.fanSpeed = FAN_SPEED_3;
+            request.hasSwingVertical = true;
+            request.swingVertical = true;
+            ControlResult result;
+            rig.controller->applyControl(request, result);
+        }});
+        s.expected = {true, AC_MODE_HEAT, 26.0f, FAN_SPEED_3, true};
+        scenarios.push_back(s);
+    }
+
+    // 擺風開關連按：100 ms 一次共 11 次，最後為開啟
+    {
+        Scenario s{"swing-toggle", "11 toggles, 100 ms apart", coolOn, {}, {}};
+        for (int i = 0; i < 11; i++) {
+            bool on = (i % 2) == 0;
+            s.writes.push_back({(unsigned long)i * 100, [on](Rig& rig) {
+                HostHap::write({{rig.swingOn, on ? 1.0 : 0.0}});
+            }});
+        }
+        s.expected = {true, AC_MODE_COOL, 24.0f, FAN_AUTO, true};
+        scenarios.push_back(s);
+    }
+
+    // 以遙控器開啟擺風：沒有 HomeKit 寫入，變化要在一個輪詢週期內回報給 HomeKit
+    // （10 秒後才按，避開啟動後第一次擺風查詢）
+    {
+        Scenario s{"remote-swing", "IR remote turns swing on after 10 s", coolOn, {}, {}};
+        s.writes.push_back({10000, [](Rig& rig) {
+            rig.unit->remoteControl({true, AC_MODE_COOL, 24.0f, FAN_AUTO, true, false});
+        }});
+        s.expected = {true, AC_MODE_COOL, 24.0f, FAN_AUTO, true};
+        scenarios.push_back(s);
+    }
+
+    return scenarios;
+}
+
+void printUsage(const char* prog) {
+    printf("用法: %s [--verbose] [--apply-delay MS] [scenario ...]\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> selected;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--verbose") {
+            Serial.echo = true;
+        } else if (arg == "--apply-delay" && i + 1 < argc) {
+            applyDelayMs = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            selected.push_back(arg);
+        }
+    }
+
+    std::vector<Scenario> scenarios = buildScenarios();
+
+    printf("空調生效延遲 %lu ms，模擬步長 %lu ms，收斂上限 %lu ms\n\n",
+           applyDelayMs, STEP_MS, CONVERGENCE_TIMEOUT_MS);
+    printf("%-16s %5s %4s %4s %4s %4s %4s %5s %6s %8s %7s %6s %6s %6s %8s\n",
+           "scenario", "write", "D1", "D5", "F1", "RH", "F5", "frame", "busMs",
+           "convMs", "dropped", "flaps", "expire", "notify", "us/write");
+    fflush(stdout);
+
+    int failures = 0;
+    for (const Scenario& scenario : scenarios) {
+        if (!selected.empty() &&
+            std::find(selected.begin(), selected.end(), scenario.name) == selected.end()) {
+            continue;
+        }
+
+        // HomeKitNotifier / AccessorySync 為單例，每個場景在獨立子行程中執行
+        pid_t pid = fork();
+        if (pid == 0) {
+            runScenario(scenario);
+            fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("%-16s 執行失敗\n", scenario.name);
+            failures++;
+        }
+    }
+
+    // 同步成本（各自在子行程中執行）
+    const struct { const char* name; unsigned long roomStepMs; } syncCases[] = {
+        {"sync-idle", 0},
+        {"sync-room-temp", 5000},
+    };
+    printf("\n%-16s %6s %6s %9s %9s %9s\n", "sync", "ticks", "dirty", "getters/s", "us/tick", "us/loop");
+    fflush(stdout);
+    for (const auto& c : syncCases) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), c.name) == selected.end()) {
+            continue;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            runSyncCost(c.name, c.roomStepMs);
+            fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("%-16s 執行失敗\n", c.name);
+            failures++;
+        }
+    }
+
+    printf("\n");
+    for (const Scenario& scenario : scenarios) {
+        if (selected.empty() ||
+            std::find(selected.begin(), selected.end(), scenario.name) != selected.end()) {
+            printf("  %-16s %s\n", scenario.name, scenario.description);
+        }
+    }
+    return failures ? 1 : 0;
+}